@@ -0,0 +1,302 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of LocalChannel.
+//
+// What: "@(#) LocalChannel.cpp, revA"
+
+#include <LocalChannel.h>
+#include <OPS_Globals.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <string.h>
+
+static int
+checkAddress(const char *method, ChannelAddress *theAddress)
+{
+  if (theAddress != 0) {
+    opserr << "LocalChannel::" << method << "() - a LocalChannel ";
+    opserr << "can only communicate with itself\n";
+    return -1;
+  }
+  return 0;
+}
+
+
+LocalChannel::LocalChannel()
+  :readLoc(0)
+{
+
+}
+
+
+LocalChannel::~LocalChannel()
+{
+
+}
+
+
+char *
+LocalChannel::addToProgram(void)
+{
+  return 0;
+}
+
+
+int
+LocalChannel::setUpConnection(void)
+{
+  return 0;
+}
+
+
+int
+LocalChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+  return checkAddress("setNextAddress", (ChannelAddress *)&theAddress);
+}
+
+
+int
+LocalChannel::writeBytes(const void *data, int num)
+{
+  // start over once everything sent has been received
+  if (readLoc == (int)theBuffer.size()) {
+    theBuffer.clear();
+    readLoc = 0;
+  }
+
+  const char *bytes = (const char *)data;
+  theBuffer.insert(theBuffer.end(), bytes, bytes+num);
+
+  return 0;
+}
+
+
+int
+LocalChannel::readBytes(void *data, int num)
+{
+  if (readLoc + num > (int)theBuffer.size()) {
+    opserr << "LocalChannel::readBytes() - receiving " << num;
+    opserr << " bytes, only " << (int)theBuffer.size() - readLoc << " have been sent\n";
+    return -1;
+  }
+
+  if (num > 0)
+    memcpy(data, &theBuffer[readLoc], num);
+  readLoc += num;
+
+  return 0;
+}
+
+
+int
+LocalChannel::sendObj(int commitTag,
+		      MovableObject &theObject,
+		      ChannelAddress *theAddress)
+{
+  if (checkAddress("sendObj", theAddress) != 0)
+    return -1;
+
+  return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+LocalChannel::recvObj(int commitTag,
+		      MovableObject &theObject,
+		      FEM_ObjectBroker &theBroker,
+		      ChannelAddress *theAddress)
+{
+  if (checkAddress("recvObj", theAddress) != 0)
+    return -1;
+
+  return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+LocalChannel::sendMsg(int dbTag, int commitTag,
+		      const Message &msg,
+		      ChannelAddress *theAddress)
+{
+  if (checkAddress("sendMsg", theAddress) != 0)
+    return -1;
+
+  Message &theMsg = (Message &)msg;
+  return this->writeBytes(theMsg.getData(), theMsg.getSize());
+}
+
+
+int
+LocalChannel::recvMsg(int dbTag, int commitTag,
+		      Message &msg,
+		      ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMsg", theAddress) != 0)
+    return -1;
+
+  return this->readBytes((void *)msg.getData(), msg.getSize());
+}
+
+
+int
+LocalChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+				 Message &msg,
+				 ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMsgUnknownSize", theAddress) != 0)
+    return -1;
+
+  // as for a socket, up to and including the end of the line or string
+  char *gMsg = (char *)msg.getData();
+  int length = msg.getSize();
+  for (int i=0; i<length; i++) {
+    if (this->readBytes(gMsg, 1) != 0)
+      return -1;
+    if (*gMsg == '\0')
+      return 0;
+    gMsg++;
+    if (*(gMsg-1) == '\n') {
+      if (i+1 < length)
+	*gMsg = '\0';
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
+
+int
+LocalChannel::sendMatrix(int dbTag, int commitTag,
+			 const Matrix &theMatrix,
+			 ChannelAddress *theAddress)
+{
+  if (checkAddress("sendMatrix", theAddress) != 0)
+    return -1;
+
+  int numRows = theMatrix.noRows();
+  int numCols = theMatrix.noCols();
+  for (int j=0; j<numCols; j++)
+    for (int i=0; i<numRows; i++) {
+      double value = theMatrix(i,j);
+      this->writeBytes(&value, sizeof(double));
+    }
+
+  return 0;
+}
+
+
+int
+LocalChannel::recvMatrix(int dbTag, int commitTag,
+			 Matrix &theMatrix,
+			 ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMatrix", theAddress) != 0)
+    return -1;
+
+  int numRows = theMatrix.noRows();
+  int numCols = theMatrix.noCols();
+  for (int j=0; j<numCols; j++)
+    for (int i=0; i<numRows; i++)
+      if (this->readBytes(&theMatrix(i,j), sizeof(double)) != 0)
+	return -1;
+
+  return 0;
+}
+
+
+int
+LocalChannel::sendVector(int dbTag, int commitTag,
+			 const Vector &theVector,
+			 ChannelAddress *theAddress)
+{
+  if (checkAddress("sendVector", theAddress) != 0)
+    return -1;
+
+  int size = theVector.Size();
+  for (int i=0; i<size; i++) {
+    double value = theVector(i);
+    this->writeBytes(&value, sizeof(double));
+  }
+
+  return 0;
+}
+
+
+int
+LocalChannel::recvVector(int dbTag, int commitTag,
+			 Vector &theVector,
+			 ChannelAddress *theAddress)
+{
+  if (checkAddress("recvVector", theAddress) != 0)
+    return -1;
+
+  int size = theVector.Size();
+  for (int i=0; i<size; i++)
+    if (this->readBytes(&theVector(i), sizeof(double)) != 0)
+      return -1;
+
+  return 0;
+}
+
+
+int
+LocalChannel::sendID(int dbTag, int commitTag,
+		     const ID &theID,
+		     ChannelAddress *theAddress)
+{
+  if (checkAddress("sendID", theAddress) != 0)
+    return -1;
+
+  int size = theID.Size();
+  for (int i=0; i<size; i++) {
+    int value = theID(i);
+    this->writeBytes(&value, sizeof(int));
+  }
+
+  return 0;
+}
+
+
+int
+LocalChannel::recvID(int dbTag, int commitTag,
+		     ID &theID,
+		     ChannelAddress *theAddress)
+{
+  if (checkAddress("recvID", theAddress) != 0)
+    return -1;
+
+  int size = theID.Size();
+  for (int i=0; i<size; i++)
+    if (this->readBytes(&theID(i), sizeof(int)) != 0)
+      return -1;
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file contains the class definition for LocalChannel.
+// LocalChannel is a sub-class of channel whose two ends are in the same
+// process: what is sent is kept in memory until it is received, in the
+// order sent. It is used to copy an object with sendSelf() and
+// recvSelf(), e.g. to give an in-process Subdomain its own copy of the
+// analysis objects a ShadowSubdomain would be sent.
+//
+// What: "@(#) LocalChannel.h, revA"
+
+#ifndef LocalChannel_h
+#define LocalChannel_h
+
+#include <Channel.h>
+#include <vector>
+
+class LocalChannel : public Channel
+{
+  public:
+    LocalChannel();
+    ~LocalChannel();
+
+    char *addToProgram(void);
+
+    virtual int setUpConnection(void);
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress(void) {return 0;};
+
+    int sendObj(int commitTag,
+		MovableObject &theObject,
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject,
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+  protected:
+
+  private:
+    int writeBytes(const void *data, int num);
+    int readBytes(void *data, int num);
+
+    std::vector<char> theBuffer;   // bytes sent and not yet received
+    int readLoc;                   // location of the next byte to receive
+};
+
+#endif
@@ -0,0 +1,518 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of SharedMemoryChannel.
+//
+// What: "@(#) SharedMemoryChannel.cpp, revA"
+
+#include <SharedMemoryChannel.h>
+#include <OPS_Globals.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Message.h>
+#include <MovableObject.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_CHANNEL_MAGIC 0x4d485330   // "0SHM"
+#define SHM_CHANNEL_SPIN  1000         // polls before yielding the cpu
+
+// the counters of a ring only ever increase; each is written by one
+// process, and each sits in its own cache line so that the writer and
+// reader do not contend for one line
+struct SharedMemoryRing
+{
+  volatile long long written;   // bytes written, set by the writer
+  char pad1[56];
+  volatile long long read;      // bytes read, set by the reader
+  char pad2[56];
+  volatile int closed;          // writer has gone, set by the writer
+  char pad3[60];
+};
+
+struct SharedMemoryHeader
+{
+  volatile int magic;           // set last by the creator
+  int bufferSize;
+  volatile int attached;        // set by the other process
+  char pad[52];
+  SharedMemoryRing rings[2];    // 0 creator to other, 1 other to creator
+};
+
+static inline long long
+loadAcquire(volatile long long *value)
+{
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline int
+loadAcquire(volatile int *value)
+{
+  return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline void
+storeRelease(volatile long long *value, long long newValue)
+{
+  __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+static inline void
+storeRelease(volatile int *value, int newValue)
+{
+  __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+static inline void
+waitForOther(int &count)
+{
+  if (++count > SHM_CHANNEL_SPIN)
+    sched_yield();
+}
+
+static int
+checkAddress(const char *method, ChannelAddress *theAddress)
+{
+  if (theAddress != 0) {
+    opserr << "SharedMemoryChannel::" << method << "() - a SharedMemoryChannel ";
+    opserr << "can only communicate with the one other process attached to it\n";
+    return -1;
+  }
+  return 0;
+}
+
+
+SharedMemoryChannel::SharedMemoryChannel(const char *theName, int type, int size)
+  :name(0), connectType(type), bufferSize(size), segmentSize(0),
+   fd(-1), theHeader(0), sendRing(0), recvRing(0), sendBuffer(0), recvBuffer(0)
+{
+  // shared memory object names start with a /
+  int length = strlen(theName);
+  name = new char[length+2];
+  if (theName[0] == '/')
+    strcpy(name, theName);
+  else {
+    name[0] = '/';
+    strcpy(&name[1], theName);
+  }
+
+  if (connectType != 0)
+    return;
+
+  if (bufferSize < 1024)
+    bufferSize = 1024;
+  segmentSize = sizeof(SharedMemoryHeader) + 2*bufferSize;
+
+  // a segment left by a process that died is removed
+  fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+
+  if (fd < 0) {
+    opserr << "SharedMemoryChannel::SharedMemoryChannel() - could not create " << name << endln;
+    return;
+  }
+
+  if (ftruncate(fd, segmentSize) != 0 || this->mapSegment(fd, segmentSize) != 0) {
+    opserr << "SharedMemoryChannel::SharedMemoryChannel() - could not size or map " << name << endln;
+    close(fd);
+    fd = -1;
+    shm_unlink(name);
+    return;
+  }
+
+  memset((void *)theHeader, 0, sizeof(SharedMemoryHeader));
+  theHeader->bufferSize = bufferSize;
+  storeRelease(&theHeader->magic, SHM_CHANNEL_MAGIC);
+}
+
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+  if (sendRing != 0)
+    storeRelease(&sendRing->closed, 1);
+
+  if (theHeader != 0) {
+    // remove the name if the other process never attached
+    if (connectType == 0 && loadAcquire(&theHeader->attached) == 0)
+      shm_unlink(name);
+    munmap((void *)theHeader, segmentSize);
+  }
+
+  if (fd >= 0)
+    close(fd);
+
+  if (name != 0)
+    delete [] name;
+}
+
+
+int
+SharedMemoryChannel::mapSegment(int theFd, int size)
+{
+  void *address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, theFd, 0);
+  if (address == MAP_FAILED)
+    return -1;
+
+  theHeader = (SharedMemoryHeader *)address;
+  segmentSize = size;
+
+  char *data = (char *)address + sizeof(SharedMemoryHeader);
+  if (connectType == 0) {
+    sendRing = &theHeader->rings[0];
+    recvRing = &theHeader->rings[1];
+    sendBuffer = data;
+    recvBuffer = data + bufferSize;
+  } else {
+    sendRing = &theHeader->rings[1];
+    recvRing = &theHeader->rings[0];
+    sendBuffer = data + bufferSize;
+    recvBuffer = data;
+  }
+
+  return 0;
+}
+
+
+char *
+SharedMemoryChannel::addToProgram(void)
+{
+  char *newStuff = (char *)malloc((strlen(name)+8)*sizeof(char));
+  strcpy(newStuff, " 3 ");
+  strcat(newStuff, name);
+  strcat(newStuff, " ");
+
+  return newStuff;
+}
+
+
+int
+SharedMemoryChannel::setUpConnection(void)
+{
+  int count = 0;
+
+  if (connectType == 0) {
+
+    if (theHeader == 0) {
+      opserr << "SharedMemoryChannel::setUpConnection() - no segment " << name << endln;
+      return -1;
+    }
+
+    // wait for the other process to attach, then remove the name so
+    // that the segment goes when both processes have finished with it
+    while (loadAcquire(&theHeader->attached) == 0)
+      waitForOther(count);
+
+    shm_unlink(name);
+    return 0;
+  }
+
+  if (theHeader != 0)
+    return 0;
+
+  // the creator may not yet be running, try for 10 seconds
+  struct stat theStat;
+  for (int i=0; i<1000 && theHeader == 0; i++) {
+
+    if (fd < 0)
+      fd = shm_open(name, O_RDWR, 0600);
+
+    if (fd >= 0 && fstat(fd, &theStat) == 0 &&
+	theStat.st_size > (off_t)sizeof(SharedMemoryHeader)) {
+      bufferSize = (theStat.st_size - sizeof(SharedMemoryHeader))/2;
+      if (this->mapSegment(fd, theStat.st_size) != 0) {
+	opserr << "SharedMemoryChannel::setUpConnection() - could not map " << name << endln;
+	return -1;
+      }
+    } else
+      usleep(10000);
+  }
+
+  if (theHeader == 0) {
+    opserr << "SharedMemoryChannel::setUpConnection() - could not attach to " << name << endln;
+    return -1;
+  }
+
+  while (loadAcquire(&theHeader->magic) != SHM_CHANNEL_MAGIC)
+    waitForOther(count);
+
+  storeRelease(&theHeader->attached, 1);
+
+  return 0;
+}
+
+
+int
+SharedMemoryChannel::setNextAddress(const ChannelAddress &theAddress)
+{
+  return checkAddress("setNextAddress", (ChannelAddress *)&theAddress);
+}
+
+
+// copies num bytes into the send ring, waiting for the other process
+// to empty it when it is full
+int
+SharedMemoryChannel::writeBytes(const char *data, int num)
+{
+  if (sendRing == 0) {
+    opserr << "SharedMemoryChannel::writeBytes() - channel not set up\n";
+    return -1;
+  }
+
+  long long written = sendRing->written;
+  int count = 0;
+
+  while (num > 0) {
+    long long space = bufferSize - (written - loadAcquire(&sendRing->read));
+    if (space == 0) {
+      if (loadAcquire(&recvRing->closed) != 0) {
+	opserr << "SharedMemoryChannel::writeBytes() - other process has gone\n";
+	return -1;
+      }
+      waitForOther(count);
+      continue;
+    }
+    count = 0;
+
+    int n = (space < num) ? (int)space : num;
+    int start = (int)(written % bufferSize);
+    int first = (n < bufferSize - start) ? n : bufferSize - start;
+
+    memcpy(sendBuffer + start, data, first);
+    if (n > first)
+      memcpy(sendBuffer, data + first, n - first);
+
+    written += n;
+    data += n;
+    num -= n;
+
+    storeRelease(&sendRing->written, written);
+  }
+
+  return 0;
+}
+
+
+// copies num bytes out of the receive ring, waiting for the other
+// process to fill it when it is empty
+int
+SharedMemoryChannel::readBytes(char *data, int num)
+{
+  if (recvRing == 0) {
+    opserr << "SharedMemoryChannel::readBytes() - channel not set up\n";
+    return -1;
+  }
+
+  long long read = recvRing->read;
+  int count = 0;
+
+  while (num > 0) {
+    int closed = loadAcquire(&recvRing->closed);
+    long long available = loadAcquire(&recvRing->written) - read;
+    if (available == 0) {
+      if (closed != 0) {
+	opserr << "SharedMemoryChannel::readBytes() - other process has gone\n";
+	return -1;
+      }
+      waitForOther(count);
+      continue;
+    }
+    count = 0;
+
+    int n = (available < num) ? (int)available : num;
+    int start = (int)(read % bufferSize);
+    int first = (n < bufferSize - start) ? n : bufferSize - start;
+
+    memcpy(data, recvBuffer + start, first);
+    if (n > first)
+      memcpy(data + first, recvBuffer, n - first);
+
+    read += n;
+    data += n;
+    num -= n;
+
+    storeRelease(&recvRing->read, read);
+  }
+
+  return 0;
+}
+
+
+int
+SharedMemoryChannel::sendObj(int commitTag,
+			     MovableObject &theObject,
+			     ChannelAddress *theAddress)
+{
+  if (checkAddress("sendObj", theAddress) != 0)
+    return -1;
+
+  return theObject.sendSelf(commitTag, *this);
+}
+
+
+int
+SharedMemoryChannel::recvObj(int commitTag,
+			     MovableObject &theObject,
+			     FEM_ObjectBroker &theBroker,
+			     ChannelAddress *theAddress)
+{
+  if (checkAddress("recvObj", theAddress) != 0)
+    return -1;
+
+  return theObject.recvSelf(commitTag, *this, theBroker);
+}
+
+
+int
+SharedMemoryChannel::sendMsg(int dbTag, int commitTag,
+			     const Message &msg,
+			     ChannelAddress *theAddress)
+{
+  if (checkAddress("sendMsg", theAddress) != 0)
+    return -1;
+
+  return this->writeBytes(msg.data, msg.length);
+}
+
+
+int
+SharedMemoryChannel::recvMsg(int dbTag, int commitTag,
+			     Message &msg,
+			     ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMsg", theAddress) != 0)
+    return -1;
+
+  return this->readBytes(msg.data, msg.length);
+}
+
+
+// reads up to the end of a string or line, as TCP_Socket does
+int
+SharedMemoryChannel::recvMsgUnknownSize(int dbTag, int commitTag,
+					Message &msg,
+					ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMsgUnknownSize", theAddress) != 0)
+    return -1;
+
+  char *gMsg = msg.data;
+  for (int i=0; i<msg.length; i++) {
+    if (this->readBytes(gMsg, 1) != 0)
+      return -1;
+    if (*gMsg == '\0')
+      return 0;
+    gMsg++;
+    if (*(gMsg-1) == '\n') {
+      if (i+1 < msg.length)
+	*gMsg = '\0';
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
+
+int
+SharedMemoryChannel::sendMatrix(int dbTag, int commitTag,
+				const Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  if (checkAddress("sendMatrix", theAddress) != 0)
+    return -1;
+
+  return this->writeBytes((const char *)theMatrix.data, theMatrix.dataSize*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvMatrix(int dbTag, int commitTag,
+				Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  if (checkAddress("recvMatrix", theAddress) != 0)
+    return -1;
+
+  return this->readBytes((char *)theMatrix.data, theMatrix.dataSize*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendVector(int dbTag, int commitTag,
+				const Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  if (checkAddress("sendVector", theAddress) != 0)
+    return -1;
+
+  return this->writeBytes((const char *)theVector.theData, theVector.sz*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::recvVector(int dbTag, int commitTag,
+				Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  if (checkAddress("recvVector", theAddress) != 0)
+    return -1;
+
+  return this->readBytes((char *)theVector.theData, theVector.sz*sizeof(double));
+}
+
+
+int
+SharedMemoryChannel::sendID(int dbTag, int commitTag,
+			    const ID &theID,
+			    ChannelAddress *theAddress)
+{
+  if (checkAddress("sendID", theAddress) != 0)
+    return -1;
+
+  return this->writeBytes((const char *)theID.data, theID.sz*sizeof(int));
+}
+
+
+int
+SharedMemoryChannel::recvID(int dbTag, int commitTag,
+			    ID &theID,
+			    ChannelAddress *theAddress)
+{
+  if (checkAddress("recvID", theAddress) != 0)
+    return -1;
+
+  return this->readBytes((char *)theID.data, theID.sz*sizeof(int));
+}
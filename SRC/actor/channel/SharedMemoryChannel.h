@@ -0,0 +1,120 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file contains the class definition for SharedMemoryChannel.
+// SharedMemoryChannel is a sub-class of channel for two processes on the
+// same machine. It is implemented with a POSIX shared memory segment
+// holding two ring buffers, one for each direction, each written by one
+// process and read by the other without locks. Data is copied straight
+// from the sending object into the ring and from the ring into the
+// receiving object, with no byte swapping and no system calls. Like a
+// TCP_Socket one side, connectType 0, creates the segment and waits for
+// the other, connectType 1, to attach to it by name.
+//
+// What: "@(#) SharedMemoryChannel.h, revA"
+
+#ifndef SharedMemoryChannel_h
+#define SharedMemoryChannel_h
+
+#include <Channel.h>
+
+#define SHM_CHANNEL_DEFAULT_SIZE 1048576
+
+struct SharedMemoryRing;
+struct SharedMemoryHeader;
+
+class SharedMemoryChannel : public Channel
+{
+  public:
+    SharedMemoryChannel(const char *name, int connectType,
+			int bufferSize = SHM_CHANNEL_DEFAULT_SIZE);
+    ~SharedMemoryChannel();
+
+    char *addToProgram(void);
+
+    virtual int setUpConnection(void);
+
+    int setNextAddress(const ChannelAddress &otherChannelAddress);
+    virtual ChannelAddress *getLastSendersAddress(void) {return 0;};
+
+    int sendObj(int commitTag,
+		MovableObject &theObject,
+		ChannelAddress *theAddress =0);
+    int recvObj(int commitTag,
+		MovableObject &theObject,
+		FEM_ObjectBroker &theBroker,
+		ChannelAddress *theAddress =0);
+
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+  protected:
+
+  private:
+    int mapSegment(int fd, int size);
+    int writeBytes(const char *data, int num);
+    int readBytes(char *data, int num);
+
+    char *name;
+    int connectType;
+    int bufferSize;       // bytes in each ring
+    int segmentSize;
+
+    int fd;
+    SharedMemoryHeader *theHeader;
+    SharedMemoryRing *sendRing;
+    SharedMemoryRing *recvRing;
+    char *sendBuffer;
+    char *recvBuffer;
+};
+
+#endif
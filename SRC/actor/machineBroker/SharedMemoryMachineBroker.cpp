@@ -0,0 +1,184 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// SharedMemoryMachineBroker.
+//
+// What: "@(#) SharedMemoryMachineBroker.cpp, revA"
+
+#include <SharedMemoryMachineBroker.h>
+#include <FEM_ObjectBroker.h>
+#include <ID.h>
+#include <OPS_Globals.h>
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+SharedMemoryMachineBroker::SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker,
+						     int np, int bufferSize)
+  :MachineBroker(theBroker), rank(0), size(np), usedChannels(0),
+   theChannels(0), thePIDs(0)
+{
+  if (size < 1)
+    size = 1;
+
+  theChannels = new SharedMemoryChannel *[size];
+  thePIDs = new pid_t[size];
+  for (int i=0; i<size; i++) {
+    theChannels[i] = 0;
+    thePIDs[i] = 0;
+  }
+  usedChannels = new ID(size);
+  usedChannels->Zero();
+
+  if (theBroker == 0 && size > 1) {
+    opserr << "SharedMemoryMachineBroker::SharedMemoryMachineBroker() - no FEM_ObjectBroker, no processes started\n";
+    size = 1;
+  }
+
+  // nothing buffered may be written twice, by the parent and a child
+  fflush(stdout);
+  fflush(stderr);
+
+  char name[64];
+  for (int i=1; i<size; i++) {
+
+    // the segment is created before the fork, so the child finds it
+    sprintf(name, "/OpenSees.%d.%d", (int)getpid(), i);
+    theChannels[i] = new SharedMemoryChannel(name, 0, bufferSize);
+
+    pid_t pid = fork();
+
+    if (pid == 0) {
+
+      // the child keeps the channels of the parent it inherited, deleting
+      // them would close the parent's rings, and connects to process 0
+      rank = i;
+      for (int j=0; j<size; j++) {
+	theChannels[j] = 0;
+	thePIDs[j] = 0;
+      }
+      size = np;
+
+      theChannels[0] = new SharedMemoryChannel(name, 1);
+      int res = theChannels[0]->setUpConnection();
+      if (res != 0)
+	opserr << "SharedMemoryMachineBroker::SharedMemoryMachineBroker() - process " << i << " could not connect\n";
+
+      // the child runs the actors process 0 starts on it until shutdown(),
+      // it must never return to the caller and run the parent's program
+      else if (this->runActors() != 0)
+	res = -1;
+
+      delete theChannels[0];
+      theChannels[0] = 0;
+      fflush(stdout);
+      fflush(stderr);
+      _exit(res == 0 ? 0 : 1);
+
+    } else if (pid < 0) {
+      opserr << "SharedMemoryMachineBroker::SharedMemoryMachineBroker() - could not fork process " << i << endln;
+      delete theChannels[i];
+      theChannels[i] = 0;
+      size = i;
+      break;
+    }
+
+    thePIDs[i] = pid;
+    theChannels[i]->setUpConnection();
+  }
+}
+
+
+SharedMemoryMachineBroker::~SharedMemoryMachineBroker()
+{
+  for (int i=0; i<size; i++)
+    if (theChannels[i] != 0)
+      delete theChannels[i];
+
+  // wait for the processes forked, which exit after shutdown()
+  if (rank == 0)
+    for (int i=1; i<size; i++)
+      if (thePIDs[i] > 0)
+	waitpid(thePIDs[i], 0, 0);
+
+  delete [] theChannels;
+  delete [] thePIDs;
+  delete usedChannels;
+}
+
+
+int
+SharedMemoryMachineBroker::getPID(void)
+{
+  return rank;
+}
+
+
+int
+SharedMemoryMachineBroker::getNP(void)
+{
+  return size;
+}
+
+
+Channel *
+SharedMemoryMachineBroker::getMyChannel(void)
+{
+  return theChannels[0];
+}
+
+
+Channel *
+SharedMemoryMachineBroker::getRemoteProcess(void)
+{
+  if (rank != 0) {
+    opserr << "SharedMemoryMachineBroker::getRemoteProcess() - child process cannot not yet allocate processes\n";
+    return 0;
+  }
+
+  for (int i=1; i<size; i++)
+    if ((*usedChannels)(i) == 0 && theChannels[i] != 0) {
+      (*usedChannels)(i) = 1;
+      return theChannels[i];
+    }
+
+  // no processes available
+  return 0;
+}
+
+
+int
+SharedMemoryMachineBroker::freeProcess(Channel *theChannel)
+{
+  for (int i=1; i<size; i++)
+    if (theChannels[i] == theChannel) {
+      (*usedChannels)(i) = 0;
+      return 0;
+    }
+
+  // channel not found!
+  return -1;
+}
@@ -0,0 +1,71 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Purpose: This file contains the class definition for
+// SharedMemoryMachineBroker. SharedMemoryMachineBroker is the broker for
+// a run on one machine: the constructor forks np-1 copies of the process,
+// each connected to process 0 by a SharedMemoryChannel. Only process 0
+// returns from the constructor; it starts the actors of ShadowSubdomains
+// as with MPI_MachineBroker. Each forked process runs runActors() and
+// exits once process 0 calls shutdown(). No MPI installation is needed.
+//
+// What: "@(#) SharedMemoryMachineBroker.h, revA"
+
+#ifndef SharedMemoryMachineBroker_h
+#define SharedMemoryMachineBroker_h
+
+#include <MachineBroker.h>
+#include <SharedMemoryChannel.h>
+#include <sys/types.h>
+
+class ID;
+class FEM_ObjectBroker;
+
+class SharedMemoryMachineBroker : public MachineBroker
+{
+  public:
+    SharedMemoryMachineBroker(FEM_ObjectBroker *theBroker, int np,
+			      int bufferSize = SHM_CHANNEL_DEFAULT_SIZE);
+    ~SharedMemoryMachineBroker();
+
+    // methods to return info about local process id and num processes
+    int getPID(void);
+    int getNP(void);
+
+    // methods to get and free Channels (processes)
+    Channel *getMyChannel(void);
+    Channel *getRemoteProcess(void);
+    int freeProcess(Channel *);
+
+  protected:
+
+  private:
+    int rank;
+    int size;
+    ID *usedChannels;
+    SharedMemoryChannel **theChannels;  // on 0 to each process, otherwise [0] to 0
+    pid_t *thePIDs;                     // on 0 the forked processes
+};
+
+#endif
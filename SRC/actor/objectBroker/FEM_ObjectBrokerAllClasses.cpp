@@ -477,6 +477,7 @@
 #include <TrapezoidalTimeSeriesIntegrator.h>
 
 #include <ArpackSOE.h>
+#include <SubspaceEigenSolver.h>
 
 #ifdef _PETSC
 #include <PetscSOE.h>
@@ -2165,6 +2166,10 @@ FEM_ObjectBrokerAllClasses::getNewEigenSOE(int classTagSOE)
 	  theSOE = new ArpackSOE();
 	  return theSOE;
 
+	case EigenSOE_TAGS_SubspaceEigenSOE:  
+	  theSOE = new ArpackSOE(*(new SubspaceEigenSolver()));
+	  return theSOE;
+
 	default:
 	  opserr << "FEM_ObjectBrokerAllClasses::getNewEigenSOE - ";
 	  opserr << " - no EigenSOE type exists for class tag ";
@@ -54,6 +54,7 @@
 void* OPS_NewtonRaphsonAlgorithm()
 {
     int formTangent = CURRENT_TANGENT;
+    bool fused = false;
 
     while(OPS_GetNumRemainingInputArgs() > 0) {
 	const char* type = OPS_GetString();
@@ -63,25 +64,28 @@ void* OPS_NewtonRaphsonAlgorithm()
 	    formTangent = INITIAL_TANGENT;
 	} else if(strcmp(type,"-intialThenCurrent")==0 || strcmp(type,"-intialCurrent")==0) {
 	    formTangent = INITIAL_THEN_CURRENT_TANGENT;
+	} else if(strcmp(type,"-fused")==0 || strcmp(type,"-Fused")==0) {
+	    fused = true;
 	}
     }
 
-    return new NewtonRaphson(formTangent);
+    return new NewtonRaphson(formTangent, fused);
 
 }
 
 // Constructor
-NewtonRaphson::NewtonRaphson(int theTangentToUse)
+NewtonRaphson::NewtonRaphson(int theTangentToUse, bool fusedFlag)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse)
+ tangent(theTangentToUse), numIterations(0), fused(fusedFlag)
 {
 
 }
 
 
-NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse)
+NewtonRaphson::NewtonRaphson(ConvergenceTest &theT, int theTangentToUse,
+			     bool fusedFlag)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_NewtonRaphson),
- tangent(theTangentToUse)
+ tangent(theTangentToUse), numIterations(0), fused(fusedFlag)
 {
 
 }
@@ -112,7 +116,23 @@ NewtonRaphson::solveCurrentStep(void)
 	return -5;
     }	
 
-    if (theIntegrator->formUnbalance() < 0) {
+    // with the fused option the tangent for the next iteration is formed
+    // in the same pass over the elements as the unbalance; only done when
+    // the tangent is the current one, as it is then needed every iteration
+    bool formFused = fused &&
+      (tangent == CURRENT_TANGENT || tangent == CURRENT_SECANT);
+    bool haveTangent = false;
+
+    if (formFused == true) {
+      SOLUTION_ALGORITHM_tangentFlag = tangent;
+      if (theIntegrator->formTangentAndUnbalance(tangent) < 0) {
+	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
+	opserr << "the Integrator failed in formTangentAndUnbalance()\n";	
+	return -2;
+      }
+      haveTangent = true;
+
+    } else if (theIntegrator->formUnbalance() < 0) {
       opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
       opserr << "the Integrator failed in formUnbalance()\n";	
       return -2;
@@ -131,7 +151,11 @@ NewtonRaphson::solveCurrentStep(void)
 
     do {
 
-      if (tangent == INITIAL_THEN_CURRENT_TANGENT) {
+      if (haveTangent == true) {
+	// formed with the unbalance
+	SOLUTION_ALGORITHM_tangentFlag = tangent;
+
+      } else if (tangent == INITIAL_THEN_CURRENT_TANGENT) {
 	if (numIterations == 0) {
 	  SOLUTION_ALGORITHM_tangentFlag = INITIAL_TANGENT;
 	  if (theIntegrator->formTangent(INITIAL_TANGENT) < 0){
@@ -167,7 +191,14 @@ NewtonRaphson::solveCurrentStep(void)
 	opserr << "the Integrator failed in update()\n";	
 	return -4;
       }	        
-      if (theIntegrator->formUnbalance() < 0) {
+      if (formFused == true) {
+	if (theIntegrator->formTangentAndUnbalance(tangent) < 0) {
+	  opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
+	  opserr << "the Integrator failed in formTangentAndUnbalance()\n";	
+	  return -2;
+	}
+	haveTangent = true;
+      } else if (theIntegrator->formUnbalance() < 0) {
 	opserr << "WARNING NewtonRaphson::solveCurrentStep() -";
 	opserr << "the Integrator failed in formUnbalance()\n";	
 	return -2;
@@ -189,6 +220,8 @@ NewtonRaphson::solveCurrentStep(void)
        
  theIntegrator->computeSensitivities();
  theIntegrator->formUnbalance();
+ // the sensitivity solve may have used the system, form the tangent again
+ haveTangent = false;
 
     } 
      
@@ -217,8 +250,9 @@ NewtonRaphson::solveCurrentStep(void)
 int
 NewtonRaphson::sendSelf(int cTag, Channel &theChannel)
 {
-  static ID data(1);
+  static ID data(2);
   data(0) = tangent;
+  data(1) = (fused == true) ? 1 : 0;
   return theChannel.sendID(this->getDbTag(), cTag, data);
 }
 
@@ -227,9 +261,10 @@ NewtonRaphson::recvSelf(int cTag,
 			Channel &theChannel, 
 			FEM_ObjectBroker &theBroker)
 {
-  static ID data(1);
+  static ID data(2);
   theChannel.recvID(this->getDbTag(), cTag, data);
   tangent = data(0);
+  fused = (data(1) == 1);
   return 0;
 }
 
@@ -48,8 +48,9 @@
 class NewtonRaphson: public EquiSolnAlgo
 {
   public:
-    NewtonRaphson(int tangent = CURRENT_TANGENT);    
-    NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT);
+    NewtonRaphson(int tangent = CURRENT_TANGENT, bool fused = false);    
+    NewtonRaphson(ConvergenceTest &theTest, int tangent = CURRENT_TANGENT,
+		  bool fused = false);
     ~NewtonRaphson();
 
     int solveCurrentStep(void);    
@@ -67,6 +68,7 @@ class NewtonRaphson: public EquiSolnAlgo
   private:
     int tangent;
     int numIterations;
+    bool fused;       // form the tangent with the unbalance after each update
 };
 
 #endif
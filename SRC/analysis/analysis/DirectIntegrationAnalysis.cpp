@@ -179,74 +179,94 @@ int
 DirectIntegrationAnalysis::analyze(int numSteps, double dT)
 {
   int result = 0;
-  Domain *the_Domain = this->getDomainPtr();
  // if (theEigenSOE != 0)
  //   theIntegrator->setEigenSOE(theEigenSOE);
 
   for (int i=0; i<numSteps; i++) {
+    result = this->analyzeStep(dT, *theAlgorithm);
+    if (result < 0)
+      return result;
+  }    
+  return result;
+}
 
-    if (theAnalysisModel->analysisStep(dT) < 0) {
-      opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed";
-      opserr << " at time " << the_Domain->getCurrentTime() << endln;
-      the_Domain->revertToLastCommit();
-      return -2;
-    }
-    
-    // check if domain has undergone change
-    int stamp = the_Domain->hasDomainChanged();
-    if (stamp != domainStamp) {
-      domainStamp = stamp;	
-      if (this->domainChanged() < 0) {
+// performs one step of size dT using theSolnAlgo, which need not be the
+// analysis's own algorithm; on failure the Domain and the Integrator are
+// left at the last committed state so that the step can be tried again
+int 
+DirectIntegrationAnalysis::analyzeStep(double dT, EquiSolnAlgo &theSolnAlgo)
+{
+  int result = 0;
+  Domain *the_Domain = this->getDomainPtr();
+
+  if (theAnalysisModel->analysisStep(dT) < 0) {
+    opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed";
+    opserr << " at time " << the_Domain->getCurrentTime() << endln;
+    the_Domain->revertToLastCommit();
+    return -2;
+  }
+  
+  // check if domain has undergone change
+  int stamp = the_Domain->hasDomainChanged();
+  if (stamp != domainStamp) {
+    domainStamp = stamp;	
+    if (this->domainChanged() < 0) {
 	opserr << "DirectIntegrationAnalysis::analyze() - domainChanged() failed\n";
 	return -1;
-      }	
-    }
+    }	
+  }
 
-    if (theIntegrator->newStep(dT) < 0) {
-      opserr << "DirectIntegrationAnalysis::analyze() - the Integrator failed";
-      opserr << " at time " << the_Domain->getCurrentTime() << endln;
-      the_Domain->revertToLastCommit();
-      theIntegrator->revertToLastStep();
-      return -2;
-    }
-    
-    result = theAlgorithm->solveCurrentStep();
-    if (result < 0) {
-      opserr << "DirectIntegrationAnalysis::analyze() - the Algorithm failed";
-      opserr << " at time " << the_Domain->getCurrentTime() << endln;
-      the_Domain->revertToLastCommit();	    
-      theIntegrator->revertToLastStep();
-      return -3;
-    }    
-    
+  if (theIntegrator->newStep(dT) < 0) {
+    opserr << "DirectIntegrationAnalysis::analyze() - the Integrator failed";
+    opserr << " at time " << the_Domain->getCurrentTime() << endln;
+    the_Domain->revertToLastCommit();
+    theIntegrator->revertToLastStep();
+    return -2;
+  }
+  
+  // an algorithm other than the analysis's own is linked each time it is
+  // used, the analysis objects may have changed since it was last used
+  if (&theSolnAlgo != theAlgorithm) {
+    theSolnAlgo.setLinks(*theAnalysisModel, *theIntegrator, *theSOE, theTest);
+    theSolnAlgo.domainChanged();
+  }
+
+  result = theSolnAlgo.solveCurrentStep();
+  if (result < 0) {
+    opserr << "DirectIntegrationAnalysis::analyze() - the Algorithm failed";
+    opserr << " at time " << the_Domain->getCurrentTime() << endln;
+    the_Domain->revertToLastCommit();	    
+    theIntegrator->revertToLastStep();
+    return -3;
+  }    
+  
 // AddingSensitivity:BEGIN ////////////////////////////////////
 #ifdef _RELIABILITY
-   /*
-    if (theSensitivityAlgorithm != 0) {
-      result = theIntegrator->computeSensitivities();
-      if (result < 0) {
+ /*
+  if (theSensitivityAlgorithm != 0) {
+    result = theIntegrator->computeSensitivities();
+    if (result < 0) {
 	opserr << "StaticAnalysis::analyze() - the SensitivityAlgorithm failed";
 	opserr << " at iteration: " << i << " with domain at load factor ";
 	opserr << the_Domain->getCurrentTime() << endln;
 	the_Domain->revertToLastCommit();	    
 	theIntegrator->revertToLastStep();
 	return -5;
-      }    
-    }
-    */
+    }    
+  }
+  */
 #endif
-    // AddingSensitivity:END //////////////////////////////////////
-    
-    result = theIntegrator->commit();
-    if (result < 0) {
-      opserr << "DirectIntegrationAnalysis::analyze() - ";
-      opserr << "the Integrator failed to commit";
-      opserr << " at time " << the_Domain->getCurrentTime() << endln;
-      the_Domain->revertToLastCommit();	    
-      theIntegrator->revertToLastStep();
-      return -4;
-    } 
-  }    
+  // AddingSensitivity:END //////////////////////////////////////
+  
+  result = theIntegrator->commit();
+  if (result < 0) {
+    opserr << "DirectIntegrationAnalysis::analyze() - ";
+    opserr << "the Integrator failed to commit";
+    opserr << " at time " << the_Domain->getCurrentTime() << endln;
+    the_Domain->revertToLastCommit();	    
+    theIntegrator->revertToLastStep();
+    return -4;
+  } 
   return result;
 }
 
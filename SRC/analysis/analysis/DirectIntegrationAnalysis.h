@@ -71,6 +71,7 @@ class DirectIntegrationAnalysis: public TransientAnalysis
     void clearAll(void);	    
     
     int analyze(int numSteps, double dT);
+    int analyzeStep(double dT, EquiSolnAlgo &theSolnAlgo);
     int eigen(int numMode, bool generlzed = true, bool findSmallest = true);
     int initialize(void);
     int domainChanged(void);
@@ -62,6 +62,7 @@
 DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain)
 :Analysis(the_Domain),
  MovableObject(DomDecompANALYSIS_TAGS_DomainDecompositionAnalysis),
+ myChannel(0),
  theSubdomain(&the_Domain),
  theHandler(0),
  theNumberer(0),
@@ -70,9 +71,9 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain)
  theIntegrator(0),
  theSOE(0),
  theSolver(0),
+ theTest(0),
  theResidual(0),numEqn(0),numExtEqn(0),tangFormed(false),tangFormedCount(0),
- domainStamp(0),
- myChannel(0)
+ domainStamp(0)
 {
     theSubdomain->setDomainDecompAnalysis(*this);
 }
@@ -82,6 +83,7 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(int clsTag,
 							 Subdomain &the_Domain)
 :Analysis(the_Domain),
  MovableObject(clsTag),
+ myChannel(0),
  theSubdomain(&the_Domain),
  theHandler(0),
  theNumberer(0),
@@ -90,9 +92,9 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(int clsTag,
  theIntegrator(0),
  theSOE(0),
  theSolver(0),
+ theTest(0),
  theResidual(0),numEqn(0),numExtEqn(0),tangFormed(false),tangFormedCount(0),
- domainStamp(0),
- myChannel(0)
+ domainStamp(0)
 {
 
 }
@@ -110,6 +112,7 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain,
 
 :Analysis(the_Domain),
  MovableObject(DomDecompANALYSIS_TAGS_DomainDecompositionAnalysis),
+ myChannel(0),
  theSubdomain( &the_Domain),
  theHandler( &handler),
  theNumberer( &numberer),
@@ -118,7 +121,9 @@ DomainDecompositionAnalysis::DomainDecompositionAnalysis(Subdomain &the_Domain,
  theIntegrator( &integrator),
  theSOE( &theLinSOE),
  theSolver( &theDDSolver),
- theResidual(0),numEqn(0),numExtEqn(0),tangFormed(false),tangFormedCount(0)
+ theTest(theTest),
+ theResidual(0),numEqn(0),numExtEqn(0),tangFormed(false),tangFormedCount(0),
+ domainStamp(0)
 {
     theModel->setLinks(the_Domain, handler);
     theHandler->setLinks(*theSubdomain,*theModel,*theIntegrator);
@@ -315,6 +320,17 @@ DomainDecompositionAnalysis::computeInternalResponse(void)
 
 int  
 DomainDecompositionAnalysis::formTangent(void)
+{
+    int result = this->formElementTangent();
+    if (result < 0)
+	return result;
+
+    return this->condenseTangent();
+}
+
+
+int  
+DomainDecompositionAnalysis::formElementTangent(void)
 {
     int result =0;
 
@@ -331,10 +347,19 @@ DomainDecompositionAnalysis::formTangent(void)
     // called for this state by formResidual() or formTangVectProduct()
     // so we won't be doing it again.
 
-    if (tangFormedCount != -1) {
+    if (tangFormedCount != -1)
 	result = theIntegrator->formTangent();
-	if (result < 0)
-	    return result;
+
+    return result;
+}
+
+
+int  
+DomainDecompositionAnalysis::condenseTangent(void)
+{
+    int result =0;
+
+    if (tangFormedCount != -1) {
 	result = theSolver->condenseA(numEqn-numExtEqn);
 	if (result < 0)
 	    return result;
@@ -692,10 +717,26 @@ DomainDecompositionAnalysis::setAlgorithm(EquiSolnAlgo &theAlgorithm)
 }
 
 int 
-DomainDecompositionAnalysis::setIntegrator(IncrementalIntegrator &theIntegrator) 
+DomainDecompositionAnalysis::setIntegrator(IncrementalIntegrator &theNewIntegrator) 
 {
-  opserr << "DomainDecompositionAnalysis::setIntegrator() - not implemented\n";
-  return -1;
+  // invoke the destructor on the old one
+  if (theIntegrator != 0)
+    delete theIntegrator;
+
+  // set the links needed by the other objects in the aggregation
+  theIntegrator = &theNewIntegrator;
+  if (theHandler != 0 && theModel != 0 && theAlgorithm != 0 && 
+      theSOE != 0 && theSolver != 0) {
+    theIntegrator->setLinks(*theModel, *theSOE, theTest);
+    theHandler->setLinks(*theSubdomain, *theModel, *theIntegrator);
+    theAlgorithm->setLinks(*theModel, *theIntegrator, *theSOE, 
+			   *theSolver, *theSubdomain);
+  }
+
+  // cause domainChanged to be invoked on next formTangent
+  domainStamp = 0;
+
+  return 0;
 }
 
 
@@ -95,6 +95,12 @@ class DomainDecompositionAnalysis: public Analysis, public MovableObject
     virtual int  eigenAnalysis(int numMode, bool generalized, bool findSmallest);
     virtual int  computeInternalResponse(void);
     virtual int  formTangent(void);
+
+    // formTangent() in two parts: the element tangents, and the
+    // condensation of the subdomain matrix, which only touches the
+    // subdomain's own solver
+    virtual int  formElementTangent(void);
+    virtual int  condenseTangent(void);
     virtual int  formResidual(void);
     virtual int  formTangVectProduct(Vector &force);
     virtual const Matrix &getTangent(void);
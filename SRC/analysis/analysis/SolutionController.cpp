@@ -0,0 +1,235 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of SolutionController.
+//
+// What: "@(#) SolutionController.cpp, revA"
+
+#include <SolutionController.h>
+#include <DirectIntegrationAnalysis.h>
+#include <EquiSolnAlgo.h>
+#include <OPS_Globals.h>
+#include <string.h>
+
+SolutionController::SolutionController(int nSub, int nCuts, double dtMin)
+  :numSub(nSub), maxCuts(nCuts), minDt(dtMin),
+   theAlgos(0), theNames(0), numAlgos(0),
+   numAttempts(0), numSuccesses(0)
+{
+  if (numSub < 2)
+    numSub = 2;
+  if (maxCuts < 0)
+    maxCuts = 0;
+
+  numAttempts = new int[1];
+  numSuccesses = new int[1];
+
+  this->resetStatistics();
+}
+
+SolutionController::~SolutionController()
+{
+  for (int i=0; i<numAlgos; i++) {
+    if (theAlgos[i] != 0)
+      delete theAlgos[i];
+    if (theNames[i] != 0)
+      delete [] theNames[i];
+  }
+
+  if (theAlgos != 0)
+    delete [] theAlgos;
+  if (theNames != 0)
+    delete [] theNames;
+
+  delete [] numAttempts;
+  delete [] numSuccesses;
+}
+
+int
+SolutionController::addAlgorithm(EquiSolnAlgo *theAlgo, const char *name)
+{
+  if (theAlgo == 0) {
+    opserr << "SolutionController::addAlgorithm() - no algorithm given\n";
+    return -1;
+  }
+
+  // enlarge the arrays by one
+  EquiSolnAlgo **newAlgos = new EquiSolnAlgo *[numAlgos+1];
+  char **newNames = new char *[numAlgos+1];
+  int *newAttempts = new int[numAlgos+2];
+  int *newSuccesses = new int[numAlgos+2];
+
+  for (int i=0; i<numAlgos; i++) {
+    newAlgos[i] = theAlgos[i];
+    newNames[i] = theNames[i];
+  }
+  for (int i=0; i<=numAlgos; i++) {
+    newAttempts[i] = numAttempts[i];
+    newSuccesses[i] = numSuccesses[i];
+  }
+
+  newAlgos[numAlgos] = theAlgo;
+  if (name != 0) {
+    newNames[numAlgos] = new char[strlen(name)+1];
+    strcpy(newNames[numAlgos], name);
+  } else
+    newNames[numAlgos] = 0;
+  newAttempts[numAlgos+1] = 0;
+  newSuccesses[numAlgos+1] = 0;
+
+  if (theAlgos != 0)
+    delete [] theAlgos;
+  if (theNames != 0)
+    delete [] theNames;
+  delete [] numAttempts;
+  delete [] numSuccesses;
+
+  theAlgos = newAlgos;
+  theNames = newNames;
+  numAttempts = newAttempts;
+  numSuccesses = newSuccesses;
+  numAlgos++;
+
+  return 0;
+}
+
+int
+SolutionController::getNumAlgorithms(void) const
+{
+  return numAlgos;
+}
+
+int
+SolutionController::analyze(DirectIntegrationAnalysis &theAnalysis, int nSteps, double dT)
+{
+  int result = 0;
+
+  for (int i=0; i<nSteps; i++) {
+    numSteps++;
+    result = this->advance(theAnalysis, dT, 0);
+    if (result < 0) {
+      numFailures++;
+      opserr << "SolutionController::analyze() - step " << i+1 << " of " << nSteps;
+      opserr << " failed with all algorithms and step sizes\n";
+      return result;
+    }
+  }
+
+  return result;
+}
+
+// tries a step of dT with each algorithm of the ladder in turn; the
+// analysis leaves the Domain at the last commit after a failure
+int
+SolutionController::solveStep(DirectIntegrationAnalysis &theAnalysis, double dT)
+{
+  EquiSolnAlgo *theAlgo = theAnalysis.getAlgorithm();
+  int result = -3;
+
+  for (int i=0; i<=numAlgos; i++) {
+    if (i > 0)
+      theAlgo = theAlgos[i-1];
+    if (theAlgo == 0)
+      continue;
+
+    numAttempts[i]++;
+    result = theAnalysis.analyzeStep(dT, *theAlgo);
+    if (result >= 0) {
+      numSuccesses[i]++;
+      return result;
+    }
+
+    // only a failure of the algorithm is worth another algorithm
+    if (result != -3)
+      return result;
+  }
+
+  return result;
+}
+
+int
+SolutionController::advance(DirectIntegrationAnalysis &theAnalysis, double dT, int level)
+{
+  int result = this->solveStep(theAnalysis, dT);
+
+  if (result >= 0) {
+    if (level > 0)
+      numSubSteps++;
+    if (minDtUsed == 0.0 || dT < minDtUsed)
+      minDtUsed = dT;
+    return result;
+  }
+
+  double subDt = dT/numSub;
+  if (result != -3 || level >= maxCuts || subDt < minDt)
+    return result;
+
+  numCuts++;
+  if (level+1 > maxLevel)
+    maxLevel = level+1;
+
+  for (int i=0; i<numSub; i++) {
+    result = this->advance(theAnalysis, subDt, level+1);
+    if (result < 0)
+      return result;
+  }
+
+  return result;
+}
+
+void
+SolutionController::resetStatistics(void)
+{
+  for (int i=0; i<=numAlgos; i++) {
+    numAttempts[i] = 0;
+    numSuccesses[i] = 0;
+  }
+
+  numSteps = 0;
+  numSubSteps = 0;
+  numCuts = 0;
+  maxLevel = 0;
+  numFailures = 0;
+  minDtUsed = 0.0;
+}
+
+void
+SolutionController::Print(OPS_Stream &s, int flag)
+{
+  s << "SolutionController: numSub " << numSub << " maxCuts " << maxCuts;
+  s << " minDt " << minDt << endln;
+  s << "  steps: " << numSteps << " failed: " << numFailures << endln;
+  s << "  cuts: " << numCuts << " sub-steps converged: " << numSubSteps;
+  s << " deepest level: " << maxLevel << " smallest step: " << minDtUsed << endln;
+
+  for (int i=0; i<=numAlgos; i++) {
+    if (i == 0)
+      s << "  analysis algorithm";
+    else if (theNames[i-1] != 0)
+      s << "  " << theNames[i-1];
+    else
+      s << "  algorithm " << i;
+    s << " attempts: " << numAttempts[i] << " successes: " << numSuccesses[i] << endln;
+  }
+}
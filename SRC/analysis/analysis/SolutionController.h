@@ -0,0 +1,88 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef SolutionController_h
+#define SolutionController_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SolutionController. A SolutionController performs the steps of a
+// DirectIntegrationAnalysis when a step fails to converge. It first
+// tries the step again with each algorithm in a fallback ladder. If
+// they all fail, it splits the step into numSub sub-steps, each tried
+// the same way, down to maxCuts levels or a minimum step size. The
+// algorithms in the ladder are created once and kept. A failed attempt
+// leaves the Domain at its last committed state, and the next attempt
+// starts from there, so a retry needs no commit and no new objects.
+// Counts of the attempts and successes of each algorithm and of the
+// cuts made are kept for reporting.
+//
+// What: "@(#) SolutionController.h, revA"
+
+class EquiSolnAlgo;
+class DirectIntegrationAnalysis;
+class OPS_Stream;
+
+class SolutionController
+{
+  public:
+    SolutionController(int numSub = 2, int maxCuts = 4, double minDt = 0.0);
+    ~SolutionController();
+
+    // adds an algorithm to the end of the ladder, the controller
+    // becomes responsible for deleting it
+    int addAlgorithm(EquiSolnAlgo *theAlgo, const char *name);
+    int getNumAlgorithms(void) const;
+
+    int analyze(DirectIntegrationAnalysis &theAnalysis, int numSteps, double dT);
+
+    void resetStatistics(void);
+    void Print(OPS_Stream &s, int flag = 0);
+
+  protected:
+
+  private:
+    int solveStep(DirectIntegrationAnalysis &theAnalysis, double dT);
+    int advance(DirectIntegrationAnalysis &theAnalysis, double dT, int level);
+
+    int numSub;           // sub-steps a failed step is split into
+    int maxCuts;          // maximum depth of splitting
+    double minDt;         // smallest sub-step tried
+
+    // the ladder, the analysis's own algorithm is tried before these
+    EquiSolnAlgo **theAlgos;
+    char **theNames;
+    int numAlgos;
+
+    // statistics, entry 0 is the analysis's own algorithm
+    int *numAttempts;
+    int *numSuccesses;
+    int numSteps;         // steps asked for in analyze()
+    int numSubSteps;      // steps converged at a reduced size
+    int numCuts;          // times a step was split
+    int maxLevel;         // deepest level of splitting used
+    int numFailures;      // steps that could not be completed
+    double minDtUsed;     // smallest step converged
+};
+
+#endif
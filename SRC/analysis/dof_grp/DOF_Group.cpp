@@ -729,6 +729,21 @@ DOF_Group::incrNodeAccel(const Vector &udotdot)
 }
 
 
+// int getStateStoreOffset(void);
+//	Method to return the location of the node's response in the
+//	domain's NodalStateStore, which allows the AnalysisModel to set the
+//	response of all such nodes in a single sweep.
+
+int
+DOF_Group::getStateStoreOffset(void) const
+{
+    if (myNode == 0)
+	return -1;
+
+    return myNode->getStateStoreOffset();
+}
+
+
 
 void
 DOF_Group::setEigenvector(int mode, const Vector &theVector)
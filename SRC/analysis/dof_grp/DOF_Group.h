@@ -97,6 +97,10 @@ class DOF_Group: public TaggedObject
     virtual void incrNodeVel(const Vector &udot);
     virtual void incrNodeAccel(const Vector &udotdot);
 
+    // location of the node's dof in the domain's NodalStateStore, or -1
+    // if the methods above do more than copy values to and from it
+    virtual int getStateStoreOffset(void) const;
+
     // methods to set the eigen vectors
     virtual void setEigenvector(int mode, const Vector &eigenvalue);
     virtual const Matrix &getEigenvectors(void);
@@ -683,6 +683,14 @@ TransformationDOF_Group::incrNodeAccel(const Vector &u)
 }
 
 
+int
+TransformationDOF_Group::getStateStoreOffset(void) const
+{
+  // the response is transformed before it is set at the node
+  return -1;
+}
+
+
 void
 TransformationDOF_Group::setEigenvector(int mode, const Vector &u)
 {
@@ -84,6 +84,7 @@ class TransformationDOF_Group: public DOF_Group
     void incrNodeDisp(const Vector &u);
     void incrNodeVel(const Vector &udot);
     void incrNodeAccel(const Vector &udotdot);
+    int getStateStoreOffset(void) const;
 
     virtual void setEigenvector(int mode, const Vector &eigenvalue);
 
@@ -234,6 +234,12 @@ int HHT::formNodTangent(DOF_Group *theDof)
 }
 
 
+int HHT::formTangentAndUnbalance(int statFlag)
+{
+    return this->formFusedTangentAndUnbalance(statFlag);
+}
+
+
 int HHT::domainChanged()
 {
     AnalysisModel *theModel = this->getAnalysisModel();
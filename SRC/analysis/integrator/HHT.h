@@ -54,6 +54,7 @@ public:
     // to the system of equation object.
     int formEleTangent(FE_Element *theEle);
     int formNodTangent(DOF_Group *theDof);
+    int formTangentAndUnbalance(int statusFlag = CURRENT_TANGENT);
     
     int domainChanged(void);
     int newStep(double deltaT);
@@ -144,6 +144,26 @@ IncrementalIntegrator::formUnbalance(void)
     return 0;
 }
     
+int
+IncrementalIntegrator::formTangentAndUnbalance(int statFlag)
+{
+    // two separate passes, correct whatever the subclass does in
+    // formTangent() and formUnbalance()
+    if (this->formUnbalance() < 0) {
+	opserr << "WARNING IncrementalIntegrator::formTangentAndUnbalance ";
+	opserr << " - this->formUnbalance failed\n";
+	return -1;
+    }
+
+    if (this->formTangent(statFlag) < 0) {
+	opserr << "WARNING IncrementalIntegrator::formTangentAndUnbalance ";
+	opserr << " - this->formTangent failed\n";
+	return -2;
+    }
+
+    return 0;
+}
+    
 int
 IncrementalIntegrator::getLastResponse(Vector &result, const ID &id)
 {
@@ -276,6 +296,37 @@ IncrementalIntegrator::formElementResidual(void)
     return res;	    
 }
 
+int 
+IncrementalIntegrator::formElementTangentAndResidual(void)
+{
+    // loop through the FE_Elements once, adding both the tangent and
+    // the residual while the element's data is still in cache; each is
+    // added before the next is formed as the FE_Element may share its
+    // work areas between the two
+    FE_Element *elePtr;
+
+    int res = 0;    
+
+    FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
+    while((elePtr = theEles2()) != 0) {
+	const ID &theID = elePtr->getID();
+
+	if (theSOE->addA(elePtr->getTangent(this),theID) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementTangentAndResidual -";
+	    opserr << " failed in addA for ID " << theID;
+	    res = -3;
+	}
+
+	if (theSOE->addB(elePtr->getResidual(this),theID) <0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementTangentAndResidual -";
+	    opserr << " failed in addB for ID " << theID;
+	    res = -2;
+	}
+    }
+
+    return res;	    
+}
+
 /*
 int
 IncrementalIntegrator::setModalDampingFactors(const Vector &factors)
@@ -70,6 +70,11 @@ class IncrementalIntegrator : public Integrator
     virtual int  formTangent(int statusFlag = CURRENT_TANGENT);    
     virtual int  formUnbalance(void);
 
+    // forms both A and B of the system of equations at the current state;
+    // this default does so with formUnbalance() and formTangent(),
+    // subclasses may do it in a single pass over the FE_Elements
+    virtual int  formTangentAndUnbalance(int statusFlag = CURRENT_TANGENT);
+
     // pure virtual methods to define the FE_ELe and DOF_Group contributions
     virtual int formEleTangent(FE_Element *theEle) =0;
     virtual int formNodTangent(DOF_Group *theDof) =0;    
@@ -107,6 +112,7 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+    int formElementTangentAndResidual(void);
     int statusFlag;
 
     //    Vector *modalDampingValues;
@@ -671,6 +671,14 @@ Newmark::formNodUnbalance(DOF_Group *theDof)
     return 0;
 }
 
+int
+Newmark::formTangentAndUnbalance(int statFlag)
+{
+    // nodal and element contributions are formed by the methods above,
+    // so the tangent and the residual can be formed in the one pass
+    return this->formFusedTangentAndUnbalance(statFlag);
+}
+
 int 
 Newmark::formSensitivityRHS(int passedGradNumber)
 {
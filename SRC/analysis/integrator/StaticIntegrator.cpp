@@ -65,6 +65,36 @@ StaticIntegrator::~StaticIntegrator()
 {
 }
 
+int
+StaticIntegrator::formTangentAndUnbalance(int statFlag)
+{
+    statusFlag = statFlag;
+
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    if (theLinSOE == 0 || this->getAnalysisModel() == 0) {
+	opserr << "WARNING StaticIntegrator::formTangentAndUnbalance() ";
+	opserr << "no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+
+    theLinSOE->zeroA();
+    theLinSOE->zeroB();
+
+    if (this->formElementTangentAndResidual() < 0) {
+	opserr << "WARNING StaticIntegrator::formTangentAndUnbalance ";
+	opserr << " - this->formElementTangentAndResidual failed\n";
+	return -1;
+    }
+
+    if (this->formNodalUnbalance() < 0) {
+	opserr << "WARNING StaticIntegrator::formTangentAndUnbalance ";
+	opserr << " - this->formNodalUnbalance failed\n";
+	return -2;
+    }
+
+    return 0;
+}
+
 int
 StaticIntegrator::formEleTangent(FE_Element *theEle)
 {
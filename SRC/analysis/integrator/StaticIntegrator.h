@@ -61,6 +61,8 @@ class StaticIntegrator : public IncrementalIntegrator
     virtual int formNodTangent(DOF_Group *theDof);        
     virtual int formNodUnbalance(DOF_Group *theDof);    
    virtual int formEleTangentSensitivity(FE_Element *theEle,int gradNumber); 
+
+    virtual int formTangentAndUnbalance(int statusFlag = CURRENT_TANGENT);
    
    virtual int newStep(void) =0;    
 
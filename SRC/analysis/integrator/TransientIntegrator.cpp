@@ -143,6 +143,56 @@ TransientIntegrator::formUnbalance(void) {
 
     return 0;
 }
+
+int
+TransientIntegrator::formFusedTangentAndUnbalance(int statFlag)
+{
+    int result = 0;
+    statusFlag = statFlag;
+
+    LinearSOE *theLinSOE = this->getLinearSOE();
+    AnalysisModel *theModel = this->getAnalysisModel();
+    if (theLinSOE == 0 || theModel == 0) {
+	opserr << "WARNING TransientIntegrator::formFusedTangentAndUnbalance() ";
+	opserr << "no LinearSOE or AnalysisModel has been set\n";
+	return -1;
+    }
+
+    theLinSOE->zeroA();
+    theLinSOE->zeroB();
+
+    // do modal damping
+    const Vector *modalValues = theModel->getModalDampingFactors();
+    if (modalValues != 0) {
+      if (theModel->inclModalDampingMatrix() == true)
+	this->addModalDampingMatrix(modalValues);
+      this->addModalDampingForce(modalValues);
+    }
+
+    // the DOF_Group tangents, the unbalance is added in formNodalUnbalance()
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != 0) {
+	if (theLinSOE->addA(dofPtr->getTangent(this),dofPtr->getID()) <0) {
+	    opserr << "TransientIntegrator::formFusedTangentAndUnbalance() - failed to addA:dof\n";
+	    result = -1;
+	}
+    }
+
+    if (this->formElementTangentAndResidual() < 0) {
+	opserr << "WARNING TransientIntegrator::formFusedTangentAndUnbalance ";
+	opserr << " - this->formElementTangentAndResidual failed\n";
+	result = -2;
+    }
+
+    if (this->formNodalUnbalance() < 0) {
+	opserr << "WARNING TransientIntegrator::formFusedTangentAndUnbalance ";
+	opserr << " - this->formNodalUnbalance failed\n";
+	result = -3;
+    }
+
+    return result;
+}
     
 int
 TransientIntegrator::formEleResidual(FE_Element *theEle)
@@ -61,6 +61,9 @@ class TransientIntegrator : public IncrementalIntegrator
     virtual int initialize(void) {return 0;};
 
   protected:
+    // forms A and B in one pass over the FE_Elements, for subclasses
+    // whose tangent and residual are formed by the methods above
+    int formFusedTangentAndUnbalance(int statFlag);
     
   private:
 };
@@ -49,6 +49,8 @@
 #include <Node.h>
 #include <NodeIter.h>
 #include <ConstraintHandler.h>
+#include <NodalStateStore.h>
+#include <ID.h>
 
 
 #include <MapOfTaggedObjects.h>
@@ -63,7 +65,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theStateMap(0), stateStoreTag(0), theOtherDOFs(0), numOtherDOFs(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -77,7 +80,8 @@ AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theStateMap(0), stateStoreTag(0), theOtherDOFs(0), numOtherDOFs(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -90,7 +94,8 @@ AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &t
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
  myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0),
+ theStateMap(0), stateStoreTag(0), theOtherDOFs(0), numOtherDOFs(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -125,6 +130,12 @@ AnalysisModel::~AnalysisModel()
   if (myDOFGraph != 0) {
     delete myDOFGraph;
   }
+
+  if (theStateMap != 0)
+    delete theStateMap;
+
+  if (theOtherDOFs != 0)
+    delete [] theOtherDOFs;
 }    
 
 void
@@ -195,6 +206,7 @@ AnalysisModel::addDOF_Group(DOF_Group *theGroup)
   bool result = theDOFs->addComponent(theGroup);
   if (result == true) {
     numDOF_Grp++;
+    stateStoreTag = 0;
     return true;  // o.k.
   } else
     return false;
@@ -219,6 +231,7 @@ AnalysisModel::clearAll(void)
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+    stateStoreTag = 0;
 }
 
 void
@@ -279,6 +292,9 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+
+    // the dof have been renumbered
+    stateStoreTag = 0;
 }
 
 int 
@@ -436,6 +452,19 @@ AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setTrialDisp(*theStateMap, disp);
+	theStore->setTrialVel(*theStateMap, vel);
+	theStore->setTrialAccel(*theStateMap, accel);
+	for (int i=0; i<numOtherDOFs; i++) {
+	    theOtherDOFs[i]->setNodeDisp(disp);
+	    theOtherDOFs[i]->setNodeVel(vel);
+	    theOtherDOFs[i]->setNodeAccel(accel);
+	}
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -449,6 +478,14 @@ AnalysisModel::setResponse(const Vector &disp,
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setTrialDisp(*theStateMap, disp);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->setNodeDisp(disp);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -459,7 +496,15 @@ AnalysisModel::setDisp(const Vector &disp)
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
-        DOF_GrpIter &theDOFGrps = this->getDOFs();
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setTrialVel(*theStateMap, vel);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->setNodeVel(vel);
+	return;
+    }
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
     while ((dofPtr = theDOFGrps()) != 0) 
@@ -470,6 +515,14 @@ AnalysisModel::setVel(const Vector &vel)
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setTrialAccel(*theStateMap, accel);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->setNodeAccel(accel);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -480,6 +533,14 @@ AnalysisModel::setAccel(const Vector &accel)
 void 
 AnalysisModel::incrDisp(const Vector &disp)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->incrTrialDisp(*theStateMap, disp);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->incrNodeDisp(disp);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -490,7 +551,15 @@ AnalysisModel::incrDisp(const Vector &disp)
 void 
 AnalysisModel::incrVel(const Vector &vel)
 {
-        DOF_GrpIter &theDOFGrps = this->getDOFs();
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->incrTrialVel(*theStateMap, vel);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->incrNodeVel(vel);
+	return;
+    }
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
     while ((dofPtr = theDOFGrps()) != 0) 
@@ -500,6 +569,14 @@ AnalysisModel::incrVel(const Vector &vel)
 void 
 AnalysisModel::incrAccel(const Vector &accel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->incrTrialAccel(*theStateMap, accel);
+	for (int i=0; i<numOtherDOFs; i++)
+	    theOtherDOFs[i]->incrNodeAccel(accel);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -508,6 +585,72 @@ AnalysisModel::incrAccel(const Vector &accel)
 }	
 
 
+// NodalStateStore *getStateStore(void);
+//	private method returning the domain's NodalStateStore, after making
+//	sure theStateMap holds the equation number of each location in it.
+//	Returns 0 if the domain has no store, in which case the response is
+//	set through the DOF_Groups as usual.
+
+NodalStateStore *
+AnalysisModel::getStateStore(void)
+{
+    if (myDomain == 0)
+	return 0;
+
+    NodalStateStore *theStore = myDomain->getNodalStateStore();
+    if (theStore == 0)
+	return 0;
+
+    if (stateStoreTag == theStore->getStoreTag())
+	return theStore;
+
+    int numStoreDOF = theStore->getNumDOF();
+    if (theStateMap == 0 || theStateMap->Size() != numStoreDOF) {
+	if (theStateMap != 0)
+	    delete theStateMap;
+	theStateMap = new ID(numStoreDOF);
+    }
+
+    if (theOtherDOFs != 0)
+	delete [] theOtherDOFs;
+    theOtherDOFs = new DOF_Group *[numDOF_Grp];
+
+    if (theStateMap == 0 || theStateMap->Size() != numStoreDOF || theOtherDOFs == 0) {
+	opserr << "AnalysisModel::getStateStore() - out of memory\n";
+	if (theOtherDOFs != 0)
+	    delete [] theOtherDOFs;
+	theOtherDOFs = 0;
+	stateStoreTag = 0;
+	return 0;
+    }
+
+    // locations not belonging to one of our groups are left alone
+    for (int i=0; i<numStoreDOF; i++)
+	(*theStateMap)(i) = -2;
+    numOtherDOFs = 0;
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
+    DOF_Group 	*dofPtr;
+
+    while ((dofPtr = theDOFGrps()) != 0) {
+	int offset = dofPtr->getStateStoreOffset();
+	if (offset < 0) {
+	    if (numOtherDOFs < numDOF_Grp)
+		theOtherDOFs[numOtherDOFs++] = dofPtr;
+	    continue;
+	}
+
+	const ID &theID = dofPtr->getID();
+	for (int i=0; i<theID.Size(); i++) {
+	    int loc = theID(i);
+	    (*theStateMap)(offset+i) = (loc >= 0) ? loc : -1;
+	}
+    }
+
+    stateStoreTag = theStore->getStoreTag();
+    return theStore;
+}
+
 void 
 AnalysisModel::setNumEigenvectors(int numEigenvectors)
 {
@@ -51,6 +51,8 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class NodalStateStore;
+class ID;
 
 class AnalysisModel: public MovableObject
 {
@@ -125,6 +127,8 @@ class AnalysisModel: public MovableObject
 
     
   private:
+    NodalStateStore *getStateStore(void);
+
     Domain *myDomain;
     ConstraintHandler *myHandler;
 
@@ -140,6 +144,12 @@ class AnalysisModel: public MovableObject
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
+
+    // for setting the response directly in the domain's NodalStateStore
+    ID *theStateMap;           // equation number of each location in the store
+    int stateStoreTag;         // tag of the store the map is for, 0 if none
+    DOF_Group **theOtherDOFs;  // groups not in the store, set one at a time
+    int numOtherDOFs;
 };
 
 #endif
@@ -55,12 +55,14 @@
 #define EigenSOE_TAGS_FullGenEigenSOE   4
 #define EigenSOE_TAGS_ArpackSOE 	5
 #define EigenSOE_TAGS_GeneralArpackSOE 	6
+#define EigenSOE_TAGS_SubspaceEigenSOE 	7
 #define EigenSOLVER_TAGS_BandArpackSolver 	1
 #define EigenSOLVER_TAGS_SymArpackSolver 	2
 #define EigenSOLVER_TAGS_SymBandEigenSolver     3
 #define EigenSOLVER_TAGS_FullGenEigenSolver  4
 #define EigenSOLVER_TAGS_ArpackSolver  5
 #define EigenSOLVER_TAGS_GeneralArpackSolver  6
+#define EigenSOLVER_TAGS_SubspaceEigenSolver  7
 
 #define EigenALGORITHM_TAGS_Frequency 1
 #define EigenALGORITHM_TAGS_Standard  2
@@ -857,6 +859,7 @@
 #define LinSOE_TAGS_PFEMLinSOE 26
 #define LinSOE_TAGS_SProfileSPDLinSOE		27
 #define LinSOE_TAGS_PFEMCompressibleLinSOE 28
+#define LinSOE_TAGS_SparseSPDLinSOE 29
 
 
 #define SOLVER_TAGS_FullGenLinLapackSolver  	1
@@ -890,6 +893,8 @@
 #define SOLVER_TAGS_CulaSparseS4                        29
 #define SOLVER_TAGS_CulaSparseS5                        30
 #define SOLVER_TAGS_CuSP                                31
+#define SOLVER_TAGS_OutOfCoreSparseSPDSolver            32
+#define SOLVER_TAGS_SupernodalSparseSPDSolver           33
 
 #define RECORDER_TAGS_ElementRecorder		1
 #define RECORDER_TAGS_NodeRecorder		2
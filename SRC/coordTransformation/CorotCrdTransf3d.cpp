@@ -36,6 +36,7 @@
 #include <math.h>
 #include <Vector.h>
 #include <Matrix.h>
+#include <MatrixND.h>
 #include <Node.h>
 #include <Channel.h>
 #include <elementAPI.h>
@@ -47,10 +48,17 @@ Matrix CorotCrdTransf3d::RI(3,3);
 Matrix CorotCrdTransf3d::RJ(3,3); 
 Matrix CorotCrdTransf3d::Rbar(3,3); 
 Matrix CorotCrdTransf3d::e(3,3); 
-Matrix CorotCrdTransf3d::Tp(6,7); 
-Matrix CorotCrdTransf3d::T(7,12);
-Matrix CorotCrdTransf3d::Tlg(12,12);
-Matrix CorotCrdTransf3d::kg(12,12);
+
+// fixed-size storage for the transformation matrices used in the
+// stiffness transformations; Tp, T, Tlg and kg are Matrix views of it
+static MatrixND<6,7>   TpStore;
+static MatrixND<7,12>  TStore;
+static MatrixND<12,12> TlgStore;
+static MatrixND<12,12> kgStore;
+Matrix CorotCrdTransf3d::Tp(TpStore.values[0], 6, 7); 
+Matrix CorotCrdTransf3d::T(TStore.values[0], 7, 12);
+Matrix CorotCrdTransf3d::Tlg(TlgStore.values[0], 12, 12);
+Matrix CorotCrdTransf3d::kg(kgStore.values[0], 12, 12);
 Matrix CorotCrdTransf3d::Lr2(12,3);
 Matrix CorotCrdTransf3d::Lr3(12,3);
 Matrix CorotCrdTransf3d::A(3,3);
@@ -1125,8 +1133,10 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     
     int i, j, k;   
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    static MatrixND<6,6> kbStore;
+    static MatrixND<7,7> kl;
+    kbStore = kb;
+    kl.addMatrixTripleProduct(0.0, TpStore, kbStore, 1.0);      // kl = Tp ^ kb * Tp;
 
     //    opserr << "kb: " << kb;
     //    opserr << "Tp: " << Tp;
@@ -1139,7 +1149,7 @@ CorotCrdTransf3d::getGlobalStiffMatrix(const Matrix &kb, const Vector &pb)
     //static Matrix kg(12,12);
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgStore.addMatrixTripleProduct(0.0, TStore, kl, 1.0);
     
     static Vector m(6);
     for (i = 0; i < 6; i++)
@@ -1399,14 +1409,16 @@ const Matrix &
 CorotCrdTransf3d::getInitialGlobalStiffMatrix(const Matrix &kb)
 {
     // transform tangent stiffness matrix from the basic system to local coordinates
-    static Matrix kl(7,7);
-    kl.addMatrixTripleProduct(0.0, Tp, kb, 1.0);      // kl = Tp ^ kb * Tp;
+    static MatrixND<6,6> kbStore;
+    static MatrixND<7,7> kl;
+    kbStore = kb;
+    kl.addMatrixTripleProduct(0.0, TpStore, kbStore, 1.0);      // kl = Tp ^ kb * Tp;
     
     // transform tangent  stiffness matrix from local to global coordinates
     //static Matrix kg(12,12);
     
     // compute the tangent stiffness matrix in global coordinates
-    kg.addMatrixTripleProduct(0.0, T, kl, 1.0);
+    kgStore.addMatrixTripleProduct(0.0, TStore, kl, 1.0);
     
     return kg;
 }
@@ -2080,8 +2092,10 @@ CorotCrdTransf3d::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theB
 const Matrix &
 CorotCrdTransf3d::getGlobalMatrixFromLocal(const Matrix &ml)
 {
-    this->compTransfMatrixLocalGlobal(Tlg);  // OPTIMIZE LATER
-    kg.addMatrixTripleProduct(0.0, Tlg, ml, 1.0);  // OPTIMIZE LATER
+    static MatrixND<12,12> mlStore;
+    mlStore = ml;
+    this->compTransfMatrixLocalGlobal(Tlg);
+    kgStore.addMatrixTripleProduct(0.0, TlgStore, mlStore, 1.0);
 
     return kg;
 }
@@ -74,6 +74,14 @@
 #include <Analysis.h>
 #include <FE_Datastore.h>
 #include <FEM_ObjectBroker.h>
+#include <ArenaAllocator.h>
+#include <NodalStateStore.h>
+
+#include <set>
+#include <utility>
+
+// number of dof whose response arrays share a page of the nodal arena
+#define NODAL_ARENA_PAGE_DOF 4096
 
 //
 // global variables
@@ -86,7 +94,7 @@ bool          ops_InitialStateAnalysis = false;
 Domain::Domain()
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), currentMassTag(0), currentCrdTag(0), currentStateTag(0), theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false),  nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
@@ -94,7 +102,10 @@ Domain::Domain()
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ theNodalArena(0), useNodalArena(false),
+ nodalArenaPage(0), nodalArenaPageSize(0), nodalArenaPageUsed(0),
+ theNodalStateStore(0), useNodalStateStore(false), nodalStateStoreComplete(false)
 {
   
     // init the arrays for storing the domain components
@@ -141,14 +152,17 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs,
 	       int numLoadPatterns)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), currentMassTag(0), currentCrdTag(0), currentStateTag(0), theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0),
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ theNodalArena(0), useNodalArena(false),
+ nodalArenaPage(0), nodalArenaPageSize(0), nodalArenaPageUsed(0),
+ theNodalStateStore(0), useNodalStateStore(false), nodalStateStoreComplete(false)
 {
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
@@ -196,7 +210,7 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
 	       TaggedObjectStorage &theLoadPatternsStorage)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), currentMassTag(0), currentCrdTag(0), currentStateTag(0), theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
@@ -208,7 +222,10 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theNodalArena(0), useNodalArena(false),
+ nodalArenaPage(0), nodalArenaPageSize(0), nodalArenaPageUsed(0),
+ theNodalStateStore(0), useNodalStateStore(false), nodalStateStoreComplete(false)
 {
     // init the arrays for storing the domain components
     thePCs      = new MapOfTaggedObjects();
@@ -259,14 +276,17 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
 Domain::Domain(TaggedObjectStorage &theStorage)
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
- hasDomainChangedFlag(false), theDbTag(0), lastGeoSendTag(-1),
+ hasDomainChangedFlag(false), currentMassTag(0), currentCrdTag(0), currentStateTag(0), theDbTag(0), lastGeoSendTag(-1),
  dbEle(0), dbNod(0), dbSPs(0), dbPCs(0), dbMPs(0), dbLPs(0), dbParam(0),
  eleGraphBuiltFlag(false), nodeGraphBuiltFlag(false), theNodeGraph(0), 
  theElementGraph(0), 
  theRegions(0), numRegions(0), commitTag(0),
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ theNodalArena(0), useNodalArena(false),
+ nodalArenaPage(0), nodalArenaPageSize(0), nodalArenaPageUsed(0),
+ theNodalStateStore(0), useNodalStateStore(false), nodalStateStoreComplete(false)
 {
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
@@ -394,6 +414,12 @@ Domain::~Domain()
   
   theRecorders = 0;
   numRecorders = 0;
+
+  if (theNodalArena != 0)
+    delete theNodalArena;
+
+  if (theNodalStateStore != 0)
+    delete theNodalStateStore;
 }
 
 
@@ -470,6 +496,7 @@ Domain::addNode(Node * node)
   if (result == true) {
       node->setDomain(this);
       this->domainChange();
+      nodalStateStoreComplete = false;
       
       // see if the physical bounds are changed
       // note this assumes 0,0,0,0,0,0 as startup min,max values
@@ -568,6 +595,98 @@ Domain::addSP_Constraint(SP_Constraint *spConstraint)
   return true;
 }
 
+// int reserveComponents(int numNodes, int numElements, int numSPs);
+//	Method to tell the storage objects of the domain how many more
+//	components are about to be added, so that those storing them in
+//	arrays can size them once.
+
+int
+Domain::reserveComponents(int numNodes, int numElements, int numSPs)
+{
+  int res = 0;
+
+  if (numNodes > 0)
+    if (theNodes->setSize(theNodes->getNumComponents() + numNodes) < 0)
+      res = -1;
+
+  if (numElements > 0)
+    if (theElements->setSize(theElements->getNumComponents() + numElements) < 0)
+      res = -1;
+
+  if (numSPs > 0)
+    if (theSPs->setSize(theSPs->getNumComponents() + numSPs) < 0)
+      res = -1;
+
+  return res;
+}
+
+// int addSP_Constraints(SP_Constraint **theSPs, int numSPs);
+//	Method to add many single point constraints at once. Does the same
+//	checks as addSP_Constraint() but looks for an existing constraint
+//	on the same dof in a set built once, rather than by a loop over
+//	all the constraints for each one added. The constraints added are
+//	set to 0 in theSPs, the caller is left with those not added; the
+//	number added is returned.
+
+int
+Domain::addSP_Constraints(SP_Constraint **theNewSPs, int numNewSPs)
+{
+  std::set<std::pair<int,int> > constrainedDOFs;
+
+  SP_ConstraintIter &theExistingSPs = this->getSPs();
+  SP_Constraint *theExistingSP = 0;
+  while ((theExistingSP = theExistingSPs()) != 0)
+    constrainedDOFs.insert(std::pair<int,int>(theExistingSP->getNodeTag(),
+					      theExistingSP->getDOF_Number()));
+
+  int numAdded = 0;
+  for (int i=0; i<numNewSPs; i++) {
+    SP_Constraint *spConstraint = theNewSPs[i];
+    if (spConstraint == 0)
+      continue;
+
+    int nodeTag = spConstraint->getNodeTag();
+    int dof = spConstraint->getDOF_Number();
+
+    Node *nodePtr = this->getNode(nodeTag);
+    if (nodePtr == 0) {
+      opserr << "Domain::addSP_Constraints - cannot add as node with tag " <<
+	nodeTag << " does not exist in model\n";       	
+      continue;
+    }
+
+    if (nodePtr->getNumberDOF() < dof) {
+      opserr << "Domain::addSP_Constraints - cannot add as node with tag " << 
+	nodeTag << " does not have associated constrained DOF\n"; 
+      continue;
+    }      
+
+    std::pair<int,int> theDOF(nodeTag, dof);
+    if (constrainedDOFs.find(theDOF) != constrainedDOFs.end()) {
+      opserr << "Domain::addSP_Constraints - cannot add as node " << nodeTag;
+      opserr << " already constrained in dof " << dof+1 << endln;
+      continue;
+    }
+
+    if (theSPs->getComponentPtr(spConstraint->getTag()) != 0 ||
+	theSPs->addComponent(spConstraint) == false) {
+      opserr << "Domain::addSP_Constraints - cannot add constraint with tag " << 
+	spConstraint->getTag() << " to the container\n";             
+      continue;
+    }
+
+    constrainedDOFs.insert(theDOF);
+    spConstraint->setDomain(this);
+    theNewSPs[i] = 0;
+    numAdded++;
+  }
+
+  if (numAdded > 0)
+    this->domainChange();  
+
+  return numAdded;
+}
+
 // void addPressure_Constraint(Pressure_Constraint *);
 //	Method to add a constraint to the model.
 //
@@ -940,6 +1059,19 @@ Domain::clearAll(void) {
   theParameters->clearAll();
   numParameters = 0;
 
+  // all the nodes are gone, free the memory they held in the arena
+  // and the state store; the store is rebuilt when nodes are added
+  if (theNodalArena != 0)
+    theNodalArena->release();
+  nodalArenaPage = 0;
+  nodalArenaPageSize = 0;
+  nodalArenaPageUsed = 0;
+
+  if (theNodalStateStore != 0)
+    delete theNodalStateStore;
+  theNodalStateStore = 0;
+  nodalStateStoreComplete = false;
+
   // remove the recorders
   int i;
   for (i=0; i<numRecorders; i++)
@@ -1043,6 +1175,13 @@ Domain::removeNode(int tag)
   // perform a downward cast to a Node (safe as only Node added to
   // this container and return the result of the cast
   Node *result = (Node *)mc;
+
+  // the node may outlive the store and the arena, give it back its
+  // own arrays
+  if (result->getStateStoreOffset() >= 0)
+    result->setStateStore(0, 0);
+  result->releaseStateArena();
+  nodalStateStoreComplete = false;
   // result->setDomain(0);
   return result;
 }
@@ -1527,6 +1666,12 @@ Domain::getCurrentTime(void) const
     return currentTime;
 }
 
+double
+Domain::getCommittedTime(void) const
+{
+    return committedTime;
+}
+
 int
 Domain::getCommitTag(void) const
 {
@@ -1819,6 +1964,8 @@ Domain::unsetLoadConstant(void)
 int
 Domain::initialize(void)
 {
+  currentStateTag++;
+
   Element *elePtr;
   ElementIter &theElemIter = this->getElements();    
   while ((elePtr = theElemIter()) != 0) 
@@ -1877,10 +2024,14 @@ Domain::commit(void)
     // 
     // first invoke commit on all nodes and elements in the domain
     //
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) {
-      nodePtr->commitState();
+    if (theNodalStateStore != 0 && nodalStateStoreComplete == true)
+      theNodalStateStore->commitState();
+    else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0) {
+	nodePtr->commitState();
+      }
     }
 
     Element *elePtr;
@@ -1900,6 +2051,7 @@ Domain::commit(void)
 
     // update the commitTag
     commitTag++;
+    currentStateTag++;
     return 0;
 }
 
@@ -1910,10 +2062,14 @@ Domain::revertToLastCommit(void)
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
     
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
+    if (theNodalStateStore != 0 && nodalStateStoreComplete == true)
+      theNodalStateStore->revertToLastCommit();
+    else {
+      Node *nodePtr;
+      NodeIter &theNodeIter = this->getNodes();
+      while ((nodePtr = theNodeIter()) != 0)
 	nodePtr->revertToLastCommit();
+    }
     
     Element *elePtr;
     ElementIter &theElemIter = this->getElements();    
@@ -1974,6 +2130,8 @@ Domain::update(void)
   ops_Dt = dT;
   ops_TheActiveDomain = this;
 
+  currentStateTag++;
+
   int ok = 0;
 
   // invoke update on all the ele's
@@ -2005,6 +2163,8 @@ Domain::update(double newTime, double dT)
 int
 Domain::updateParameter(int tag, int value)
 {
+  currentStateTag++;
+
   // get the object from the container 
   TaggedObject *mc = theParameters->getComponentPtr(tag);
   
@@ -2022,6 +2182,8 @@ Domain::updateParameter(int tag, int value)
 int
 Domain::updateParameter(int tag, double value)
 {
+  currentStateTag++;
+
   // remove the object from the container    
   TaggedObject *mc = theParameters->getComponentPtr(tag);
   
@@ -2146,6 +2308,41 @@ Domain::domainChange(void)
 }
 
 
+void
+Domain::massChange(void)
+{
+    currentMassTag++;
+}
+
+
+int
+Domain::getMassChangeStamp(void)
+{
+    return currentMassTag;
+}
+
+
+void
+Domain::crdChange(void)
+{
+    currentCrdTag++;
+}
+
+
+int
+Domain::getCrdChangeStamp(void)
+{
+    return currentCrdTag;
+}
+
+
+int
+Domain::getStateChangeStamp(void)
+{
+    return currentStateTag;
+}
+
+
 bool 
 Domain::getDomainChangeFlag(void)
 {
@@ -2165,6 +2362,9 @@ Domain::hasDomainChanged(void)
 	currentGeoTag++;
 	nodeGraphBuiltFlag = false;
 	eleGraphBuiltFlag = false;
+
+	if (useNodalStateStore == true && nodalStateStoreComplete == false)
+	  this->buildNodalStateStore();
     }
 
     // return the integer so user can determine if domain has changed 
@@ -3441,3 +3641,141 @@ Domain::calculateNodalReactions(int flag)
       theElement->addResistingForceToNodalReaction(flag);
   return 0;
 }
+
+int
+Domain::setNodalArena(bool useArena)
+{
+  // the arena itself is kept until the domain is cleared, as nodes
+  // created while it was in use still hold memory in it
+  if (useArena == true && theNodalArena == 0) {
+    theNodalArena = new ArenaAllocator();
+    if (theNodalArena == 0) {
+      opserr << "Domain::setNodalArena() - out of memory creating the arena\n";
+      return -1;
+    }
+  }
+
+  useNodalArena = useArena;
+  return 0;
+}
+
+ArenaAllocator *
+Domain::getNodalArena(void)
+{
+  if (useNodalArena == false)
+    return 0;
+
+  return theNodalArena;
+}
+
+// allocateNodalState():
+// returns the slot in the arena for the response arrays of a node with
+// numDOF dof. The arena is carved into pages holding 8 arrays of
+// NODAL_ARENA_PAGE_DOF dof each: trial, committed, incremental and
+// incremental-delta displacement, then trial and committed velocity and
+// acceleration. Consecutive nodes take consecutive dof of the page, so
+// that e.g. their trial displacements form one contiguous block; array
+// k of the node is at slot + k*stride.
+
+double *
+Domain::allocateNodalState(int numDOF, int &stride)
+{
+  ArenaAllocator *theArena = this->getNodalArena();
+  if (theArena == 0 || numDOF <= 0)
+    return 0;
+
+  if (nodalArenaPage == 0 || nodalArenaPageUsed + numDOF > nodalArenaPageSize) {
+    int pageSize = NODAL_ARENA_PAGE_DOF;
+    if (numDOF > pageSize)
+      pageSize = numDOF;
+
+    double *thePage = theArena->allocateDoubles(8*pageSize);
+    if (thePage == 0) {
+      opserr << "Domain::allocateNodalState() - out of memory in the arena\n";
+      return 0;
+    }
+
+    nodalArenaPage = thePage;
+    nodalArenaPageSize = pageSize;
+    nodalArenaPageUsed = 0;
+  }
+
+  double *slot = &nodalArenaPage[nodalArenaPageUsed];
+  nodalArenaPageUsed += numDOF;
+  stride = nodalArenaPageSize;
+
+  return slot;
+}
+
+int
+Domain::setNodalStateStore(bool useStore)
+{
+  useNodalStateStore = useStore;
+
+  if (useStore == true)
+    return this->buildNodalStateStore();
+
+  // give the nodes back their own arrays and remove the store
+  if (theNodalStateStore != 0) {
+    Node *nodePtr;
+    NodeIter &theNodeIter = this->getNodes();
+    while ((nodePtr = theNodeIter()) != 0)
+      if (nodePtr->getStateStoreOffset() >= 0)
+	nodePtr->setStateStore(0, 0);
+
+    delete theNodalStateStore;
+    theNodalStateStore = 0;
+  }
+  nodalStateStoreComplete = false;
+
+  return 0;
+}
+
+NodalStateStore *
+Domain::getNodalStateStore(void)
+{
+  return theNodalStateStore;
+}
+
+int
+Domain::buildNodalStateStore(void)
+{
+  // size the new store
+  int numDOF = 0;
+  Node *nodePtr;
+  NodeIter &theNodeIter = this->getNodes();
+  while ((nodePtr = theNodeIter()) != 0)
+    numDOF += nodePtr->getNumberDOF();
+
+  NodalStateStore *theStore = new NodalStateStore(numDOF);
+  if (theStore == 0 || theStore->getNumDOF() != numDOF) {
+    opserr << "Domain::buildNodalStateStore() - out of memory for store of " << numDOF << " dof\n";
+    if (theStore != 0)
+      delete theStore;
+    return -1;
+  }
+
+  // move the nodes into it, in the order of the node container; the
+  // nodes copy their values across from wherever they are now
+  int offset = 0;
+  NodeIter &theNodes = this->getNodes();
+  while ((nodePtr = theNodes()) != 0) {
+    if (nodePtr->setStateStore(theStore, offset) < 0) {
+      opserr << "Domain::buildNodalStateStore() - failed to add node " << nodePtr->getTag() << endln;
+      // go back to the nodes holding their own arrays
+      this->setNodalStateStore(false);
+      delete theStore;
+      return -2;
+    }
+    offset += nodePtr->getNumberDOF();
+  }
+
+  // no node is left in the old store
+  if (theNodalStateStore != 0)
+    delete theNodalStateStore;
+
+  theNodalStateStore = theStore;
+  nodalStateStoreComplete = true;
+
+  return 0;
+}
@@ -74,6 +74,8 @@ class Channel;
 class FEM_ObjectBroker;
 
 class TaggedObjectStorage;
+class ArenaAllocator;
+class NodalStateStore;
 
 class Domain
 {
@@ -104,6 +106,10 @@ class Domain
     virtual  bool addMP_Constraint(MP_Constraint *); 
     virtual  bool addLoadPattern(LoadPattern *);            
     virtual  bool addParameter(Parameter *);            
+
+    // methods to populate a domain in bulk
+    virtual  int  reserveComponents(int numNodes, int numElements, int numSPs);
+    virtual  int  addSP_Constraints(SP_Constraint **theSPs, int numSPs);
     
     // methods to add components to a LoadPattern object
     virtual  bool addSP_Constraint(SP_Constraint *, int loadPatternTag); 
@@ -152,6 +158,7 @@ class Domain
 
     // methods to query the state of the domain
     virtual double  getCurrentTime(void) const;
+    virtual double  getCommittedTime(void) const;
     virtual int     getCommitTag(void) const;    	
     virtual int getNumElements(void) const;
     virtual int getNumNodes(void) const;
@@ -206,6 +213,13 @@ class Domain
     virtual void domainChange(void);    
     virtual void setDomainChangeStamp(int newStamp);
 
+    // methods for objects caching products of the nodal masses and coordinates
+    virtual void massChange(void);
+    virtual int getMassChangeStamp(void);
+    virtual void crdChange(void);
+    virtual int getCrdChangeStamp(void);
+    virtual int getStateChangeStamp(void);
+
 
     // methods for output
     virtual int  addRecorder(Recorder &theRecorder);    	
@@ -232,6 +246,17 @@ class Domain
 
     virtual int calculateNodalReactions(int flag);
 
+    // optional arena from which the nodes allocate their response arrays;
+    // the memory is released in bulk when the domain is cleared
+    virtual int setNodalArena(bool useArena);
+    virtual ArenaAllocator *getNodalArena(void);
+    virtual double *allocateNodalState(int numDOF, int &stride);
+
+    // optional store holding the response of all the nodes as a
+    // structure of arrays; built when the domain changes
+    virtual int setNodalStateStore(bool useStore);
+    virtual NodalStateStore *getNodalStateStore(void);
+
   protected:    
 
     virtual int buildEleGraph(Graph *theEleGraph);
@@ -246,6 +271,9 @@ class Domain
     double dT;                        // difference between committed and current time
     int	   currentGeoTag;             // an integer used to mark if domain has changed
     bool   hasDomainChangedFlag;      // a bool flag used to indicate if GeoTag needs to be ++
+    int    currentMassTag;            // an integer incremented when a nodal mass is changed
+    int    currentCrdTag;             // an integer incremented when a nodal coordinate is changed
+    int    currentStateTag;           // an integer incremented when the state is updated or committed
     int    theDbTag;                   // the Domains unique database tag == 0
     int    lastGeoSendTag;            // the value of currentGeoTag when sendSelf was last invoked
     int dbEle, dbNod, dbSPs, dbPCs, dbMPs, dbLPs, dbParam; // database tags for storing info
@@ -294,6 +322,17 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    ArenaAllocator *theNodalArena;
+    bool useNodalArena;
+    double *nodalArenaPage;        // current page of nodal response arrays
+    int nodalArenaPageSize;        // number of dof in that page
+    int nodalArenaPageUsed;        // number of them handed out
+
+    int buildNodalStateStore(void);
+    NodalStateStore *theNodalStateStore;
+    bool useNodalStateStore;
+    bool nodalStateStoreComplete;  // true if every node is in the store
 };
 
 #endif
@@ -48,12 +48,14 @@
 #include <ArrayOfTaggedObjects.h>
 #include <ArrayOfTaggedObjectsIter.h>
 #include <Subdomain.h>
+#include <ThreadedSubdomain.h>
 #include <DomainPartitioner.h>
 #include <PartitionedDomain.h>
 #include <PartitionedDomainEleIter.h>
 #include <PartitionedDomainSubIter.h>
 #include <SingleDomEleIter.h>
 #include <Vertex.h>
+#include <VertexIter.h>
 #include <Graph.h>
 #include <LoadPattern.h>
 #include <NodalLoad.h>
@@ -77,7 +79,9 @@ typedef MAP_ID::iterator     MAP_ID_ITERATOR;
 PartitionedDomain::PartitionedDomain()
 :Domain(),
  theSubdomains(0),theDomainPartitioner(0),
- theSubdomainIter(0), mySubdomainGraph(0)
+ theSubdomainIter(0), mySubdomainGraph(0),
+ balanceInterval(1), numCommitsSinceBalance(0), printImbalance(false), loadImbalance(1.0),
+ theThreadedSubdomains(0)
 {
     elements = new ArrayOfTaggedObjects(1024);    
     theSubdomains = new ArrayOfTaggedObjects(32);
@@ -100,7 +104,9 @@ PartitionedDomain::PartitionedDomain()
 PartitionedDomain::PartitionedDomain(DomainPartitioner &thePartitioner)
 :Domain(),
  theSubdomains(0),theDomainPartitioner(&thePartitioner),
- theSubdomainIter(0), mySubdomainGraph(0)
+ theSubdomainIter(0), mySubdomainGraph(0),
+ balanceInterval(1), numCommitsSinceBalance(0), printImbalance(false), loadImbalance(1.0),
+ theThreadedSubdomains(0)
 {
     elements = new ArrayOfTaggedObjects(1024);    
     theSubdomains = new ArrayOfTaggedObjects(32);
@@ -127,7 +133,9 @@ PartitionedDomain::PartitionedDomain(int numNodes, int numElements,
 
 :Domain(numNodes,0,numSPs,numMPs,numLoadPatterns),
  theSubdomains(0),theDomainPartitioner(&thePartitioner),
- theSubdomainIter(0), mySubdomainGraph(0)
+ theSubdomainIter(0), mySubdomainGraph(0),
+ balanceInterval(1), numCommitsSinceBalance(0), printImbalance(false), loadImbalance(1.0),
+ theThreadedSubdomains(0)
 {
     elements = new ArrayOfTaggedObjects(numElements);    
     theSubdomains = new ArrayOfTaggedObjects(numSubdomains);
@@ -164,6 +172,9 @@ PartitionedDomain::~PartitionedDomain()
 
   if (theEleIter != 0)
     delete theEleIter;
+
+  if (theThreadedSubdomains != 0)
+    delete theThreadedSubdomains;
 }
 
 void
@@ -1198,16 +1209,77 @@ PartitionedDomain::commit(void)
     }
   }
 
-  // now we load balance if we have subdomains and a partitioner
+  // now we load balance if we have subdomains and a partitioner with a
+  // load balancer, every balanceInterval commits; the subdomain costs 
+  // are those measured since the last time
   int numSubdomains = this->getNumSubdomains();
-  if (numSubdomains != 0 && theDomainPartitioner != 0)  {
-    Graph &theSubGraphs = this->getSubdomainGraph();
-    theDomainPartitioner->balance(theSubGraphs);
+  if (numSubdomains != 0 && theDomainPartitioner != 0 && balanceInterval > 0 &&
+      theDomainPartitioner->hasLoadBalancer() == true)  {
+
+    numCommitsSinceBalance++;
+    if (numCommitsSinceBalance >= balanceInterval) {
+      numCommitsSinceBalance = 0;
+
+      Graph &theSubGraphs = this->getSubdomainGraph();
+
+      double maxCost = 0.0;
+      double totalCost = 0.0;
+      VertexIter &theVertices = theSubGraphs.getVertices();
+      Vertex *vertexPtr;
+      while ((vertexPtr = theVertices()) != 0) {
+	double cost = vertexPtr->getWeight();
+	if (cost > maxCost)
+	  maxCost = cost;
+	totalCost += cost;
+      }
+      if (totalCost > 0.0)
+	loadImbalance = maxCost*numSubdomains/totalCost;
+
+      theDomainPartitioner->balance(theSubGraphs);
+
+      if (printImbalance == true) {
+	opserr << "PartitionedDomain::commit - time " << this->getCurrentTime();
+	opserr << " load imbalance " << loadImbalance;
+	opserr << " max cost " << maxCost << " elements moved ";
+	opserr << theDomainPartitioner->getNumElementsMoved() << endln;
+      }
+    }
+  }
+
+  return 0;
+}
+
+int
+PartitionedDomain::setLoadBalancing(int numCommits, bool printFlag)
+{
+  if (numCommits < 0) {
+    opserr << "PartitionedDomain::setLoadBalancing - numCommits " << numCommits << " < 0\n";
+    return -1;
   }
 
+  balanceInterval = numCommits;
+  numCommitsSinceBalance = 0;
+  printImbalance = printFlag;
+
   return 0;
 }
 
+double
+PartitionedDomain::getLoadImbalance(void) const
+{
+  return loadImbalance;
+}
+
+
+ThreadedSubdomainGroup &
+PartitionedDomain::getThreadedSubdomains(void)
+{
+  if (theThreadedSubdomains == 0)
+    theThreadedSubdomains = new ThreadedSubdomainGroup();
+
+  return *theThreadedSubdomains;
+}
+
 
 int
 PartitionedDomain::revertToLastCommit(void)
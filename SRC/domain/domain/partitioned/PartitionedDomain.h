@@ -50,6 +50,7 @@ class  PartitionedDomainSubIter;
 class  PartitionedDomainEleIter;
 class SingleDomEleIter;
 class Parameter;
+class ThreadedSubdomainGroup;
 
 class PartitionedDomain: public Domain
 {
@@ -138,6 +139,14 @@ class PartitionedDomain: public Domain
     virtual Node *removeExternalNode(int tag);        
     virtual Graph &getSubdomainGraph(void);
 
+    // load balancing every numCommits, with the measured load imbalance,
+    // the max over the mean subdomain cost, printed if printFlag is set
+    virtual int setLoadBalancing(int numCommits, bool printFlag = false);
+    virtual double getLoadImbalance(void) const;
+
+    // the ThreadedSubdomains of this domain, which are run together
+    virtual ThreadedSubdomainGroup &getThreadedSubdomains(void);
+
     // nodal methods required in domain interface for parallel interprter
     virtual const Vector *getNodeResponse(int nodeTag, NodeResponseType); 
     virtual const Vector *getElementResponse(int eleTag, const char **argv, int argc); 
@@ -165,6 +174,13 @@ class PartitionedDomain: public Domain
     PartitionedDomainEleIter   *theEleIter;
     
     Graph *mySubdomainGraph;    // a graph of subdomain connectivity
+
+    int balanceInterval;        // commits between load balancing, 0 for none
+    int numCommitsSinceBalance;
+    bool printImbalance;
+    double loadImbalance;       // max/mean subdomain cost at the last balancing
+
+    ThreadedSubdomainGroup *theThreadedSubdomains;
 };
 
 #endif
@@ -0,0 +1,399 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ResponseSpectrum.
+//
+// What: "@(#) ResponseSpectrum.cpp, revA"
+
+#include <ResponseSpectrum.h>
+#include <OPS_Globals.h>
+#include <ThreadPool.h>
+
+#include <math.h>
+
+#define PI 3.141592653589793238462643383279502884197169399
+
+// number of sub-steps per period used by the bilinear oscillators
+#define RS_BILINEAR_STEPS_PER_PERIOD 20
+#define RS_BILINEAR_MAX_ITER 50
+
+ResponseSpectrum::ResponseSpectrum(int nP, const double *T, int nD, const double *z)
+  :numPeriods(nP), numDampings(nD), periods(0), dampings(0),
+   R(0.0), alpha(0.0),
+   numRecords(0), accel(0), numSteps(0), dt(0),
+   Sd(0), PSv(0), PSa(0), SdInelastic(0), ductility(0)
+{
+  if (numPeriods < 0)
+    numPeriods = 0;
+  if (numDampings < 0)
+    numDampings = 0;
+
+  periods = new double[numPeriods];
+  for (int i=0; i<numPeriods; i++)
+    periods[i] = T[i];
+
+  dampings = new double[numDampings];
+  for (int i=0; i<numDampings; i++)
+    dampings[i] = z[i];
+}
+
+ResponseSpectrum::~ResponseSpectrum()
+{
+  delete [] periods;
+  delete [] dampings;
+
+  if (Sd != 0) delete [] Sd;
+  if (PSv != 0) delete [] PSv;
+  if (PSa != 0) delete [] PSa;
+  if (SdInelastic != 0) delete [] SdInelastic;
+  if (ductility != 0) delete [] ductility;
+}
+
+int
+ResponseSpectrum::setBilinear(double r, double a)
+{
+  if (r > 0.0 && (a < 0.0 || a >= 1.0)) {
+    opserr << "ResponseSpectrum::setBilinear() - post-yield stiffness ratio " << a;
+    opserr << " not in [0,1)\n";
+    return -1;
+  }
+
+  R = r;
+  alpha = a;
+  return 0;
+}
+
+int
+ResponseSpectrum::compute(int nR, double **theAccel, const int *theNumSteps,
+			  const double *theDt, int numThreads)
+{
+  for (int i=0; i<numDampings; i++)
+    if (dampings[i] < 0.0 || dampings[i] >= 1.0) {
+      opserr << "ResponseSpectrum::compute() - damping ratio " << dampings[i];
+      opserr << " not in [0,1)\n";
+      return -1;
+    }
+
+  for (int i=0; i<nR; i++)
+    if (theNumSteps[i] < 1 || theDt[i] <= 0.0) {
+      opserr << "ResponseSpectrum::compute() - record " << i+1;
+      opserr << " has " << theNumSteps[i] << " steps of size " << theDt[i] << endln;
+      return -1;
+    }
+
+  if (Sd != 0) delete [] Sd;
+  if (PSv != 0) delete [] PSv;
+  if (PSa != 0) delete [] PSa;
+  if (SdInelastic != 0) delete [] SdInelastic;
+  if (ductility != 0) delete [] ductility;
+  SdInelastic = 0;
+  ductility = 0;
+
+  numRecords = nR;
+  accel = theAccel;
+  numSteps = theNumSteps;
+  dt = theDt;
+
+  int numResults = numRecords*numDampings*numPeriods;
+  Sd = new double[numResults];
+  PSv = new double[numResults];
+  PSa = new double[numResults];
+  if (R > 0.0) {
+    SdInelastic = new double[numResults];
+    ductility = new double[numResults];
+  }
+
+  if (numThreads > numRecords)
+    numThreads = numRecords;
+
+  // each thread writes the results of its own records only
+  if (numThreads <= 1)
+    this->computeRecords(0, 1);
+  else
+    ThreadPool::getThreadPool().run(numThreads, numThreads, [&](int i) {
+      this->computeRecords(i, numThreads);
+    });
+
+  accel = 0;
+  numSteps = 0;
+  dt = 0;
+
+  return 0;
+}
+
+void
+ResponseSpectrum::computeRecords(int first, int stride)
+{
+  for (int i=first; i<numRecords; i+=stride)
+    this->computeRecord(i, accel[i], numSteps[i], dt[i]);
+}
+
+void
+ResponseSpectrum::computeRecord(int record, const double *ag, int nSteps, double h)
+{
+  const int numPairs = numDampings*numPeriods;
+  const int offset = record*numPairs;
+
+  double pga = 0.0;
+  for (int i=0; i<nSteps; i++)
+    if (fabs(ag[i]) > pga)
+      pga = fabs(ag[i]);
+
+  // coefficients of the recurrence, Chopra Table 5.2.1, for a unit mass
+  // and the excitation p = -ag:
+  //   u(i+1) = A u(i) + B v(i) + C p(i) + D p(i+1)
+  //   v(i+1) = A' u(i) + B' v(i) + C' p(i) + D' p(i+1)
+  double *work = new double[11*numPairs];
+  double *A = work;
+  double *B = A + numPairs;
+  double *C = B + numPairs;
+  double *D = C + numPairs;
+  double *Ap = D + numPairs;
+  double *Bp = Ap + numPairs;
+  double *Cp = Bp + numPairs;
+  double *Dp = Cp + numPairs;
+  double *u = Dp + numPairs;
+  double *v = u + numPairs;
+  double *uMax = v + numPairs;
+
+  for (int i=0; i<numDampings; i++) {
+    double zeta = dampings[i];
+    double root = sqrt(1.0 - zeta*zeta);
+    for (int j=0; j<numPeriods; j++) {
+      int pair = i*numPeriods + j;
+      u[pair] = 0.0;
+      v[pair] = 0.0;
+      uMax[pair] = 0.0;
+
+      // a rigid oscillator has no relative motion
+      if (periods[j] <= 0.0) {
+	A[pair] = B[pair] = C[pair] = D[pair] = 0.0;
+	Ap[pair] = Bp[pair] = Cp[pair] = Dp[pair] = 0.0;
+	continue;
+      }
+
+      double omega = 2.0*PI/periods[j];
+      double omegaD = omega*root;
+      double k = omega*omega;
+      double e = exp(-zeta*omega*h);
+      double s = sin(omegaD*h);
+      double c = cos(omegaD*h);
+      double zr = zeta/root;
+      double zwh = 2.0*zeta/(omega*h);
+
+      A[pair] = e*(zr*s + c);
+      B[pair] = e*s/omegaD;
+      C[pair] = (zwh + e*(((1.0-2.0*zeta*zeta)/(omegaD*h) - zr)*s - (1.0 + zwh)*c))/k;
+      D[pair] = (1.0 - zwh + e*((2.0*zeta*zeta-1.0)/(omegaD*h)*s + zwh*c))/k;
+      Ap[pair] = -e*omega/root*s;
+      Bp[pair] = e*(c - zr*s);
+      Cp[pair] = (-1.0/h + e*((omega/root + zeta/(h*root))*s + c/h))/k;
+      Dp[pair] = (1.0 - e*(zr*s + c))/(k*h);
+    }
+  }
+
+  // all the oscillators are advanced together, the inner loop has no
+  // dependence between iterations and vectorizes
+  for (int n=0; n<nSteps-1; n++) {
+    const double p0 = -ag[n];
+    const double p1 = -ag[n+1];
+    for (int pair=0; pair<numPairs; pair++) {
+      double u0 = u[pair];
+      double v0 = v[pair];
+      double u1 = A[pair]*u0 + B[pair]*v0 + C[pair]*p0 + D[pair]*p1;
+      double v1 = Ap[pair]*u0 + Bp[pair]*v0 + Cp[pair]*p0 + Dp[pair]*p1;
+      u[pair] = u1;
+      v[pair] = v1;
+      double absU = fabs(u1);
+      uMax[pair] = (absU > uMax[pair]) ? absU : uMax[pair];
+    }
+  }
+
+  for (int i=0; i<numDampings; i++) {
+    for (int j=0; j<numPeriods; j++) {
+      int pair = i*numPeriods + j;
+      int loc = offset + pair;
+      if (periods[j] <= 0.0) {
+	Sd[loc] = 0.0;
+	PSv[loc] = 0.0;
+	PSa[loc] = pga;
+      } else {
+	double omega = 2.0*PI/periods[j];
+	Sd[loc] = uMax[pair];
+	PSv[loc] = omega*uMax[pair];
+	PSa[loc] = omega*omega*uMax[pair];
+      }
+    }
+  }
+
+  delete [] work;
+
+  if (R <= 0.0)
+    return;
+
+  for (int i=0; i<numDampings; i++) {
+    for (int j=0; j<numPeriods; j++) {
+      int loc = offset + i*numPeriods + j;
+      double uy = Sd[loc]/R;
+      if (periods[j] <= 0.0 || uy <= 0.0) {
+	SdInelastic[loc] = 0.0;
+	ductility[loc] = (periods[j] <= 0.0 && pga > 0.0) ? 1.0 : 0.0;
+	continue;
+      }
+
+      double omega = 2.0*PI/periods[j];
+      SdInelastic[loc] = this->computeBilinear(omega, dampings[i], uy, ag, nSteps, h);
+      ductility[loc] = SdInelastic[loc]/uy;
+    }
+  }
+}
+
+double
+ResponseSpectrum::computeBilinear(double omega, double zeta, double uy,
+				  const double *ag, int nSteps, double dt)
+{
+  const double k = omega*omega;
+  const double c = 2.0*zeta*omega;
+  const double fy = k*uy;
+  const double kp = alpha*k;
+
+  // the average acceleration method is unconditionally stable, the
+  // sub-steps are there to limit the period error
+  double T = 2.0*PI/omega;
+  int numSub = (int)ceil(dt*RS_BILINEAR_STEPS_PER_PERIOD/T);
+  if (numSub < 1)
+    numSub = 1;
+  const double h = dt/numSub;
+  const double a1 = 4.0/(h*h);
+  const double a2 = 4.0/h;
+  const double a3 = 2.0/h;
+
+  // start at rest
+  double u = 0.0;
+  double v = 0.0;
+  double a = -ag[0];
+  double fs = 0.0;
+  double uMax = 0.0;
+
+  for (int n=0; n<nSteps-1; n++) {
+    const double dp = -(ag[n+1] - ag[n])/numSub;
+    for (int m=1; m<=numSub; m++) {
+      const double p = -ag[n] + dp*m;
+
+      // Newton iteration on the trial displacement, the restoring force
+      // from a return map with kinematic hardening
+      double uNew = u;
+      double vNew = v;
+      double aNew = a;
+      double fsNew = fs;
+      for (int iter=0; iter<RS_BILINEAR_MAX_ITER; iter++) {
+	double du = uNew - u;
+	double kt = k;
+	fsNew = fs + k*du;
+	double fUpper = kp*uNew + (1.0-alpha)*fy;
+	double fLower = kp*uNew - (1.0-alpha)*fy;
+	if (fsNew > fUpper) {
+	  fsNew = fUpper;
+	  kt = kp;
+	} else if (fsNew < fLower) {
+	  fsNew = fLower;
+	  kt = kp;
+	}
+
+	aNew = a1*du - a2*v - a;
+	vNew = a3*du - v;
+
+	double r = p - aNew - c*vNew - fsNew;
+	double dU = r/(a1 + c*a3 + kt);
+	if (fabs(dU) <= 1.0e-12*uy)
+	  break;
+	uNew += dU;
+      }
+
+      u = uNew;
+      v = vNew;
+      a = aNew;
+      fs = fsNew;
+      if (fabs(u) > uMax)
+	uMax = fabs(u);
+    }
+  }
+
+  return uMax;
+}
+
+int
+ResponseSpectrum::getNumPeriods(void) const
+{
+  return numPeriods;
+}
+
+int
+ResponseSpectrum::getNumDampings(void) const
+{
+  return numDampings;
+}
+
+int
+ResponseSpectrum::getNumRecords(void) const
+{
+  return numRecords;
+}
+
+bool
+ResponseSpectrum::isBilinear(void) const
+{
+  return (R > 0.0);
+}
+
+const double *
+ResponseSpectrum::getSd(void) const
+{
+  return Sd;
+}
+
+const double *
+ResponseSpectrum::getPSv(void) const
+{
+  return PSv;
+}
+
+const double *
+ResponseSpectrum::getPSa(void) const
+{
+  return PSa;
+}
+
+const double *
+ResponseSpectrum::getSdInelastic(void) const
+{
+  return SdInelastic;
+}
+
+const double *
+ResponseSpectrum::getDuctility(void) const
+{
+  return ductility;
+}
@@ -0,0 +1,99 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for ResponseSpectrum.
+// A ResponseSpectrum computes the peak response of single degree of freedom
+// oscillators, for a set of periods and damping ratios, to a number of
+// ground acceleration records. The elastic oscillators are integrated with
+// the exact recurrence for a piecewise linear excitation (Nigam and
+// Jennings), whose coefficients depend only on the period, damping ratio
+// and time step; all the oscillators are stepped together, one time step
+// at a time, so that the inner loop runs over contiguous arrays. If
+// requested, bilinear oscillators with yield strength equal to the elastic
+// strength divided by R are also integrated, with the average acceleration
+// method, giving the inelastic displacement and ductility demand. The
+// records are shared out among a number of threads.
+//
+// What: "@(#) ResponseSpectrum.h, revA"
+
+#ifndef ResponseSpectrum_h
+#define ResponseSpectrum_h
+
+class ResponseSpectrum
+{
+  public:
+    ResponseSpectrum(int numPeriods, const double *periods,
+		     int numDampings, const double *dampings);
+    ~ResponseSpectrum();
+
+    // R <= 0 turns the inelastic analysis off
+    int setBilinear(double R, double alpha);
+
+    // record i holds numSteps[i] accelerations at a constant time step dt[i]
+    int compute(int numRecords, double **accel, const int *numSteps,
+		const double *dt, int numThreads = 1);
+
+    int getNumPeriods(void) const;
+    int getNumDampings(void) const;
+    int getNumRecords(void) const;
+    bool isBilinear(void) const;
+
+    // the results are stored record by record, then damping ratio by
+    // damping ratio, the periods varying fastest
+    const double *getSd(void) const;
+    const double *getPSv(void) const;
+    const double *getPSa(void) const;
+    const double *getSdInelastic(void) const;
+    const double *getDuctility(void) const;
+
+  protected:
+
+  private:
+    void computeRecord(int record, const double *accel, int numSteps, double dt);
+    void computeRecords(int first, int stride);
+    double computeBilinear(double omega, double zeta, double uy,
+			   const double *accel, int numSteps, double dt);
+
+    int numPeriods;
+    int numDampings;
+    double *periods;
+    double *dampings;
+
+    double R;          // strength reduction factor of the bilinear oscillators
+    double alpha;      // post-yield to elastic stiffness ratio
+
+    int numRecords;
+    double **accel;    // the records being analysed, not owned
+    const int *numSteps;
+    const double *dt;
+
+    double *Sd;
+    double *PSv;
+    double *PSa;
+    double *SdInelastic;
+    double *ductility;
+};
+
+#endif
@@ -0,0 +1,91 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent 
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation for RepartitionWhenUnbalanced.
+//
+// What: "@(#) RepartitionWhenUnbalanced.C, revA"
+
+#include <RepartitionWhenUnbalanced.h>
+#include <Graph.h>
+#include <VertexIter.h>
+#include <Vertex.h>
+ 
+RepartitionWhenUnbalanced::RepartitionWhenUnbalanced()
+ :factorGreater(1.1)
+{
+    
+}
+
+RepartitionWhenUnbalanced::RepartitionWhenUnbalanced(double fact)
+ :factorGreater(fact)
+{
+    if (fact < 1.0)
+	factorGreater = 1.0;
+}
+
+RepartitionWhenUnbalanced::~RepartitionWhenUnbalanced()
+{
+    
+}
+
+int
+RepartitionWhenUnbalanced::balance(Graph &theWeightedGraph)
+{
+    // check to see a domain partitioner has been set
+    DomainPartitioner *thePartitioner = this->getDomainPartitioner();
+    if (thePartitioner == 0) {
+	opserr << "RepartitionWhenUnbalanced::balance - No DomainPartitioner has been set\n";
+	return -1;
+    }
+
+    // determine the max and mean load of the partitions
+    int numPartitions = 0;
+    double maxLoad = 0.0;
+    double totalLoad = 0.0;
+    VertexIter &theVertices = theWeightedGraph.getVertices();
+    Vertex *vertexPtr;
+    while ((vertexPtr = theVertices()) != 0) {
+	double load = vertexPtr->getWeight();
+	if (load > maxLoad)
+	    maxLoad = load;
+	totalLoad += load;
+	numPartitions++;
+    }
+
+    // nothing measured, or balanced enough
+    if (numPartitions == 0 || totalLoad <= 0.0)
+	return 0;
+
+    if (maxLoad*numPartitions <= factorGreater*totalLoad)
+	return 0;
+
+    int res = thePartitioner->repartition();
+    if (res < 0) {
+	opserr << "WARNING RepartitionWhenUnbalanced::balance() ";
+	opserr << " - DomainPartitioner::repartition returned ";
+	opserr << res << endln;
+    }
+    
+    return res;
+}
@@ -0,0 +1,53 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent 
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for RepartitionWhenUnbalanced.
+// A RepartitionWhenUnbalanced is a LoadBalancer which, when the heaviest 
+// partition is more than factorGreater times the mean, has the DomainPartitioner
+// partition the element graph again using the measured cost of each element
+// as its weight, and move the elements whose partition changed.
+//
+// What: "@(#) RepartitionWhenUnbalanced.h, revA"
+
+#ifndef RepartitionWhenUnbalanced_h
+#define RepartitionWhenUnbalanced_h
+
+#include <LoadBalancer.h>
+
+class RepartitionWhenUnbalanced: public LoadBalancer
+{
+  public:
+    RepartitionWhenUnbalanced();
+    RepartitionWhenUnbalanced(double factorGreater);
+    virtual  ~RepartitionWhenUnbalanced();    
+
+    virtual int balance(Graph &theWeightedGraph);
+
+  protected:    
+	
+  private:
+    double factorGreater;
+};
+
+#endif
@@ -0,0 +1,271 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of NodalStateStore.
+//
+// What: "@(#) NodalStateStore.cpp, revA"
+
+#include <NodalStateStore.h>
+#include <ID.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <string.h>
+
+int NodalStateStore::numStores = 0;
+
+NodalStateStore::NodalStateStore(int nDOF)
+  :numDOF(nDOF), storeTag(0), data(0)
+{
+  storeTag = ++numStores;
+
+  if (numDOF < 0)
+    numDOF = 0;
+
+  if (numDOF > 0) {
+    data = new double[8*numDOF];
+    if (data == 0) {
+      opserr << "NodalStateStore::NodalStateStore() - out of memory for " << numDOF << " dof\n";
+      numDOF = 0;
+      return;
+    }
+    for (int i=0; i<8*numDOF; i++)
+      data[i] = 0.0;
+  }
+}
+
+NodalStateStore::~NodalStateStore()
+{
+  if (data != 0)
+    delete [] data;
+}
+
+int
+NodalStateStore::getNumDOF(void) const
+{
+  return numDOF;
+}
+
+int
+NodalStateStore::getStoreTag(void) const
+{
+  return storeTag;
+}
+
+double *
+NodalStateStore::getDisp(void)
+{
+  return data;
+}
+
+double *
+NodalStateStore::getVel(void)
+{
+  if (data == 0)
+    return 0;
+  return &data[4*numDOF];
+}
+
+double *
+NodalStateStore::getAccel(void)
+{
+  if (data == 0)
+    return 0;
+  return &data[6*numDOF];
+}
+
+int
+NodalStateStore::commitState(void)
+{
+  if (data == 0)
+    return 0;
+
+  size_t numBytes = numDOF*sizeof(double);
+  double *disp = data;
+  double *vel = &data[4*numDOF];
+  double *accel = &data[6*numDOF];
+
+  // committed = trial, incr = incrDelta = 0
+  memcpy(&disp[numDOF], disp, numBytes);
+  memset(&disp[2*numDOF], 0, 2*numBytes);
+  memcpy(&vel[numDOF], vel, numBytes);
+  memcpy(&accel[numDOF], accel, numBytes);
+
+  return 0;
+}
+
+int
+NodalStateStore::revertToLastCommit(void)
+{
+  if (data == 0)
+    return 0;
+
+  size_t numBytes = numDOF*sizeof(double);
+  double *disp = data;
+  double *vel = &data[4*numDOF];
+  double *accel = &data[6*numDOF];
+
+  // trial = committed, incr = incrDelta = 0
+  memcpy(disp, &disp[numDOF], numBytes);
+  memset(&disp[2*numDOF], 0, 2*numBytes);
+  memcpy(vel, &vel[numDOF], numBytes);
+  memcpy(accel, &accel[numDOF], numBytes);
+
+  return 0;
+}
+
+int
+NodalStateStore::revertToStart(void)
+{
+  if (data != 0)
+    memset(data, 0, 8*numDOF*sizeof(double));
+
+  return 0;
+}
+
+int
+NodalStateStore::setTrialDisp(const ID &map, const Vector &u)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::setTrialDisp() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = data;
+  double *commit = &data[numDOF];
+  double *incr = &data[2*numDOF];
+  double *incrDelta = &data[3*numDOF];
+
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0) {
+      double tDisp = u(loc);
+      incr[i] = tDisp - commit[i];
+      incrDelta[i] = tDisp - trial[i];
+      trial[i] = tDisp;
+    } else if (loc == -1)
+      // as Node::setTrialDisp() with the trial value unchanged
+      incrDelta[i] = 0.0;
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::setTrialVel(const ID &map, const Vector &udot)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::setTrialVel() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = &data[4*numDOF];
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0)
+      trial[i] = udot(loc);
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::setTrialAccel(const ID &map, const Vector &udotdot)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::setTrialAccel() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = &data[6*numDOF];
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0)
+      trial[i] = udotdot(loc);
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::incrTrialDisp(const ID &map, const Vector &du)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::incrTrialDisp() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = data;
+  double *incr = &data[2*numDOF];
+  double *incrDelta = &data[3*numDOF];
+
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0) {
+      double dDisp = du(loc);
+      trial[i] += dDisp;
+      incr[i] += dDisp;
+      incrDelta[i] = dDisp;
+    } else if (loc == -1)
+      // as Node::incrTrialDisp() with a zero increment
+      incrDelta[i] = 0.0;
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::incrTrialVel(const ID &map, const Vector &dudot)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::incrTrialVel() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = &data[4*numDOF];
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0)
+      trial[i] += dudot(loc);
+  }
+
+  return 0;
+}
+
+int
+NodalStateStore::incrTrialAccel(const ID &map, const Vector &dudotdot)
+{
+  if (map.Size() != numDOF) {
+    opserr << "NodalStateStore::incrTrialAccel() - map of wrong size\n";
+    return -1;
+  }
+
+  double *trial = &data[6*numDOF];
+  for (int i=0; i<numDOF; i++) {
+    int loc = map(i);
+    if (loc >= 0)
+      trial[i] += dudotdot(loc);
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NodalStateStore_h
+#define NodalStateStore_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for NodalStateStore.
+// A NodalStateStore holds the response quantities of all the nodes in
+// a Domain in a structure of arrays: one array of length numDOF for
+// each of trial disp, committed disp, incremental disp, incremental
+// delta disp, trial vel, committed vel, trial accel and committed accel.
+// The nodes keep their Vector objects, which point into these arrays.
+// Committing or reverting the nodal state of the Domain then becomes a
+// copy of whole arrays, and the AnalysisModel can set the trial response
+// of all the nodes in one sweep over the store, the location of each
+// equation in the store being given by a map with:
+//     map(i) >= 0  equation number of store location i
+//     map(i) == -1 location i is a constrained dof of a node being set
+//     map(i) == -2 location i is not set by the sweep
+//
+// What: "@(#) NodalStateStore.h, revA"
+
+class ID;
+class Vector;
+
+class NodalStateStore
+{
+  public:
+    NodalStateStore(int numDOF);
+    ~NodalStateStore();
+
+    int getNumDOF(void) const;
+    int getStoreTag(void) const;
+
+    // the arrays; disp holds trial, committed, incr and incrDelta one
+    // after the other, vel and accel hold trial and committed
+    double *getDisp(void);
+    double *getVel(void);
+    double *getAccel(void);
+
+    // operations on all the nodes in the store
+    int commitState(void);
+    int revertToLastCommit(void);
+    int revertToStart(void);
+
+    // sweeps setting the trial response from equation ordered Vectors
+    int setTrialDisp(const ID &map, const Vector &u);
+    int setTrialVel(const ID &map, const Vector &udot);
+    int setTrialAccel(const ID &map, const Vector &udotdot);
+    int incrTrialDisp(const ID &map, const Vector &du);
+    int incrTrialVel(const ID &map, const Vector &dudot);
+    int incrTrialAccel(const ID &map, const Vector &dudotdot);
+
+  protected:
+
+  private:
+    int numDOF;
+    int storeTag;    // unique, so that users can tell a rebuilt store
+    double *data;    // 8*numDOF doubles: disp, vel, accel
+
+    static int numStores;
+};
+
+#endif
@@ -47,6 +47,9 @@
 
 // AddingSensitivity:BEGIN //////////////////////////
 #include <Domain.h>
+#include <ArenaAllocator.h>
+#include <NodalStateStore.h>
+#include <new>
 #include <Element.h>
 #include <ElementIter.h>
 #include <SP_Constraint.h>
@@ -189,7 +192,9 @@ Node::Node(int theClassTag)
  incrDeltaDisp(0),
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // for FEM_ObjectBroker, recvSelf() must be invoked on object
 
@@ -210,7 +215,9 @@ Node::Node(int tag, int theClassTag)
  incrDeltaDisp(0), 
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // for subclasses - they must implement all the methods with
   // their own data structures.
@@ -231,7 +238,9 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  incrDeltaDisp(0), 
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0)
+ index(-1), reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -288,7 +297,9 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  incrDeltaDisp(0), 
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
- reaction(0), displayLocation(0)
+ reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -347,7 +358,9 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  incrDeltaDisp(0), 
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
- reaction(0), displayLocation(0)
+ reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -407,7 +420,9 @@ Node::Node(const Node &otherNode, bool copyMass)
  incrDeltaDisp(0), 
  disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
-   reaction(0), displayLocation(0)
+   reaction(0), displayLocation(0),
+ theStateArena(0), arenaState(0), arenaStride(0),
+ theStateStore(0), stateOffset(-1), stateStride(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -431,8 +446,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numberDOF; i++)
+	disp[i+k*stateStride] = otherNode.disp[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -440,8 +456,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	vel[i+k*stateStride] = otherNode.vel[i+k*otherNode.stateStride];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -449,8 +466,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	accel[i+k*stateStride] = otherNode.accel[i+k*otherNode.stateStride];
   }    
   
   
@@ -519,41 +537,69 @@ Node::~Node()
     if (Crd != 0)
 	delete Crd;
 
-    if (commitDisp != 0)
+    if (arenaState != 0) {
+
+      // the response arrays and the Vectors wrapping them were placed in
+      // the domain's arena, which releases the memory in bulk in clearAll()
+      if (commitDisp != 0)
+	commitDisp->~Vector();
+      if (commitVel != 0)
+	commitVel->~Vector();
+      if (commitAccel != 0)
+	commitAccel->~Vector();
+      if (trialDisp != 0)
+	trialDisp->~Vector();
+      if (trialVel != 0)
+	trialVel->~Vector();
+      if (trialAccel != 0)
+	trialAccel->~Vector();
+      if (incrDisp != 0)
+	incrDisp->~Vector();
+      if (incrDeltaDisp != 0)
+	incrDeltaDisp->~Vector();
+
+    } else {
+
+      if (commitDisp != 0)
 	delete commitDisp;
 
-    if (commitVel != 0)
+      if (commitVel != 0)
 	delete commitVel;
 
-    if (commitAccel != 0)
+      if (commitAccel != 0)
 	delete commitAccel;
 
-    if (trialDisp != 0)
+      if (trialDisp != 0)
 	delete trialDisp;
 
-    if (trialVel != 0)
+      if (trialVel != 0)
 	delete trialVel;
 
-    if (trialAccel != 0)
+      if (trialAccel != 0)
 	delete trialAccel;
 
-    if (incrDisp != 0)
+      if (incrDisp != 0)
 	delete incrDisp;
     
-    if (incrDeltaDisp != 0)
+      if (incrDeltaDisp != 0)
 	delete incrDeltaDisp;    
-    
-    if (unbalLoad != 0)
-	delete unbalLoad;
-    
-    if (disp != 0)
+
+    }
+
+    // arrays held in an arena or the domain's state store are not ours
+    if (arenaState == 0 && theStateStore == 0) {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
+    
+    if (unbalLoad != 0)
+	delete unbalLoad;
 
     if (mass != 0)
 	delete mass;
@@ -772,8 +818,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we dont't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -803,8 +849,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -879,8 +925,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -889,8 +935,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1017,9 +1063,9 @@ Node::addInertiaLoadToUnbalance(const Vector &accelG, double fact)
   // form - fact * M*R*accelG and add it to the unbalanced load
   //(*unbalLoad) -= ((*mass) * (*R) * accelG)*fact;
 
-  Matrix MR(mass->noRows(), R->noCols());
-  MR.addMatrixProduct(0.0, *mass, *R, 1.0);
-  unbalLoad->addMatrixVector(1.0, MR, accelG, -fact);
+  // R*accelG is formed first, so no M*R matrix is created on each call
+  const Vector &RV = this->getRV(accelG);
+  unbalLoad->addMatrixVector(1.0, *mass, RV, -fact);
 
   return 0;
 }
@@ -1124,22 +1170,22 @@ Node::commitState()
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
     // check vel exists, if does set commit = trial    
     if (trialVel != 0) {
       for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
     if (trialAccel != 0) {
       for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
     // if we get here we are done
@@ -1154,22 +1200,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     // if we get here we are done
@@ -1182,20 +1228,23 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int k=0 ; k<4; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  disp[i+k*stateStride] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int k=0 ; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  vel[i+k*stateStride] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int k=0 ; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  accel[i+k*stateStride] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1283,6 +1332,11 @@ Node::setMass(const Matrix &newMass)
 	return -1;
     }	
 
+    // let those caching products of the mass know it has changed
+    Domain *theDomain = this->getDomain();
+    if (theDomain != 0)
+      theDomain->massChange();
+
     // create a matrix if no mass yet set
     if (mass == 0) {
 	mass = new Matrix(newMass);
@@ -1610,7 +1664,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal commited
+	disp[i] = disp[i+stateStride];  // set trial equal commited
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1632,7 +1686,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal commited
+	vel[i] = vel[i+stateStride];  // set trial equal commited
     }
 
     if (data(4) == 0) {
@@ -1648,7 +1702,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal commited
+	accel[i] = accel[i+stateStride];  // set trial equal commited
     }
 
     if (data(5) == 0) {
@@ -1795,6 +1849,223 @@ Node::displaySelf(Renderer &theRenderer, int displayMode, float fact)
 }
 
 
+// getStateArena():
+// private method returning the domain's arena if the response arrays of
+// this node are to be placed in it. The choice is made when the first
+// array is created; the domain then hands out the node's slot in a page
+// of the arena, in which each of the 8 response arrays of consecutive
+// nodes are contiguous, array k of this node being at
+// arenaState + k*arenaStride.
+
+ArenaAllocator *
+Node::getStateArena(void)
+{
+  if (arenaState != 0)
+    return theStateArena;
+
+  if (disp != 0 || vel != 0 || accel != 0)
+    return 0;
+
+  Domain *theDomain = this->getDomain();
+  if (theDomain == 0)
+    return 0;
+
+  ArenaAllocator *theArena = theDomain->getNodalArena();
+  if (theArena == 0)
+    return 0;
+
+  arenaState = theDomain->allocateNodalState(numberDOF, arenaStride);
+  if (arenaState == 0)
+    return 0;
+
+  theStateArena = theArena;
+  return theStateArena;
+}
+
+static Vector *
+newArenaVector(ArenaAllocator *theArena, double *data, int size)
+{
+  void *mem = theArena->allocate(sizeof(Vector));
+  if (mem == 0)
+    return 0;
+  return new (mem) Vector(data, size);
+}
+
+
+static Vector *
+moveArenaVector(Vector *theVector, double *data, int size)
+{
+  theVector->~Vector();
+  return new Vector(data, size);
+}
+
+
+// releaseStateArena():
+// moves the response arrays, and the Vector objects wrapping them, out
+// of the domain's arena into memory owned by the node, so that the node
+// may outlive the arena. Invoked by the domain when the node is removed.
+
+int
+Node::releaseStateArena(void)
+{
+  if (arenaState == 0)
+    return 0;
+
+  // leave any state store first, this puts the values back in the arena
+  if (theStateStore != 0 && this->setStateStore(0, 0) < 0)
+    return -1;
+
+  if (disp != 0) {
+    double *newDisp = new double[4*numberDOF];
+    if (newDisp == 0) {
+      opserr << "WARNING - Node::releaseStateArena() ran out of memory\n";
+      return -2;
+    }
+    for (int i=0; i<numberDOF; i++)
+      for (int k=0; k<4; k++)
+	newDisp[i+k*numberDOF] = disp[i+k*stateStride];
+
+    trialDisp = moveArenaVector(trialDisp, newDisp, numberDOF);
+    commitDisp = moveArenaVector(commitDisp, &newDisp[numberDOF], numberDOF);
+    incrDisp = moveArenaVector(incrDisp, &newDisp[2*numberDOF], numberDOF);
+    incrDeltaDisp = moveArenaVector(incrDeltaDisp, &newDisp[3*numberDOF], numberDOF);
+    disp = newDisp;
+  }
+
+  if (vel != 0) {
+    double *newVel = new double[2*numberDOF];
+    if (newVel == 0) {
+      opserr << "WARNING - Node::releaseStateArena() ran out of memory\n";
+      return -2;
+    }
+    for (int i=0; i<numberDOF; i++)
+      for (int k=0; k<2; k++)
+	newVel[i+k*numberDOF] = vel[i+k*stateStride];
+
+    trialVel = moveArenaVector(trialVel, newVel, numberDOF);
+    commitVel = moveArenaVector(commitVel, &newVel[numberDOF], numberDOF);
+    vel = newVel;
+  }
+
+  if (accel != 0) {
+    double *newAccel = new double[2*numberDOF];
+    if (newAccel == 0) {
+      opserr << "WARNING - Node::releaseStateArena() ran out of memory\n";
+      return -2;
+    }
+    for (int i=0; i<numberDOF; i++)
+      for (int k=0; k<2; k++)
+	newAccel[i+k*numberDOF] = accel[i+k*stateStride];
+
+    trialAccel = moveArenaVector(trialAccel, newAccel, numberDOF);
+    commitAccel = moveArenaVector(commitAccel, &newAccel[numberDOF], numberDOF);
+    accel = newAccel;
+  }
+
+  theStateArena = 0;
+  arenaState = 0;
+  arenaStride = 0;
+  stateStride = numberDOF;
+
+  return 0;
+}
+
+
+// setStateStore():
+// moves the disp, vel and accel arrays of the node into theStore, at
+// location offset of each of the store's arrays, or, if theStore is 0,
+// moves them out of the store they are currently in. The current values
+// are kept and the Vector objects are left pointing at the new arrays.
+
+int
+Node::setStateStore(NodalStateStore *theStore, int offset)
+{
+  if (theStore == 0 && theStateStore == 0)
+    return 0;
+
+  // make sure all the Vectors exist, the store has room for all
+  if (trialDisp == 0 && this->createDisp() < 0)
+    return -1;
+  if (trialVel == 0 && this->createVel() < 0)
+    return -1;
+  if (trialAccel == 0 && this->createAccel() < 0)
+    return -1;
+
+  double *newDisp, *newVel, *newAccel;
+  int newStride;
+
+  if (theStore != 0) {
+    newStride = theStore->getNumDOF();
+    if (offset < 0 || offset+numberDOF > newStride) {
+      opserr << "Node::setStateStore() - node " << this->getTag() << " does not fit in the store\n";
+      return -2;
+    }
+    newDisp = theStore->getDisp() + offset;
+    newVel = theStore->getVel() + offset;
+    newAccel = theStore->getAccel() + offset;
+  } else {
+    newStride = numberDOF;
+    if (arenaState != 0) {
+      // back into the slot the arena gave us
+      newStride = arenaStride;
+      newDisp = arenaState;
+      newVel = &arenaState[4*arenaStride];
+      newAccel = &arenaState[6*arenaStride];
+    } else {
+      newDisp = new double[4*numberDOF];
+      newVel = new double[2*numberDOF];
+      newAccel = new double[2*numberDOF];
+      if (newDisp == 0 || newVel == 0 || newAccel == 0) {
+	opserr << "Node::setStateStore() - ran out of memory\n";
+	return -3;
+      }
+    }
+  }
+
+  // copy the current values across
+  for (int i=0; i<numberDOF; i++) {
+    for (int k=0; k<4; k++)
+      newDisp[i+k*newStride] = disp[i+k*stateStride];
+    for (int k=0; k<2; k++) {
+      newVel[i+k*newStride] = vel[i+k*stateStride];
+      newAccel[i+k*newStride] = accel[i+k*stateStride];
+    }
+  }
+
+  // free the old arrays if we own them
+  if (arenaState == 0 && theStateStore == 0) {
+    delete [] disp;
+    delete [] vel;
+    delete [] accel;
+  }
+
+  disp = newDisp;
+  vel = newVel;
+  accel = newAccel;
+  stateStride = newStride;
+
+  trialDisp->setData(disp, numberDOF);
+  commitDisp->setData(&disp[stateStride], numberDOF);
+  incrDisp->setData(&disp[2*stateStride], numberDOF);
+  incrDeltaDisp->setData(&disp[3*stateStride], numberDOF);
+  trialVel->setData(vel, numberDOF);
+  commitVel->setData(&vel[stateStride], numberDOF);
+  trialAccel->setData(accel, numberDOF);
+  commitAccel->setData(&accel[stateStride], numberDOF);
+
+  theStateStore = theStore;
+  stateOffset = (theStore != 0) ? offset : -1;
+
+  return 0;
+}
+
+int
+Node::getStateStoreOffset(void) const
+{
+  return stateOffset;
+}
+
+
 // createDisp(), createVel() and createAccel():
 // private methods to create the arrays to hold the disp, vel and acceleration
 // values and the Vector objects for the committed and trial quantaties.
@@ -1802,6 +2073,24 @@ Node::displaySelf(Renderer &theRenderer, int displayMode, float fact)
 int
 Node::createDisp(void)
 {
+  stateStride = numberDOF;
+
+  ArenaAllocator *theArena = this->getStateArena();
+  if (theArena != 0) {
+    stateStride = arenaStride;
+    disp = arenaState;
+    commitDisp = newArenaVector(theArena, &disp[stateStride], numberDOF);
+    trialDisp = newArenaVector(theArena, disp, numberDOF);
+    incrDisp = newArenaVector(theArena, &disp[2*stateStride], numberDOF);
+    incrDeltaDisp = newArenaVector(theArena, &disp[3*stateStride], numberDOF);
+
+    if (commitDisp == 0 || trialDisp == 0 || incrDisp == 0 || incrDeltaDisp == 0) {
+      opserr << "WARNING - Node::createDisp() ran out of memory in the domain arena\n";
+      return -2;
+    }
+    return 0;
+  }
+
   // trial , committed, incr = (committed-trial)
   disp = new double[4*numberDOF];
     
@@ -1831,6 +2120,22 @@ Node::createDisp(void)
 int
 Node::createVel(void)
 {
+    stateStride = numberDOF;
+
+    ArenaAllocator *theArena = this->getStateArena();
+    if (theArena != 0) {
+      stateStride = arenaStride;
+      vel = &arenaState[4*stateStride];
+      commitVel = newArenaVector(theArena, &vel[stateStride], numberDOF);
+      trialVel = newArenaVector(theArena, vel, numberDOF);
+
+      if (commitVel == 0 || trialVel == 0) {
+	opserr << "WARNING - Node::createVel() ran out of memory in the domain arena\n";
+	return -2;
+      }
+      return 0;
+    }
+
     vel = new double[2*numberDOF];
     
     if (vel == 0) {
@@ -1855,6 +2160,22 @@ Node::createVel(void)
 int
 Node::createAccel(void)
 {
+    stateStride = numberDOF;
+
+    ArenaAllocator *theArena = this->getStateArena();
+    if (theArena != 0) {
+      stateStride = arenaStride;
+      accel = &arenaState[6*stateStride];
+      commitAccel = newArenaVector(theArena, &accel[stateStride], numberDOF);
+      trialAccel = newArenaVector(theArena, accel, numberDOF);
+
+      if (commitAccel == 0 || trialAccel == 0) {
+	opserr << "WARNING - Node::createAccel() ran out of memory in the domain arena\n";
+	return -2;
+      }
+      return 0;
+    }
+
     accel = new double[2*numberDOF];
     
     if (accel == 0) {
@@ -1980,6 +2301,12 @@ Node::setParameter(const char **argv, int argc, Parameter &param)
 int
 Node::updateParameter(int pparameterID, Information &info)
 {
+  if ((pparameterID >= 1 && pparameterID <= 3) || pparameterID == 7 || pparameterID == 8) {
+    Domain *theDomain = this->getDomain();
+    if (theDomain != 0)
+      theDomain->massChange();
+  }
+
   if (pparameterID >= 1 && pparameterID <= 3)
     (*mass)(pparameterID-1,pparameterID-1) = info.theDouble;
 
@@ -2001,6 +2328,7 @@ Node::updateParameter(int pparameterID, Information &info)
       
       // Need to "setDomain" to make the change take effect. 
       Domain *theDomain = this->getDomain();
+      theDomain->crdChange();
       ElementIter &theElements = theDomain->getElements();
       Element *theElement;
       while ((theElement = theElements()) != 0) {
@@ -2219,6 +2547,7 @@ Node::setCrds(double Crd1)
 
   // Need to "setDomain" to make the change take effect. 
   Domain *theDomain = this->getDomain();
+  theDomain->crdChange();
   ElementIter &theElements = theDomain->getElements();
   Element *theElement;
   while ((theElement = theElements()) != 0) {
@@ -2235,6 +2564,7 @@ Node::setCrds(double Crd1, double Crd2)
 
     // Need to "setDomain" to make the change take effect. 
     Domain *theDomain = this->getDomain();
+    theDomain->crdChange();
     ElementIter &theElements = theDomain->getElements();
     Element *theElement;
     while ((theElement = theElements()) != 0) {
@@ -2253,6 +2583,7 @@ Node::setCrds(double Crd1, double Crd2, double Crd3)
 
     // Need to "setDomain" to make the change take effect. 
     Domain *theDomain = this->getDomain();
+    theDomain->crdChange();
     ElementIter &theElements = theDomain->getElements();
     Element *theElement;
     while ((theElement = theElements()) != 0) {
@@ -2267,10 +2598,15 @@ Node::setCrds(const Vector &newCrds)
   if (Crd != 0 && Crd->Size() == newCrds.Size()) {
     (*Crd) = newCrds;
 
+    // the elements are not reset here, but cached products of the
+    // coordinates held by the load patterns are
+    Domain *theDomain = this->getDomain();
+    if (theDomain != 0)
+      theDomain->crdChange();
+
 	return;
 
     // Need to "setDomain" to make the change take effect. 
-    Domain *theDomain = this->getDomain();
     ElementIter &theElements = theDomain->getElements();
     Element *theElement;
     while ((theElement = theElements()) != 0) {
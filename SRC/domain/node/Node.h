@@ -48,6 +48,8 @@ class Channel;
 class Renderer;
 
 class DOF_Group;
+class ArenaAllocator;
+class NodalStateStore;
 
 class Node : public DomainComponent
 {
@@ -158,6 +160,13 @@ class Node : public DomainComponent
     virtual void setCrds(double Crd1, double Crd2, double Crd3);
     virtual void setCrds(const Vector &);
 
+    // methods to move the response arrays into the domain's state store
+    virtual int setStateStore(NodalStateStore *theStore, int offset);
+    virtual int getStateStoreOffset(void) const;
+
+    // method to move the response arrays out of the domain's arena
+    virtual int releaseStateArena(void);
+
   protected:
 
   private:
@@ -166,6 +175,7 @@ class Node : public DomainComponent
     int createDisp(void);
     int createVel(void);
     int createAccel(void); 
+    ArenaAllocator *getStateArena(void);
 
     // private data associated with each node object
     int numberDOF;                    // number of dof at Node
@@ -203,6 +213,14 @@ class Node : public DomainComponent
 
     Vector *reaction;
     Vector *displayLocation;
+
+    ArenaAllocator *theStateArena;    // domain arena holding disp, vel and accel, if any
+    double *arenaState;               // slot of this node in a page of that arena
+    int arenaStride;                  // distance between the response arrays in the page
+
+    NodalStateStore *theStateStore;   // domain state store holding disp, vel and accel, if any
+    int stateOffset;                  // location of this node's dof in that store
+    int stateStride;                  // distance between trial, commit and incr values
 };
 
 #endif
@@ -50,6 +50,7 @@
 #include <VertexIter.h>
 #include <Graph.h>
 #include <Vector.h>
+#include <Matrix.h>
 #include <NodalLoad.h>
 #include <ElementalLoad.h>
 #include <NodalLoadIter.h>
@@ -68,16 +69,37 @@ public:
   NodeLocations(int tag);
   void Print(OPS_Stream &s, int flag =0);  
   int addPartition(int partition);
+  int addVertex(int vertexTag);
+  int addSP(int spTag);
   ID nodePartitions;
   int numPartitions;
+  ID nodeVertices;      // vertices of the elements connected to the node
+  int numVertices;
+  ID nodeSPs;           // the single point constraints on the node
+  int numSPs;
+  int pinned;           // 1 if loaded in a LoadPattern, 2 if MP or LoadPattern SP constrained
 };
 
+class ElementLocation: public TaggedObject
+{
+public:
+  ElementLocation(int tag, int vertexTag, const ID &nodes);
+  void Print(OPS_Stream &s, int flag =0);  
+  int vertexTag;
+  ID nodes;
+  bool canMove;         // false if the element is loaded in a LoadPattern
+};
 
 
 NodeLocations::NodeLocations(int tag)
 :TaggedObject(tag), 
  nodePartitions(0,1), 
- numPartitions(0)
+ numPartitions(0),
+ nodeVertices(0,4),
+ numVertices(0),
+ nodeSPs(0,1),
+ numSPs(0),
+ pinned(0)
 {
 
 }
@@ -96,10 +118,62 @@ NodeLocations::addPartition(int partition)
   return 0;
 }
 
+int
+NodeLocations::addVertex(int vertexTag)
+{
+  if (nodeVertices.insert(vertexTag) != 1)
+    numVertices++;
+  return 0;
+}
+
+int
+NodeLocations::addSP(int spTag)
+{
+  if (nodeSPs.insert(spTag) != 1)
+    numSPs++;
+  return 0;
+}
+
+ElementLocation::ElementLocation(int tag, int vertex, const ID &eleNodes)
+:TaggedObject(tag), 
+ vertexTag(vertex),
+ nodes(eleNodes),
+ canMove(true)
+{
+
+}
+
+void 
+ElementLocation::Print(OPS_Stream &s, int flag)
+{
+  s << "ElementLocation tag: " << this->getTag() << " vertex: " << vertexTag << " nodes: " << nodes;
+}
+
+// removes the vertices from a graph without deleting them, as the
+// boundary graphs share their vertices with the element graph
+static void
+emptyGraph(Graph &theGraph)
+{
+  int numVertex = theGraph.getNumVertex();
+  if (numVertex == 0)
+    return;
+
+  ID vertexTags(numVertex);
+  int count = 0;
+  VertexIter &theVertices = theGraph.getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0)
+    vertexTags(count++) = vertexPtr->getTag();
+
+  for (int i=0; i<count; i++)
+    theGraph.removeVertex(vertexTags(i), false);
+}
+
 DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner)
 :myDomain(0),thePartitioner(theGraphPartitioner),theBalancer(0),
  theElementGraph(0), theBoundaryElements(0), 
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0), theElementLocations(0), elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false),
+ numMoved(0)
 {
 
 }    
@@ -108,7 +182,8 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 				     LoadBalancer &theLoadBalancer)
 :myDomain(0),thePartitioner(theGraphPartitioner),theBalancer(&theLoadBalancer),
  theElementGraph(0), theBoundaryElements(0),
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0), theElementLocations(0), elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false),
+ numMoved(0)
 {
     // set the links the loadBalancer needs
     theLoadBalancer.setLinks(*this);
@@ -119,10 +194,21 @@ DomainPartitioner::~DomainPartitioner()
 {
   if (theBoundaryElements != 0) {
     for (int i=0; i<numPartitions; i++)
-      if (theBoundaryElements[i] != 0)
+      if (theBoundaryElements[i] != 0) {
+	emptyGraph(*theBoundaryElements[i]);
 	delete theBoundaryElements[i];
+      }
     delete []theBoundaryElements;
   }
+
+  if (theElementGraph != 0)
+    delete theElementGraph;
+
+  if (theNodeLocations != 0)
+    delete theNodeLocations;
+
+  if (theElementLocations != 0)
+    delete theElementLocations;
 }
 
 void 
@@ -151,11 +237,22 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     }
   }
 
-  // we get the ele graph from the domain and partition it
-  //    Graph &theEleGraph = myDomain->getElementGraph();
-  //    theElementGraph = new Graph(myDomain->getElementGraph());
+  // we get the ele graph from the domain and partition it; a copy is kept
+  // as the domain's graph is cleared once the elements have been moved
+  if (theBoundaryElements != 0) {
+    for (int i=0; i<numPartitions; i++)
+      if (theBoundaryElements[i] != 0) {
+	emptyGraph(*theBoundaryElements[i]);
+	delete theBoundaryElements[i];
+      }
+    delete [] theBoundaryElements;
+    theBoundaryElements = 0;
+  }
+
+  if (theElementGraph != 0)
+    delete theElementGraph;
 
-  theElementGraph = &(myDomain->getElementGraph());
+  theElementGraph = new Graph(myDomain->getElementGraph());
 
   int theError = thePartitioner.partition(*theElementGraph, numParts);
 
@@ -213,9 +310,6 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   // we do not invoke the destructor on the individual graphs as 
   // this would invoke the destructor on the individual vertices
 
-  if (theBoundaryElements != 0)
-    delete [] theBoundaryElements;
-  
   theBoundaryElements = new Graph * [numParts];
   if (theBoundaryElements == 0) {
     opserr << "DomainPartitioner::partition(int numParts)";
@@ -242,8 +336,14 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   // we now create a MapOfTaggedObjectStorage to store the NodeLocations
   // and create a new NodeLocation for each node; adding it to the map object
 
+  if (theNodeLocations != 0)
+    delete theNodeLocations;
+  if (theElementLocations != 0)
+    delete theElementLocations;
+
   theNodeLocations = new MapOfTaggedObjects();
-  if (theNodeLocations == 0) {
+  theElementLocations = new MapOfTaggedObjects();
+  if (theNodeLocations == 0 || theElementLocations == 0) {
     opserr << "DomainPartitioner::partition(int numParts)";
     opserr << " - ran out of memory creating MapOfTaggedObjectStorage for node locations\n";
     numPartitions = 0;
@@ -294,6 +394,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     
     Element *elePtr = myDomain->getElement(eleTag);
     const ID &nodes = elePtr->getExternalNodes();
+    theElementLocations->addComponent(new ElementLocation(eleTag, vertexPtr->getTag(), nodes));
     size = nodes.Size();
     for (int j=0; j<size; j++) {
       int nodeTag = nodes(j);
@@ -306,6 +407,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       }
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
       theNodeLocation->addPartition(vertexColor);
+      theNodeLocation->addVertex(vertexPtr->getTag());
     }
   }
 
@@ -332,6 +434,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     
     NodeLocations *theRetainedLocation = (NodeLocations *)theRetainedObject;
     NodeLocations *theConstrainedLocation = (NodeLocations *)theConstrainedObject;
+    theRetainedLocation->pinned = 2;
+    theConstrainedLocation->pinned = 2;
     ID &theConstrainedNodesPartitions = theConstrainedLocation->nodePartitions;
     int numPartitions = theConstrainedNodesPartitions.Size();
     for (int i=0; i<numPartitions; i++) {
@@ -434,6 +538,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       }
     
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+      if (theNodeLocation->pinned == 0)
+	theNodeLocation->pinned = 1;
       ID &nodePartitions = theNodeLocation->nodePartitions;
       int numPartitions = theNodeLocation->numPartitions;
       for (int i=0; i<numPartitions; i++) {
@@ -464,6 +570,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       }
       
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+      theNodeLocation->pinned = 2;
       ID &nodePartitions = theNodeLocation->nodePartitions;
       int numPartitions = theNodeLocation->numPartitions;
       for (int i=0; i<numPartitions; i++) {
@@ -484,6 +591,10 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     while ((theLoad = theLoads()) != 0) {
       int loadEleTag = theLoad->getElementTag();
 
+      TaggedObject *theEleObject = theElementLocations->getComponentPtr(loadEleTag);
+      if (theEleObject != 0)
+	((ElementLocation *)theEleObject)->canMove = false;
+
       SubdomainIter &theSubdomains = myDomain->getSubdomains();
       Subdomain *theSub;
       bool added = false;
@@ -516,6 +627,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     }
     
     NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+    theNodeLocation->addSP(spPtr->getTag());
     ID &nodePartitions = theNodeLocation->nodePartitions;
     int numPartitions = theNodeLocation->numPartitions;
     for (int i=0; i<numPartitions; i++) {
@@ -588,23 +700,42 @@ DomainPartitioner::balance(Graph &theWeightedPGraph)
 
     if (theBalancer != 0) {
 
+	// weigh the elements by their measured cost
+	this->weighElements();
+
 	// call on the LoadBalancer to partition		
+	numMoved = 0;
 	res = theBalancer->balance(theWeightedPGraph);
 	    
-	// now invoke domainChanged on Subdomains and PartitionedDomain
-	SubdomainIter &theSubDomains = myDomain->getSubdomains();
-	Subdomain *theSubDomain;
-
-	while ((theSubDomain = theSubDomains()) != 0) 
-	  theSubDomain->domainChange();
+	// now invoke domainChanged on Subdomains and PartitionedDomain,
+	// if the balancer moved any elements
+	if (numMoved != 0) {
+	  SubdomainIter &theSubDomains = myDomain->getSubdomains();
+	  Subdomain *theSubDomain;
+
+	  while ((theSubDomain = theSubDomains()) != 0) 
+	    theSubDomain->domainChange();
 	
-	// we invoke change on the PartitionedDomain
-	myDomain->domainChange();
+	  // we invoke change on the PartitionedDomain
+	  myDomain->domainChange();
+	}
     }
 
     return res;
 }
 
+bool
+DomainPartitioner::hasLoadBalancer(void) const
+{
+    return (theBalancer != 0);
+}
+
+int
+DomainPartitioner::getNumElementsMoved(void) const
+{
+    return numMoved;
+}
+
 
 
 int 
@@ -634,6 +765,10 @@ DomainPartitioner::getColoredGraph(void)
       opserr << " - No domain has been set";
       exit(0);
     }
+
+    // once partitioned the colors are kept in our copy of the element graph
+    if (partitionFlag == true && theElementGraph != 0)
+      return *theElementGraph;
     
     return myDomain->getElementGraph();
 }
@@ -643,12 +778,9 @@ int
 DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 			      bool adjacentVertexNotInOther)
 {
-  opserr << "DomainPartitioner::swapVertex() " << from << " " << to << " " << vertexTag << endln;
-
-  /*
   // check that the object did the partitioning
   if (partitionFlag == false) {
-    opserr << "DomainPartitioner::balance(const Vector &load)";
+    opserr << "DomainPartitioner::swapVertex()";
     opserr << " - not partitioned or DomainPartitioner did not partition\n";
     return -1;
   }
@@ -666,29 +798,13 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
     opserr << to << " exists\n";
     return -3;
   }    
-  
-  // remove the vertex from the boundary if there
-  // if not there we have to get a pointer to it from the ele graph.
-  
-  //    Graph &theEleGraph = myDomain->getElementGraph();    
-  Graph *fromBoundary = theBoundaryElements[from-1];
-  Graph *toBoundary = theBoundaryElements[to-1];    
-  Vertex *vertexPtr;
-  
-  // get a pointer to the vertex in the element graph
-  if (adjacentVertexNotInOther  == false) {
-    vertexPtr = fromBoundary->removeVertex(vertexTag,false);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;
-  } else { // get a pointer and check vertex not adjacent to another partition
-    vertexPtr = fromBoundary->getVertexPtr(vertexTag);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;	
+
+  Vertex *vertexPtr = theElementGraph->getVertexPtr(vertexTag);
+  if (vertexPtr == 0 || vertexPtr->getColor() != from)
+    return -4;
+
+  // check the vertex is adjacent to to and to no other partition
+  if (adjacentVertexNotInOther == true) {
     const ID &adjacent = vertexPtr->getAdjacency();
     bool inTo = false;
     bool inOther = false;
@@ -702,658 +818,472 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 	i = adjacentSize;
       }
     }
-    if (inTo != true || inOther == true) // we cannot remove the vertex
+    if (inTo != true || inOther == true) // we cannot move the vertex
       return -5;
-    // if can remove the vertex from the fromBoundary
-    Vertex *theVertex = fromBoundary->removeVertex(vertexTag,false);
   }
-  
-  int eleTag = vertexPtr->getRef();
-  
-  //
-  // in the FROM subdomain we:
-  //  1. remove the element
-  //  2. remove all nodes connected to the element divide color by prime
-  //  3. see if have to add nodes back as external
-  //  4. remove from the PartitionedDomain if node was external
-  //  5. add new elements to the boundary vertices for from
-  
-  //  1. remove the element from the fromSubdomain
-    //          this gives us a pointer to the element as well.
-
-    Element *elePtr = fromSubdomain->removeElement(eleTag);
-    if (elePtr == 0) // if ele not there we can just return but ERROR it should be
-  return -6;
-
-    //  2. remove all nodes connected to the element divide color by prime    
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-    int primeFrom = primes(from);
-    const ID  &nodes1 = elePtr->getExternalNodes(); // create a copy, need after send ele
-    ID  nodes(nodes1);
-
-    int nodesSize = nodes.Size();
-    Node **nodesArray = new Node *[nodesSize];
-    for (int i=0; i<nodesSize; i++) {
-  int nodeTag = nodes(i);
-
-  // remove the node
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-
-  (*nodePlace)(nodeTag) /= primeFrom;
-  nodesArray[i] = nodePtr;
-        // opserr << "DomainPartitioner::swapVertex -NODE " << *nodePtr;
-  // add back as external if still needed
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
-
-    // 5. add new elements to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
 
-    const ID &eleAdjacent = vertexPtr->getAdjacency();
-    int eleAdjacentSize = eleAdjacent.Size();
+  return this->moveElement(vertexPtr, from, to);
+}
 
-    for (int a=0; a<eleAdjacentSize; a++) {
-	int otherEleVertexTag = eleAdjacent(a);
-	Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	if (other == 0) {
-	    other = theElementGraph->getVertexPtr(otherEleVertexTag);
-	    if (other->getColor() == from)
-		fromBoundary->addVertex(other,false);
-	}
-    }
 
+// method to move from from to to, all elements on the interface of 
+// from that are adjacent with to.
 
-    
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-    int primeTo = primes(to);
-    for (int l=0; l<nodesSize; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  int nodeColor = (*nodePlace)(nodeTag);
-  if (nodeColor % primeTo == 0) {
-      Node *nodePtr;
-      nodePtr = toSubdomain->removeNode(nodes(l));
+int 
+DomainPartitioner::swapBoundary(int from, int to, bool adjacentVertexNotInOther)
+{
+  // check that the object did the partitioning
+  if (partitionFlag == false) {
+    opserr << "DomainPartitioner::swapBoundary()";
+    opserr << " - not partitioned or DomainPartitioner did not partition\n";
+    return -1;
   }
-    }
 
-
-    for (int m=0; m<nodesSize; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  2. mark all connecting nodes of elements as belonging to To      
-  (*nodePlace)(nodeTag) *= primeTo;
-
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
-      }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
+  if (from < 1 || from > numPartitions) {
+    opserr << "DomainPartitioner::swapBoundary - No from Subdomain: ";
+    opserr << from << " exists\n";
+    return -2;
   }
-    }
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the element
-    
-    toSubdomain->addElement(elePtr);
-    
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-
-    vertexPtr->setColor(to);
-    toBoundary->addVertex(vertexPtr,false);
-
-    for (int n=0; n<eleAdjacentSize; n++) {
-	int otherEleVertexTag = eleAdjacent(n);
-	Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	if (other != 0) {
-	    const ID &othersAdjacency = other->getAdjacency();
-	    int otherSize = othersAdjacency.Size();
-	    for (int b=0; b<otherSize; b++) {
-		int anotherEleVertexTag = othersAdjacency(b);
-		Vertex *otherOther = theElementGraph->getVertexPtr(anotherEleVertexTag);
-		if (otherOther->getColor() != to) {
-		    toBoundary->addVertex(other,false);
-		    b=otherSize;
-		}
-	    }
-	}
-    }
 
+  // into a new graph place the vertices on the fromBoundary adjacent to to,
+  // we cannot use fromBoundary as it changes as vertices are moved
+  Graph *fromBoundary = theBoundaryElements[from-1];
+  Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+  VertexIter &theVertices = fromBoundary->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0) {
+    const ID &adjacent = vertexPtr->getAdjacency();
+    int adjacentSize = adjacent.Size();
+    for (int i=0; i<adjacentSize; i++) {
+      Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
+      if (other->getColor() == to) {
+	swapVertices->addVertex(vertexPtr, false);
+	i = adjacentSize;
       }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeSP_Constraint(spPtr->getTag());
-        toSubdomain->addSP_Constraint(spPtr);
     }
-      }
   }
-    }
 
-    
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeSP_Constraint(spPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) 
-        toSubdomain->addSP_Constraint(spPtr);
-    else
-        myDomain->addSP_Constraint(spPtr);
-      }
-  }
-    }
+  VertexIter &verticesToSwap = swapVertices->getVertices();
+  while ((vertexPtr = verticesToSwap()) != 0)
+    this->swapVertex(from, to, vertexPtr->getTag(), adjacentVertexNotInOther);
 
+  emptyGraph(*swapVertices);
+  delete swapVertices;
 
+  return 0;
+}
 
-  */
-    /*
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeNodalLoad(loadPtr->getTag());
-        toSubdomain->addNodalLoad(loadPtr);
-    }
-      }
-  }
-    }
 
+int
+DomainPartitioner::weighElements(void)
+{
+  if (partitionFlag == false || theElementLocations == 0)
+    return -1;
 
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeNodalLoad(loadPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+  // set the weight of each element vertex to the time the element took
+  // in its subdomain since the last call, elements not measured keep
+  // the weight they had
+  ID eleTags(1);
+  Vector eleCosts(1);
+  SubdomainIter &theSubdomains = myDomain->getSubdomains();
+  Subdomain *theSub;
+  while ((theSub = theSubdomains()) != 0) {
+    int numEle = theSub->getElementCosts(eleTags, eleCosts);
+    for (int i=0; i<numEle; i++) {
+      TaggedObject *theObject = theElementLocations->getComponentPtr(eleTags(i));
+      if (theObject != 0) {
+	ElementLocation *theLocation = (ElementLocation *)theObject;
+	Vertex *vertexPtr = theElementGraph->getVertexPtr(theLocation->vertexTag);
+	if (vertexPtr != 0)
+	  vertexPtr->setWeight(eleCosts(i));
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addNodalLoad(loadPtr);
-    else
-        myDomain->addNodalLoad(loadPtr);
-      }  
-  }
     }
-    */
-
-    return 0;
+  }
 
+  return 0;
 }
 
 
+int
+DomainPartitioner::repartition(void)
+{
+  // check that the object did the partitioning
+  if (partitionFlag == false) {
+    opserr << "DomainPartitioner::repartition()";
+    opserr << " - not partitioned or DomainPartitioner did not partition\n";
+    return -1;
+  }
 
-// method to move from from to to, all elements on the interface of 
-// from that are adjacent with to.
+  // keep the current partition of each vertex as the graph partitioner
+  // will overwrite the colors
+  int numVertex = theElementGraph->getNumVertex();
+  ID oldColors(numVertex);
+  for (int i=0; i<numVertex; i++) {
+    Vertex *vertexPtr = theElementGraph->getVertexPtr(i+START_VERTEX_NUM);
+    oldColors(i) = vertexPtr->getColor();
+  }
 
-int 
-DomainPartitioner::swapBoundary(int from, int to, bool adjacentVertexNotInOther)
-          
-{
-  opserr << "DomainPartitioner::swapBoundary: from "  << from << " to " << to << endln;
-  /***********************************************************************************
-    opserr << "DomainPartitioner::swapBoundary from " << from << "  to " << to << endln;
-    Timer timer;
-    timer.start();
+  // partition the element graph again, now weighted by the measured costs
+  int theError = thePartitioner.partition(*theElementGraph, numPartitions);
+  if (theError < 0) {
+    opserr << "DomainPartitioner::repartition";
+    opserr << " - the graph partitioner failed to partition the element graph\n";
+    for (int i=0; i<numVertex; i++)
+      theElementGraph->getVertexPtr(i+START_VERTEX_NUM)->setColor(oldColors(i));
+    return -10+theError;
+  }
 
-    // check that the object did the partitioning
-    if (partitionFlag == false) {
-  opserr << "DomainPartitioner::balance(const Vector &load)";
-  opserr << " - not partitioned or DomainPartitioner did not partition\n";
-  return -1;
-    }
+  // the new partitions are numbered arbitrarily, so each is matched to the
+  // old partition it shares most weight with; greedily the largest shared
+  // weight first, so that as few elements as possible have to move
+  Matrix shared(numPartitions, numPartitions);
+  for (int i=0; i<numVertex; i++) {
+    Vertex *vertexPtr = theElementGraph->getVertexPtr(i+START_VERTEX_NUM);
+    shared(vertexPtr->getColor()-1, oldColors(i)-1) += 1.0 + vertexPtr->getWeight();
+  }
 
-    // check that the subdomains exist in partitioned domain
-    Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
-    if (fromSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No from Subdomain: ";
-  opserr << from << " exists\n";
-  return -2;
+  ID newToOld(numPartitions);
+  ID oldUsed(numPartitions);
+  newToOld.Zero();
+  oldUsed.Zero();
+  for (int k=0; k<numPartitions; k++) {
+    int maxNew = -1;
+    int maxOld = -1;
+    double maxShared = -1.0;
+    for (int i=0; i<numPartitions; i++) {
+      if (newToOld(i) != 0)
+	continue;
+      for (int j=0; j<numPartitions; j++)
+	if (oldUsed(j) == 0 && shared(i,j) > maxShared) {
+	  maxShared = shared(i,j);
+	  maxNew = i;
+	  maxOld = j;
+	}
     }
+    newToOld(maxNew) = maxOld+1;
+    oldUsed(maxOld) = 1;
+  }
 
-    Subdomain *toSubdomain = myDomain->getSubdomainPtr(to);
-    if (toSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No to Subdomain: ";
-  opserr << to << " exists\n";
-  return -3;
-    }    
+  // restore the old colors, keeping the new partition in tmp, and move the
+  // elements whose partition changed one at a time
+  for (int i=0; i<numVertex; i++) {
+    Vertex *vertexPtr = theElementGraph->getVertexPtr(i+START_VERTEX_NUM);
+    vertexPtr->setTmp(newToOld(vertexPtr->getColor()-1));
+    vertexPtr->setColor(oldColors(i));
+  }
 
-    // get the element graph
-    //    Graph &theEleGraph = myDomain->getElementGraph();    
-    Graph *fromBoundary = theBoundaryElements[from-1];
-    Graph *toBoundary = theBoundaryElements[to-1];
+  int numMovedBefore = numMoved;
+  for (int i=0; i<numVertex; i++) {
+    Vertex *vertexPtr = theElementGraph->getVertexPtr(i+START_VERTEX_NUM);
+    int from = vertexPtr->getColor();
+    int to = vertexPtr->getTmp();
+    if (from != to) 
+      this->moveElement(vertexPtr, from, to);
+  }
 
-    // into a new graph place the vertices that are to be swapped
-    Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
+  return numMoved - numMovedBefore;
+}
 
-    VertexIter &swappableVertices = fromBoundary->getVertices();
-    Vertex *vertexPtr;
 
-    while ((vertexPtr = swappableVertices()) != 0) {
-	if (adjacentVertexNotInOther == false) {   
-	    const ID &adjacency=vertexPtr->getAdjacency();
-	    int size = adjacency.Size();
-	    for (int i=0; i<size; i++) {
-		int otherTag = adjacency(i);
-		Vertex *otherVertex = toBoundary->getVertexPtr(otherTag);
-		if (otherVertex != 0) {
-		    swapVertices->addVertex(vertexPtr,false);
-		    i = size;
-		}
-	    }
-	}
-	else {
-	    const ID &adjacent = vertexPtr->getAdjacency();
-	    bool inTo = false;
-	    bool inOther = false;
-	    int adjacentSize = adjacent.Size();
-	    for (int i=0; i<adjacentSize; i++) {
-		Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-		if (other->getColor() == to) 
-		    inTo = true;
-		else if (other->getColor() != from) {
-		    inOther = true;
-		    i = adjacentSize;
-		}
-	    }
-	    if (inTo == true && inOther == false) { // we remove the vertex
-		swapVertices->addVertex(vertexPtr,false);
-		vertexPtr->setColor(to);
-	    }
-	}
-    }
+int
+DomainPartitioner::moveElement(Vertex *vertexPtr, int from, int to)
+{
+  int eleTag = vertexPtr->getRef();
+  int vertexTag = vertexPtr->getTag();
 
-    //
-    // in the FROM subdomain we:
-    //  1. remove the elements corresponding to the vertices
-    //  2. remove all nodes connected to the elements divide color by prime
-    //  3. see if have to add nodes back as external
-    //  4. remove from the PartitionedDomain if node was external
-    //  5. add new elements to the boundary vertices for from
+  // elements in the main domain are not moved
+  if (usingMainDomain == true && (from == mainPartition || to == mainPartition))
+    return -5;
 
-    // 1. first remove all the elements from from subdomain
-    VertexIter &verticesToSwap = swapVertices->getVertices();
+  TaggedObject *theObject = theElementLocations->getComponentPtr(eleTag);
+  if (theObject == 0)
+    return -5;
 
-    int numEleToSwap = swapVertices->getNumVertex();
-    Element **elementsArray = new Element *[numEleToSwap];
+  ElementLocation *theEleLocation = (ElementLocation *)theObject;
+  if (theEleLocation->canMove == false)
+    return -5;
 
-    int count =0; 
-    int numCannotRemove =0;
-    for (int i=0; i<numEleToSwap; i++) {
-      vertexPtr = verticesToSwap();
-  if (vertexPtr == 0) 
-      return -1;
+  Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
+  Subdomain *toSubdomain = myDomain->getSubdomainPtr(to);
+  if (fromSubdomain == 0 || toSubdomain == 0)
+    return -2;
 
-  int vertexTag = vertexPtr->getTag();
-  int eleTag = vertexPtr->getRef();
+  //
+  // determine the partitions each node of the element will be in after
+  // the move, and the elements that must leave their subdomain while one
+  // of their nodes changes between internal and external
+  //
 
-  // remove the vertex from fromBoundary, set color to to
-  // and add to toBoundary
-  bool inFrom = true;
-  vertexPtr = fromBoundary->removeVertex(vertexTag,false);
+  const ID &nodes = theEleLocation->nodes;
+  int numNodes = nodes.Size();
+  NodeLocations **theLocations = new NodeLocations *[numNodes];
+  ID **newPartitions = new ID *[numNodes];
+  ID reseatVertices(0, 8);
+  int numReseat = 0;
+  bool canMove = true;
+
+  for (int i=0; i<numNodes; i++) {
+    NodeLocations *theLocation = (NodeLocations *)theNodeLocations->getComponentPtr(nodes(i));
+    theLocations[i] = theLocation;
+    newPartitions[i] = 0;
+    if (theLocation == 0) {
+      canMove = false;
+      continue;
+    }
 
+    ID &oldPartitions = theLocation->nodePartitions;
+    int numOld = theLocation->numPartitions;
 
-  if (inFrom == true) {
-      vertexPtr->setColor(to);
-      toBoundary->addVertex(vertexPtr,false);
-      Element *elePtr = fromSubdomain->removeElement(eleTag);
-      if (elePtr == 0) // if ele not there we can just return IT SHOULD BE
-    return -4;
-      elementsArray[count] = elePtr;
-      count++;
-  }
-  else  // we cannot remove the element
-      numCannotRemove++;
-    }
-    numEleToSwap -= numCannotRemove;
-
-    //  2. remove all nodes connected to the elements divide color by prime    
-    //     for each element and add back if still in subdomain
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-
-    // first determine which nodes to remove
-    int primeFrom = primes(from);
-    int primeTo = primes(to);
-    int numNodToSwap = 0;
-    ID nodesToRemove(0,128);
-    for (int j=0; j<numEleToSwap; j++) {
-  Element *elePtr = elementsArray[j];
-  const ID  &nodes = elePtr->getExternalNodes(); 
-  
-  int nodesSize = nodes.Size();
-
-  for (int k=0; k<nodesSize; k++) {
-      int nodeTag = nodes(k);
-      int loc = nodesToRemove.getLocation(nodeTag);
-      if (loc < 0) {
-    nodesToRemove[numNodToSwap] = nodeTag;
-    numNodToSwap++;
+    bool stillInFrom = false;
+    for (int j=0; j<theLocation->numVertices; j++) {
+      int otherTag = theLocation->nodeVertices(j);
+      if (otherTag != vertexTag && 
+	  theElementGraph->getVertexPtr(otherTag)->getColor() == from) {
+	stillInFrom = true;
+	j = theLocation->numVertices;
       }
-      (*nodePlace)(nodeTag) /= primeFrom;    
-      (*nodePlace)(nodeTag) *= primeTo;        
-  }
     }
 
-    // remove the nodes
-    Node **nodesArray = new Node *[numNodToSwap];  
-    for (int k=0; k<numNodToSwap; k++) {
-  int nodeTag = nodesToRemove(k); 
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-  nodesArray[k] = nodePtr;
-
-  // add the node back to from if still external
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
+    ID *newP = new ID(0, numOld+1);
+    int numNew = 0;
+    for (int j=0; j<numOld; j++)
+      if (oldPartitions(j) != from || stillInFrom == true)
+	if (newP->insert(oldPartitions(j)) != 1)
+	  numNew++;
+    if (newP->insert(to) != 1)
+      numNew++;
+    newPartitions[i] = newP;
+
+    bool changed = (numNew != numOld);
+    for (int j=0; j<numNew && changed == false; j++)
+      if (oldPartitions.getLocation((*newP)(j)) < 0)
+	changed = true;
+
+    if (changed == false)
+      continue;
+
+    // nodes with MP_Constraints, or SP_Constraints in a LoadPattern, are
+    // in the same subdomains for good; those with loads in a LoadPattern
+    // must not change between internal and external
+    if (theLocation->pinned == 2 ||
+	(theLocation->pinned == 1 && (numOld == 1 || numNew == 1))) {
+      canMove = false;
+      continue;
     }
+
+    // the node changes from internal to external in from or from
+    // external to internal in to, the elements there connected to it 
+    // have to be removed and added back as the node object is replaced
+    int reseatPartition = 0;
+    if (numOld == 1 && numNew > 1 && stillInFrom == true)
+      reseatPartition = from;
+    else if (numOld > 1 && numNew == 1)
+      reseatPartition = to;
+
+    if (reseatPartition != 0) {
+      for (int j=0; j<theLocation->numVertices; j++) {
+	int otherTag = theLocation->nodeVertices(j);
+	if (otherTag != vertexTag && 
+	    theElementGraph->getVertexPtr(otherTag)->getColor() == reseatPartition)
+	  if (reseatVertices.insert(otherTag) != 1)
+	    numReseat++;
       }
     }
+  }
 
-    // 5. add new vertices to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    VertexIter &verticesToSwap2 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap2()) != 0) {
-  const ID &vertexAdjacent = vertexPtr->getAdjacency();
-  int vertexAdjacentSize = vertexAdjacent.Size();
-
-	for (int a=0; a<vertexAdjacentSize; a++) {
-	    int otherEleVertexTag = vertexAdjacent(a);
-	    Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	    if (other == 0) {
-		other = theElementGraph->getVertexPtr(otherEleVertexTag);
-		if (other->getColor() == from)
-		    fromBoundary->addVertex(other,false);
-	    }
-	}	
-    }
+  // the elements to be reseated must themselves be movable, as they
+  // are sent through the same channels
+  for (int k=0; k<numReseat && canMove == true; k++) {
+    Vertex *otherVertex = theElementGraph->getVertexPtr(reseatVertices(k));
+    TaggedObject *otherObject = theElementLocations->getComponentPtr(otherVertex->getRef());
+    if (otherObject == 0 || ((ElementLocation *)otherObject)->canMove == false)
+      canMove = false;
+  }
 
+  if (canMove == false) {
+    for (int i=0; i<numNodes; i++)
+      if (newPartitions[i] != 0)
+	delete newPartitions[i];
+    delete [] newPartitions;
+    delete [] theLocations;
+    return -5;
+  }
 
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
+  //
+  // now do the move, the elements and nodes carry their committed state
+  // with them so this is done right after a commit
+  //
 
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
+  Element *elePtr = fromSubdomain->removeElement(eleTag);
+  if (elePtr == 0) {
+    opserr << "DomainPartitioner::moveElement - element " << eleTag;
+    opserr << " not in subdomain " << from << endln;
+    for (int i=0; i<numNodes; i++)
+      if (newPartitions[i] != 0)
+	delete newPartitions[i];
+    delete [] newPartitions;
+    delete [] theLocations;
+    return -6;
+  }
 
-    for (int l=0; l<numNodToSwap; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  Node *nodePtr;
-  nodePtr = toSubdomain->removeNode(nodesToRemove(l));
+  Element **reseatElements = 0;
+  if (numReseat != 0) {
+    reseatElements = new Element *[numReseat];
+    for (int k=0; k<numReseat; k++) {
+      Vertex *otherVertex = theElementGraph->getVertexPtr(reseatVertices(k));
+      Subdomain *theSub = myDomain->getSubdomainPtr(otherVertex->getColor());
+      reseatElements[k] = theSub->removeElement(otherVertex->getRef());
     }
+  }
 
+  for (int i=0; i<numNodes; i++) {
+    this->moveNode(*theLocations[i], *newPartitions[i]);
+    delete newPartitions[i];
+  }
+  delete [] newPartitions;
+  delete [] theLocations;
 
-    for (int m=0; m<numNodToSwap; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
-      }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
+  toSubdomain->addElement(elePtr);
+
+  for (int k=0; k<numReseat; k++) {
+    Vertex *otherVertex = theElementGraph->getVertexPtr(reseatVertices(k));
+    Subdomain *theSub = myDomain->getSubdomainPtr(otherVertex->getColor());
+    if (reseatElements[k] != 0)
+      theSub->addElement(reseatElements[k]);
   }
-    }
+  if (reseatElements != 0)
+    delete [] reseatElements;
 
+  //
+  // finally change the vertex color and the boundaries of from and to
+  //
 
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the elements
-    for (int a=0; a<numEleToSwap; a++)
-  toSubdomain->addElement(elementsArray[a]);
-
-
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-    VertexIter &verticesToSwap3 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap3()) != 0) {
-	const ID &vertexAdjacent = vertexPtr->getAdjacency();
-	int vertexAdjacentSize = vertexAdjacent.Size();
-	for (int n=0; n<vertexAdjacentSize; n++) {
-	    int otherEleVertexTag = vertexAdjacent(n);
-	    Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	    if (other != 0) {
-		const ID &othersAdjacency = other->getAdjacency();
-		int otherSize = othersAdjacency.Size();
-		for (int b=0; b<otherSize; b++) {
-		    int anotherEleVertexTag = othersAdjacency(b);
-		    Vertex *otherOther 
-			= theElementGraph->getVertexPtr(anotherEleVertexTag);
-		    if (otherOther->getColor() != to) {
-			toBoundary->addVertex(other,false);
-			b=otherSize;
-		    }
-		}
-	    }
-	}
+  vertexPtr->setColor(to);
+
+  Graph *fromBoundary = theBoundaryElements[from-1];
+  Graph *toBoundary = theBoundaryElements[to-1];
+  fromBoundary->removeVertex(vertexTag, false);
+  toBoundary->addVertex(vertexPtr, false);
+
+  const ID &adjacent = vertexPtr->getAdjacency();
+  int adjacentSize = adjacent.Size();
+  for (int a=0; a<adjacentSize; a++) {
+    Vertex *other = theElementGraph->getVertexPtr(adjacent(a));
+    int otherColor = other->getColor();
+
+    // neighbours left in from are now on its boundary, if not already
+    if (otherColor == from) {
+      if (fromBoundary->getVertexPtr(other->getTag()) == 0)
+	fromBoundary->addVertex(other, false);
     }
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
+    // neighbours in to may no longer be on its boundary
+    else if (otherColor == to) {
+      const ID &othersAdjacency = other->getAdjacency();
+      int otherSize = othersAdjacency.Size();
+      bool onBoundary = false;
+      for (int b=0; b<otherSize && onBoundary == false; b++)
+	if (theElementGraph->getVertexPtr(othersAdjacency(b))->getColor() != to)
+	  onBoundary = true;
+      if (onBoundary == false)
+	toBoundary->removeVertex(other->getTag(), false);
     }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeSP_Constraint(spPtr->getTag());
-    toSubdomain->addSP_Constraint(spPtr);
-      }
   }
-    }
 
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeSP_Constraint(spPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addSP_Constraint(spPtr);
-      else
-    myDomain->addSP_Constraint(spPtr);
-  }  
-    }
+  numMoved++;
 
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeNodalLoad(loadPtr->getTag());
-    toSubdomain->addNodalLoad(loadPtr);
+  return 0;
+}
+
+
+int
+DomainPartitioner::moveNode(NodeLocations &theLocation, const ID &newPartitions)
+{
+  int nodeTag = theLocation.getTag();
+  ID &oldPartitions = theLocation.nodePartitions;
+  int numOld = theLocation.numPartitions;
+  int numNew = newPartitions.Size();
+
+  int numSPs = theLocation.numSPs;
+  SP_Constraint **theSPs = 0;
+  if (numSPs != 0)
+    theSPs = new SP_Constraint *[numSPs];
+
+  // get the node, with its state, and its SP_Constraints; only the Domain
+  // methods of the PartitionedDomain are used as those of the 
+  // PartitionedDomain also add and remove from the subdomains
+  Node *theNode = 0;
+  if (numOld == 1) {
+    Subdomain *theSub = myDomain->getSubdomainPtr(oldPartitions(0));
+    theNode = theSub->removeNode(nodeTag);
+    for (int i=0; i<numSPs; i++)
+      theSPs[i] = theSub->removeSP_Constraint(theLocation.nodeSPs(i));
+  } else {
+    for (int i=0; i<numSPs; i++)
+      theSPs[i] = myDomain->Domain::getSP_Constraint(theLocation.nodeSPs(i));
+
+    // remove the external node from the subdomains it leaves, or from all
+    // of them if it becomes internal; the subdomains hold copies
+    for (int j=0; j<numOld; j++) {
+      int partition = oldPartitions(j);
+      if (numNew == 1 || newPartitions.getLocation(partition) < 0) {
+	Subdomain *theSub = myDomain->getSubdomainPtr(partition);
+	Node *theCopy = theSub->removeNode(nodeTag);
+	if (theCopy != 0)
+	  delete theCopy;
+	for (int i=0; i<numSPs; i++)
+	  theSub->removeSP_Constraint(theLocation.nodeSPs(i));
       }
-  }
     }
 
+    if (numNew == 1) {
+      theNode = myDomain->Domain::removeNode(nodeTag);
+      for (int i=0; i<numSPs; i++)
+	myDomain->Domain::removeSP_Constraint(theLocation.nodeSPs(i));
+    } else 
+      theNode = myDomain->getNode(nodeTag);
+  }
 
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeNodalLoad(loadPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
+  if (theNode == 0) {
+    opserr << "DomainPartitioner::moveNode - node " << nodeTag << " lost -- A BUG!!\n";
+    if (theSPs != 0)
+      delete [] theSPs;
+    return -1;
+  }
+
+  if (numNew == 1) {
+    Subdomain *theSub = myDomain->getSubdomainPtr(newPartitions(0));
+    theSub->addNode(theNode);
+    for (int i=0; i<numSPs; i++)
+      if (theSPs[i] != 0)
+	theSub->addSP_Constraint(theSPs[i]);
+  } else {
+    if (numOld == 1) {
+      myDomain->Domain::addNode(theNode);
+      for (int i=0; i<numSPs; i++)
+	if (theSPs[i] != 0)
+	  myDomain->Domain::addSP_Constraint(theSPs[i]);
     }
-      if (internal == 0) 
-    toSubdomain->addNodalLoad(loadPtr);
-      else
-    myDomain->addNodalLoad(loadPtr);
-  }  
+    for (int j=0; j<numNew; j++) {
+      int partition = newPartitions(j);
+      if (numOld == 1 || oldPartitions.getLocation(partition) < 0) {
+	Subdomain *theSub = myDomain->getSubdomainPtr(partition);
+	theSub->addExternalNode(theNode);
+	for (int i=0; i<numSPs; i++)
+	  if (theSPs[i] != 0)
+	    theSub->addSP_Constraint(theSPs[i]);
+      }
     }
+  }
 
+  if (theSPs != 0)
+    delete [] theSPs;
 
-    delete swapVertices;
-
-    timer.pause();
-    opserr << "DomainPartitioner::swapBoundary DONE" << timer.getReal() << endln;
+  theLocation.nodePartitions = newPartitions;
+  theLocation.numPartitions = numNew;
 
-  ***************************************************************************/
-    return 0;
+  return 0;
 }
 
 
@@ -46,6 +46,8 @@ class PartitionedDomain;
 class Vector;
 class Graph;
 class TaggedObjectStorage;
+class Vertex;
+class NodeLocations;
 
 class DomainPartitioner
 {
@@ -61,6 +63,7 @@ class DomainPartitioner
     virtual int partition(int numParts, bool useMainDomain = false, int mainPartition = 0, int specialElementTag = 0);
 
     virtual int balance(Graph &theWeightedSubdomainGraph);
+    virtual bool hasLoadBalancer(void) const;
 
     // public member functions needed by the load balancer
     virtual int getNumPartitions(void) const;
@@ -88,10 +91,19 @@ class DomainPartitioner
 			       bool mustReleaseToLighter = true,
 			       double factorGreater = 1.0,
 			       bool adjacentVertexNotInOther = true);
+
+    // weigh the element graph by the measured cost of the elements and
+    // partition it again, moving the elements whose partition changed
+    virtual int weighElements(void);
+    virtual int repartition(void);
+    virtual int getNumElementsMoved(void) const;
 				 
   protected:    
     
   private:
+    int moveElement(Vertex *theVertex, int from, int to);
+    int moveNode(NodeLocations &theLocation, const ID &newPartitions);
+
     PartitionedDomain *myDomain; 
     GraphPartitioner  &thePartitioner;
     LoadBalancer      *theBalancer;    
@@ -100,6 +112,7 @@ class DomainPartitioner
     Graph **theBoundaryElements; 
     
     TaggedObjectStorage *theNodeLocations;
+    TaggedObjectStorage *theElementLocations;
     ID *elementPlace;
     int numPartitions;
     ID primes;
@@ -107,6 +120,7 @@ class DomainPartitioner
     
     bool usingMainDomain;
     int mainPartition;
+    int numMoved;       // elements moved in the current balance()
 };
 
 #endif
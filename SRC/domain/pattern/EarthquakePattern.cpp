@@ -34,6 +34,8 @@
 #include <Domain.h>
 #include <NodeIter.h>
 #include <Node.h>
+#include <Vector.h>
+#include <Matrix.h>
 #include <ElementIter.h>
 #include <Element.h>
 #include <stdlib.h>
@@ -44,7 +46,9 @@
 #include <stdlib.h>
 
 EarthquakePattern::EarthquakePattern(int tag, int _classTag)
-  :LoadPattern(tag, _classTag), theMotions(0), numMotions(0), uDotG(0), uDotDotG(0), currentTime(0.0), parameterID(0)
+  :LoadPattern(tag, _classTag), theMotions(0), numMotions(0), uDotG(0), uDotDotG(0), currentTime(0.0),
+   theInertiaNodes(0), theInertiaMR(0), numInertiaNodes(0), inertiaDomainStamp(-1), inertiaMassStamp(-1),
+   inertiaCrdStamp(-1), parameterID(0)
 {
 
 }
@@ -65,6 +69,12 @@ EarthquakePattern::~EarthquakePattern()
 
   if (uDotDotG != 0)
     delete uDotDotG;
+
+  if (theInertiaNodes != 0)
+    delete [] theInertiaNodes;
+
+  if (theInertiaMR != 0)
+    delete [] theInertiaMR;
 }
 
 
@@ -91,17 +101,97 @@ EarthquakePattern::applyLoad(double time)
     (*uDotDotG)(i) = theMotions[i]->getAccel(currentTime);
   }
 
-  NodeIter &theNodes = theDomain->getNodes();
-  Node *theNode;
-  while ((theNode = theNodes()) != 0) 
-    theNode->addInertiaLoadToUnbalance(*uDotDotG, 1.0);
-  
+  // form M*R again only if the domain, a nodal mass or a nodal coordinate
+  // (which enters R for the rotational dofs) has changed
+  int domainStamp = theDomain->hasDomainChanged();
+  int massStamp = theDomain->getMassChangeStamp();
+  int crdStamp = theDomain->getCrdChangeStamp();
+  if (domainStamp != inertiaDomainStamp || massStamp != inertiaMassStamp ||
+      crdStamp != inertiaCrdStamp) {
+    if (this->formInertiaLoads(theDomain) < 0)
+      return;
+    inertiaDomainStamp = domainStamp;
+    inertiaMassStamp = massStamp;
+    inertiaCrdStamp = crdStamp;
+  }
+
+  // add - M*R*accelG to the unbalanced load of the nodes
+  const double *MR = theInertiaMR;
+  for (int i=0; i<numInertiaNodes; i++) {
+    Node *theNode = theInertiaNodes[i];
+    int numDOF = theNode->getNumberDOF();
+    for (int j=0; j<numMotions; j++) {
+      Vector theLoad((double *)MR, numDOF);
+      theNode->addUnbalancedLoad(theLoad, -(*uDotDotG)(j));
+      MR += numDOF;
+    }
+  }
 
   ElementIter &theElements = theDomain->getElements();
   Element *theElement;
   while ((theElement = theElements()) != 0) 
     theElement->addInertiaLoadToUnbalance(*uDotDotG);
 }
+
+
+int
+EarthquakePattern::formInertiaLoads(Domain *theDomain)
+{
+  if (theInertiaNodes != 0)
+    delete [] theInertiaNodes;
+  if (theInertiaMR != 0)
+    delete [] theInertiaMR;
+  theInertiaNodes = 0;
+  theInertiaMR = 0;
+  numInertiaNodes = 0;
+
+  // count the space needed
+  int numNodes = 0;
+  int sizeMR = 0;
+  NodeIter &theNodes = theDomain->getNodes();
+  Node *theNode;
+  while ((theNode = theNodes()) != 0) {
+    numNodes++;
+    sizeMR += theNode->getNumberDOF()*numMotions;
+  }
+
+  if (numNodes == 0)
+    return 0;
+
+  theInertiaNodes = new Node *[numNodes];
+  theInertiaMR = new double[sizeMR];
+  if (theInertiaNodes == 0 || theInertiaMR == 0) {
+    opserr << "EarthquakePattern::formInertiaLoads - out of memory\n";
+    return -1;
+  }
+
+  // column j of M*R is M*(R*e_j); only nodes for which it is non-zero
+  // are kept, those without mass or excitation are skipped each step
+  Vector e(numMotions);
+  double *MR = theInertiaMR;
+  NodeIter &theNodes2 = theDomain->getNodes();
+  while ((theNode = theNodes2()) != 0) {
+    int numDOF = theNode->getNumberDOF();
+    const Matrix &mass = theNode->getMass();
+    bool nonZero = false;
+    for (int j=0; j<numMotions; j++) {
+      e.Zero();
+      e(j) = 1.0;
+      const Vector &Rj = theNode->getRV(e);
+      Vector MRj(&MR[j*numDOF], numDOF);
+      MRj.addMatrixVector(0.0, mass, Rj, 1.0);
+      for (int k=0; k<numDOF; k++)
+	if (MRj(k) != 0.0)
+	  nonZero = true;
+    }
+    if (nonZero == true) {
+      theInertiaNodes[numInertiaNodes++] = theNode;
+      MR += numDOF*numMotions;
+    }
+  }
+
+  return 0;
+}
     
 void 
 EarthquakePattern::applyLoadSensitivity(double time)
@@ -179,6 +269,9 @@ EarthquakePattern::addMotion(GroundMotion &theMotion)
     delete uDotDotG;
   uDotDotG = new Vector(numMotions);
 
+  // M*R has a column for each motion
+  inertiaDomainStamp = -1;
+
   if (uDotDotG == 0 || uDotDotG->Size() == 0 || uDotG == 0 || uDotG->Size() == 0) {
     opserr << "EarthquakePattern::addMotion - ran out of memory creating vectors\n";
     numMotions = 0;
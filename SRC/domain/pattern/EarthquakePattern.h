@@ -38,6 +38,8 @@
 
 class GroundMotion;
 class Vector;
+class Node;
+class Domain;
 
 class EarthquakePattern : public LoadPattern
 {
@@ -72,9 +74,21 @@ class EarthquakePattern : public LoadPattern
     int numMotions;
 
   private:
+    int formInertiaLoads(Domain *theDomain);
+
     Vector *uDotG, *uDotDotG;
     double currentTime;
 
+    // M*R of the nodes with an inertia load, numDOF x numMotions for
+    // each node stored by column, formed again only when the domain,
+    // a nodal mass or a nodal coordinate has changed
+    Node **theInertiaNodes;
+    double *theInertiaMR;
+    int numInertiaNodes;
+    int inertiaDomainStamp;
+    int inertiaMassStamp;
+    int inertiaCrdStamp;
+
 // AddingSensitivity:BEGIN //////////////////////////////////////////
     int parameterID;
 // AddingSensitivity:END ///////////////////////////////////////////
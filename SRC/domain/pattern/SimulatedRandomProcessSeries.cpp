@@ -34,6 +34,7 @@
 
 #include <SimulatedRandomProcessSeries.h>
 #include <Vector.h>
+#include <Matrix.h>
 #include <Channel.h>
 #include <Spectrum.h>
 #include <RandomNumberGenerator.h>
@@ -54,17 +55,24 @@ SimulatedRandomProcessSeries::SimulatedRandomProcessSeries(int tag,
 	mean = pmean;
 
 	
-	// Generate random numbers, uniformly distributed between 0 and 2pi
+	// Generate the phase angles and amplitudes together, as one sample of
+	// 2*numFreqIntervals uniform numbers
 	double pi = 3.14159265358979;
-	theRandomNumberGenerator->generate_nIndependentUniformNumbers(numFreqIntervals,0.0,(2*pi));
-	Vector theta1 = theRandomNumberGenerator->getGeneratedNumbers();
-	theta = new Vector(theta1);
-	
-
-	// Generate standard normal random numbers
-	theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numFreqIntervals);
-	Vector A1 = theRandomNumberGenerator->getGeneratedNumbers();
-	A = new Vector(A1);
+	Matrix u(2*numFreqIntervals, 1);
+	theRandomNumberGenerator->generate_nSamplesUniformNumbers(1, 2*numFreqIntervals, u);
+
+	// phase angles uniformly distributed between 0 and 2pi
+	theta = new Vector(numFreqIntervals);
+	for (int i=0; i<numFreqIntervals; i++)
+		(*theta)(i) = 2*pi*u(i,0);
+
+	// standard normal amplitudes
+	A = new Vector(numFreqIntervals);
+	if (numFreqIntervals > 0) {
+		RandomNumberGenerator::transformUniformToStdNormal(&u(numFreqIntervals,0), numFreqIntervals);
+		for (int i=0; i<numFreqIntervals; i++)
+			(*A)(i) = u(numFreqIntervals+i,0);
+	}
 
 
 	// Length of each interval
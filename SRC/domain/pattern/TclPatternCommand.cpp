@@ -65,6 +65,7 @@
 #include <DRMInputHandler.h>
 #include <PlaneDRMInputHandler.h>
 #include <DRMLoadPatternWrapper.h>
+#include <DRMBinaryInput.h>
 
 #include <string.h>
 
@@ -540,7 +541,11 @@ TclPatternCommand(ClientData clientData, Tcl_Interp *interp,
       
       int nf =6;
       char** files = new char*[nf];
+      for (int i=0; i<5; i++)
+	files[i] = 0;
       files[5] = "./NONE";
+      TCL_Char * binaryFileName = 0;
+      bool writeBinary = false;
       int* f_d = new int[15];
       int num_steps=1;
       int steps_cached=10;
@@ -720,6 +725,15 @@ TclPatternCommand(ClientData clientData, Tcl_Interp *interp,
 	  c_arg++;
 	}
 	
+	// one binary file in place of the text files, or the text files
+	// converted to a binary file before the analysis
+	else if ((strcmp(argv[c_arg],"-binaryFile") == 0) || (strcmp(argv[c_arg],"-writeBinary") == 0) ) {
+	  writeBinary = (strcmp(argv[c_arg],"-writeBinary") == 0);
+	  c_arg++;
+	  binaryFileName = argv[c_arg];
+	  c_arg++;
+	}
+	
 	else if ((strcmp(argv[c_arg],"-fileFace5aGridPoints") == 0) ) {
 	  c_arg++;	
 	  if (Tcl_GetInt(interp,argv[c_arg], &n1) != TCL_OK) {
@@ -783,6 +797,23 @@ TclPatternCommand(ClientData clientData, Tcl_Interp *interp,
 	
       }
       
+      if (binaryFileName != 0) {
+	if (writeBinary == true &&
+	    DRMBinaryInput::convertTextFiles(files, f_d, n1, n2, binaryFileName) < 0) {
+	  opserr << " Error writing binary file for DRMLoadPattern \n";
+	  exit(-1);
+	}
+	if (files[0] != 0)
+	  delete [] files[0];
+	files[0] = new char[strlen(binaryFileName)+1];
+	strcpy(files[0],binaryFileName);
+      }
+      for (int i=0; i<5; i++)
+	if (files[i] == 0) {
+	  files[i] = new char[7];
+	  strcpy(files[i],"./NONE");
+	}
+      
       thePattern = new DRMLoadPatternWrapper(patternID,factor,files,nf,dt,num_steps,f_d,15,n1,n2,
 					     drm_box_crds,ele_d,
 					     steps_cached);
@@ -188,9 +188,11 @@ void* OPS_UniformExcitationPattern()
     return thePattern;
 }
 
+UniformExcitation *UniformExcitation::theRPattern = 0;
+
 UniformExcitation::UniformExcitation()
 :EarthquakePattern(0, PATTERN_TAG_UniformExcitation), 
- theMotion(0), theDof(0), vel0(0.0), fact(0.0)
+ theMotion(0), theDof(0), vel0(0.0), fact(0.0), rDomainStamp(-1), rCrdStamp(-1)
 {
 
 }
@@ -199,7 +201,8 @@ UniformExcitation::UniformExcitation()
 UniformExcitation::UniformExcitation(GroundMotion &_theMotion, 
 				     int dof, int tag, double velZero, double theFactor)
 :EarthquakePattern(tag, PATTERN_TAG_UniformExcitation), 
- theMotion(&_theMotion), theDof(dof), vel0(velZero), fact(theFactor)
+ theMotion(&_theMotion), theDof(dof), vel0(velZero), fact(theFactor),
+ rDomainStamp(-1), rCrdStamp(-1)
 {
   // add the motion to the list of ground motions
   this->addMotion(*theMotion);
@@ -208,7 +211,8 @@ UniformExcitation::UniformExcitation(GroundMotion &_theMotion,
 
 UniformExcitation::~UniformExcitation()
 {
-
+  if (theRPattern == this)
+    theRPattern = 0;
 }
 
 
@@ -242,6 +246,7 @@ void
 UniformExcitation::setDomain(Domain *theDomain) 
 {
   this->LoadPattern::setDomain(theDomain);
+  rDomainStamp = -1;
 
   // now we go through and set all the node velocities to be vel0 
   // for those nodes not fixed in the dirn!
@@ -286,6 +291,18 @@ UniformExcitation::applyLoad(double time)
     if (theDomain == 0)
         return;
     
+    // set R again only if another pattern has set it or the nodes, or
+    // their coordinates (the rotational dofs), have changed
+    int domainStamp = theDomain->hasDomainChanged();
+    int crdStamp = theDomain->getCrdChangeStamp();
+    if (theRPattern == this && domainStamp == rDomainStamp && crdStamp == rCrdStamp) {
+        this->EarthquakePattern::applyLoad(time);
+        return;
+    }
+    theRPattern = this;
+    rDomainStamp = domainStamp;
+    rCrdStamp = crdStamp;
+    
     NodeIter &theNodes = theDomain->getNodes();
     Node *theNode;
     while ((theNode = theNodes()) != 0) {
@@ -357,6 +374,7 @@ UniformExcitation::applyLoadSensitivity(double time)
       theNode->setR(theDof, 0, 1.0);
     }
 //  }
+  theRPattern = 0;
 
   this->EarthquakePattern::applyLoadSensitivity(time);
 
@@ -417,6 +435,7 @@ UniformExcitation::recvSelf(int commitTag, Channel &theChannel,
   theDof = int(data(1));
   vel0 = data(2);
   fact = data(5);
+  rDomainStamp = -1;
   int motionClassTag = int(data(3));
   int motionDbTag = int(data(4));
 
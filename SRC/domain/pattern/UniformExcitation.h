@@ -70,6 +70,13 @@ class UniformExcitation : public EarthquakePattern
     int theDof;      // the dof corrseponding to the ground motion
     double vel0;     // the initial velocity, should be neg of ug dot(0)
     double fact;
+
+    // the nodal R is shared by all the patterns, it is set again only
+    // when another pattern has set it or the domain or a nodal
+    // coordinate has changed since this pattern last set it
+    int rDomainStamp;
+    int rCrdStamp;
+    static UniformExcitation *theRPattern; // the pattern last setting R
 };
 
 #endif
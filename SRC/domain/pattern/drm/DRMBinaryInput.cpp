@@ -0,0 +1,399 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of DRMBinaryInput.
+//
+// What: "@(#) DRMBinaryInput.cpp, revA"
+
+#include "DRMBinaryInput.h"
+#include <OPS_Globals.h>
+
+#include <string.h>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define DRM_BINARY_HEADER_BYTES (DRM_BINARY_HEADER_SIZE*sizeof(int))
+
+DRMBinaryInput::DRMBinaryInput()
+  :numSteps(0), stepSize(0),
+#ifdef _WIN32
+   theFile(0),
+#else
+   fd(-1), theMap(0), mapSize(0),
+#endif
+   data(0), prefetchStep(0), prefetchNum(0), prefetchResult(0), prefetchCapacity(0)
+{
+  for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+    faceSize[i] = 0;
+    faceOffset[i] = 0;
+    faceFirst[i] = 0;
+    faceLast[i] = 0;
+    prefetchBuffers[i] = 0;
+  }
+}
+
+DRMBinaryInput::~DRMBinaryInput()
+{
+  this->close();
+
+  for (int i=0; i<DRM_BINARY_NUM_FACES; i++)
+    if (prefetchBuffers[i] != 0)
+      delete [] prefetchBuffers[i];
+}
+
+bool
+DRMBinaryInput::isBinaryFile(const char *fileName)
+{
+  FILE *fp = fopen(fileName, "rb");
+  if (fp == 0)
+    return false;
+
+  int magic = 0;
+  bool res = (fread(&magic, sizeof(int), 1, fp) == 1 && magic == DRM_BINARY_MAGIC);
+  fclose(fp);
+
+  return res;
+}
+
+int
+DRMBinaryInput::convertTextFiles(char **textFiles, const int *fileData,
+				 int nd1, int nd2, const char *binaryFile)
+{
+  int header[DRM_BINARY_HEADER_SIZE];
+  for (int i=0; i<DRM_BINARY_HEADER_SIZE; i++)
+    header[i] = 0;
+  header[0] = DRM_BINARY_MAGIC;
+  header[1] = DRM_BINARY_VERSION;
+  header[2] = DRM_BINARY_NUM_FACES;
+
+  int size = 0;
+  for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+    header[4+i] = 3*fileData[3*i];
+    size += header[4+i];
+  }
+
+  if (nd1 < 0 || nd2 < 0 || nd1+nd2 != fileData[12]) {
+    opserr << "DRMBinaryInput::convertTextFiles() - face 5 has " << fileData[12];
+    opserr << " nodes but files 5a and 5b " << nd1 << " and " << nd2 << endln;
+    return -1;
+  }
+
+  int numFiles = (nd2 > 0) ? 6 : 5;
+  std::ifstream ifiles[6];
+  for (int i=0; i<numFiles; i++) {
+    ifiles[i].open(textFiles[i]);
+    if (!ifiles[i].is_open()) {
+      opserr << "DRMBinaryInput::convertTextFiles() - could not open " << textFiles[i] << endln;
+      return -1;
+    }
+  }
+
+  FILE *fp = fopen(binaryFile, "wb");
+  if (fp == 0) {
+    opserr << "DRMBinaryInput::convertTextFiles() - could not open " << binaryFile << endln;
+    return -1;
+  }
+
+  if (fwrite(header, sizeof(int), DRM_BINARY_HEADER_SIZE, fp) != DRM_BINARY_HEADER_SIZE) {
+    opserr << "DRMBinaryInput::convertTextFiles() - could not write " << binaryFile << endln;
+    fclose(fp);
+    return -1;
+  }
+
+  // a step is written only if it was read in full from every file
+  double *step = new double[size];
+  int count = 0;
+  int res = 0;
+  bool done = false;
+  while (done == false) {
+    int loc = 0;
+    for (int i=0; i<4 && done == false; i++)
+      for (int j=0; j<header[4+i] && done == false; j++)
+	if (!(ifiles[i] >> step[loc++]))
+	  done = true;
+    for (int j=0; j<3*nd1 && done == false; j++)
+      if (!(ifiles[4] >> step[loc++]))
+	done = true;
+    for (int j=0; j<3*nd2 && done == false; j++)
+      if (!(ifiles[5] >> step[loc++]))
+	done = true;
+
+    if (done == false) {
+      if (fwrite(step, sizeof(double), size, fp) != (size_t)size) {
+	opserr << "DRMBinaryInput::convertTextFiles() - could not write " << binaryFile << endln;
+	res = -1;
+	break;
+      }
+      count++;
+    }
+  }
+  delete [] step;
+
+  header[3] = count;
+  if (res == 0 && (fseek(fp, 0, SEEK_SET) != 0 ||
+		   fwrite(header, sizeof(int), DRM_BINARY_HEADER_SIZE, fp) != DRM_BINARY_HEADER_SIZE)) {
+    opserr << "DRMBinaryInput::convertTextFiles() - could not write " << binaryFile << endln;
+    res = -1;
+  }
+  fclose(fp);
+
+  if (res != 0)
+    return res;
+
+  return count;
+}
+
+int
+DRMBinaryInput::open(const char *fileName, const int *fileData)
+{
+  this->close();
+
+  int header[DRM_BINARY_HEADER_SIZE];
+  FILE *fp = fopen(fileName, "rb");
+  if (fp == 0) {
+    opserr << "DRMBinaryInput::open() - could not open " << fileName << endln;
+    return -1;
+  }
+  size_t numRead = fread(header, sizeof(int), DRM_BINARY_HEADER_SIZE, fp);
+  fclose(fp);
+
+  if (numRead != DRM_BINARY_HEADER_SIZE || header[0] != DRM_BINARY_MAGIC) {
+    opserr << "DRMBinaryInput::open() - " << fileName;
+    opserr << " is not a DRM file or was written with a different byte order\n";
+    return -1;
+  }
+
+  if (header[1] != DRM_BINARY_VERSION || header[2] != DRM_BINARY_NUM_FACES) {
+    opserr << "DRMBinaryInput::open() - unknown version " << header[1] << endln;
+    return -1;
+  }
+
+  stepSize = 0;
+  for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+    if (header[4+i] != 3*fileData[3*i]) {
+      opserr << "DRMBinaryInput::open() - face " << i+1 << " of " << fileName;
+      opserr << " has " << header[4+i]/3 << " nodes, the model " << fileData[3*i] << endln;
+      return -1;
+    }
+    faceSize[i] = header[4+i];
+    faceOffset[i] = stepSize;
+    faceFirst[i] = 0;
+    faceLast[i] = faceSize[i];
+    stepSize += faceSize[i];
+  }
+  numSteps = header[3];
+
+  size_t fileSize = DRM_BINARY_HEADER_BYTES + (size_t)numSteps*stepSize*sizeof(double);
+
+#ifdef _WIN32
+  theFile = fopen(fileName, "rb");
+  if (theFile == 0) {
+    opserr << "DRMBinaryInput::open() - could not open " << fileName << endln;
+    return -1;
+  }
+#else
+  fd = ::open(fileName, O_RDONLY);
+  struct stat fileStat;
+  if (fd < 0 || fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < fileSize) {
+    opserr << "DRMBinaryInput::open() - " << fileName << " is shorter than its ";
+    opserr << numSteps << " steps\n";
+    this->close();
+    return -1;
+  }
+
+  mapSize = fileSize;
+  void *theAddress = mmap(0, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+  if (theAddress == MAP_FAILED) {
+    opserr << "DRMBinaryInput::open() - could not map " << fileName << endln;
+    mapSize = 0;
+    this->close();
+    return -1;
+  }
+  theMap = (char *)theAddress;
+  madvise(theMap, mapSize, MADV_SEQUENTIAL);
+  data = (const double *)(theMap + DRM_BINARY_HEADER_BYTES);
+#endif
+
+  return 0;
+}
+
+void
+DRMBinaryInput::close(void)
+{
+  this->waitPrefetch();
+  prefetchNum = 0;
+
+#ifdef _WIN32
+  if (theFile != 0)
+    fclose(theFile);
+  theFile = 0;
+#else
+  if (theMap != 0)
+    munmap(theMap, mapSize);
+  if (fd >= 0)
+    ::close(fd);
+  theMap = 0;
+  mapSize = 0;
+  fd = -1;
+#endif
+  data = 0;
+}
+
+int
+DRMBinaryInput::getNumSteps(void) const
+{
+  return numSteps;
+}
+
+int
+DRMBinaryInput::setFaceRange(int face, int first, int last)
+{
+  if (face < 0 || face >= DRM_BINARY_NUM_FACES)
+    return -1;
+
+  if (first < 0)
+    first = 0;
+  if (last > faceSize[face])
+    last = faceSize[face];
+  if (last < first)
+    last = first;
+
+  this->waitPrefetch();
+  prefetchNum = 0;
+
+  faceFirst[face] = first;
+  faceLast[face] = last;
+
+  return 0;
+}
+
+int
+DRMBinaryInput::readSteps(int step, int num, double **buffers, int destStep)
+{
+  this->waitPrefetch();
+
+  if (prefetchNum > 0 && step == prefetchStep && num <= prefetchNum && prefetchResult == 0) {
+    for (int k=0; k<num; k++)
+      for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+	int n = faceLast[i] - faceFirst[i];
+	if (n > 0)
+	  memcpy(&buffers[i][(size_t)(destStep+k)*faceSize[i] + faceFirst[i]],
+		 &prefetchBuffers[i][(size_t)k*faceSize[i] + faceFirst[i]],
+		 n*sizeof(double));
+      }
+    prefetchNum = 0;
+    return 0;
+  }
+
+  prefetchNum = 0;
+  return this->copySteps(step, num, buffers, destStep);
+}
+
+int
+DRMBinaryInput::prefetch(int step, int num)
+{
+  this->waitPrefetch();
+
+  if (num <= 0 || step >= numSteps) {
+    prefetchNum = 0;
+    return 0;
+  }
+
+  if (num > prefetchCapacity) {
+    for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+      if (prefetchBuffers[i] != 0)
+	delete [] prefetchBuffers[i];
+      prefetchBuffers[i] = new double[(size_t)num*faceSize[i]];
+    }
+    prefetchCapacity = num;
+  }
+
+  prefetchStep = step;
+  prefetchNum = num;
+  prefetchResult = 0;
+
+  prefetchThread = std::thread([this]() {
+      prefetchResult = this->copySteps(prefetchStep, prefetchNum, prefetchBuffers, 0);
+    });
+
+  return 0;
+}
+
+void
+DRMBinaryInput::waitPrefetch(void)
+{
+  if (prefetchThread.joinable())
+    prefetchThread.join();
+}
+
+int
+DRMBinaryInput::copySteps(int step, int num, double **buffers, int destStep)
+{
+  // may be running in the prefetch thread, so no output here
+  for (int k=0; k<num; k++) {
+    int theStep = step + k;
+    for (int i=0; i<DRM_BINARY_NUM_FACES; i++) {
+      int n = faceLast[i] - faceFirst[i];
+      if (n <= 0)
+	continue;
+
+      double *dest = &buffers[i][(size_t)(destStep+k)*faceSize[i] + faceFirst[i]];
+      if (theStep < 0 || theStep >= numSteps) {
+	for (int j=0; j<n; j++)
+	  dest[j] = 0.0;
+	continue;
+      }
+
+      size_t loc = (size_t)theStep*stepSize + faceOffset[i] + faceFirst[i];
+#ifdef _WIN32
+      if (_fseeki64(theFile, DRM_BINARY_HEADER_BYTES + loc*sizeof(double), SEEK_SET) != 0 ||
+	  fread(dest, sizeof(double), n, theFile) != (size_t)n)
+	return -1;
+#else
+      memcpy(dest, &data[loc], n*sizeof(double));
+#endif
+    }
+  }
+
+#ifndef _WIN32
+  // the steps before the window are not needed again, so their pages are
+  // released rather than left to grow the resident set
+  size_t pageSize = sysconf(_SC_PAGESIZE);
+  size_t used = DRM_BINARY_HEADER_BYTES + (size_t)step*stepSize*sizeof(double);
+  if (step > 0 && used < mapSize) {
+    used -= used % pageSize;
+    if (used > 0)
+      madvise(theMap, used, MADV_DONTNEED);
+  }
+#endif
+
+  return 0;
+}
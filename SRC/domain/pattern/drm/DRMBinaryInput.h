@@ -0,0 +1,113 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for DRMBinaryInput.
+// A DRMBinaryInput reads the free field motion of the DRM boundary from a
+// single binary file, in place of the six text files read by the
+// PlaneDRMInputHandler. The file is a 64 byte header of ints, magic number,
+// version, number of faces, number of steps and the number of doubles per
+// step of each face, followed by the doubles themselves step by step, the
+// faces of a step one after the other in the order of the text files (face
+// 5 holding the contents of files 5a and 5b). Steps are therefore
+// contiguous and a window of steps is a single range of the file, which is
+// memory mapped. While the analysis works on one window the next one is
+// copied out of the file by a background thread into a second buffer.
+// Only a range of each face, those nodes needed by the elements in the
+// local domain, need be read.
+//
+// What: "@(#) DRMBinaryInput.h, revA"
+
+#ifndef DRMBinaryInput_h
+#define DRMBinaryInput_h
+
+#include <stdio.h>
+#include <thread>
+
+#define DRM_BINARY_MAGIC 0x424d5244
+#define DRM_BINARY_VERSION 1
+#define DRM_BINARY_NUM_FACES 5
+#define DRM_BINARY_HEADER_SIZE 16
+
+class DRMBinaryInput
+{
+ public:
+  DRMBinaryInput();
+  ~DRMBinaryInput();
+
+  // true if the file starts with the header of a binary DRM file
+  static bool isBinaryFile(const char *fileName);
+
+  // writes the six text files of a PlaneDRMInputHandler as one binary
+  // file, returns the number of steps written or a negative number
+  static int convertTextFiles(char **textFiles, const int *fileData,
+			      int nd1, int nd2, const char *binaryFile);
+
+  // fileData as for the PlaneDRMInputHandler, giving the face sizes
+  int open(const char *fileName, const int *fileData);
+  int getNumSteps(void) const;
+
+  // only the doubles first to last-1 of each step of a face are copied
+  int setFaceRange(int face, int first, int last);
+
+  // copies num steps starting at step into the face buffers, starting at
+  // step destStep of the buffers; steps past the end of the file are zero
+  int readSteps(int step, int num, double **buffers, int destStep);
+
+  // starts copying num steps starting at step in the background, for a
+  // readSteps() of the same steps to come
+  int prefetch(int step, int num);
+
+ protected:
+
+ private:
+  int copySteps(int step, int num, double **buffers, int destStep);
+  void waitPrefetch(void);
+  void close(void);
+
+  int numSteps;
+  int faceSize[DRM_BINARY_NUM_FACES];      // doubles per step of each face
+  int faceOffset[DRM_BINARY_NUM_FACES];    // offset of each face in a step
+  int stepSize;
+  int faceFirst[DRM_BINARY_NUM_FACES];
+  int faceLast[DRM_BINARY_NUM_FACES];
+
+#ifdef _WIN32
+  FILE *theFile;
+#else
+  int fd;
+  char *theMap;
+  size_t mapSize;
+#endif
+  const double *data;
+
+  std::thread prefetchThread;
+  int prefetchStep;
+  int prefetchNum;
+  int prefetchResult;
+  int prefetchCapacity;                    // steps in the prefetch buffers
+  double *prefetchBuffers[DRM_BINARY_NUM_FACES];
+};
+
+#endif
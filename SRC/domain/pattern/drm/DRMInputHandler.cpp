@@ -69,6 +69,7 @@ void DRMInputHandler::seteleMap(std::map<int,Element* >& ele, std::map<int,Vecto
 						stor2);
   this->ele_str = stor;
   this->ele_str2 = stor2;
+  this->ele_map = ele;
 }
 
 
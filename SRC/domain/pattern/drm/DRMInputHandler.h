@@ -70,5 +70,6 @@ class DRMInputHandler
 
   std::map<int, Vector*> ele_str;
   std::map<int, int> ele_str2;
+  std::map<int, Element*> ele_map;
 };
 #endif
@@ -112,38 +112,48 @@ PlaneDRMInputHandler::PlaneDRMInputHandler(int tag, char** in_files, int files,
     exit(-1);
   }
 	
-  // Open File streams
-  
-  this->ifile1.open(filePtrs[0]);
-  this->ifile2.open(filePtrs[1]);
-  this->ifile3.open(filePtrs[2]);
-  this->ifile4.open(filePtrs[3]);
-  this->ifile5a.open(filePtrs[4]);
-  this->ifile5b.open(filePtrs[5]);
-
-  if (ifile1.bad() ) {
-    opserr << " Bad file 1 " << endln;
-    exit(-1);
-  }
-  if (ifile2.bad() ) {
-    opserr << " Bad file 2 " << endln;
-    exit(-1);
-  }
-  if (ifile3.bad() ) {
-    opserr << " Bad file 3 " << endln;
-    exit(-1);
-  }
-  if (ifile4.bad() ) {
-    opserr << " Bad file 4 " << endln;
-    exit(-1);
-  }
-  if (ifile5a.bad() ) {
-    opserr << " Bad file 5a " << endln;
-    exit(-1);
-  }
-  if (ifile5b.bad() ) {
-    opserr << " Bad file 5b " << endln;
-    exit(-1);
+  // a binary file given for face 1 holds all the faces, otherwise
+  // open file streams
+  this->theBinaryInput = 0;
+  this->nextStep = 0;
+  if (DRMBinaryInput::isBinaryFile(filePtrs[0])) {
+    theBinaryInput = new DRMBinaryInput();
+    if (theBinaryInput->open(filePtrs[0], this->fileData) != 0) {
+      opserr << " Bad DRM binary file " << filePtrs[0] << endln;
+      exit(-1);
+    }
+  } else {
+    this->ifile1.open(filePtrs[0]);
+    this->ifile2.open(filePtrs[1]);
+    this->ifile3.open(filePtrs[2]);
+    this->ifile4.open(filePtrs[3]);
+    this->ifile5a.open(filePtrs[4]);
+    this->ifile5b.open(filePtrs[5]);
+
+    if (ifile1.bad() ) {
+      opserr << " Bad file 1 " << endln;
+      exit(-1);
+    }
+    if (ifile2.bad() ) {
+      opserr << " Bad file 2 " << endln;
+      exit(-1);
+    }
+    if (ifile3.bad() ) {
+      opserr << " Bad file 3 " << endln;
+      exit(-1);
+    }
+    if (ifile4.bad() ) {
+      opserr << " Bad file 4 " << endln;
+      exit(-1);
+    }
+    if (ifile5a.bad() ) {
+      opserr << " Bad file 5a " << endln;
+      exit(-1);
+    }
+    if (ifile5b.bad() ) {
+      opserr << " Bad file 5b " << endln;
+      exit(-1);
+    }
   }
 
   this->cacheValue = cacheValue;
@@ -170,7 +180,10 @@ PlaneDRMInputHandler::PlaneDRMInputHandler(int tag, char** in_files, int files,
   nd1 = _nd1;
   nd2 = _nd2;
 
-  populateBuffers();
+  // binary input is read on first use, once the elements in the local
+  // domain are known
+  if (theBinaryInput == 0)
+    populateBuffers();
 }
 
 PlaneDRMInputHandler::~PlaneDRMInputHandler()
@@ -184,6 +197,8 @@ PlaneDRMInputHandler::~PlaneDRMInputHandler()
   delete [] buffers;
   delete [] which;
   delete myDecorator;
+  if (theBinaryInput != 0)
+    delete theBinaryInput;
 }
 
 
@@ -192,6 +207,11 @@ void PlaneDRMInputHandler::populateBuffers()
 {
 //  int pid;
 //  bool debug = false;
+
+  if (theBinaryInput != 0) {
+    populateBinaryBuffers();
+    return;
+  }
   
   if (this->initial) {
     
@@ -339,6 +359,119 @@ void PlaneDRMInputHandler::populateBuffers()
   }
 }
 
+void PlaneDRMInputHandler::populateBinaryBuffers()
+{
+  // same windows as the text files, the steps of the next window are
+  // read in the background while this one is in use
+  if (this->initial) {
+
+    setLocalRanges();
+
+    for (int f=0; f<5; f++) {
+      int temp = this->fileData[3*f];
+      for (int i=0; i<3*temp; i++)
+	buffers[f][i] = 0.0;
+    }
+    theBinaryInput->readSteps(0, cacheValue+3, buffers, 1);
+    nextStep = cacheValue+3;
+
+    initial = false;
+    globalCounter += cacheValue + 1;
+    
+    //update time buff
+    timeBuf[0] = -deltaT;
+    timeBuf[1] = 0.0;
+    timeBuf[2] = deltaT;
+    for (int i=0; i<this->cacheValue+1; i++)
+      timeBuf[3+i] = timeBuf[2+i]+this->deltaT;
+  }
+  else {
+    int rem = numSteps - globalCounter;
+    if (rem < 0)
+      return;
+
+    for (int f=0; f<5; f++) {
+      int temp = this->fileData[3*f];
+      double *fbuffer = buffers[f];
+      for (int i=0; i<3*temp; i++) {
+	fbuffer[i] = fbuffer[i+ 3*(cacheValue+1)*temp];
+	fbuffer[i+3*temp] = fbuffer[i+3*(cacheValue+2)*temp];			
+	fbuffer[i+6*temp] = fbuffer[i+3*(cacheValue+3)*temp];			
+      }
+    }
+    theBinaryInput->readSteps(nextStep, cacheValue+1, buffers, 3);
+    nextStep += cacheValue+1;
+
+    globalCounter += cacheValue+1;
+
+    //update time buff
+    timeBuf[0] = timeBuf[this->cacheValue+1];
+    timeBuf[1] = timeBuf[this->cacheValue+2];
+    timeBuf[2] = timeBuf[this->cacheValue+3];
+    for (int i=0; i<this->cacheValue+1; i++)
+      timeBuf[3+i] = timeBuf[2+i]+this->deltaT;
+  }
+
+  theBinaryInput->prefetch(nextStep, cacheValue+1);
+}
+
+void PlaneDRMInputHandler::setLocalRanges()
+{
+  // only the rows of each face under the elements in this domain, and the
+  // row above them used in the interpolation, are read; in a parallel run
+  // the domain holds the elements of the partition only
+  if (ele_map.empty())
+    return;
+
+  int rowMin[5], rowMax[5];
+  for (int f=0; f<5; f++) {
+    rowMin[f] = fileData[3*f+2]+1;
+    rowMax[f] = -1;
+  }
+
+  double dy = this->eleD[1];
+  double dz = this->eleD[2];
+
+  for (std::map<int,Element*>::iterator pos=ele_map.begin(); pos!=ele_map.end(); pos++) {
+    Element* ele = pos->second;
+    if (ele == 0)
+      continue;
+
+    int f;
+    switch (getFace(ele)) {
+    case 1: f = 4; break;
+    case 5: f = 0; break;
+    case 3: f = 1; break;
+    case 7: f = 2; break;
+    case 11: f = 3; break;
+    default: continue;
+    }
+
+    Node** nodes = ele->getNodePtrs();
+    int numNodes = ele->getNumExternalNodes();
+    for (int i=0; i<numNodes; i++) {
+      const Vector& crd = nodes[i]->getCrds();
+      int row;
+      if (f == 4)
+	row = (int)floor((-crd(1) + fileData[14]*dy)/dy);
+      else
+	row = (int)floor((-crd(2) + fileData[3*f+2]*dz)/dz);
+      if (row < rowMin[f])
+	rowMin[f] = row;
+      if (row > rowMax[f])
+	rowMax[f] = row;
+    }
+  }
+
+  for (int f=0; f<5; f++) {
+    int rowSize = 3*(fileData[3*f+1]+1);
+    if (rowMax[f] < rowMin[f])
+      theBinaryInput->setFaceRange(f, 0, 0);
+    else
+      theBinaryInput->setFaceRange(f, rowSize*rowMin[f], rowSize*(rowMax[f]+2));
+  }
+}
+
 void PlaneDRMInputHandler::getMotions(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd)
 {
   
@@ -351,26 +484,7 @@ void PlaneDRMInputHandler::getMotions(Element* eletag, double time, Vector& U, V
   ///Start by finding the face to which the element belongs;
   // check for bottom face i.e f5
   // check for 1,2,3,4
-  double xMin,xMax,yMin,yMax,zMin,zMax;
-  xMin = this->drm_box_Crds[0];
-  xMax = this->drm_box_Crds[1];
-  yMin = this->drm_box_Crds[2];
-  yMax = this->drm_box_Crds[3];
-  zMin = this->drm_box_Crds[4];
-  zMax = this->drm_box_Crds[5];
-  
-  this->myDecorator->setBrick(eletag);
-  int result = 0;
-  if (this->myDecorator->isLeftBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
-    result =3;
-  if (this->myDecorator->isRightBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
-    result =5;
-  if (this->myDecorator->isFrontBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
-    result =7;
-  if (this->myDecorator->isRearBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
-    result =11;
-  if (this->myDecorator->isBottomBoundary(xMin,xMax, yMin,  yMax,  zMin,  zMax)) 
-    result =1;
+  int result = getFace(eletag);
 
   switch (result) {
   case 1:
@@ -400,6 +514,33 @@ void PlaneDRMInputHandler::getMotions(Element* eletag, double time, Vector& U, V
 }
 
 
+int PlaneDRMInputHandler::getFace(Element* eletag)
+{
+  double xMin,xMax,yMin,yMax,zMin,zMax;
+  xMin = this->drm_box_Crds[0];
+  xMax = this->drm_box_Crds[1];
+  yMin = this->drm_box_Crds[2];
+  yMax = this->drm_box_Crds[3];
+  zMin = this->drm_box_Crds[4];
+  zMax = this->drm_box_Crds[5];
+  
+  this->myDecorator->setBrick(eletag);
+  int result = 0;
+  if (this->myDecorator->isLeftBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
+    result =3;
+  if (this->myDecorator->isRightBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
+    result =5;
+  if (this->myDecorator->isFrontBoundary(xMin,xMax,  yMin,  yMax,  zMin,  zMax)) 
+    result =7;
+  if (this->myDecorator->isRearBoundary(xMin, xMax,  yMin,  yMax,  zMin,  zMax)) 
+    result =11;
+  if (this->myDecorator->isBottomBoundary(xMin,xMax, yMin,  yMax,  zMin,  zMax)) 
+    result =1;
+
+  return result;
+}
+
+
 void PlaneDRMInputHandler::computeHistory(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd, bool updateDm1) 
 {
   double oo2dt = 0.5/deltaT;
@@ -591,6 +732,10 @@ void PlaneDRMInputHandler::getTemporal(double time, int* tloc)
 
 int PlaneDRMInputHandler::getIndex(double time)
 {
+  // binary input is read on first use
+  if (this->initial)
+    populateBuffers();
+
   // kill roundoffs
   double tmptime = time + 0.0000000001;
 
@@ -19,6 +19,7 @@
 #include "DRMInputHandler.h"
 #include "GeometricBrickDecorator.h"
 #include "Mesh3DSubdomain.h"
+#include "DRMBinaryInput.h"
 #include <math.h>
 
 class PlaneDRMInputHandler : public DRMInputHandler {
@@ -34,6 +35,9 @@ class PlaneDRMInputHandler : public DRMInputHandler {
   virtual ~PlaneDRMInputHandler();
   
   void populateBuffers();
+  void populateBinaryBuffers();
+  void setLocalRanges();
+  int getFace(Element* eletag);
   void getMotions(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd);
   void computeHistory(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd, bool updateDm1); 
   void handle_elementAtface5(Element* eletag, double time, Vector& U, Vector& Ud, Vector& Udd); 
@@ -76,6 +80,10 @@ class PlaneDRMInputHandler : public DRMInputHandler {
   std::ifstream ifile4;
   std::ifstream ifile5a;
   std::ifstream ifile5b;
+
+  // used in place of the ifstreams if given a binary file
+  DRMBinaryInput* theBinaryInput;
+  int nextStep;
   
 
   static Vector Vtm2;
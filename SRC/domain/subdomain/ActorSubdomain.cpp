@@ -177,6 +177,19 @@ ActorSubdomain::run(void)
 	    this->sendVector(theVect);
 	    break;	    
 
+	  case ShadowActorSubdomain_getElementCosts:
+	    {
+	      ID eleTags(0);
+	      Vector eleCosts(0);
+	      msgData(0) = this->getElementCosts(eleTags, eleCosts);
+	      this->sendID(msgData);
+	      if (msgData(0) > 0) {
+		this->sendID(eleTags);
+		this->sendVector(eleCosts);
+	      }
+	    }
+	    break;
+
  	  case ShadowActorSubdomain_addElement:
 	    theType = msgData(1);
 	    dbTag = msgData(2);
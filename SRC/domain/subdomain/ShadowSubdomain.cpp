@@ -1434,15 +1434,30 @@ ShadowSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
 double
 ShadowSubdomain::getCost(void)    
 {
-  /*
     msgData(0) = ShadowActorSubdomain_getCost;
     
     this->sendID(msgData);
-    Vector cost(2);
+    Vector cost(4);
     this->recvVector(cost);
     return cost(0);
-  */
-  return 0.0;
+}
+
+int
+ShadowSubdomain::getElementCosts(ID &eleTags, Vector &eleCosts)
+{
+    msgData(0) = ShadowActorSubdomain_getElementCosts;
+    this->sendID(msgData);
+    this->recvID(msgData);
+
+    int numEle = msgData(0);
+    if (numEle > 0) {
+	eleTags.resize(numEle);
+	eleCosts.resize(numEle);
+	this->recvID(eleTags);
+	this->recvVector(eleCosts);
+    }
+
+    return numEle;
 }
 
 
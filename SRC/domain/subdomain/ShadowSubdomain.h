@@ -166,6 +166,7 @@ class ShadowSubdomain: public Shadow, public Subdomain
 			 FEM_ObjectBroker &theBroker);    
 
     virtual double getCost(void);
+    virtual int getElementCosts(ID &eleTags, Vector &eleCosts);
     
     virtual  void Print(OPS_Stream &s, int flag =0);
     virtual void Print(OPS_Stream &s, ID *nodeTags, ID *eleTags, int flag =0);
@@ -59,6 +59,15 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
+#include <chrono>
+
+// wall clock in seconds, cheap enough to be read around every element update
+static double
+costClock(void)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 
 Matrix Subdomain::badResult(1,1); // for returns from getStiff, getMass and getDamp
 
@@ -67,7 +76,7 @@ Subdomain::Subdomain(int tag)
 :Element(tag,ELE_TAG_Subdomain),
  Domain(),
  mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
- realCost(0.0),cpuCost(0),pageCost(0),
+ realCost(0.0),cpuCost(0),pageCost(0),costTags(0),eleCosts(0),
  theAnalysis(0), extNodes(0), theFEele(0) 
 {
 
@@ -106,7 +115,7 @@ Subdomain::Subdomain(int tag,
    mapBuilt(false),map(0),mappedVect(0),mappedMatrix(0),
    internalNodes(&theInternalNodeStorage),
    externalNodes(&theExternalNodeStorage), 
-   realCost(0.0),cpuCost(0),pageCost(0),
+   realCost(0.0),cpuCost(0),pageCost(0),costTags(0),eleCosts(0),
    theAnalysis(0), extNodes(0), theFEele(0)
 {
   //thePartitionedModelBuilder = 0;
@@ -147,6 +156,11 @@ Subdomain::~Subdomain()
     delete mappedVect;
   if (mappedMatrix != 0)
     delete mappedMatrix;
+
+  if (costTags != 0)
+    delete costTags;
+  if (eleCosts != 0)
+    delete eleCosts;
 }
 
 
@@ -243,6 +257,7 @@ Subdomain::removeNode(int tag)
         //	  Node *dummy = (Node *)object;
 	//	  object = realExternalNodes->removeComponent(tag);      	  
 	Node *result = (Node *)object;
+	result->releaseStateArena();
 	this->domainChange();          
 	//	  delete dummy;
 	return result;	  
@@ -251,6 +266,7 @@ Subdomain::removeNode(int tag)
   else {
       this->domainChange();          
       Node *result = (Node *)object;
+      result->releaseStateArena();
       return result;	  
   }
   
@@ -360,13 +376,63 @@ Subdomain::revertToStart(void)
 int
 Subdomain::update(void)
 {
-  return this->Domain::update();
+  // the elements are updated here, and not in Domain::update(), so that
+  // the time each takes can be measured for the load balancer
+  ops_Dt = this->getCurrentTime() - this->getCommittedTime();
+  ops_TheActiveDomain = this;
+
+  int numEle = this->getNumElements();
+  if (numEle == 0)
+    return 0;
+
+  if (costTags == 0 || costTags->Size() != numEle) {
+    if (costTags != 0)
+      delete costTags;
+    if (eleCosts != 0)
+      delete eleCosts;
+    costTags = new ID(numEle);
+    eleCosts = new Vector(numEle);
+    for (int i=0; i<numEle; i++)
+      (*costTags)(i) = -1;
+  }
+
+  int ok = 0;
+  int count = 0;
+  double start = costClock();
+  double last = start;
+
+  ElementIter &theEles = this->getElements();
+  Element *theEle;
+  while ((theEle = theEles()) != 0) {
+    ops_TheActiveElement = theEle;
+    ok += theEle->update();
+
+    double now = costClock();
+
+    // elements added or removed since the last update restart their cost
+    int eleTag = theEle->getTag();
+    if ((*costTags)(count) != eleTag) {
+      (*costTags)(count) = eleTag;
+      (*eleCosts)(count) = 0.0;
+    }
+    (*eleCosts)(count) += now - last;
+    last = now;
+    count++;
+  }
+
+  realCost += last - start;
+
+  if (ok != 0)
+    opserr << "Subdomain::update - failed in update\n";
+
+  return ok;
 }
 
 int
 Subdomain::update(double newTime, double dT)
 {
-    return this->Domain::update(newTime, dT);
+  this->applyLoad(newTime);
+  return this->update();
 }
 
 void
@@ -683,10 +749,12 @@ int
 Subdomain::computeTang(void)
 {   
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    double start = costClock();
     
     int res =0;
     res = theAnalysis->formTangent();
+
+    realCost += costClock() - start;
     
     return res;
     
@@ -703,15 +771,12 @@ int
 Subdomain::computeResidual(void)
 {
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    double start = costClock();
     
     int res =0;
     res = theAnalysis->formResidual();
     
-    //theTimer.pause();
-    //    realCost += theTimer.getReal();
-    //    cpuCost += theTimer.getCPU();
-    //    pageCost += theTimer.getNumPageFaults();
+    realCost += costClock() - start;
     
     return res;
     
@@ -878,6 +943,24 @@ Subdomain::getCost(void)
     return lastRealCost;
 }
 
+int
+Subdomain::getElementCosts(ID &eleTags, Vector &theCosts)
+{
+  int numEle = 0;
+  if (costTags != 0)
+    numEle = costTags->Size();
+
+  // no update since the elements changed, nothing has been measured
+  if (numEle == 0 || (*costTags)(numEle-1) == -1)
+    return 0;
+
+  eleTags = *costTags;
+  theCosts = *eleCosts;
+  eleCosts->Zero();
+
+  return numEle;
+}
+
 
 int
 Subdomain::buildMap(void)
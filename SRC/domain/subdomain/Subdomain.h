@@ -158,6 +158,7 @@ class Subdomain: public Element, public Domain
 			 FEM_ObjectBroker &theBroker);
 
     virtual double getCost(void);
+    virtual int getElementCosts(ID &eleTags, Vector &eleCosts);
     virtual int addResistingForceToNodalReaction(bool inclInertia);
     
   protected:    
@@ -178,6 +179,8 @@ class Subdomain: public Element, public Domain
     double realCost;
     double cpuCost;
     int pageCost;
+    ID *costTags;         // measured cost of each element since last
+    Vector *eleCosts;     // call to getElementCosts()
     DomainDecompositionAnalysis *theAnalysis;
     ID *extNodes;
     FE_Element *theFEele;
@@ -0,0 +1,532 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ThreadedSubdomain
+// and ThreadedSubdomainGroup.
+//
+// What: "@(#) ThreadedSubdomain.cpp, revA"
+
+#include <ThreadedSubdomain.h>
+#include <PartitionedDomain.h>
+#include <DomainDecompositionAnalysis.h>
+#include <ConstraintHandler.h>
+#include <DOF_Numberer.h>
+#include <AnalysisModel.h>
+#include <DomainDecompAlgo.h>
+#include <IncrementalIntegrator.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinSubstrSolver.h>
+#include <LocalChannel.h>
+#include <FEM_ObjectBroker.h>
+#include <OPS_Globals.h>
+
+// the tasks done by the worker
+#define ThreadedSubdomain_computeTang          1
+#define ThreadedSubdomain_computeResidual      2
+#define ThreadedSubdomain_computeNodalResponse 3
+#define ThreadedSubdomain_update               4
+#define ThreadedSubdomain_updateTimeDt         5
+#define ThreadedSubdomain_commit               6
+#define ThreadedSubdomain_revertToLastCommit   7
+#define ThreadedSubdomain_revertToStart        8
+#define ThreadedSubdomain_analysisStep         9
+#define ThreadedSubdomain_eigenAnalysis        10
+
+
+ThreadedSubdomainGroup::ThreadedSubdomainGroup()
+{
+
+}
+
+
+ThreadedSubdomainGroup::~ThreadedSubdomainGroup()
+{
+
+}
+
+
+int
+ThreadedSubdomainGroup::addSubdomain(ThreadedSubdomain *theSubdomain)
+{
+  theSubdomains.push_back(theSubdomain);
+  return 0;
+}
+
+
+int
+ThreadedSubdomainGroup::removeSubdomain(ThreadedSubdomain *theSubdomain)
+{
+  for (std::vector<ThreadedSubdomain *>::iterator i = theSubdomains.begin();
+       i != theSubdomains.end(); i++)
+    if (*i == theSubdomain) {
+      theSubdomains.erase(i);
+      return 0;
+    }
+
+  return -1;
+}
+
+
+int
+ThreadedSubdomainGroup::getNumSubdomains(void) const
+{
+  return (int)theSubdomains.size();
+}
+
+
+ThreadedSubdomain *
+ThreadedSubdomainGroup::getSubdomain(int i) const
+{
+  return theSubdomains[i];
+}
+
+
+std::mutex &
+ThreadedSubdomainGroup::getElementMutex(void)
+{
+  return elementMutex;
+}
+
+
+ThreadedSubdomain::ThreadedSubdomain(int tag, PartitionedDomain &theDomain)
+  :Subdomain(tag), theGroup(theDomain.getThreadedSubdomains()), theThread(0),
+   theTask(0), startedTask(0), done(false), taskResult(0),
+   theTime(0.0), theDT(0.0), numModes(0),
+   generalizedModes(false), smallestModes(false), theBroker(0)
+{
+  theGroup.addSubdomain(this);
+  theThread = new std::thread(&ThreadedSubdomain::run, this);
+}
+
+
+ThreadedSubdomain::~ThreadedSubdomain()
+{
+  this->finishTask();
+
+  {
+    std::lock_guard<std::mutex> theLock(theMutex);
+    done = true;
+  }
+  theCondition.notify_all();
+
+  theThread->join();
+  delete theThread;
+
+  theGroup.removeSubdomain(this);
+}
+
+
+// the worker waits to be given a task, does it, and waits again
+void
+ThreadedSubdomain::run(void)
+{
+  std::unique_lock<std::mutex> theLock(theMutex);
+
+  while (true) {
+    while (theTask == 0 && done == false)
+      theCondition.wait(theLock);
+
+    if (done == true)
+      return;
+
+    int task = theTask;
+    theLock.unlock();
+    int result = this->doTask(task);
+    theLock.lock();
+
+    taskResult = result;
+    theTask = 0;
+    theCondition.notify_all();
+  }
+}
+
+
+int
+ThreadedSubdomain::doTask(int task)
+{
+  std::mutex &elementMutex = theGroup.getElementMutex();
+
+  // only the condensation is done outside the element mutex
+  if (task == ThreadedSubdomain_computeTang) {
+    DomainDecompositionAnalysis *theAnalysis = this->getDDAnalysis();
+    int result;
+    {
+      std::lock_guard<std::mutex> theLock(elementMutex);
+      result = theAnalysis->formElementTangent();
+    }
+    if (result < 0)
+      return result;
+
+    return theAnalysis->condenseTangent();
+  }
+
+  std::lock_guard<std::mutex> theLock(elementMutex);
+
+  switch (task) {
+  case ThreadedSubdomain_computeResidual:
+    return this->Subdomain::computeResidual();
+  case ThreadedSubdomain_computeNodalResponse:
+    return this->Subdomain::computeNodalResponse();
+  case ThreadedSubdomain_update:
+    return this->Subdomain::update();
+  case ThreadedSubdomain_updateTimeDt:
+    return this->Subdomain::update(theTime, theDT);
+  case ThreadedSubdomain_commit:
+    return this->Subdomain::commit();
+  case ThreadedSubdomain_revertToLastCommit:
+    return this->Subdomain::revertToLastCommit();
+  case ThreadedSubdomain_revertToStart:
+    return this->Subdomain::revertToStart();
+  case ThreadedSubdomain_analysisStep:
+    return this->Subdomain::analysisStep(theDT);
+  case ThreadedSubdomain_eigenAnalysis:
+    return this->Subdomain::eigenAnalysis(numModes, generalizedModes, smallestModes);
+  default:
+    opserr << "ThreadedSubdomain::doTask() - unknown task " << task << endln;
+    return -1;
+  }
+}
+
+
+int
+ThreadedSubdomain::startTask(int task)
+{
+  {
+    std::lock_guard<std::mutex> theLock(theMutex);
+    theTask = task;
+  }
+  theCondition.notify_all();
+
+  startedTask = task;
+
+  return 0;
+}
+
+
+int
+ThreadedSubdomain::finishTask(void)
+{
+  if (startedTask == 0)
+    return 0;
+
+  std::unique_lock<std::mutex> theLock(theMutex);
+  while (theTask != 0)
+    theCondition.wait(theLock);
+
+  startedTask = 0;
+
+  return taskResult;
+}
+
+
+int
+ThreadedSubdomain::runTask(int task)
+{
+  this->finishTask();
+  this->startTask(task);
+
+  return this->finishTask();
+}
+
+
+// the first subdomain asked in a round starts the task on all of them
+int
+ThreadedSubdomain::startRound(int task)
+{
+  // started by another subdomain in this round
+  if (startedTask == task)
+    return 0;
+
+  int numSubdomains = theGroup.getNumSubdomains();
+  for (int i=0; i<numSubdomains; i++) {
+    ThreadedSubdomain *theSub = theGroup.getSubdomain(i);
+    if (theSub->startedTask != task && theSub->getDDAnalysis() != 0) {
+      theSub->finishTask();
+      theSub->startTask(task);
+    }
+  }
+
+  return 0;
+}
+
+
+int
+ThreadedSubdomain::computeTang(void)
+{
+  if (this->getDDAnalysis() == 0)
+    return this->Subdomain::computeTang();
+
+  return this->startRound(ThreadedSubdomain_computeTang);
+}
+
+
+const Matrix &
+ThreadedSubdomain::getTang(void)
+{
+  if (this->finishTask() < 0)
+    opserr << "ThreadedSubdomain::getTang() - failed to form the tangent in subdomain " << this->getTag() << endln;
+
+  return this->Subdomain::getTang();
+}
+
+
+int
+ThreadedSubdomain::computeResidual(void)
+{
+  if (this->getDDAnalysis() == 0)
+    return this->Subdomain::computeResidual();
+
+  return this->startRound(ThreadedSubdomain_computeResidual);
+}
+
+
+const Vector &
+ThreadedSubdomain::getResistingForce(void)
+{
+  if (this->finishTask() < 0)
+    opserr << "ThreadedSubdomain::getResistingForce() - failed to form the residual in subdomain " << this->getTag() << endln;
+
+  return this->Subdomain::getResistingForce();
+}
+
+
+int
+ThreadedSubdomain::computeNodalResponse(void)
+{
+  return this->runTask(ThreadedSubdomain_computeNodalResponse);
+}
+
+
+int
+ThreadedSubdomain::analysisStep(double deltaT)
+{
+  this->finishTask();
+  theDT = deltaT;
+
+  return this->runTask(ThreadedSubdomain_analysisStep);
+}
+
+
+int
+ThreadedSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
+{
+  this->finishTask();
+  numModes = numMode;
+  generalizedModes = generalized;
+  smallestModes = findSmallest;
+
+  return this->runTask(ThreadedSubdomain_eigenAnalysis);
+}
+
+
+int
+ThreadedSubdomain::commit(void)
+{
+  return this->runTask(ThreadedSubdomain_commit);
+}
+
+
+int
+ThreadedSubdomain::revertToLastCommit(void)
+{
+  return this->runTask(ThreadedSubdomain_revertToLastCommit);
+}
+
+
+int
+ThreadedSubdomain::revertToStart(void)
+{
+  return this->runTask(ThreadedSubdomain_revertToStart);
+}
+
+
+int
+ThreadedSubdomain::update(void)
+{
+  return this->runTask(ThreadedSubdomain_update);
+}
+
+
+int
+ThreadedSubdomain::update(double newTime, double dT)
+{
+  this->finishTask();
+  theTime = newTime;
+  theDT = dT;
+
+  return this->runTask(ThreadedSubdomain_updateTimeDt);
+}
+
+
+void
+ThreadedSubdomain::clearAll(void)
+{
+  this->finishTask();
+  this->Subdomain::clearAll();
+}
+
+
+void
+ThreadedSubdomain::wipeAnalysis(void)
+{
+  this->finishTask();
+  this->Subdomain::wipeAnalysis();
+  theBroker = 0;
+}
+
+
+void
+ThreadedSubdomain::setDomainDecompAnalysis(DomainDecompositionAnalysis &theAnalysis)
+{
+  this->finishTask();
+  this->Subdomain::setDomainDecompAnalysis(theAnalysis);
+}
+
+
+int
+ThreadedSubdomain::copyObject(MovableObject &theObject, MovableObject &theCopy)
+{
+  LocalChannel theChannel;
+
+  if (theChannel.sendObj(0, theObject) < 0 ||
+      theChannel.recvObj(0, theCopy, *theBroker) < 0) {
+    opserr << "ThreadedSubdomain::copyObject() - failed to copy object in subdomain " << this->getTag() << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+ThreadedSubdomain::buildDomainDecompAnalysis(ConstraintHandler &theHandler,
+					     DOF_Numberer &theNumberer,
+					     IncrementalIntegrator &theIntegrator,
+					     FEM_ObjectBroker &theObjectBroker)
+{
+  this->wipeAnalysis();
+  theBroker = &theObjectBroker;
+
+  ConstraintHandler *theNewHandler = theBroker->getNewConstraintHandler(theHandler.getClassTag());
+  DOF_Numberer *theNewNumberer = theBroker->getNewNumberer(theNumberer.getClassTag());
+  IncrementalIntegrator *theNewIntegrator = theBroker->getNewIncrementalIntegrator(theIntegrator.getClassTag());
+
+  if (theNewHandler == 0 || theNewNumberer == 0 || theNewIntegrator == 0 ||
+      this->copyObject(theHandler, *theNewHandler) < 0 ||
+      this->copyObject(theNumberer, *theNewNumberer) < 0 ||
+      this->copyObject(theIntegrator, *theNewIntegrator) < 0) {
+    opserr << "ThreadedSubdomain::buildDomainDecompAnalysis() - failed to copy the analysis objects\n";
+    if (theNewHandler != 0)
+      delete theNewHandler;
+    if (theNewNumberer != 0)
+      delete theNewNumberer;
+    if (theNewIntegrator != 0)
+      delete theNewIntegrator;
+    theBroker = 0;
+    return -1;
+  }
+
+  ProfileSPDLinSubstrSolver *theSolver = new ProfileSPDLinSubstrSolver();
+  LinearSOE *theSOE = new ProfileSPDLinSOE(*theSolver);
+
+  // the analysis sets itself as the analysis of this subdomain
+  new DomainDecompositionAnalysis(*this,
+				  *theNewHandler,
+				  *theNewNumberer,
+				  *(new AnalysisModel()),
+				  *(new DomainDecompAlgo()),
+				  *theNewIntegrator,
+				  *theSOE,
+				  *theSolver,
+				  0);
+
+  return 0;
+}
+
+
+// a subdomain whose analysis was built here condenses with it, only a
+// new integrator is copied in; other subdomains are given the objects
+
+int
+ThreadedSubdomain::setAnalysisAlgorithm(EquiSolnAlgo &theAlgorithm)
+{
+  if (theBroker != 0)
+    return 0;
+
+  this->finishTask();
+  return this->Subdomain::setAnalysisAlgorithm(theAlgorithm);
+}
+
+
+int
+ThreadedSubdomain::setAnalysisIntegrator(IncrementalIntegrator &theIntegrator)
+{
+  this->finishTask();
+
+  if (theBroker == 0)
+    return this->Subdomain::setAnalysisIntegrator(theIntegrator);
+
+  IncrementalIntegrator *theNewIntegrator = theBroker->getNewIncrementalIntegrator(theIntegrator.getClassTag());
+  if (theNewIntegrator == 0 || this->copyObject(theIntegrator, *theNewIntegrator) < 0) {
+    opserr << "ThreadedSubdomain::setAnalysisIntegrator() - failed to copy the integrator\n";
+    if (theNewIntegrator != 0)
+      delete theNewIntegrator;
+    return -1;
+  }
+
+  return this->Subdomain::setAnalysisIntegrator(*theNewIntegrator);
+}
+
+
+int
+ThreadedSubdomain::setAnalysisLinearSOE(LinearSOE &theSOE)
+{
+  if (theBroker != 0)
+    return 0;
+
+  this->finishTask();
+  return this->Subdomain::setAnalysisLinearSOE(theSOE);
+}
+
+
+int
+ThreadedSubdomain::setAnalysisEigenSOE(EigenSOE &theSOE)
+{
+  if (theBroker != 0)
+    return 0;
+
+  this->finishTask();
+  return this->Subdomain::setAnalysisEigenSOE(theSOE);
+}
+
+
+int
+ThreadedSubdomain::setAnalysisConvergenceTest(ConvergenceTest &theTest)
+{
+  if (theBroker != 0)
+    return 0;
+
+  this->finishTask();
+  return this->Subdomain::setAnalysisConvergenceTest(theTest);
+}
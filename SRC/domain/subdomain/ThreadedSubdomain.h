@@ -0,0 +1,144 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ThreadedSubdomain_h
+#define ThreadedSubdomain_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definitions for
+// ThreadedSubdomain and ThreadedSubdomainGroup. A ThreadedSubdomain is a
+// Subdomain in the same process as the PartitionedDomain, with its own
+// worker thread on which all of its state determination is done. As with
+// the ShadowSubdomain, the first computeTang() or computeResidual() of a
+// round starts the work for all the ThreadedSubdomains of the
+// PartitionedDomain, and getTang() or getResistingForce() collects the
+// result of each in turn. The other operations run on the worker and are
+// waited for. The ThreadedSubdomains of a PartitionedDomain are kept in
+// its ThreadedSubdomainGroup.
+//
+// Elements, materials and the analysis model objects share static work
+// storage, so the element and nodal work of the subdomains of a domain is
+// serialized by the element mutex of the group; the condensation of each
+// subdomain matrix by its DomainDecompositionAnalysis, which only uses
+// the subdomain's own system of equations, runs concurrently. For the
+// same reason no elements are to be left in the PartitionedDomain itself.
+//
+// What: "@(#) ThreadedSubdomain.h, revA"
+
+#include <Subdomain.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class PartitionedDomain;
+class ThreadedSubdomain;
+class MovableObject;
+class FEM_ObjectBroker;
+class ConstraintHandler;
+class DOF_Numberer;
+
+class ThreadedSubdomainGroup
+{
+  public:
+    ThreadedSubdomainGroup();
+    ~ThreadedSubdomainGroup();
+
+    int addSubdomain(ThreadedSubdomain *theSubdomain);
+    int removeSubdomain(ThreadedSubdomain *theSubdomain);
+    int getNumSubdomains(void) const;
+    ThreadedSubdomain *getSubdomain(int i) const;
+    std::mutex &getElementMutex(void);
+
+  private:
+    std::vector<ThreadedSubdomain *> theSubdomains;
+    std::mutex elementMutex;
+};
+
+class ThreadedSubdomain: public Subdomain
+{
+  public:
+    ThreadedSubdomain(int tag, PartitionedDomain &theDomain);
+    virtual ~ThreadedSubdomain();
+
+    virtual void clearAll(void);
+    virtual int commit(void);
+    virtual int revertToLastCommit(void);
+    virtual int revertToStart(void);
+    virtual int update(void);
+    virtual int update(double newTime, double dT);
+
+    virtual void wipeAnalysis(void);
+    virtual void setDomainDecompAnalysis(DomainDecompositionAnalysis &theAnalysis);
+    virtual int setAnalysisAlgorithm(EquiSolnAlgo &theAlgorithm);
+    virtual int setAnalysisIntegrator(IncrementalIntegrator &theIntegrator);
+    virtual int setAnalysisLinearSOE(LinearSOE &theSOE);
+    virtual int setAnalysisEigenSOE(EigenSOE &theSOE);
+    virtual int setAnalysisConvergenceTest(ConvergenceTest &theTest);
+
+    // builds the subdomain's own DomainDecompositionAnalysis: copies of
+    // theHandler, theNumberer and theIntegrator, made with sendSelf() and
+    // recvSelf(), a new AnalysisModel and DomainDecompAlgo and a
+    // ProfileSPDLinSOE with a ProfileSPDLinSubstrSolver to condense
+    int buildDomainDecompAnalysis(ConstraintHandler &theHandler,
+				  DOF_Numberer &theNumberer,
+				  IncrementalIntegrator &theIntegrator,
+				  FEM_ObjectBroker &theBroker);
+
+    virtual int computeTang(void);
+    virtual int computeResidual(void);
+    virtual const Matrix &getTang(void);
+    virtual const Vector &getResistingForce(void);
+    virtual int computeNodalResponse(void);
+    virtual int analysisStep(double deltaT);
+    virtual int eigenAnalysis(int numMode, bool generalized, bool findSmallest);
+
+  protected:
+
+  private:
+    int startTask(int task);
+    int finishTask(void);
+    int runTask(int task);
+    int startRound(int task);
+    int doTask(int task);
+    int copyObject(MovableObject &theObject, MovableObject &theCopy);
+    void run(void);
+
+    ThreadedSubdomainGroup &theGroup;
+    std::thread *theThread;
+    std::mutex theMutex;
+    std::condition_variable theCondition;
+    int theTask;           // the task given to the worker, 0 if none
+    int startedTask;       // the task started and not yet collected, 0 if none
+    bool done;             // the worker is to exit
+    int taskResult;
+
+    double theTime, theDT; // arguments of the task
+    int numModes;
+    bool generalizedModes, smallestModes;
+
+    FEM_ObjectBroker *theBroker; // set if the analysis was built here
+};
+
+#endif
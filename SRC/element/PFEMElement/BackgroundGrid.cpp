@@ -28,6 +28,7 @@
 //
 
 #include "BackgroundGrid.h"
+#include "Particle.h"
 #include <Domain.h>
 #include <Element.h>
 #include <Node.h>
@@ -101,6 +102,32 @@ BackgroundGrid::addParticle(const GridIndex& index, Particle* p)
     }
 }
 
+void
+BackgroundGrid::addParticles(const GridIndex& index, Particle* p, int num)
+{
+    // the particles p[0] to p[num-1] are all in this grid, so
+    // the grids are found once for all of them
+    if (num <= 0) return;
+    this->addParticle(index, p);
+
+    std::vector<Particle*>& particles = data[index]->particles;
+    particles.reserve(particles.size()+num-1);
+    for (int i=1; i<num; i++) {
+	particles.push_back(&p[i]);
+    }
+}
+
+void
+BackgroundGrid::getIndices(std::vector<GridIndex>& indices) const
+{
+    indices.clear();
+    indices.reserve(data.size());
+    std::map<GridIndex,GridData*>::const_iterator it;
+    for (it=data.begin(); it!=data.end(); it++) {
+	indices.push_back(it->first);
+    }
+}
+
 void
 BackgroundGrid::addElement(const GridIndex& index, Element* e)
 {
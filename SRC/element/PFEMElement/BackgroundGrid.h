@@ -95,6 +95,7 @@ public:
     // add and get
     void addGrid(const GridIndex& index);
     void addParticle(const GridIndex& index, Particle* p);
+    void addParticles(const GridIndex& index, Particle* p, int num);
     void setNode(const GridIndex& index, Node* nd);
     void addElement(const GridIndex& index, Element* e);
     
@@ -104,6 +105,7 @@ public:
     bool hasGrid(const GridIndex& index);
 
     int numGridPoints() const {return (int)data.size();}
+    void getIndices(std::vector<GridIndex>& indices) const;
 
     // iterators
     GridIndex getIndex() const;
@@ -46,6 +46,8 @@
 #include <fstream>
 #include <iostream>
 #include <string.h>
+#include <algorithm>
+#include <ThreadPool.h>
 
 void* OPS_PVDRecorder();
 
@@ -54,6 +56,60 @@ BackgroundMesh backgroundMesh;
 
 double BackgroundMesh::pi = 3.141592653589793;
 
+// nodal values of a cell without structural nodes, which are
+// interpolated to the particles in the cell
+struct CellMotion {
+    double x0, y0;
+    double disp[4][3];
+    double vel[4][3];
+    double pressure[4];
+    std::vector<Particle*>* particles;
+};
+
+static void
+moveCellParticles(const CellMotion& cell, double size)
+{
+    for (int i=0; i<(int)cell.particles->size(); i++) {
+	Particle* p = (*cell.particles)[i];
+	if (p == 0) continue;
+	ParticleGroup* group = p->getGroup();
+	int id = p->getIndex();
+	int ndm = group->getNDM();
+	int ndf = group->getNDF();
+	if (ndm < 2) continue;
+
+	// shape functions
+	double* crds = group->getCrds(id);
+	double xl = (crds[0]-cell.x0)/size*2-1;
+	double yl = (crds[1]-cell.y0)/size*2-1;
+	double N[4];
+	N[0] = (1-xl)*(1-yl)/4.0;
+	N[1] = (1+xl)*(1-yl)/4.0;
+	N[2] = (1+xl)*(1+yl)/4.0;
+	N[3] = (1-xl)*(1+yl)/4.0;
+
+	// move the particle
+	for (int k=0; k<ndm && k<3; k++) {
+	    for (int j=0; j<4; j++) {
+		crds[k] += N[j]*cell.disp[j][k];
+	    }
+	}
+	double* vel = group->getVel(id);
+	for (int k=0; k<ndf; k++) {
+	    vel[k] = 0.0;
+	    if (k >= 3) continue;
+	    for (int j=0; j<4; j++) {
+		vel[k] += N[j]*cell.vel[j][k];
+	    }
+	}
+	double ppre = 0.0;
+	for (int j=0; j<4; j++) {
+	    ppre += N[j]*cell.pressure[j];
+	}
+	group->getPressure(id) = ppre;
+    }
+}
+
 BackgroundMesh& OPS_GetBackgroundMesh()
 {
     return backgroundMesh;
@@ -96,6 +152,21 @@ int OPS_BackgroundMesh()
 	}
 	background->setMeshsize(size);
 
+    } else if (strcmp(type, "threads") == 0) {
+
+	if (OPS_GetNumRemainingInputArgs() <1) {
+	    opserr<<"WARNING: insufficient args\n";
+	    return -1;
+	}
+
+	int num = 1;
+	int numThreads;
+	if (OPS_GetIntInput(&num, &numThreads) < 0) {
+	    opserr<<"WARNING: failed to get number of threads\n";
+	    return -1;
+	}
+	background->setNumThreads(numThreads);
+
     } else if (strcmp(type, "pvd") == 0) {
 
 	PVDRecorder* recorder = (PVDRecorder*)OPS_PVDRecorder();
@@ -428,7 +499,7 @@ int OPS_BackgroundMesh()
 
 BackgroundMesh::BackgroundMesh()
     :groups(), fixInfo(), grids(), structuralNodes(), structuralCoord(),
-     connectedNodes(), theRecorder(0)
+     connectedNodes(), theRecorder(0), numThreads(1)
 {
 }
 
@@ -580,26 +651,46 @@ BackgroundMesh::fix()
 int
 BackgroundMesh::particlesInGrids()
 {
+    double size = grids.getSize();
     
     for (int i=0; i<(int)groups.size(); i++) {
 	ParticleGroup* group = groups[i];
 	if (group == 0) continue;
 
-	for (int j=0; j<group->numParticles(); j++) {
-	    Particle* p = group->getParticle(j);
-	    if (p == 0) return -1;
-	    
-	    // locate the particle 
-	    const Vector& crds = p->getCrds();
-	    if (crds.Size() < 2) return -1;
-
-	    int nx = (int)floor(crds(0)/grids.getSize());
-	    int ny = (int)floor(crds(1)/grids.getSize());
+	int num = group->numParticles();
+	if (num == 0) continue;
+	if (group->getNDM() < 2) return -1;
+
+	// locate the particles
+	std::vector<GridIndex> cells(num);
+	parallelFor(num, numThreads, [&](int begin, int end) {
+		for (int j=begin; j<end; j++) {
+		    const double* crds = group->getCrds(j);
+		    int nx = (int)floor(crds[0]/size);
+		    int ny = (int)floor(crds[1]/size);
+		    cells[j] = GridIndex(nx,ny);
+		}
+	    });
 
-	    // add particle to the grid
-	    GridIndex index(nx,ny);
-	    grids.addParticle(index,p);
+	// sort the particles by grid, so that the particles of a grid
+	// are contiguous in the group and the grids are visited in
+	// the order the particles are stored
+	std::vector<int> order(num);
+	for (int j=0; j<num; j++) {
+	    order[j] = j;
+	}
+	std::stable_sort(order.begin(), order.end(),
+			 [&cells](int a, int b) {return cells[a] < cells[b];});
+	group->reorder(order);
 
+	// add each run of particles in the same grid
+	int j = 0;
+	while (j < num) {
+	    const GridIndex& index = cells[order[j]];
+	    int k = j+1;
+	    while (k < num && !(index < cells[order[k]])) k++;
+	    grids.addParticles(index, group->getParticle(j), k-j);
+	    j = k;
 	}
     }
     
@@ -784,83 +875,115 @@ BackgroundMesh::nodesInGrids()
 	return 0;
     }
 
-    // for each grid
-    grids.reset();
-    while (grids.isEnd() == false) {
+    double size = grids.getSize();
 
-	// get locations of neibors
-	GridIndex index[4];
-	index[0] = grids.getIndex();
-	if (index[0].isValid() == false) {
-	    opserr<<"index[0].isValid() == false\n";
-	    grids.next();
-	    continue;
+    // velocity size
+    int ndf = 0;
+    for (int i=0; i<(int)groups.size(); i++) {
+	if (groups[i] != 0 && groups[i]->getNDF() > ndf) {
+	    ndf = groups[i]->getNDF();
 	}
-	index[1] = index[0].west();
-	index[2] = index[0].southWest();
-	index[3] = index[0].south();
-
-	// grid's crds
-	double x = index[0].getX(grids.getSize());
-	double y = index[0].getY(grids.getSize());
+    }
 
-	// nodal data
-	double wt = 0.0, pressure = 0.0;
-	Vector vel;
+    // nodal data of all grids, in which the particles around
+    // each grid are mapped in parallel
+    std::vector<GridIndex> indices;
+    grids.getIndices(indices);
+    int numGrids = (int)indices.size();
+    std::vector<double> wts(numGrids, 0.0);
+    std::vector<double> pressures(numGrids, 0.0);
+    std::vector<double> vels(numGrids*ndf, 0.0);
+    std::vector<int> velSizes(numGrids, 0);
+
+    parallelFor(numGrids, numThreads, [&](int begin, int end) {
+	    for (int g=begin; g<end; g++) {
+
+		// get locations of neibors
+		GridIndex index[4];
+		index[0] = indices[g];
+		if (index[0].isValid() == false) continue;
+		index[1] = index[0].west();
+		index[2] = index[0].southWest();
+		index[3] = index[0].south();
+
+		// grid's crds
+		double x = index[0].getX(size);
+		double y = index[0].getY(size);
+
+		// nodal data
+		double wt = 0.0, pressure = 0.0;
+		double* vel = vels.data() + g*ndf;
+		int& velSize = velSizes[g];
 	
-	// map all particles in neighbor to current location
-	for (int i=0; i<4; i++) {
+		// map all particles in neighbor to current location
+		for (int i=0; i<4; i++) {
 
-	    // particles
-	    std::vector<Particle*>* particles = grids.getParticles(index[i]);
-	    if (particles == 0) continue;
+		    // particles
+		    std::vector<Particle*>* particles = grids.getParticles(index[i]);
+		    if (particles == 0) continue;
 
-	    // for each particle
-	    for (int j=0; j<(int)particles->size(); j++) {
+		    // for each particle
+		    for (int j=0; j<(int)particles->size(); j++) {
 
-		Particle* p = (*particles)[j];
-		if (p == 0) continue;
+			Particle* p = (*particles)[j];
+			if (p == 0) continue;
+			ParticleGroup* group = p->getGroup();
+			int id = p->getIndex();
 
-		// particle crds
-		const Vector& crds = p->getCrds();
-		if (crds.Size() < 2) continue;
+			// particle crds
+			int ndm = group->getNDM();
+			if (ndm < 2) continue;
+			const double* crds = group->getCrds(id);
 
-		// distance from particle to current location
-		double dx = crds(0) - x;
-		double dy = crds(1) - y;
-		double q = sqrt(dx*dx+dy*dy)/grids.getSize();
+			// distance from particle to current location
+			double dx = crds[0] - x;
+			double dy = crds[1] - y;
+			double q = sqrt(dx*dx+dy*dy)/size;
 
-		// weight for the particle
-		double w = QuinticKernel(q, grids.getSize(), crds.Size());
+			// weight for the particle
+			double w = QuinticKernel(q, size, ndm);
 
-		// add weight
-		wt += w;
+			// add weight
+			wt += w;
 
-		// add pressure
-		pressure += p->getPressure() * w;
+			// add pressure
+			pressure += group->getPressure(id) * w;
 
-		// add velocity
-		const Vector& pvel = p->getVel();
-		if (vel.Size() == 0) {
-		    vel.resize(pvel.Size());
-		    vel.Zero();
-		}
-		for (int k=0; k<vel.Size(); k++) {
-		    if (k < pvel.Size()) {
-			vel(k) += w*pvel(k);
+			// add velocity
+			const double* pvel = group->getVel(id);
+			int pvelSize = group->getNDF();
+			if (velSize == 0) {
+			    velSize = pvelSize;
+			}
+			for (int k=0; k<velSize && k<pvelSize; k++) {
+			    vel[k] += w*pvel[k];
+			}
 		    }
 		}
+
+		wts[g] = wt;
+		pressures[g] = pressure;
 	    }
-	}
+	});
+
+    // create the nodes in order
+    for (int g=0; g<numGrids; g++) {
 
+	double wt = wts[g];
 	if (wt == 0) {
-	    grids.next();
 	    continue;
 	}
 
 	// get nodal data
-	pressure /= wt;
-	vel /= wt;
+	double pressure = pressures[g]/wt;
+	Vector vel(velSizes[g]);
+	for (int k=0; k<vel.Size(); k++) {
+	    vel(k) = vels[g*ndf+k]/wt;
+	}
+
+	// grid's crds
+	double x = indices[g].getX(size);
+	double y = indices[g].getY(size);
 
 	// create a new node
 	Node* node = 0;
@@ -901,10 +1024,7 @@ BackgroundMesh::nodesInGrids()
 	}
 
 	// add node to the grid
-	grids.setNode(node);
-
-	// go to next grid
-	grids.next();
+	grids.setNode(indices[g], node);
     }
    
     
@@ -1542,6 +1662,13 @@ BackgroundMesh::moveParticles()
     
     Domain* domain = OPS_GetDomain();
     if (domain == 0) return 0;
+
+    double size = grids.getSize();
+
+    // the cells without structural nodes, whose particles are moved in
+    // parallel, and the cells with, whose particles are moved after
+    std::vector<CellMotion> cells;
+    std::vector<GridIndex> structuralCells;
     
     // for each grid
     grids.reset();
@@ -1579,181 +1706,200 @@ BackgroundMesh::moveParticles()
 	    }
 	}
 
-	// if a corner node is structural node
-	// gather particles
-	std::map< GridIndex, std::vector<Particle*>* > allparticles;
+	// if a corner node is structural node, the particles are
+	// moved with the elements
+	bool structural = false;
 	for (int i=0; i<4; i++) {
 	    if (structuralNodes.getLocationOrdered(nodes[i]->getTag()) >= 0) {
-		allparticles[index[i]] = grids.getParticles(index[i]);
-		allparticles[index[i].west()] = grids.getParticles(index[i].west());
-		allparticles[index[i].southWest()] = grids.getParticles(index[i].southWest());
-		allparticles[index[i].south()] = grids.getParticles(index[i].south());
+		structural = true;
 	    }
 	}
+	if (structural) {
+	    structuralCells.push_back(index[0]);
+	    grids.next();
+	    continue;
+	}
 
 	// if no structural node, move particles in the cell
-	if (allparticles.empty()) {
+	std::vector<Particle*>* particles = grids.getParticles();
+	if (particles == 0 || particles->empty()) {
+	    grids.next();
+	    continue;
+	}
 
-	    std::vector<Particle*>* particles = grids.getParticles();
-	    if (particles == 0) {
-		grids.next();
-		continue;
+	// grid's crds and nodal data
+	CellMotion cell;
+	cell.x0 = index[0].getX(size);
+	cell.y0 = index[0].getY(size);
+	cell.particles = particles;
+	for (int j=0; j<4; j++) {
+	    const Vector& disp = nodes[j]->getDisp();
+	    const Vector& vel = nodes[j]->getVel();
+	    for (int k=0; k<3; k++) {
+		cell.disp[j][k] = k<disp.Size()? disp(k):0.0;
+		cell.vel[j][k] = k<vel.Size()? vel(k):0.0;
 	    }
-	    if (particles->empty()) {
-		grids.next();
-		continue;
+	    Pressure_Constraint* pc = domain->getPressure_Constraint(nodes[j]->getTag());
+	    cell.pressure[j] = 0.0;
+	    if (pc != 0) cell.pressure[j] = pc->getPressure();
+	}
+	cells.push_back(cell);
+
+	grids.next();
+    }
+
+    // each cell moves only its own particles
+    parallelFor((int)cells.size(), numThreads, [&](int begin, int end) {
+	    for (int c=begin; c<end; c++) {
+		moveCellParticles(cells[c], size);
 	    }
+	});
 
-	    // grid's crds
-	    double x0 = index[0].getX(grids.getSize());
-	    double y0 = index[0].getY(grids.getSize());
+    // the particles around structural nodes
+    for (int c=0; c<(int)structuralCells.size(); c++) {
+	if (moveParticlesInElements(structuralCells[c]) < 0) {
+	    return -1;
+	}
+    }
+    
+    return 0;
+}
 
-	    // shape functions
-	    Vector N;
-	
-	    // move all particles in the cell
-	    for (int i=0; i<(int)particles->size(); i++) {
+int
+BackgroundMesh::moveParticlesInElements(const GridIndex& center)
+{
+    Domain* domain = OPS_GetDomain();
+    if (domain == 0) return 0;
 
-		// get shape function
-		const Vector& crds = (*particles)[i]->getCrds();
-		if (crds.Size() < 2) continue;
-		getNForRect(x0,y0,grids.getSize(),grids.getSize(),crds(0),crds(1),N);
-		Vector pdisp(crds.Size());
-		Vector pvel((*particles)[i]->getVel().Size());
-		double ppre = 0.0;
-
-		// interpolation
-		for (int j=0; j<4; j++) {
-		    const Vector& disp = nodes[j]->getDisp();
-		    const Vector& vel = nodes[j]->getVel();
-		    Pressure_Constraint* pc = domain->getPressure_Constraint(nodes[j]->getTag());
-		    double pressure = 0.0;
-		    if (pc != 0) pressure = pc->getPressure();
-
-		    for (int k=0; k<pdisp.Size(); k++) {
-			if (k < disp.Size()) {
-			    pdisp(k) += N(j)*disp(k);
-			}
-		    }
-		    for (int k=0; k<pvel.Size(); k++) {
-			if (k < vel.Size()) {
-			    pvel(k) += N(j)*vel(k);
-			}
-		    }
-		    if (pressure != 0.0) {
-			ppre += N(j) * pressure;
-		    }
-		}
+    // get all four grid points
+    GridIndex index[4];
+    index[0] = center;
+    index[1] = index[0].east();
+    index[2] = index[0].northEast();
+    index[3] = index[0].north();
+
+    // get grid elements
+    std::vector<Element*>* eles = grids.getElements(center);
+    if (eles == 0 || eles->empty()) {
+	return 0;
+    }
+
+    // get all four nodes
+    Node* nodes[4];
+    for (int i=0; i<4; i++) {
+	nodes[i] = grids.getNode(index[i]);
+	if (nodes[i] == 0) {
+	    opserr << "WARNING: no corner node "<<i<<"\n";
+	    return -1;
+	}
+    }
 
-		// move the particle
-		(*particles)[i]->move(pdisp);
-		(*particles)[i]->setVel(pvel);
-		(*particles)[i]->setPressure(ppre);
+    // gather particles around the structural nodes
+    std::map< GridIndex, std::vector<Particle*>* > allparticles;
+    for (int i=0; i<4; i++) {
+	if (structuralNodes.getLocationOrdered(nodes[i]->getTag()) >= 0) {
+	    allparticles[index[i]] = grids.getParticles(index[i]);
+	    allparticles[index[i].west()] = grids.getParticles(index[i].west());
+	    allparticles[index[i].southWest()] = grids.getParticles(index[i].southWest());
+	    allparticles[index[i].south()] = grids.getParticles(index[i].south());
+	}
+    }
+
+    // move particles in the elements
+    Vector N;
+    for (int i=0; i<(int)eles->size(); i++) {
+
+	// get element
+	Element* ele = (*eles)[i];
+	if (ele == 0) continue;
+	if (ele->getNumExternalNodes() != 6) {
+	    opserr << "WARNING: fluid element has number of fluid nodes != 3\n";
+	    return -1;
+	}
+
+	// get element nodes original coordinates
+	Node** elenodes = ele->getNodePtrs();
+	double pressure[3] = {0.,0.,0.};
+	double x[3], y[3], vx[3], vy[3];
+	double posx[3], posy[3];
+	for (int j=0; j<3; j++) {
+	    int loc = structuralNodes.getLocationOrdered(elenodes[2*j]->getTag());
+
+	    // get displacement
+	    const Vector& disp = elenodes[2*j]->getDisp();
+	    double ux = disp(0);
+	    double uy = disp(1);
+
+	    // node cooridnates of original step
+	    const Vector& crds = elenodes[2*j]->getCrds();
+	    x[j] = crds(0);
+	    y[j] = crds(1);
+
+	    // current position for both fluid and structure
+	    posx[j] = x[j] + ux;
+	    posy[j] = y[j] + uy;
+
+	    // structural node coordinates of last time step
+	    if (loc >= 0) {
+		const Vector& crds1 = structuralCoord[loc];
+		x[j] = crds1(0);
+		y[j] = crds1(1);
 	    }
-	} else {
 
-	    // if there is structural nodes, move particles in elements
+	    // get vel
+	    const Vector& vel = elenodes[2*j]->getVel();
+	    vx[j] = vel(0);
+	    vy[j] = vel(1);
 
-	    // move particles in the elements
-	    Vector N;
-	    for (int i=0; i<(int)eles->size(); i++) {
+	    // get pressure
+	    Pressure_Constraint* pc = domain->getPressure_Constraint(elenodes[2*j]->getTag());
+	    if (pc != 0) {
+		pressure[j] = pc->getPressure();
+	    }
+	    
+	}
 
-		// get element
-		Element* ele = (*eles)[i];
-		if (ele == 0) continue;
-		if (ele->getNumExternalNodes() != 6) {
-		    opserr << "WARNING: fluid element has number of fluid nodes != 3\n";
-		    return -1;
-		}
+	// check each particle
+	std::map< GridIndex, std::vector<Particle*>* >::iterator it;
+	for (it=allparticles.begin(); it!=allparticles.end(); it++) {
+	    if (it->second == 0) continue;
+	    if (it->second->empty()) continue;
 
-		// get element nodes original coordinates
-		Node** elenodes = ele->getNodePtrs();
-		double pressure[3] = {0.,0.,0.};
-		double x[3], y[3], vx[3], vy[3];
-		double posx[3], posy[3];
-		for (int j=0; j<3; j++) {
-		    int loc = structuralNodes.getLocationOrdered(elenodes[2*j]->getTag());
-
-                    // get displacement
-		    const Vector& disp = elenodes[2*j]->getDisp();
-		    double ux = disp(0);
-		    double uy = disp(1);
-
-		    // node cooridnates of original step
-		    const Vector& crds = elenodes[2*j]->getCrds();
-		    x[j] = crds(0);
-		    y[j] = crds(1);
-
-		    // current position for both fluid and structure
-		    posx[j] = x[j] + ux;
-		    posy[j] = y[j] + uy;
-
-		    // structural node coordinates of last time step
-		    if (loc >= 0) {
-			const Vector& crds1 = structuralCoord[loc];
-			x[j] = crds1(0);
-			y[j] = crds1(1);
-		    }
+	    for (int j=0; j<(int)it->second->size(); j++) {
+		Particle* p = (*(it->second))[j];
+		if (p == 0) continue;
+		const Vector& crds = p->getCrds();
+		if (crds.Size() < 2) continue;
+		getNForTri(x[0],y[0],x[1],y[1],x[2],y[2],crds(0),crds(1),N);
 
-		    // get vel
-		    const Vector& vel = elenodes[2*j]->getVel();
-		    vx[j] = vel(0);
-		    vy[j] = vel(1);
+		// this particle is in the element
+		if (N(0)>=0 && N(0)<=1 && N(1)>=0 && N(1)<=1 && N(2)>=0 && N(2)<=1) {
 
-		    // get pressure
-		    Pressure_Constraint* pc = domain->getPressure_Constraint(elenodes[2*j]->getTag());
-		    if (pc != 0) {
-			pressure[j] = pc->getPressure();
-		    }
-		    
-		}
+		    // move the particle
+		    Vector pcrds(crds.Size());
+		    Vector pvel(p->getVel().Size());
+		    double ppre = 0.0;
 
-		// check each particle
-		std::map< GridIndex, std::vector<Particle*>* >::iterator it;
-		for (it=allparticles.begin(); it!=allparticles.end(); it++) {
-		    if (it->second == 0) continue;
-		    if (it->second->empty()) continue;
+		    // interpolation
+		    for (int k=0; k<3; k++) {
 
-		    for (int j=0; j<(int)it->second->size(); j++) {
-			Particle* p = (*(it->second))[j];
-			if (p == 0) continue;
-			const Vector& crds = p->getCrds();
-			if (crds.Size() < 2) continue;
-			getNForTri(x[0],y[0],x[1],y[1],x[2],y[2],crds(0),crds(1),N);
-
-			// this particle is in the element
-			if (N(0)>=0 && N(0)<=1 && N(1)>=0 && N(1)<=1 && N(2)>=0 && N(2)<=1) {
-
-			    // move the particle
-			    Vector pcrds(crds.Size());
-			    Vector pvel(p->getVel().Size());
-			    double ppre = 0.0;
-
-			    // interpolation
-			    for (int k=0; k<3; k++) {
-
-				pcrds(0) += N(k) * posx[k];
-				pcrds(1) += N(k) * posy[k];
-				pvel(0) += N(k) * vx[k];
-				pvel(1) += N(k) * vy[k];
-				ppre += N(k) * pressure[k];
-			    }
-
-			    // move the particle
-			    p->moveTo(pcrds);
-			    p->setVel(pvel);
-			    p->setPressure(ppre);
-			}
+			pcrds(0) += N(k) * posx[k];
+			pcrds(1) += N(k) * posy[k];
+			pvel(0) += N(k) * vx[k];
+			pvel(1) += N(k) * vy[k];
+			ppre += N(k) * pressure[k];
 		    }
+
+		    // move the particle
+		    p->moveTo(pcrds);
+		    p->setVel(pvel);
+		    p->setPressure(ppre);
 		}
-		
 	    }
-
 	}
 	
-	grids.next();
     }
-    
+
     return 0;
 }
 
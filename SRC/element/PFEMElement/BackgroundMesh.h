@@ -52,6 +52,9 @@ public:
     void setMeshsize(double size) {grids.setSize(size);}
     double getMeshsize() const {return grids.getSize();}
 
+    // threads for mapping between particles and grids
+    void setNumThreads(int num) {numThreads = num>0? num:1;}
+
     // add new particle group
     ParticleGroup* newParticleGroup();
 
@@ -87,6 +90,7 @@ private:
     int fix();
 
     int moveParticles();
+    int moveParticlesInElements(const GridIndex& center);
     // int structureToGrids();
     void clear();
     
@@ -109,6 +113,7 @@ private:
     std::vector<Vector> structuralCoord;
     std::map<int, ID> connectedNodes;
     PVDRecorder* theRecorder;
+    int numThreads;
 };
 
 BackgroundMesh& OPS_GetBackgroundMesh();
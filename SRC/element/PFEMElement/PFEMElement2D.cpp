@@ -30,6 +30,7 @@
 
 #include "PFEMElement2D.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -379,7 +380,10 @@ PFEMElement2D::getResistingForceIncInertia()
     P.Zero();
 
     // get v and p
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int a=0; a<3; a++) {
 
         const Vector& vel = nodes[2*a]->getTrialVel();
@@ -30,6 +30,7 @@
 
 #include "PFEMElement2DBubble.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -322,7 +323,10 @@ PFEMElement2DBubble::getResistingForceIncInertia()
     P.Zero();
 
     // get velocity, accleration
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int i=0; i<3; i++) {
         const Vector& accel = nodes[2*i]->getTrialAccel();
         vdot(numDOFs(2*i)) = accel(0);
@@ -1129,7 +1133,9 @@ PFEMElement2DBubble::getdK(const Vector& v, Matrix& dk) const
     getK(dk);
     dk *= -1.0/J;
 
-    Vector kv = dk*v;
+    double kvData[6];
+    Vector kv(kvData, 6);
+    kv = MatrixView(dk)*v;
 
     dk.Zero();
     for(int a=0; a<6; a++) {
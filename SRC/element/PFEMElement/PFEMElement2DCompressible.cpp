@@ -30,6 +30,7 @@
 
 #include "PFEMElement2DCompressible.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -701,7 +702,10 @@ PFEMElement2DCompressible::getResistingForceIncInertia()
     P(vydof[3]) = fb*b2;
     
     // vdot, v
-    Vector vdot(ndf), v(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int a=0; a<4; a++) {
 	const Vector& vel = nodes[2*a]->getTrialVel();
 	const Vector& accel = nodes[2*a]->getTrialAccel();
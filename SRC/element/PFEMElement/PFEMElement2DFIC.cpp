@@ -30,6 +30,7 @@
 
 #include "PFEMElement2DFIC.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -330,7 +331,10 @@ PFEMElement2DFIC::getResistingForceIncInertia()
     P.Zero();
 
     // get velocity, accleration
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int i=0; i<3; i++) {
         const Vector& accel = nodes[2*i]->getTrialAccel();
         vdot(numDOFs(2*i)) = accel(0);
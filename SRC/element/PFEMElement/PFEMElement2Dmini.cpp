@@ -30,6 +30,7 @@
 
 #include "PFEMElement2Dmini.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -337,7 +338,10 @@ PFEMElement2Dmini::getResistingForceIncInertia()
     P.Zero();
     
     // get velocity, accleration
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int a=0; a<3; a++) {
 
         const Vector& vel = nodes[2*a]->getTrialVel();
@@ -30,6 +30,7 @@
 
 #include "PFEMElement3D.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Node.h>
 #include <Pressure_Constraint.h>
@@ -344,7 +345,10 @@ PFEMElement3D::getResistingForceIncInertia()
     P.Zero();
 
     // get velocity, accleration
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int i=0; i<4; i++) {
         const Vector& accel = nodes[2*i]->getTrialAccel();
         vdot(numDOFs(2*i)) = accel(0);
@@ -27,6 +27,7 @@
 
 #include "PFEMElement3Dmini.h"
 #include <elementAPI.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Renderer.h>
 #include <Node.h>
@@ -343,7 +344,10 @@ PFEMElement3Dmini::getResistingForceIncInertia()
     int ndm = body.Size();
     
     // get velocity, accleration
-    Vector v(ndf), vdot(ndf);
+    MatrixExprWork vData(ndf), vdotData(ndf);
+    Vector v(vData, ndf), vdot(vdotData, ndf);
+    v.Zero();
+    vdot.Zero();
     for(int a=0; a<numnodes; a++) {
 
         const Vector& vel = nodes[2*a]->getTrialVel();
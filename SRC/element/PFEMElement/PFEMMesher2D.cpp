@@ -61,10 +61,13 @@
 #include <algorithm>
 #include <elementAPI.h>
 #include <MeshRegion.h>
+#include <classTags.h>
+#include <ThreadPool.h>
 
 double PFEMMesher2D::PI = 3.1415926535897932384626433;
 
 PFEMMesher2D::PFEMMesher2D()
+    :meshStates(), numThreads(1)
 {
 }
 
@@ -870,30 +873,10 @@ PFEMMesher2D::doTriangulation(int starteletag, double alpha, const ID& groups,
     }
 
     // add PFEM elements
-    int numeles = eles.Size()/3;
-    if(numeles == 0) return 0;
-    int etag = starteletag-1;
-    for(int i=0; i<numeles; i++) {
-        Element* theEle = 0;
-        if(type == 1) {
-            theEle = new PFEMElement2D(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk);
-        } else if(type == 3) {
-            theEle = new PFEMElement2DCompressible(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk, kappa);
-        } else if(type == 4) {
-            theEle = new PFEMElement2DBubble(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk, kappa);
-        }
-        
-        if(theEle == 0) {
-            opserr<<"WARNING: no enough memory -- ";
-            opserr<<" -- PFEMMesher2D::doTriangulation\n";
-            return -1;
-        }
-        if(theDomain->addElement(theEle) == false) {
-            opserr<<"WARNING: failed to add element to domain -- ";
-            opserr<<" -- PFEMMesher2D::doTriangulation\n";
-            delete theEle;
-            return -1;
-        }
+    if(eles.Size()/3 == 0) return 0;
+    if(addElements(starteletag,eles,theDomain,rho,mu,b1,b2,thk,kappa,
+                   type,endele) < 0) {
+        return -1;
     }
 
     // identify
@@ -901,7 +884,6 @@ PFEMMesher2D::doTriangulation(int starteletag, double alpha, const ID& groups,
     //timer.pause();
     //opserr<<"meshing :"<<timer.getCPU()<<"\n";
 
-    endele = etag;
     return res;
     
 }
@@ -929,39 +911,16 @@ PFEMMesher2D::doTriangulation(int starteletag, double alpha, const ID& groups,
         return res;
     }
 
-    NDMaterial *theMaterial = OPS_getNDMaterial(matTag);
-    if(theMaterial == 0) {
-        opserr << "WARNING:  Material " << matTag << "not found\n";
-        opserr<<"PFEMMesher2D::doTriangulation\n";
-        return -1;
-    }
-
     // add Tri31 elements
     //timer.start();
-    int numeles = eles.Size()/3;
-    if(numeles == 0) return 0;
-    int etag = starteletag-1;
-    for(int i=0; i<numeles; i++) {
-        Tri31* theEle = new Tri31(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),
-                                  *theMaterial, type, t, p, rho, b1, b2);
-
-        if(theEle == 0) {
-            opserr<<"WARNING: no enough memory -- ";
-            opserr<<" -- PFEMMesher2D::doTriangulation\n";
-            return -1;
-        }
-        if(theDomain->addElement(theEle) == false) {
-            opserr<<"WARNING: failed to add element to domain -- ";
-            opserr<<" -- PFEMMesher2D::doTriangulation\n";
-            delete theEle;
-            return -1;
-        }
+    if(eles.Size()/3 == 0) return 0;
+    if(addElements(starteletag,eles,theDomain,t,type,matTag,p,rho,b1,b2,
+                   endele) < 0) {
+        return -1;
     }
     //timer.pause();
     //opserr<<"create PFEM elements :"<<timer;
 
-    endele = etag;
-
     return res;
     
 }
@@ -1065,82 +1024,88 @@ PFEMMesher2D::doTriangulation(double alpha, const ID& groups, const ID& addgroup
     // do alpha shape test
     if(alpha > 0) {
 
-        // radius and average size of triangles
-        Vector radius(out.numberoftriangles);
-        double avesize = 0.0;
-        for(int i=0; i<out.numberoftriangles; i++) {
+        // radius and size of triangles, in parallel
+        int numtri = out.numberoftriangles;
+        std::vector<double> radius(numtri), sizes(numtri);
+        parallelFor(numtri, numThreads, [&](int begin, int end) {
+            for(int i=begin; i<end; i++) {
 
-            // circumcenter of traingle
-            double& xc = vout.pointlist[2*i];
-            double& yc = vout.pointlist[2*i+1];
+                // circumcenter of traingle
+                double xc = vout.pointlist[2*i];
+                double yc = vout.pointlist[2*i+1];
 
-            // triangle points
-            int pt[3];
-            for(int j=0; j<3; j++) {
-                pt[j] = out.trianglelist[out.numberofcorners*i+j];
-            }
+                // triangle points
+                int pt[3];
+                for(int j=0; j<3; j++) {
+                    pt[j] = out.trianglelist[out.numberofcorners*i+j];
+                }
 
-            // nodal coordinates
-            double x[3], y[3];
-            for(int j=0; j<3; j++) {
-                x[j] = out.pointlist[2*pt[j]];
-                y[j] = out.pointlist[2*pt[j]+1];
-            }
+                // nodal coordinates
+                double x[3], y[3];
+                for(int j=0; j<3; j++) {
+                    x[j] = out.pointlist[2*pt[j]];
+                    y[j] = out.pointlist[2*pt[j]+1];
+                }
 
-            // size of triangle
-            double he = -1.0;
-            for(int j=0; j<3; j++) {
-                for(int k=j+1; k<3; k++) {
-                    double h = (x[j]-x[k])*(x[j]-x[k])+(y[j]-y[k])*(y[j]-y[k]);
-                    if(h<he || he==-1.0) {
-                        he = h;
+                // size of triangle
+                double he = -1.0;
+                for(int j=0; j<3; j++) {
+                    for(int k=j+1; k<3; k++) {
+                        double h = (x[j]-x[k])*(x[j]-x[k])+(y[j]-y[k])*(y[j]-y[k]);
+                        if(h<he || he==-1.0) {
+                            he = h;
+                        }
                     }
                 }
+                sizes[i] = sqrt(he);
+
+                // radius
+                radius[i] = sqrt((xc-x[0])*(xc-x[0])+(yc-y[0])*(yc-y[0]));
             }
-            avesize += sqrt(he);
-            // double h = sqrt((x[1]-x[0])*(x[1]-x[0])+(y[1]-y[0])*(y[1]-y[0]));
-            // h += sqrt((x[1]-x[2])*(x[1]-x[2])+(y[1]-y[2])*(y[1]-y[2]));
-            // h += sqrt((x[0]-x[2])*(x[0]-x[2])+(y[0]-y[2])*(y[0]-y[2]));
-            // h /= 3.0;
-            // avesize += h;
-            // double area = fabs((x[1]-x[0])*(y[2]-y[0])-(x[2]-x[0])*(y[1]-y[0])) / 2.0;
-            // avesize += sqrt(area);
+        });
 
-            // radius
-            radius(i) = sqrt((xc-x[0])*(xc-x[0])+(yc-y[0])*(yc-y[0]));
+        // average size
+        double avesize = 0.0;
+        for(int i=0; i<numtri; i++) {
+            avesize += sizes[i];
         }
-        avesize /= out.numberoftriangles;
-
-        // alpha test
-        int num = 0;
-        eles.resize(out.numberoftriangles*out.numberofcorners);
-        for(int i=0; i<out.numberoftriangles; i++) {
-            if(radius(i) / avesize <= alpha) {
-                // pass the test
-
-                // check if all nodes are additional nodes
-                int add[3] = {-1,-1,-1};
-                for(int j=0; j<3; j++) {
-                    int tag = p2nd(out.trianglelist[out.numberofcorners*i+j]);
-                    int type = fluidNodes[tag];
-                    for(int k=0; k<groups.Size(); k++) {
-                        if(type == groups(k)) {
-                            add[j] = 0;
-                            break;
-                        }
-                    }
+        avesize /= numtri;
+
+        // points of nodes in groups, the others are additional nodes
+        std::vector<char> ingroup(numpoints, 0);
+        for(int i=0; i<numpoints; i++) {
+            int type = fluidNodes[p2nd(i)];
+            for(int k=0; k<groups.Size(); k++) {
+                if(type == groups(k)) {
+                    ingroup[i] = 1;
+                    break;
                 }
-                    
-                // add ele
-                // if(add[0]==add[1] && add[1]==add[2] && add[2]!=0) continue;
-                if(add[0]!=0 && add[1]!=0 && add[2]!=0) continue;
+            }
+        }
 
+        // alpha test, in parallel
+        std::vector<char> pass(numtri, 0);
+        parallelFor(numtri, numThreads, [&](int begin, int end) {
+            for(int i=begin; i<end; i++) {
+                if(radius[i] / avesize > alpha) continue;
 
-                for(int j=0; j<3; j++) {
-                    int tag = p2nd(out.trianglelist[out.numberofcorners*i+j]);
-                    eles(num++) = tag;
+                // not all nodes are additional nodes
+                const int* pt = &out.trianglelist[out.numberofcorners*i];
+                if(ingroup[pt[0]] || ingroup[pt[1]] || ingroup[pt[2]]) {
+                    pass[i] = 1;
                 }
             }
+        });
+
+        // add eles
+        int num = 0;
+        eles.resize(numtri*out.numberofcorners);
+        for(int i=0; i<numtri; i++) {
+            if(pass[i] == 0) continue;
+            for(int j=0; j<3; j++) {
+                int tag = p2nd(out.trianglelist[out.numberofcorners*i+j]);
+                eles(num++) = tag;
+            }
         }
         if(num == 0) {
             eles = ID();
@@ -1171,6 +1136,290 @@ PFEMMesher2D::doTriangulation(double alpha, const ID& groups, const ID& addgroup
     return 0;
 }
 
+int
+PFEMMesher2D::remesh(int eleRegTag, double tol, double alpha, const ID& groups,
+                     const ID& addgroups, int classTag, Domain* theDomain, ID& eles)
+{
+    if(theDomain == 0) {
+        opserr<<"WARNING: null domain";
+        opserr<<" -- PFEMMesher2D::remesh\n";
+        return -1;
+    }
+    eles = ID();
+
+    // fluid nodes
+    std::map<int,int> fluidNodes;
+    getNodes(groups,fluidNodes,theDomain);
+    getNodes(addgroups,fluidNodes,theDomain);
+
+    // check if any node has moved too far, or the nodes have changed
+    std::map<int,MeshState>::iterator state = meshStates.find(eleRegTag);
+    if(tol > 0 && state != meshStates.end() &&
+       theDomain->getRegion(eleRegTag) != 0 &&
+       state->second.crds.size() == fluidNodes.size()) {
+
+        double dmax = tol*state->second.size;
+        bool valid = true;
+        std::map<int,int>::iterator it;
+        for(it=fluidNodes.begin(); it!=fluidNodes.end() && valid; it++) {
+            std::map<int, std::pair<double,double> >::iterator crds;
+            crds = state->second.crds.find(it->first);
+            Node* node = theDomain->getNode(it->first);
+            if(crds == state->second.crds.end() || node == 0) {
+                valid = false;
+                break;
+            }
+            const Vector& coord = node->getCrds();
+            const Vector& disp = node->getTrialDisp();
+            if(coord.Size() < 2 || disp.Size() < 2) {
+                valid = false;
+                break;
+            }
+            double dx = coord(0)+disp(0)-crds->second.first;
+            double dy = coord(1)+disp(1)-crds->second.second;
+            if(dx*dx+dy*dy > dmax*dmax) {
+                valid = false;
+            }
+        }
+
+        if(valid) return 1;
+    }
+
+    // do triangulation
+    ID alleles;
+    if(doTriangulation(alpha,groups,addgroups,theDomain,alleles) < 0) {
+        opserr<<"WARNING: failed to do triangulation --";
+        opserr<<"PFEMMesher2D::remesh\n";
+        return -1;
+    }
+
+    // save node positions and the average element size
+    MeshState& newstate = meshStates[eleRegTag];
+    newstate.crds.clear();
+    std::map<int,int>::iterator it;
+    for(it=fluidNodes.begin(); it!=fluidNodes.end(); it++) {
+        Node* node = theDomain->getNode(it->first);
+        if(node == 0) continue;
+        const Vector& coord = node->getCrds();
+        const Vector& disp = node->getTrialDisp();
+        if(coord.Size() < 2 || disp.Size() < 2) continue;
+        newstate.crds[it->first] = std::make_pair(coord(0)+disp(0),coord(1)+disp(1));
+    }
+    int numeles = alleles.Size()/3;
+    newstate.size = 0.0;
+    for(int i=0; i<numeles; i++) {
+        double he = -1.0;
+        for(int j=0; j<3; j++) {
+            for(int k=j+1; k<3; k++) {
+                const std::pair<double,double>& xj = newstate.crds[alleles(3*i+j)];
+                const std::pair<double,double>& xk = newstate.crds[alleles(3*i+k)];
+                double dx = xj.first-xk.first;
+                double dy = xj.second-xk.second;
+                double h = dx*dx+dy*dy;
+                if(h<he || he==-1.0) {
+                    he = h;
+                }
+            }
+        }
+        newstate.size += sqrt(he);
+    }
+    if(numeles > 0) {
+        newstate.size /= numeles;
+    }
+
+    // keep the existing elements
+    if(reuseElements(eleRegTag,classTag,alleles,theDomain) < 0) {
+        return -1;
+    }
+    eles = alleles;
+
+    return 0;
+}
+
+// the corner nodes of a triangle element: for PFEM elements each is
+// followed by its pressure node, and PFEMElement2DCompressible has a
+// seventh node; Tri31 has the corners only
+static bool
+getCornerNodes(Element* ele, int nd[3])
+{
+    const ID& ntags = ele->getExternalNodes();
+    if(ntags.Size() >= 6) {
+        nd[0] = ntags(0); nd[1] = ntags(2); nd[2] = ntags(4);
+    } else if(ntags.Size() == 3) {
+        nd[0] = ntags(0); nd[1] = ntags(1); nd[2] = ntags(2);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int
+PFEMMesher2D::reuseElements(int eleRegTag, int classTag, ID& eles, Domain* theDomain)
+{
+    // existing elements by their sorted nodes
+    typedef std::pair<int, std::pair<int,int> > TriKey;
+    std::map<TriKey,int> existing;
+    MeshRegion* region = theDomain->getRegion(eleRegTag);
+    if(region != 0) {
+        const ID& regEles = region->getElements();
+        for(int i=0; i<regEles.Size(); i++) {
+            Element* ele = theDomain->getElement(regEles(i));
+            if(ele == 0 || ele->getClassTag() != classTag) continue;
+
+            // an element which can't be matched is replaced
+            int nd[3];
+            if(!getCornerNodes(ele, nd)) {
+                theDomain->removeElement(ele->getTag());
+                delete ele;
+                continue;
+            }
+            std::sort(nd, nd+3);
+            TriKey key(nd[0],std::make_pair(nd[1],nd[2]));
+            if(existing.find(key) != existing.end()) {
+                theDomain->removeElement(ele->getTag());
+                delete ele;
+                continue;
+            }
+            existing[key] = ele->getTag();
+        }
+    }
+
+    // match the new triangles
+    int numeles = eles.Size()/3;
+    ID kept(0, numeles);
+    int numkept = 0, numnew = 0;
+    for(int i=0; i<numeles; i++) {
+        int nd[3] = {eles(3*i), eles(3*i+1), eles(3*i+2)};
+        std::sort(nd, nd+3);
+        std::map<TriKey,int>::iterator it;
+        it = existing.find(TriKey(nd[0],std::make_pair(nd[1],nd[2])));
+
+        // the element must also have the same orientation
+        bool same = false;
+        if(it != existing.end()) {
+            int corners[3];
+            getCornerNodes(theDomain->getElement(it->second), corners);
+            for(int j=0; j<3 && !same; j++) {
+                same = corners[0] == eles(3*i+j) &&
+                    corners[1] == eles(3*i+(j+1)%3) &&
+                    corners[2] == eles(3*i+(j+2)%3);
+            }
+        }
+
+        if(same) {
+            kept[numkept++] = it->second;
+            existing.erase(it);
+        } else {
+            for(int j=0; j<3; j++) {
+                eles(3*numnew+j) = eles(3*i+j);
+            }
+            numnew++;
+        }
+    }
+    if(numnew == 0) {
+        eles = ID();
+    } else {
+        eles.resize(3*numnew);
+    }
+
+    // remove the others
+    std::map<TriKey,int>::iterator it;
+    for(it=existing.begin(); it!=existing.end(); it++) {
+        Element* ele = theDomain->removeElement(it->second);
+        if(ele != 0) delete ele;
+    }
+    if(region != 0) {
+        const ID& regEles = region->getElements();
+        for(int i=0; i<regEles.Size(); i++) {
+            Element* ele = theDomain->getElement(regEles(i));
+            if(ele != 0 && ele->getClassTag() != classTag) {
+                theDomain->removeElement(regEles(i));
+                delete ele;
+            }
+        }
+        if(numkept == 0) {
+            region->setElements(ID());
+        } else {
+            kept.resize(numkept);
+            region->setElements(kept);
+        }
+    }
+
+    return numkept;
+}
+
+// linear elements
+int
+PFEMMesher2D::addElements(int startele, const ID& eles, Domain* theDomain,
+                          double rho, double mu, double b1, double b2,
+                          double thk, double kappa, int type, int& endele)
+{
+    int numeles = eles.Size()/3;
+    int etag = startele-1;
+    for(int i=0; i<numeles; i++) {
+        Element* theEle = 0;
+        if(type == 1) {
+            theEle = new PFEMElement2D(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk);
+        } else if(type == 3) {
+            theEle = new PFEMElement2DCompressible(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk, kappa);
+        } else if(type == 4) {
+            theEle = new PFEMElement2DBubble(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),rho, mu, b1, b2, thk, kappa);
+        }
+        
+        if(theEle == 0) {
+            opserr<<"WARNING: no enough memory -- ";
+            opserr<<" -- PFEMMesher2D::addElements\n";
+            return -1;
+        }
+        if(theDomain->addElement(theEle) == false) {
+            opserr<<"WARNING: failed to add element to domain -- ";
+            opserr<<" -- PFEMMesher2D::addElements\n";
+            delete theEle;
+            return -1;
+        }
+    }
+
+    endele = etag;
+    return 0;
+}
+
+// solid elements
+int
+PFEMMesher2D::addElements(int startele, const ID& eles, Domain* theDomain,
+                          double t, const char* type, int matTag,
+                          double p, double rho, double b1, double b2,
+                          int& endele)
+{
+    NDMaterial *theMaterial = OPS_getNDMaterial(matTag);
+    if(theMaterial == 0) {
+        opserr << "WARNING:  Material " << matTag << "not found\n";
+        opserr<<"PFEMMesher2D::addElements\n";
+        return -1;
+    }
+
+    int numeles = eles.Size()/3;
+    int etag = startele-1;
+    for(int i=0; i<numeles; i++) {
+        Tri31* theEle = new Tri31(++etag, eles(3*i), eles(3*i+1), eles(3*i+2),
+                                  *theMaterial, type, t, p, rho, b1, b2);
+
+        if(theEle == 0) {
+            opserr<<"WARNING: no enough memory -- ";
+            opserr<<" -- PFEMMesher2D::addElements\n";
+            return -1;
+        }
+        if(theDomain->addElement(theEle) == false) {
+            opserr<<"WARNING: failed to add element to domain -- ";
+            opserr<<" -- PFEMMesher2D::addElements\n";
+            delete theEle;
+            return -1;
+        }
+    }
+
+    endele = etag;
+    return 0;
+}
+
 int 
 PFEMMesher2D::save(const char* filename, Domain* theDomain, int maxelenodes)
 {
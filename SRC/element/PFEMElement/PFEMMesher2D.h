@@ -118,6 +118,27 @@ public:
                         double p, double rho, double b1, double b2, 
                         int& endele);
 
+    // incremental remeshing of an element region: the region is
+    // triangulated again only if a node has moved more than tol times
+    // the average element size since its last triangulation, and its
+    // elements of class classTag whose nodes are in the new
+    // triangulation are kept. The triangles needing new elements are
+    // returned in eles. Returns 1 if the mesh is unchanged.
+    int remesh(int eleRegTag, double tol, double alpha, const ID& groups,
+               const ID& addgroups, int classTag, Domain* theDomain, ID& eles);
+
+    // add elements for the triangles in eles
+    int addElements(int startele, const ID& eles, Domain* theDomain,
+                    double rho, double mu, double b1, double b2,
+                    double thk, double kappa, int type, int& endele);
+    int addElements(int startele, const ID& eles, Domain* theDomain,
+                    double t, const char* type, int matTag,
+                    double p, double rho, double b1, double b2,
+                    int& endele);
+
+    // threads for the alpha shape test
+    void setNumThreads(int num) {numThreads = num>0? num:1;}
+
     // Crouzeix-Raviart element
     int doTriangulation(int newNodeRegTag, int eleRegTag,
                         double alpha, const ID& groups, const ID& addgroups,
@@ -161,6 +182,9 @@ public:
 
 private:
 
+    // keep the elements of a region found in eles
+    int reuseElements(int eleRegTag, int classTag, ID& eles, Domain* theDomain);
+
     // initialize triangulateio
     void initializeTri(triangulateio& tri);
 
@@ -170,6 +194,15 @@ private:
     
     // PI
     static double PI;
+
+    // node positions and average element size of
+    // each element region at its last triangulation
+    struct MeshState {
+        std::map<int, std::pair<double,double> > crds;
+        double size;
+    };
+    std::map<int,MeshState> meshStates;
+    int numThreads;
 };
 
 
@@ -55,9 +55,11 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <ThreadPool.h>
 
 PFEMMesher3D::PFEMMesher3D()
-    :bound(6), avesize(0.0)
+    :bound(6), avesize(0.0), numThreads(1)
 {
 }
 
@@ -454,98 +456,103 @@ PFEMMesher3D::doTriangulation(const std::vector<int>& nodes, double alpha, doubl
     eles.clear();
     if(alpha > 0) {
 
-        // need mesh functions
-        tetgenmesh mesh;
+        // radius, volume and size of tetrahedra, in parallel
+        int numtet = out.numberoftetrahedra;
+        std::vector<double> radius(numtet), volume(numtet), sizes(numtet);
+        parallelFor(numtet, numThreads, [&](int begin, int end) {
 
-        // radius and average size of tetrahedra
-        avesize = 0.0;
-        Vector radius(out.numberoftetrahedra);
-        Vector volume(out.numberoftetrahedra);
-        for(int i=0; i<out.numberoftetrahedra; i++) {
+            // need mesh functions
+            tetgenmesh mesh;
 
-            // tetrahedra points
-            ID pt(nptet);
-            for(int j=0; j<nptet; j++) {
-                pt(j) = out.tetrahedronlist[out.numberofcorners*i+j];
-            }
+            for(int i=begin; i<end; i++) {
 
-            // nodal coordinates
-            double* ppointer[4];
-            Matrix pcoord(nptet,ndm);
-            for(int j=0; j<nptet; j++) {
-                for(int k=0; k<ndm; k++) {
-                    pcoord(j,k) = out.pointlist[ndm*pt(j)+k];
+                // tetrahedra points
+                int pt[nptet];
+                for(int j=0; j<nptet; j++) {
+                    pt[j] = out.tetrahedronlist[out.numberofcorners*i+j];
+                }
+
+                // nodal coordinates
+                double* ppointer[4];
+                for(int j=0; j<nptet; j++) {
+                    ppointer[j] = &(out.pointlist[ndm*pt[j]]);
                 }
-                ppointer[j] = &(out.pointlist[ndm*pt(j)]);
-            }
 
-            // size of tetrahedra
-            double he = -1.0;
-            for(int j=0; j<nptet; j++) {
-                for(int k=j+1; k<nptet; k++) {
-                    double h = 0.0;
-                    for(int l=0; l<ndm; l++) {
-                        h += (pcoord(j,l)-pcoord(k,l))*(pcoord(j,l)-pcoord(k,l));
+                // size of tetrahedra
+                double he = -1.0;
+                for(int j=0; j<nptet; j++) {
+                    for(int k=j+1; k<nptet; k++) {
+                        double h = 0.0;
+                        for(int l=0; l<ndm; l++) {
+                            h += (ppointer[j][l]-ppointer[k][l])*(ppointer[j][l]-ppointer[k][l]);
+                        }
+                        if(h<he || he==-1.0) {
+                            he = h;
+                        }
                     }
-                    if(h<he || he==-1.0) {
-                        he = h;
+                }
+                sizes[i] = sqrt(he);
+
+                // volume
+                double A[4][4], D;
+                int indx[4];
+                for(int j=0; j<nptet-1; j++) {
+                    for(int k=0; k<ndm; k++) {
+                        A[j][k] = ppointer[j][k] - ppointer[3][k];
                     }
                 }
+                mesh.lu_decmp(A,3,indx,&D,0);
+                volume[i] = fabs(A[indx[0]][0]*A[indx[1]][1]*A[indx[2]][2]) / 6.0;
+
+                // radius
+                double* pradius = &radius[i];
+                mesh.circumsphere(ppointer[0],ppointer[1],ppointer[2],ppointer[3],NULL,pradius);
             }
-            avesize += sqrt(he);
-
-            // volume
-            double A[4][4], D;
-            int indx[4];
-            for(int j=0; j<nptet-1; j++) {
-                for(int k=0; k<ndm; k++) {
-                    A[j][k] = pcoord(j,k) - pcoord(3,k);
+        });
+
+        // average size
+        avesize = 0.0;
+        for(int i=0; i<numtet; i++) {
+            avesize += sizes[i];
+        }
+        avesize /= numtet;
+
+        // points of additional nodes
+        std::vector<char> isadd(numpoints, 0);
+        for(int i=0; i<numpoints; i++) {
+            int tag = p2nd(i);
+            for(int k=0; k<(int)addnodes.size()/2; k++) {
+                if(tag>=addnodes[2*k] && tag<=addnodes[2*k+1]) {
+                    isadd[i] = 1;
+                    break;
                 }
             }
-            mesh.lu_decmp(A,3,indx,&D,0);
-            volume(i) = fabs(A[indx[0]][0]*A[indx[1]][1]*A[indx[2]][2]) / 6.0;
-
-            // radius
-            double* pradius = &radius(i);
-            mesh.circumsphere(ppointer[0],ppointer[1],ppointer[2],ppointer[3],NULL,pradius);
         }
-        avesize /= out.numberoftetrahedra;
 
-        // alpha test
-        double totalvolume = 0.0;
-        for(int i=0; i<out.numberoftetrahedra; i++) {
-            // coplanar factor
-            // double coplane = volume(i) / pow(avesize,3);
-            // if(q < 1e-6) {
-            //     // opserr<<"coplanar: volume = "<<volume(i)<<", q = "<<q<<"\n";
-            //     continue;
-            // }
-            double vsphere = 4./3.*3.14*radius(i)*radius(i)*radius(i);
-            if(radius(i) / avesize <= alpha && volume(i)/vsphere > volthresh) {
-                // pass the test
-                totalvolume += volume(i);
-
-                // check if all nodes are additional nodes
-                int add[4] = {-1,-1,-1,-1};
-                for(int j=0; j<4; j++) {
-                    int tag = p2nd(out.tetrahedronlist[out.numberofcorners*i+j]);
-                    for(int k=0; k<(int)addnodes.size()/2; k++) {
-                        if(tag>=addnodes[2*k] && tag<=addnodes[2*k+1]) {
-                            add[j] = k;
-                            break;
-                        }
-                    }
+        // alpha test, in parallel
+        std::vector<char> pass(numtet, 0);
+        parallelFor(numtet, numThreads, [&](int begin, int end) {
+            for(int i=begin; i<end; i++) {
+                double vsphere = 4./3.*3.14*radius[i]*radius[i]*radius[i];
+                if(radius[i] / avesize > alpha || volume[i]/vsphere <= volthresh) {
+                    continue;
                 }
 
-                // add ele
-                // if(add[0]==add[1] && add[1]==add[2] && add[2]==add[3] && add[3]!=-1) continue;
-                if(add[0]!=-1 && add[1]!=-1 && add[2]!=-1 && add[3]!=-1) continue;
-                for(int j=0; j<4; j++) {
-                    int tag = p2nd(out.tetrahedronlist[out.numberofcorners*i+j]);
-                    //opserr<<tag<<" ";
-                    eles.push_back(tag);
+                // not all nodes are additional nodes
+                const int* pt = &out.tetrahedronlist[out.numberofcorners*i];
+                if(!isadd[pt[0]] || !isadd[pt[1]] || !isadd[pt[2]] || !isadd[pt[3]]) {
+                    pass[i] = 1;
                 }
             }
+        });
+
+        // add eles
+        for(int i=0; i<numtet; i++) {
+            if(pass[i] == 0) continue;
+            for(int j=0; j<4; j++) {
+                int tag = p2nd(out.tetrahedronlist[out.numberofcorners*i+j]);
+                eles.push_back(tag);
+            }
         }
 
     } else if(alpha < 0) {
@@ -126,10 +126,14 @@ public:
     void setBoundary(double x1, double y1, double z1, double x2, double y2, double z2);
     void removeOutBoundNodes(const ID& nodes, Domain* theDomain);
 
+    // threads for the alpha shape test
+    void setNumThreads(int num) {numThreads = num>0? num:1;}
+
 private:
 
     Vector bound;
     double avesize;
+    int numThreads;
 };
 
 
@@ -31,10 +31,63 @@
 #include "ParticleGroup.h"
 
 void
-Particle::print()
+Particle::moveTo(const Vector& coord)
+{
+    double* crds = group->getCrds(index);
+    int ndm = group->getNDM();
+    for (int i=0; i<ndm && i<coord.Size(); i++) {
+	crds[i] = coord(i);
+    }
+}
+
+void
+Particle::move(const Vector& disp)
+{
+    double* crds = group->getCrds(index);
+    int ndm = group->getNDM();
+    for (int i=0; i<ndm && i<disp.Size(); i++) {
+	crds[i] += disp(i);
+    }
+}
+
+void
+Particle::setVel(const Vector& vel)
+{
+    double* v = group->getVel(index);
+    int ndf = group->getNDF();
+    for (int i=0; i<ndf && i<vel.Size(); i++) {
+	v[i] = vel(i);
+    }
+}
+
+void
+Particle::setPressure(double p)
 {
-    opserr<<"Particle coord      = "<<coord;
-    opserr<<"         pressure   = "<<pressure<<"\n";
-    opserr<<"         vel        = "<<velocity<<"\n";
+    group->getPressure(index) = p;
 }
 
+Vector
+Particle::getCrds() const
+{
+    return Vector(group->getCrds(index), group->getNDM());
+}
+
+Vector
+Particle::getVel() const
+{
+    return Vector(group->getVel(index), group->getNDF());
+}
+
+double
+Particle::getPressure() const
+{
+    return group->getPressure(index);
+}
+
+void
+Particle::print()
+{
+    opserr<<"Particle coord      = "<<this->getCrds();
+    opserr<<"         pressure   = "<<this->getPressure()<<"\n";
+    opserr<<"         vel        = "<<this->getVel()<<"\n";
+}
@@ -34,42 +34,35 @@
 
 class ParticleGroup;
 
+// A particle is a handle to one entry of the coordinate, velocity and
+// pressure arrays of its group, which keeps them contiguous so that
+// the particles of a grid cell are next to each other in memory.
+// The handles are stored by value in the group and are invalidated
+// when particles are added to it.
 class Particle
 {
 public:
-    Particle():coord(),velocity(),pressure(0),group(0) {}
+    Particle():group(0),index(-1) {}
+    Particle(ParticleGroup* g, int i):group(g),index(i) {}
     ~Particle() {}
 
-    void moveTo(const Vector& coord) {
-	this->coord = coord;
-    }
-
-    void move(const Vector& disp) {
-	this->coord += disp;
-    }
-
-    void setVel(const Vector& vel) {
-	this->velocity = vel;
-    }
-
-    void setPressure(double p) {
-	pressure = p;
-    }
-
-    void setGroup(ParticleGroup* g) {group = g;}
+    void moveTo(const Vector& coord);
+    void move(const Vector& disp);
+    void setVel(const Vector& vel);
+    void setPressure(double p);
 
     void print();
 
-    const Vector& getCrds() const {return coord;}
-    const Vector& getVel() const {return velocity;}
-    double getPressure() const {return pressure;}
+    // views of the group arrays
+    Vector getCrds() const;
+    Vector getVel() const;
+    double getPressure() const;
     ParticleGroup* getGroup() {return group;}
+    int getIndex() const {return index;}
     
 private:
-    Vector coord;
-    Vector velocity;
-    double pressure;
     ParticleGroup* group;
+    int index;
 };
 
 
@@ -31,32 +31,57 @@
 #include <elementAPI.h>
 
 ParticleGroup::ParticleGroup()
-    :particles(), type(0), prop(), ndf(0)
+    :particles(), crds(), vels(), pressures(), type(0), prop(), ndm(0), ndf(0)
 {
 
 }
 
 ParticleGroup::~ParticleGroup()
 {
-    for (int i=0; i<(int)particles.size(); i++) {
-	Particle* p = particles[i];
-	if (p != 0) delete p;
-    }
-    particles.clear();
-
     if (type != 0) delete [] type;
 }
 
 void
 ParticleGroup::addParticle(const Vector& coord, const Vector& vel, double p)
 {
-    Particle* particle = new Particle;
-    particles.push_back(particle);
+    // the first particle sets the dimension
+    if (particles.empty()) {
+	ndm = coord.Size();
+    }
+
+    int i = (int)particles.size();
+    particles.push_back(Particle(this,i));
+    crds.resize(crds.size()+ndm, 0.0);
+    vels.resize(vels.size()+ndf, 0.0);
+    pressures.push_back(p);
+
+    Particle& particle = particles[i];
+    particle.moveTo(coord);
+    particle.setVel(vel);
+}
 
-    particle->moveTo(coord);
-    particle->setVel(vel);
-    particle->setPressure(p);
-    particle->setGroup(this);
+void
+ParticleGroup::reorder(const std::vector<int>& order)
+{
+    int num = this->numParticles();
+    if ((int)order.size() != num) return;
+
+    std::vector<double> newcrds(crds.size());
+    std::vector<double> newvels(vels.size());
+    std::vector<double> newpressures(num);
+    for (int i=0; i<num; i++) {
+	int j = order[i];
+	for (int k=0; k<ndm; k++) {
+	    newcrds[i*ndm+k] = crds[j*ndm+k];
+	}
+	for (int k=0; k<ndf; k++) {
+	    newvels[i*ndf+k] = vels[j*ndf+k];
+	}
+	newpressures[i] = pressures[j];
+    }
+    crds.swap(newcrds);
+    vels.swap(newvels);
+    pressures.swap(newpressures);
 }
 
 void
@@ -82,10 +107,7 @@ ParticleGroup::setType(const char* eletype)
 void
 ParticleGroup::print() {
     for(int i=0; i<this->numParticles(); i++) {
-	Particle* p = particles[i];
-	if (p != 0) {
-	    p->print();
-	}
+	particles[i].print();
     }
 }
 
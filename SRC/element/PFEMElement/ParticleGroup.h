@@ -43,7 +43,16 @@ public:
 
     void addParticle(const Vector& coord, const Vector& vel, double p);
     int numParticles() const {return (int)particles.size();}
-    Particle* getParticle(int i) {return (i>=0&&i<this->numParticles())? particles[i]:0;}
+    Particle* getParticle(int i) {return (i>=0&&i<this->numParticles())? &particles[i]:0;}
+
+    // the particle arrays
+    double* getCrds(int i) {return &crds[i*ndm];}
+    double* getVel(int i) {return &vels[i*ndf];}
+    double& getPressure(int i) {return pressures[i];}
+    int getNDM() const {return ndm;}
+
+    // particle i becomes the one which was order[i]
+    void reorder(const std::vector<int>& order);
 
 
     void setType(const char* eletype);
@@ -68,10 +77,13 @@ public:
     
 private:
     
-    std::vector<Particle*> particles;
+    std::vector<Particle> particles;
+    std::vector<double> crds;
+    std::vector<double> vels;
+    std::vector<double> pressures;
     char* type;
     Vector prop;
-    int ndf;
+    int ndm, ndf;
 };
 
 #endif
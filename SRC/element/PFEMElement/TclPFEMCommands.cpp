@@ -40,6 +40,7 @@
 #include <string>
 #include <PFEMElement2DBubble.h>
 #include <MeshRegion.h>
+#include <classTags.h>
 
 static PFEMMesher2D theMesher2D;
 static PFEMMesher3D theMesher3D;
@@ -2066,7 +2067,8 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                 opserr << "-PFEMElement2D {rho mu b1 b2 <thk kappa>} ";
                 opserr << "-PFEMElement2DCompressible {rho mu b1 b2 <thk kappa>} ";
                 opserr << "-PFEMElement2DBubble {rho mu b1 b2 <thk kappa>} ";
-                opserr << "-Tri31 {thk type matTag <pressure rho b1 b2>}\n ";
+                opserr << "-Tri31 {thk type matTag <pressure rho b1 b2>} ";
+                opserr << "<-tol {tol}> <-threads {num}>\n ";
                 return TCL_ERROR;
             }
             double alpha;
@@ -2085,6 +2087,7 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
             int eletype = 0;
             std::string type;
             ID nodes, addnodes;
+            Vector tolParams, threadParams;
             while(loc < argc) {
 
                 Vector* vecPtr = 0;
@@ -2117,6 +2120,12 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                     vecPtr = &params;
                     eletype = 4;
                     loc++;
+                } else if(strcmp(argv[loc], "-tol") == 0) {
+                    vecPtr = &tolParams;
+                    loc++;
+                } else if(strcmp(argv[loc], "-threads") == 0) {
+                    vecPtr = &threadParams;
+                    loc++;
                 }
 
                 if(vecPtr!=0 || idPtr!=0) {
@@ -2133,7 +2142,7 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                     }
                     if(vecPtr != 0) {
                         for(int i=0; i<num; i++) {
-                            if(eletype==2 && i==2) {
+                            if(vecPtr==&params && eletype==2 && i==2) {
                                 type = argvPtr[i];
                                 continue;
                             }
@@ -2163,6 +2172,23 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                 loc++;
             }
 
+            // incremental remeshing
+            double tol = 0.0;
+            if(tolParams.Size() > 0) {
+                tol = tolParams(0);
+            }
+            if(threadParams.Size() > 0) {
+                theMesher2D.setNumThreads((int)threadParams(0));
+            }
+            int classTag = ELE_TAG_Tri31;
+            if(eletype == 1) {
+                classTag = ELE_TAG_PFEMElement2D;
+            } else if(eletype == 3) {
+                classTag = ELE_TAG_PFEMElement2DCompressible;
+            } else if(eletype == 4) {
+                classTag = ELE_TAG_PFEMElement2DBubble;
+            }
+
             // triangulation
             int res = -1;
             ID eles;
@@ -2186,17 +2212,35 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                     kappa = params(5);
                 }
 
-                // remove all elements in eleReg
-                theMesher2D.removeElements(eleRegTag,theDomain);
-
                 // triangulation
                 int startele = theMesher2D.findEleTag(theDomain);
                 int endele = startele;
-            
-                res = theMesher2D.doTriangulation(startele,alpha,nodes,
-                                                  addnodes,theDomain,
-                                                  rho,mu,b1,b2,thk,kappa,
-                                                  eletype,endele);
+
+                if(tol > 0) {
+
+                    // keep the elements which are still in the mesh
+                    res = theMesher2D.remesh(eleRegTag,tol,alpha,nodes,addnodes,
+                                             classTag,theDomain,eles);
+                    endele = startele-1;
+                    if(res == 0 && eles.Size() > 0) {
+                        res = theMesher2D.addElements(startele,eles,theDomain,
+                                                      rho,mu,b1,b2,thk,kappa,
+                                                      eletype,endele);
+                    }
+                    if(res >= 0) {
+                        theMesher2D.identify(b2,theDomain);
+                    }
+
+                } else {
+
+                    // remove all elements in eleReg
+                    theMesher2D.removeElements(eleRegTag,theDomain);
+
+                    res = theMesher2D.doTriangulation(startele,alpha,nodes,
+                                                      addnodes,theDomain,
+                                                      rho,mu,b1,b2,thk,kappa,
+                                                      eletype,endele);
+                }
             
                 if(res < 0) {
                     opserr<<"WARNING: failed to mesh -- ";
@@ -2237,16 +2281,32 @@ TclModelBuilderPFEM2DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                     b2 = params(6);
                 }
 
-                // remove all elements in eleReg
-                theMesher2D.removeElements(eleRegTag,theDomain);
-            
                 // triangulation
                 int startele = theMesher2D.findEleTag(theDomain);
                 int endele = startele;
-                res = theMesher2D.doTriangulation(startele,alpha,nodes,addnodes,
-                                                  theDomain,
-                                                  thk,type.c_str(),matTag,p,rho,
-                                                  b1,b2,endele);
+
+                if(tol > 0) {
+
+                    // keep the elements which are still in the mesh
+                    res = theMesher2D.remesh(eleRegTag,tol,alpha,nodes,addnodes,
+                                             classTag,theDomain,eles);
+                    endele = startele-1;
+                    if(res == 0 && eles.Size() > 0) {
+                        res = theMesher2D.addElements(startele,eles,theDomain,
+                                                      thk,type.c_str(),matTag,p,rho,
+                                                      b1,b2,endele);
+                    }
+
+                } else {
+
+                    // remove all elements in eleReg
+                    theMesher2D.removeElements(eleRegTag,theDomain);
+
+                    res = theMesher2D.doTriangulation(startele,alpha,nodes,addnodes,
+                                                      theDomain,
+                                                      thk,type.c_str(),matTag,p,rho,
+                                                      b1,b2,endele);
+                }
 
                 if(res < 0) {
                     opserr<<"WARNING: failed to do triangulation -- ";
@@ -2728,7 +2788,7 @@ TclModelBuilderPFEM3DCommand(ClientData clientData, Tcl_Interp *interp, int argc
             opserr << "WARNING: wrong num of args -- ";
             opserr << "PFEM3D doTriangulation alpha -volthresh volthres ";
             opserr << "-nodes (start1 end1 start2 end2 ...)  ";
-            opserr << "<-PFEMElement3D starteletag rho mu b1 b2 b3>\n";
+            opserr << "<-PFEMElement3D starteletag rho mu b1 b2 b3> <-threads num>\n";
             return TCL_ERROR;
         }
         double alpha;
@@ -2753,6 +2813,9 @@ TclModelBuilderPFEM3DCommand(ClientData clientData, Tcl_Interp *interp, int argc
             } else if(strcmp(argv[loc], "-volthresh") == 0) {
                 states.push_back(4);
                 locs.push_back(loc);
+            } else if(strcmp(argv[loc], "-threads") == 0) {
+                states.push_back(5);
+                locs.push_back(loc);
             }
         }
         locs.push_back(argc);
@@ -2822,6 +2885,18 @@ TclModelBuilderPFEM3DCommand(ClientData clientData, Tcl_Interp *interp, int argc
                     opserr<<" -- PFEM3D doTriangulation\n";
                     return TCL_ERROR; 
                 }
+            } else if(state == 5) {
+                int numThreads;
+                if(l1-l0 < 1) {
+                    opserr<<"WARNING: wrong no of arguments -- PFEM3D doTriangulation\n";
+                    return TCL_ERROR;
+                }
+                if(Tcl_GetInt(interp, argv[l0], &numThreads) != TCL_OK) {
+                    opserr<<"WARNING: invalid number of threads "<<argv[l0];
+                    opserr<<" -- PFEM3D doTriangulation\n";
+                    return TCL_ERROR; 
+                }
+                theMesher3D.setNumThreads(numThreads);
             }
         }
 
@@ -29,6 +29,7 @@
 #include <ElementResponse.h>
 #include <ElementalLoad.h>
 #include <ID.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Node.h>
 #include <Channel.h>
@@ -413,7 +414,8 @@ SSPbrick::update(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 	
 	// assemble displacement vector
-	Vector u(24);
+	double uData[24];
+	Vector u(uData, 24);
 	u(0) =  mDisp_1(0);
 	u(1) =  mDisp_1(1);
 	u(2) =  mDisp_1(2);
@@ -440,8 +442,9 @@ SSPbrick::update(void)
 	u(23) = mDisp_8(2);
 
 	// compute strain and send it to the material
-	Vector strain(6);
-	strain = Bnot*u;
+	double strainData[6];
+	Vector strain(strainData, 6);
+	strain = MatrixView(Bnot)*u;
 	theMaterial->setTrialStrain(strain);
 
 	return 0;
@@ -455,8 +458,9 @@ SSPbrick::getTangentStiff(void)
 	const Matrix &Cmat = theMaterial->getTangent();
 
 	// full element stiffness matrix
+	MatrixView B(Bnot);
 	mTangentStiffness = Kstab;
-	mTangentStiffness.addMatrixTripleProduct(1.0, Bnot, Cmat, mVol);
+	mTangentStiffness += B^MatrixView(Cmat)*B*mVol;
 	
 	return mTangentStiffness;
 }
@@ -598,7 +602,7 @@ SSPbrick::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
 	// get stress from the material
-	Vector mStress = theMaterial->getStress();
+	const Vector &mStress = theMaterial->getStress();
 
 	// get trial displacement
 	const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -611,7 +615,8 @@ SSPbrick::getResistingForce(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 	
 	// assemble displacement vector
-	Vector d(24);
+	double dData[24];
+	Vector d(dData, 24);
 	d(0) =  mDisp_1(0);
 	d(1) =  mDisp_1(1);
 	d(2) =  mDisp_1(2);
@@ -637,14 +642,10 @@ SSPbrick::getResistingForce(void)
 	d(22) = mDisp_8(1);
 	d(23) = mDisp_8(2);
 
-	// add stabilization force to internal force vector
-	mInternalForces = Kstab*d;
-
-	// add internal force from the stress  ->  fint = Kstab*d + 8*Jo*Bnot'*stress
-	mInternalForces.addMatrixTransposeVector(1.0, Bnot, mStress, mVol);
+	// internal force from stabilization and stress  ->  fint = Kstab*d + 8*Jo*Bnot'*stress
+	mInternalForces = MatrixView(Kstab)*d + (MatrixView(Bnot)^VectorView(mStress)*mVol);
 
 	// subtract body forces from internal force vector
-	Vector body(3);
 	if (applyLoad == 0) {
 		double polyJac = 0.0;
 		for (int i = 0; i < 8; i++) {
@@ -36,6 +36,7 @@
 #include <ElementResponse.h>
 #include <ElementalLoad.h>
 #include <ID.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Node.h>
 #include <Channel.h>
@@ -368,7 +369,8 @@ SSPbrickUP::update(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 
 	// assemble displacement vector
-	Vector u(24);
+	double uData[24];
+	Vector u(uData, 24);
 	u(0) =  mDisp_1(0);
 	u(1) =  mDisp_1(1);
 	u(2) =  mDisp_1(2);
@@ -395,8 +397,9 @@ SSPbrickUP::update(void)
 	u(23) = mDisp_8(2);
 
 	// compute strain and send it to the material
-	Vector strain(6);
-	strain = Bnot*u;
+	double strainData[6];
+	Vector strain(strainData, 6);
+	strain = MatrixView(Bnot)*u;
 	theMaterial->setTrialStrain(strain);
 
 	return 0;
@@ -455,7 +458,9 @@ SSPbrickUP::getInitialStiff(void)
 const Matrix &
 SSPbrickUP::getDamp(void)
 {
-	Matrix dampC(24,24);
+	double dampCData[576];
+	Matrix dampC(dampCData, 24, 24);
+	dampC.Zero();
 
 	// solid phase stiffness matrix
 	GetSolidStiffness();
@@ -474,16 +479,17 @@ SSPbrickUP::getDamp(void)
 	}
 
 	// compute coupling matrix Q
-	Matrix couple(24,8);
-	Matrix INp(6,8);
+	double coupleData[192];
+	Matrix couple(coupleData, 24, 8);
+	double INpData[48];
+	Matrix INp(INpData, 6, 8);
 
 	INp.Zero();
 	INp(0,0) = 0.125; INp(0,1) = 0.125; INp(0,2) = 0.125; INp(0,3) = 0.125; INp(0,4) = 0.125; INp(0,5) = 0.125; INp(0,6) = 0.125; INp(0,7) = 0.125;
 	INp(1,0) = 0.125; INp(1,1) = 0.125; INp(1,2) = 0.125; INp(1,3) = 0.125; INp(1,4) = 0.125; INp(1,5) = 0.125; INp(1,6) = 0.125; INp(1,7) = 0.125;
 	INp(2,0) = 0.125; INp(2,1) = 0.125; INp(2,2) = 0.125; INp(2,3) = 0.125; INp(2,4) = 0.125; INp(2,5) = 0.125; INp(2,6) = 0.125; INp(2,7) = 0.125;
 
-	couple.Zero();
-	couple.addMatrixTransposeProduct(0.0, Bnot, INp, mVol);	
+	couple = MatrixView(Bnot)^MatrixView(INp)*mVol;
 
 	// assemble full element damping matrix   [  C  -Q ]
 	// comprised of C, Q, and H submatrices   [ -Q' -H ]
@@ -686,13 +692,13 @@ const Vector &
 SSPbrickUP::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
-	Vector f1(24);
-    f1.Zero();
-	Vector f2(8);
-    f2.Zero();
+	double f1Data[24];
+	Vector f1(f1Data, 24);
+	double f2Data[8];
+	Vector f2(f2Data, 8);
 	
 	// get stress from the material
-	Vector mStress = theMaterial->getStress();
+	const Vector &mStress = theMaterial->getStress();
 
 	// get trial displacement
 	const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -705,7 +711,8 @@ SSPbrickUP::getResistingForce(void)
 	const Vector &mDisp_8 = theNodes[7]->getTrialDisp();
 	
 	// assemble displacement vector
-	Vector d(24);
+	double dData[24];
+	Vector d(dData, 24);
 	d(0) =  mDisp_1(0);
 	d(1) =  mDisp_1(1);
 	d(2) =  mDisp_1(2);
@@ -731,11 +738,8 @@ SSPbrickUP::getResistingForce(void)
 	d(22) = mDisp_8(1);
 	d(23) = mDisp_8(2);
 
-	// add stabilization force to internal force vector
-	f1 = Kstab*d;
-
-	// add internal force from the stress  ->  fint = Kstab*d + 8*Jo*Bnot'*stress
-	f1.addMatrixTransposeVector(1.0, Bnot, mStress, mVol);
+	// internal force from stabilization and stress  ->  fint = Kstab*d + 8*Jo*Bnot'*stress
+	f1 = MatrixView(Kstab)*d + (MatrixView(Bnot)^VectorView(mStress)*mVol);
 
 	// subtract body forces from internal force vector
 	double density = theMaterial->getRho();
@@ -769,23 +773,19 @@ SSPbrickUP::getResistingForce(void)
 	}
 
 	// account for fluid body forces
-	Matrix k(3,3);
-	Vector body(3);
-	// permeability tensor
-	k(0,0) = perm[0];
-	k(1,1) = perm[1];
-	k(2,2) = perm[2];
-	// body force vector
+	// k*body, with k the diagonal permeability tensor
+	double kBodyData[3];
+	Vector kBody(kBodyData, 3);
 	if (applyLoad == 0) {
-		body(0) = b[0];
-		body(1) = b[1];
-		body(2) = b[2];
+		kBody(0) = perm[0]*b[0];
+		kBody(1) = perm[1]*b[1];
+		kBody(2) = perm[2]*b[2];
 	} else {
-		body(0) = appliedB[0];
-		body(1) = appliedB[1];
-		body(2) = appliedB[2];
+		kBody(0) = perm[0]*appliedB[0];
+		kBody(1) = perm[1]*appliedB[1];
+		kBody(2) = perm[2]*appliedB[2];
 	}
-	f2 = mVol*fDens*dNmod*k*body;
+	f2 = MatrixView(dNmod)*kBody*(mVol*fDens);
 
 	// assemble full internal force vector for the element
 	mInternalForces(0)  = f1(0);
@@ -2186,8 +2186,9 @@ SSPbrickUP::GetSolidStiffness(void)
 	const Matrix &Cmat = theMaterial->getTangent();
 
 	// full element stiffness matrix
+	MatrixView B(Bnot);
 	mSolidK = Kstab;
-	mSolidK.addMatrixTripleProduct(1.0, Bnot, Cmat, mVol);
+	mSolidK += B^MatrixView(Cmat)*B*mVol;
 	
 	return;
 }
@@ -33,6 +33,7 @@
 #include <ElementResponse.h>
 #include <ElementalLoad.h>
 #include <ID.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Node.h>
 #include <Channel.h>
@@ -296,7 +297,8 @@ SSPquad::update(void)
 	const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
 	
 	// assemble displacement vector
-	Vector u(8);
+	double uData[8];
+	Vector u(uData, 8);
 	u(0) = mDisp_1(0);
 	u(1) = mDisp_1(1);
 	u(2) = mDisp_2(0);
@@ -306,8 +308,9 @@ SSPquad::update(void)
 	u(6) = mDisp_4(0);
 	u(7) = mDisp_4(1);
 
-	Vector strain(3);
-	strain = Mmem*u;
+	double strainData[3];
+	Vector strain(strainData, 3);
+	strain = MatrixView(Mmem)*u;
 	theMaterial->setTrialStrain(strain);
 
 	return 0;
@@ -321,8 +324,9 @@ SSPquad::getTangentStiff(void)
 	const Matrix &Cmat = theMaterial->getTangent();
 
 	// full element stiffness matrix
+	MatrixView B(Mmem);
 	mTangentStiffness = Kstab;
-	mTangentStiffness.addMatrixTripleProduct(1.0, Mmem, Cmat, 4.0*J0*mThickness);
+	mTangentStiffness += B^MatrixView(Cmat)*B*(4.0*J0*mThickness);
 	
 	return mTangentStiffness;
 }
@@ -442,7 +446,7 @@ SSPquad::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
 	// get stress from the material
-	Vector mStress = theMaterial->getStress();
+	const Vector &mStress = theMaterial->getStress();
 
 	// get trial displacement
 	const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -450,7 +454,8 @@ SSPquad::getResistingForce(void)
 	const Vector &mDisp_3 = theNodes[2]->getTrialDisp();
 	const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
 
-	Vector d(8);
+	double dData[8];
+	Vector d(dData, 8);
 	d(0) = mDisp_1(0);
 	d(1) = mDisp_1(1);
 	d(2) = mDisp_2(0);
@@ -460,11 +465,8 @@ SSPquad::getResistingForce(void)
 	d(6) = mDisp_4(0);
 	d(7) = mDisp_4(1);
 	
-	// add stabilization force to internal force vector
-	mInternalForces = Kstab*d;
-
-	// add internal force from the stress  ->  fint = Kstab*d + 4*t*Jo*Mmem'*stress
-	mInternalForces.addMatrixTransposeVector(1.0, Mmem, mStress, 4.0*mThickness*J0);
+	// internal force from stabilization and stress  ->  fint = Kstab*d + 4*t*Jo*Mmem'*stress
+	mInternalForces = MatrixView(Kstab)*d + (MatrixView(Mmem)^VectorView(mStress)*(4.0*mThickness*J0));
 
 	// subtract body forces from internal force vector
 	double xi[4];
@@ -42,6 +42,7 @@
 #include <ElementResponse.h>
 #include <ElementalLoad.h>
 #include <ID.h>
+#include <MatrixView.h>
 #include <Domain.h>
 #include <Node.h>
 #include <Channel.h>
@@ -367,7 +368,8 @@ SSPquadUP::update(void)
     const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
         
     // assemble displacement vector
-    Vector u(8);
+    double uData[8];
+    Vector u(uData, 8);
     u(0) = mDisp_1(0);
     u(1) = mDisp_1(1);
     u(2) = mDisp_2(0);
@@ -377,8 +379,9 @@ SSPquadUP::update(void)
     u(6) = mDisp_4(0);
     u(7) = mDisp_4(1);
 
-    Vector strain(3);
-    strain = Mmem*u;
+    double strainData[3];
+    Vector strain(strainData, 3);
+    strain = MatrixView(Mmem)*u;
     theMaterial->setTrialStrain(strain);
 
     return 0;
@@ -429,7 +432,9 @@ SSPquadUP::getInitialStiff(void)
 const Matrix &
 SSPquadUP::getDamp(void)
 {
-    Matrix dampC(8,8);
+    double dampCData[64];
+    Matrix dampC(dampCData, 8, 8);
+    dampC.Zero();
 
     // solid phase stiffness matrix
     GetSolidStiffness();
@@ -498,14 +503,11 @@ SSPquadUP::getMass(void)
     // get mass density from the material
     double density = theMaterial->getRho();
 
-    // transpose the shape function derivative array
-    Matrix dNp(2,4);
-    dNp(0,0) = dN(0,0); dNp(0,1) = dN(1,0); dNp(0,2) = dN(2,0); dNp(0,3) = dN(3,0);
-    dNp(1,0) = dN(0,1); dNp(1,1) = dN(1,1); dNp(1,2) = dN(2,1); dNp(1,3) = dN(3,1);
-
     // compute stabilization matrix for incompressible problems
-    Matrix Kp(4,4);
-    Kp = -4.0*mAlpha*J0*mThickness*dN*dNp;
+    MatrixView N(dN);
+    double KpData[16];
+    Matrix Kp(KpData, 4, 4);
+    Kp = N*N.transpose()*(-4.0*mAlpha*J0*mThickness);
 
     // return zero matrix if density is zero
     if (density == 0.0) {
@@ -625,12 +627,13 @@ const Vector &
 SSPquadUP::getResistingForce(void)
 // this function computes the resisting force vector for the element
 {
-    Vector f1(8);
-    Vector f2(4);
-    Vector mStress(3); 
+    double f1Data[8];
+    Vector f1(f1Data, 8);
+    double f2Data[4];
+    Vector f2(f2Data, 4);
         
     // get stress from the material
-    mStress = theMaterial->getStress();
+    const Vector &mStress = theMaterial->getStress();
 
     // get trial displacement
     const Vector &mDisp_1 = theNodes[0]->getTrialDisp();
@@ -638,7 +641,8 @@ SSPquadUP::getResistingForce(void)
     const Vector &mDisp_3 = theNodes[2]->getTrialDisp();
     const Vector &mDisp_4 = theNodes[3]->getTrialDisp();
 
-    Vector d(8);
+    double dData[8];
+    Vector d(dData, 8);
     d(0) = mDisp_1(0);
     d(1) = mDisp_1(1);
     d(2) = mDisp_2(0);
@@ -648,11 +652,8 @@ SSPquadUP::getResistingForce(void)
     d(6) = mDisp_4(0);
     d(7) = mDisp_4(1);
 
-    // add stabilization force to internal force vector 
-    f1 = Kstab*d;
-
-    // add internal force from the stress
-    f1.addMatrixTransposeVector(1.0, Mmem, mStress, 4.0*mThickness*J0);
+    // internal force from stabilization and stress
+    f1 = MatrixView(Kstab)*d + (MatrixView(Mmem)^VectorView(mStress)*(4.0*mThickness*J0));
 
     // get mass density from the material
     double density = theMaterial->getRho();
@@ -676,20 +677,17 @@ SSPquadUP::getResistingForce(void)
     }
 
     // account for fluid body forces
-    Matrix k(2,2);
-    Vector body(2);
-    // permeability tensor
-    k(0,0) = perm[0];
-    k(1,1) = perm[1];
-    // body force vector
+    // k*body, with k the diagonal permeability tensor
+    double kBodyData[2];
+    Vector kBody(kBodyData, 2);
     if (applyLoad == 0) {
-        body(0) = b[0];
-        body(1) = b[1];
+        kBody(0) = perm[0]*b[0];
+        kBody(1) = perm[1]*b[1];
     } else {
-        body(0) = appliedB[0];
-        body(1) = appliedB[1];
+        kBody(0) = perm[0]*appliedB[0];
+        kBody(1) = perm[1]*appliedB[1];
     }
-    f2 = 4.0*J0*mThickness*fDens*dN*k*body;
+    f2 = MatrixView(dN)*kBody*(4.0*J0*mThickness*fDens);
 
     // assemble full internal force vector for the element
     mInternalForces(0)  = f1(0);
@@ -1162,8 +1160,9 @@ SSPquadUP::GetSolidStiffness(void)
 	// get material tangent
 	const Matrix &Cmat = theMaterial->getTangent();
 
+	MatrixView B(Mmem);
 	mSolidK = Kstab;
-	mSolidK.addMatrixTripleProduct(1.0, Mmem, Cmat, 4.0*J0*mThickness);
+	mSolidK += B^MatrixView(Cmat)*B*(4.0*J0*mThickness);
 
 	return;
 }
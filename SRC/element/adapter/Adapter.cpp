@@ -38,6 +38,9 @@
 #include <Information.h>
 #include <ElementResponse.h>
 #include <TCP_Socket.h>
+#ifndef _WIN32
+    #include <SharedMemoryChannel.h>
+#endif
 
 #include <math.h>
 #include <stdlib.h>
@@ -47,11 +50,11 @@
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 Adapter::Adapter(int tag, ID nodes, ID *dof,
-    const Matrix &_kb, int ipport, int addRay, const Matrix *_mb)
+    const Matrix &_kb, int ipport, int addRay, const Matrix *_mb, int _shm)
     : Element(tag, ELE_TAG_Adapter),
     connectedExternalNodes(nodes), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), kb(_kb), ipPort(ipport), addRayleigh(addRay),
-    mb(0), tPast(0.0), theMatrix(1,1), theVector(1), theLoad(1), db(1), q(1),
+    shm(_shm), mb(0), tPast(0.0), theMatrix(1,1), theVector(1), theLoad(1), db(1), q(1),
     theChannel(0), rData(0), recvData(0), sData(0), sendData(0),
     ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
     daqDisp(0), daqVel(0), daqAccel(0), daqForce(0), daqTime(0)
@@ -102,7 +105,7 @@ Adapter::Adapter(int tag, ID nodes, ID *dof,
 Adapter::Adapter()
     : Element(0, ELE_TAG_Adapter),
     connectedExternalNodes(1), basicDOF(1), numExternalNodes(0),
-    numDOF(0), numBasicDOF(0), kb(1,1), ipPort(0), addRayleigh(0), mb(0),
+    numDOF(0), numBasicDOF(0), kb(1,1), ipPort(0), addRayleigh(0), shm(0), mb(0),
     tPast(0.0), theMatrix(1,1), theVector(1), theLoad(1), db(1), q(1),
     theChannel(0), rData(0), recvData(0), sData(0), sendData(0),
     ctrlDisp(0), ctrlVel(0), ctrlAccel(0), ctrlForce(0), ctrlTime(0),
@@ -502,7 +505,7 @@ const Vector& Adapter::getResistingForceIncInertia()
 int Adapter::sendSelf(int commitTag, Channel &sChannel)
 {
     // send element parameters
-    static Vector data(9);
+    static Vector data(10);
     data(0) = this->getTag();
     data(1) = numExternalNodes;
     data(2) = ipPort;
@@ -512,6 +515,7 @@ int Adapter::sendSelf(int commitTag, Channel &sChannel)
     data(6) = betaK;
     data(7) = betaK0;
     data(8) = betaKc;
+    data(9) = shm;
     sChannel.sendVector(0, commitTag, data);
     
     // send the end nodes and dofs
@@ -540,7 +544,7 @@ int Adapter::recvSelf(int commitTag, Channel &rChannel,
         delete mb;
     
     // receive element parameters
-    static Vector data(9);
+    static Vector data(10);
     rChannel.recvVector(0, commitTag, data);
     this->setTag((int)data(0));
     numExternalNodes = (int)data(1);
@@ -550,6 +554,7 @@ int Adapter::recvSelf(int commitTag, Channel &rChannel,
     betaK = data(6);
     betaK0 = data(7);
     betaKc = data(8);
+    shm = (int)data(9);
     
     // initialize nodes and receive them
     connectedExternalNodes.resize(numExternalNodes);
@@ -867,6 +872,15 @@ int Adapter::getResponse(int responseID, Information &eleInformation)
 int Adapter::setupConnection()
 {
     // setup the connection
+#ifndef _WIN32
+    if (shm)  {
+        // the client process is on this machine, the port names the segment
+        char shmName[32];
+        sprintf(shmName, "/OpenSees.%d", ipPort);
+        theChannel = new SharedMemoryChannel(shmName, 0);
+    }
+    else
+#endif
     theChannel = new TCP_Socket(ipPort);
     if (theChannel != 0) {
         opserr << "\nChannel successfully created: "
@@ -56,7 +56,7 @@ double DispBeamColumn3d::workArea[200];
 void* OPS_DispBeamColumn3d()
 {
     if(OPS_GetNumRemainingInputArgs() < 5) {
-	opserr<<"insufficient arguments:eleTag,iNode,jNode,transfTag,integrationTag <-mass mass> <-cmass>\n";
+	opserr<<"insufficient arguments:eleTag,iNode,jNode,transfTag,integrationTag <-mass mass> <-cmass> <-elasticBypass tol>\n";
 	return 0;
     }
 
@@ -71,6 +71,7 @@ void* OPS_DispBeamColumn3d()
     // options
     double mass = 0.0;
     int cmass = 0;
+    double elasticTol = -1.0;
     numData = 1;
     while(OPS_GetNumRemainingInputArgs() > 0) {
 	const char* type = OPS_GetString();
@@ -83,6 +84,14 @@ void* OPS_DispBeamColumn3d()
 		    return 0;
 		}
 	    }
+	} else if(strcmp(type,"-elasticBypass") == 0) {
+	    elasticTol = 0.0;
+	    if(OPS_GetNumRemainingInputArgs() > 0) {
+		if(OPS_GetDoubleInput(&numData,&elasticTol) < 0) {
+		    opserr<<"WARNING: invalid elastic bypass tol\n";
+		    return 0;
+		}
+	    }
 	}
     }
 
@@ -118,7 +127,7 @@ void* OPS_DispBeamColumn3d()
     }
     
     Element *theEle =  new DispBeamColumn3d(iData[0],iData[1],iData[2],secTags.Size(),sections,
-					    *bi,*theTransf,mass,cmass);
+					    *bi,*theTransf,mass,cmass,elasticTol);
     delete [] sections;
     return theEle;
 }
@@ -127,11 +136,13 @@ void* OPS_DispBeamColumn3d()
 DispBeamColumn3d::DispBeamColumn3d(int tag, int nd1, int nd2,
 				   int numSec, SectionForceDeformation **s,
 				   BeamIntegration &bi,
-				   CrdTransf &coordTransf, double r, int cm)
+				   CrdTransf &coordTransf, double r, int cm,
+				   double eTol)
 :Element (tag, ELE_TAG_DispBeamColumn3d),
 numSections(numSec), theSections(0), crdTransf(0), beamInt(0),
 connectedExternalNodes(2), 
-Q(12), q(6), rho(r), cMass(cm), parameterID(0)
+Q(12), q(6), rho(r), cMass(cm), parameterID(0),
+elasticTol(eTol), elasticCommit(false), elasticTrial(false)
 {
   // Allocate arrays of pointers to SectionForceDeformations
   theSections = new SectionForceDeformation *[numSections];
@@ -192,7 +203,8 @@ DispBeamColumn3d::DispBeamColumn3d()
 :Element (0, ELE_TAG_DispBeamColumn3d),
 numSections(0), theSections(0), crdTransf(0), beamInt(0),
 connectedExternalNodes(2), 
-Q(12), q(6), rho(0.0), cMass(0), parameterID(0)
+Q(12), q(6), rho(0.0), cMass(0), parameterID(0),
+elasticTol(-1.0), elasticCommit(false), elasticTrial(false)
 {
   q0[0] = 0.0;
   q0[1] = 0.0;
@@ -311,12 +323,21 @@ DispBeamColumn3d::commitState()
       opserr << "DispBeamColumn3d::commitState () - failed in base class";
     }    
 
+    // bring bypassed sections to the trial state before they commit
+    if (elasticTrial == true) {
+      elasticCommit = false;
+      retVal += this->update();
+    }
+
     // Loop over the integration points and commit the material states
     for (int i = 0; i < numSections; i++)
 		retVal += theSections[i]->commitState();
 
     retVal += crdTransf->commitState();
 
+    if (elasticTol >= 0.0)
+      this->formElasticState();
+
     return retVal;
 }
 
@@ -325,6 +346,9 @@ DispBeamColumn3d::revertToLastCommit()
 {
     int retVal = 0;
 
+    // the linear range about the committed state is still valid
+    elasticTrial = false;
+
     // Loop over the integration points and revert to last committed state
     for (int i = 0; i < numSections; i++)
 		retVal += theSections[i]->revertToLastCommit();
@@ -339,6 +363,9 @@ DispBeamColumn3d::revertToStart()
 {
     int retVal = 0;
 
+    elasticTrial = false;
+    elasticCommit = false;
+
     // Loop over the integration points and revert states to start
     for (int i = 0; i < numSections; i++)
 		retVal += theSections[i]->revertToStart();
@@ -366,39 +393,57 @@ DispBeamColumn3d::update(void)
   double xi[maxNumSections];
   beamInt->getSectionLocations(numSections, L, xi);
 
-  // Loop over the integration points
-  for (int i = 0; i < numSections; i++) {
+  // with the elastic bypass a first pass only checks the section
+  // deformations, the sections are set if one leaves its linear range
+  elasticTrial = false;
+  int pass = (elasticTol >= 0.0 && elasticCommit == true) ? 0 : 1;
 
-    int order = theSections[i]->getOrder();
-    const ID &code = theSections[i]->getType();
+  for ( ; pass < 2; pass++) {
 
-    Vector e(workArea, order);
+    // Loop over the integration points
+    int i;
+    for (i = 0; i < numSections; i++) {
+
+      int order = theSections[i]->getOrder();
+      const ID &code = theSections[i]->getType();
+
+      Vector e(workArea, order);
       
-    double xi6 = 6.0*xi[i];
+      double xi6 = 6.0*xi[i];
     
-    int j;
-    for (j = 0; j < order; j++) {
-      switch(code(j)) {
-      case SECTION_RESPONSE_P:
-	e(j) = oneOverL*v(0);
-	break;
-      case SECTION_RESPONSE_MZ:
-	e(j) = oneOverL*((xi6-4.0)*v(1) + (xi6-2.0)*v(2));
-	break;
-      case SECTION_RESPONSE_MY:
-	e(j) = oneOverL*((xi6-4.0)*v(3) + (xi6-2.0)*v(4));
-	break;
-      case SECTION_RESPONSE_T:
-	e(j) = oneOverL*v(5);
-	break;
-      default:
-	e(j) = 0.0;
-	break;
+      int j;
+      for (j = 0; j < order; j++) {
+	switch(code(j)) {
+	case SECTION_RESPONSE_P:
+	  e(j) = oneOverL*v(0);
+	  break;
+	case SECTION_RESPONSE_MZ:
+	  e(j) = oneOverL*((xi6-4.0)*v(1) + (xi6-2.0)*v(2));
+	  break;
+	case SECTION_RESPONSE_MY:
+	  e(j) = oneOverL*((xi6-4.0)*v(3) + (xi6-2.0)*v(4));
+	  break;
+	case SECTION_RESPONSE_T:
+	  e(j) = oneOverL*v(5);
+	  break;
+	default:
+	  e(j) = 0.0;
+	  break;
+	}
       }
-    }
     
-    // Set the section deformations
-    err += theSections[i]->setTrialSectionDeformation(e);
+      if (pass == 0) {
+	if (theSections[i]->isElastic(e, elasticTol) == false)
+	  break;
+      } else
+	// Set the section deformations
+	err += theSections[i]->setTrialSectionDeformation(e);
+    }
+
+    if (pass == 0 && i == numSections) {
+      elasticTrial = true;
+      return 0;
+    }
   }
 
   if (err != 0) {
@@ -412,6 +457,13 @@ const Matrix&
 DispBeamColumn3d::getTangentStiff()
 {
   static Matrix kb(6,6);
+
+  if (elasticTrial == true) {
+    this->formElasticBasicForce();
+    Matrix kbElasticMatrix(kbElastic, 6, 6);
+    K = crdTransf->getGlobalStiffMatrix(kbElasticMatrix, q);
+    return K;
+  }
   
   // Zero for integral
   kb.Zero();
@@ -639,6 +691,97 @@ DispBeamColumn3d::getInitialBasicStiff()
   return kb;
 }
 
+int
+DispBeamColumn3d::formElasticState(void)
+{
+  elasticCommit = false;
+
+  double L = crdTransf->getInitialLength();
+  double oneOverL = 1.0/L;
+
+  double xi[maxNumSections];
+  beamInt->getSectionLocations(numSections, L, xi);
+  double wt[maxNumSections];
+  beamInt->getSectionWeights(numSections, L, wt);
+
+  Matrix kb(kbElastic, 6, 6);
+  Vector qb(qElastic, 6);
+  kb.Zero();
+  qb.Zero();
+
+  // kb = sum B^ ks B wt/L and qb = sum B^ s wt with the stiffness of
+  // the linear range, only done at commit so the B are formed in full
+  for (int i = 0; i < numSections; i++) {
+
+    const Matrix *ks = theSections[i]->getElasticTangent();
+    if (ks == 0)
+      return -1;
+
+    int order = theSections[i]->getOrder();
+    const ID &code = theSections[i]->getType();
+    const Vector &s = theSections[i]->getStressResultant();
+
+    Matrix B(workArea, order, 6);
+    B.Zero();
+
+    double xi6 = 6.0*xi[i];
+
+    for (int j = 0; j < order; j++) {
+      switch(code(j)) {
+      case SECTION_RESPONSE_P:
+	B(j,0) = 1.0;
+	break;
+      case SECTION_RESPONSE_MZ:
+	B(j,1) = xi6-4.0; B(j,2) = xi6-2.0;
+	break;
+      case SECTION_RESPONSE_MY:
+	B(j,3) = xi6-4.0; B(j,4) = xi6-2.0;
+	break;
+      case SECTION_RESPONSE_T:
+	B(j,5) = 1.0;
+	break;
+      default:
+	break;
+      }
+    }
+
+    kb.addMatrixTripleProduct(1.0, B, *ks, wt[i]*oneOverL);
+    qb.addMatrixTransposeVector(1.0, B, s, wt[i]);
+  }
+
+  const Vector &v = crdTransf->getBasicTrialDisp();
+  for (int i = 0; i < 6; i++)
+    vElastic[i] = v(i);
+
+  elasticCommit = true;
+
+  return 0;
+}
+
+void
+DispBeamColumn3d::formElasticBasicForce(void)
+{
+  const Vector &v = crdTransf->getBasicTrialDisp();
+
+  double dv[6];
+  for (int j = 0; j < 6; j++)
+    dv[j] = v(j) - vElastic[j];
+
+  // q = qElastic + kbElastic*(v - vElastic), kbElastic by columns
+  for (int i = 0; i < 6; i++) {
+    double qi = qElastic[i];
+    for (int j = 0; j < 6; j++)
+      qi += kbElastic[j*6+i]*dv[j];
+    q(i) = qi;
+  }
+
+  q(0) += q0[0];
+  q(1) += q0[1];
+  q(2) += q0[2];
+  q(3) += q0[3];
+  q(4) += q0[4];
+}
+
 const Matrix&
 DispBeamColumn3d::getInitialStiff()
 {
@@ -842,6 +985,13 @@ DispBeamColumn3d::addInertiaLoadToUnbalance(const Vector &accel)
 const Vector&
 DispBeamColumn3d::getResistingForce()
 {
+  if (elasticTrial == true) {
+    this->formElasticBasicForce();
+    Vector p0Vec(p0, 5);
+    P = crdTransf->getGlobalResistingForce(q, p0Vec);
+    return P;
+  }
+
   double L = crdTransf->getInitialLength();
 
   //const Matrix &pts = quadRule.getIntegrPointCoords(numSections);
@@ -960,7 +1110,7 @@ DispBeamColumn3d::sendSelf(int commitTag, Channel &theChannel)
   int i, j;
   int loc = 0;
   
-  static Vector data(14);
+  static Vector data(15);
   data(0) = this->getTag();
   data(1) = connectedExternalNodes(0);
   data(2) = connectedExternalNodes(1);
@@ -987,6 +1137,7 @@ DispBeamColumn3d::sendSelf(int commitTag, Channel &theChannel)
   data(11) = betaK;
   data(12) = betaK0;
   data(13) = betaKc;
+  data(14) = elasticTol;
   
   if (theChannel.sendVector(dbTag, commitTag, data) < 0) {
     opserr << "DispBeamColumn3d::sendSelf() - failed to send data Vector\n";
@@ -1054,7 +1205,7 @@ DispBeamColumn3d::recvSelf(int commitTag, Channel &theChannel,
   int dbTag = this->getDbTag();
   int i;
   
-  static Vector data(14);
+  static Vector data(15);
 
   if (theChannel.recvVector(dbTag, commitTag, data) < 0)  {
     opserr << "DispBeamColumn3d::recvSelf() - failed to recv data Vector\n";
@@ -1078,6 +1229,10 @@ DispBeamColumn3d::recvSelf(int commitTag, Channel &theChannel,
   betaK = data(11);
   betaK0 = data(12);
   betaKc = data(13);
+
+  elasticTol = data(14);
+  elasticCommit = false;
+  elasticTrial = false;
   
   // create a new crdTransf object if one needed
   if (crdTransf == 0 || crdTransf->getClassTag() != crdTransfClassTag) {
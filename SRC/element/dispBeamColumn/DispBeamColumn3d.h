@@ -53,7 +53,7 @@ class DispBeamColumn3d : public Element
     DispBeamColumn3d(int tag, int nd1, int nd2,
 		     int numSections, SectionForceDeformation **s,
 		     BeamIntegration &bi, CrdTransf &coordTransf,
-             double rho = 0.0, int cMass = 0);
+             double rho = 0.0, int cMass = 0, double elasticTol = -1.0);
     DispBeamColumn3d();
     ~DispBeamColumn3d();
 
@@ -108,6 +108,8 @@ class DispBeamColumn3d : public Element
     
   private:
     const Matrix &getInitialBasicStiff(void);
+    int formElasticState(void);
+    void formElasticBasicForce(void);
 
     int numSections;
     SectionForceDeformation **theSections; // pointer to the ND material objects
@@ -132,6 +134,16 @@ class DispBeamColumn3d : public Element
 
 	int parameterID;
 
+    // elastic bypass: while every section stays in the linear range about
+    // the committed state the sections are not updated, the basic forces
+    // follow from the stiffness formed at the last commit
+    double elasticTol;     // fraction of the range held back, < 0 for no bypass
+    bool elasticCommit;    // kbElastic etc. formed at the last commit
+    bool elasticTrial;     // the trial state is in the linear range
+    double kbElastic[36];  // basic stiffness in the linear range
+    double qElastic[6];    // committed basic forces, without q0
+    double vElastic[6];    // committed basic deformations
+
     enum {maxNumSections = 20};
 
     static double workArea[];
@@ -45,14 +45,19 @@
 #include <Renderer.h>
 #include <SectionForceDeformation.h>
 #include <ID.h>
+#include <MatrixND.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string>
 #include <elementAPI.h>
 
-Matrix ElasticBeam3d::K(12,12);
-Vector ElasticBeam3d::P(12);
-Matrix ElasticBeam3d::kb(6,6);
+// fixed-size storage for the static matrices; K, P and kb are views of it
+static MatrixND<12,12> KStore;
+static VectorND<12>    PStore;
+static MatrixND<6,6>   kbStore;
+Matrix ElasticBeam3d::K(KStore.values[0], 12, 12);
+Vector ElasticBeam3d::P(PStore.values, 12);
+Matrix ElasticBeam3d::kb(kbStore.values[0], 6, 6);
 
 void* OPS_ElasticBeam3d(void)
 {
@@ -67,6 +67,7 @@ Journal of Structural Engineering, Approved for publication, February 2007.
 #include <Parameter.h>
 #include <ForceBeamColumn3d.h>
 #include <MatrixUtil.h>
+#include <MatrixND.h>
 #include <Domain.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -122,6 +123,7 @@ void* OPS_ForceBeamColumn3d()
 
     // options
     double mass = 0.0, tol=1e-12;
+    double elasticTol = -1.0;
     int maxIter = 10;
     numData = 1;
     while(OPS_GetNumRemainingInputArgs() > 0) {
@@ -144,6 +146,14 @@ void* OPS_ForceBeamColumn3d()
 		    return 0;
 		}
 	    }
+	} else if(strcmp(type,"-elasticBypass") == 0) {
+	    elasticTol = 0.0;
+	    if(OPS_GetNumRemainingInputArgs() > 0) {
+		if(OPS_GetDoubleInput(&numData,&elasticTol) < 0) {
+		    opserr << "WARNING invalid elastic bypass tol\n";
+		    return 0;
+		}
+	    }
 	}
     }
 
@@ -178,7 +188,7 @@ void* OPS_ForceBeamColumn3d()
     }
 
     Element *theEle =  new ForceBeamColumn3d(iData[0],iData[1],iData[2],secTags.Size(),sections,
-					     *bi,*theTransf,mass,maxIter,tol);
+					     *bi,*theTransf,mass,maxIter,tol,elasticTol);
     delete [] sections;
     return theEle;
 }
@@ -195,7 +205,9 @@ ForceBeamColumn3d::ForceBeamColumn3d():
   kvcommit(NEBD,NEBD), Secommit(NEBD),
   fs(0), vs(0), Ssr(0), vscommit(0), sp(0),
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0),
-  Ki(0), isTorsion(false), parameterID(0)
+  Ki(0), isTorsion(false),
+  elasticTol(-1.0), elasticCommit(false), elasticTrial(false), fsElastic(0),
+  parameterID(0)
 {
   theNodes[0] = 0;  
   theNodes[1] = 0;
@@ -231,7 +243,8 @@ ForceBeamColumn3d::ForceBeamColumn3d (int tag, int nodeI, int nodeJ,
 				      int numSec, SectionForceDeformation **sec,
 				      BeamIntegration &bi,
 				      CrdTransf &coordTransf, double massDensPerUnitLength,
-				      int maxNumIters, double tolerance):
+				      int maxNumIters, double tolerance,
+				      double eTol):
   Element(tag,ELE_TAG_ForceBeamColumn3d), connectedExternalNodes(2),
   beamIntegr(0), numSections(0), sections(0), crdTransf(0),
   rho(massDensPerUnitLength),maxIters(maxNumIters), tol(tolerance), 
@@ -240,7 +253,9 @@ ForceBeamColumn3d::ForceBeamColumn3d (int tag, int nodeI, int nodeJ,
   kvcommit(NEBD,NEBD), Secommit(NEBD),
   fs(0), vs(0),Ssr(0), vscommit(0), sp(0), 
   numEleLoads(0), sizeEleLoads(0), eleLoads(0), eleLoadFactors(0), 
-  Ki(0), isTorsion(false), parameterID(0)
+  Ki(0), isTorsion(false),
+  elasticTol(eTol), elasticCommit(false), elasticTrial(false), fsElastic(0),
+  parameterID(0)
 {
   theNodes[0] = 0;
   theNodes[1] = 0;
@@ -323,6 +338,9 @@ ForceBeamColumn3d::~ForceBeamColumn3d()
 
   if (Ki != 0)
     delete Ki;
+
+  if (fsElastic != 0)
+    delete [] fsElastic;
 }
 
 int
@@ -420,6 +438,16 @@ ForceBeamColumn3d::commitState()
   if ((err = this->Element::commitState()) != 0) {
     opserr << "ForceBeamColumn3d::commitState () - failed in base class";
   }    
+
+  // bring bypassed sections to the trial state before they commit
+  if (elasticTrial == true) {
+    for (int k = 0; k < numSections; k++) {
+      sections[k]->setTrialSectionDeformation(vs[k]);
+      Ssr[k] = sections[k]->getStressResultant();
+      fs[k]  = sections[k]->getSectionFlexibility();
+    }
+    elasticTrial = false;
+  }
   
   do {
     vscommit[i] = vs[i];
@@ -437,6 +465,9 @@ ForceBeamColumn3d::commitState()
   // commit the element variables state
   kvcommit = kv;
   Secommit = Se;
+
+  if (elasticTol >= 0.0)
+    this->formElasticState();
   
   //   initialFlag = 0;  fmk - commented out, see what happens to Example3.1.tcl if uncommented
   //                         - i have not a clue why, ask remo if he ever gets in contact with us again!
@@ -448,6 +479,9 @@ int ForceBeamColumn3d::revertToLastCommit()
 {
   int err;
   int i = 0;
+
+  // the linear range about the committed state is still valid
+  elasticTrial = false;
   
   do {
     vs[i] = vscommit[i];
@@ -483,6 +517,9 @@ int ForceBeamColumn3d::revertToStart()
   // revert the sections state to start
   int err;
   int i = 0;
+
+  elasticTrial = false;
+  elasticCommit = false;
   
   do {
     fs[i].Zero();
@@ -519,18 +556,15 @@ ForceBeamColumn3d::getInitialStiff(void)
   if (Ki != 0)
     return *Ki;
 
-  static Matrix f(NEBD,NEBD);   // element flexibility matrix  
+  static MatrixND<NEBD,NEBD> fStore;
+  static Matrix f(fStore.values[0], NEBD, NEBD);   // element flexibility matrix  
   this->getInitialFlexibility(f);
   
-  static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse  
-  I.Zero();
-  for (int i=0; i<NEBD; i++)
-    I(i,i) = 1.0;
-  
   // calculate element stiffness matrix
   // invert3by3Matrix(f, kv);
-  static Matrix kvInit(NEBD, NEBD);
-  if (f.Solve(I, kvInit) < 0)
+  static MatrixND<NEBD,NEBD> kvInitStore;
+  static Matrix kvInit(kvInitStore.values[0], NEBD, NEBD);
+  if (fStore.invert(kvInitStore) < 0)
     opserr << "ForceBeamColumn3d::getInitialStiff() -- could not invert flexibility";
 
     Ki = new Matrix(crdTransf->getInitialGlobalStiffMatrix(kvInit));
@@ -710,6 +744,12 @@ ForceBeamColumn3d::computeReactionSensitivity(double *dp0dh, int gradNumber)
     if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && sp == 0)
       return 0;
 
+    // skip the local iterations while the sections stay linear
+    elasticTrial = false;
+    if (elasticTol >= 0.0 && elasticCommit == true && initialFlag == 1 && sp == 0)
+      if (this->updateElastic(v) == 0)
+	return 0;
+
     static Vector vin(NEBD);
     vin = v;
     vin -= dv;
@@ -723,23 +763,20 @@ ForceBeamColumn3d::computeReactionSensitivity(double *dp0dh, int gradNumber)
     beamIntegr->getSectionWeights(numSections, L, wt);
 
     static Vector vr(NEBD);       // element residual displacements
-    static Matrix f(NEBD,NEBD);   // element flexibility matrix
+    static MatrixND<NEBD,NEBD> fStore;
+    static Matrix f(fStore.values[0], NEBD, NEBD);   // element flexibility matrix
 
-    static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
     double dW;                    // section strain energy (work) norm 
     int i, j;
 
-    I.Zero();
-    for (i=0; i<NEBD; i++)
-      I(i,i) = 1.0;
-
     int numSubdivide = 1;
     bool converged = false;
     static Vector dSe(NEBD);
     static Vector dvToDo(NEBD);
     static Vector dvTrial(NEBD);
     static Vector SeTrial(NEBD);
-    static Matrix kvTrial(NEBD, NEBD);
+    static MatrixND<NEBD,NEBD> kvTrialStore;
+    static Matrix kvTrial(kvTrialStore.values[0], NEBD, NEBD);
 
     dvToDo = dv;
     dvTrial = dvToDo;
@@ -1087,7 +1124,7 @@ ForceBeamColumn3d::computeReactionSensitivity(double *dp0dh, int gradNumber)
 	    // invert3by3Matrix(f, kv);	  
 	    // FRANK
 	    //	  if (f.SolveSVD(I, kvTrial, 1.0e-12) < 0)
-	    if (f.Solve(I, kvTrial) < 0)
+	    if (fStore.invert(kvTrialStore) < 0)
 	      opserr << "ForceBeamColumn3d::update() -- could not invert flexibility\n";
 	    
 
@@ -1179,6 +1216,129 @@ ForceBeamColumn3d::computeReactionSensitivity(double *dp0dh, int gradNumber)
     return 0;
   }
 
+  int
+  ForceBeamColumn3d::formElasticState(void)
+  {
+    elasticCommit = false;
+
+    if (sp != 0)
+      return -1;
+
+    if (fsElastic == 0)
+      fsElastic = new Matrix [maxNumSections];
+
+    double L = crdTransf->getInitialLength();
+
+    double xi[maxNumSections];
+    beamIntegr->getSectionLocations(numSections, L, xi);
+
+    double wt[maxNumSections];
+    beamIntegr->getSectionWeights(numSections, L, wt);
+
+    static Matrix f(NEBD,NEBD);   // element flexibility in the linear range
+    f.Zero();
+    beamIntegr->addElasticFlexibility(L, f);
+
+    // f += b^ fs b wtL, only done at commit so the b are formed in full
+    for (int i = 0; i < numSections; i++) {
+
+      const Matrix *ks = sections[i]->getElasticTangent();
+      if (ks == 0)
+	return -1;
+
+      int order = sections[i]->getOrder();
+      const ID &code = sections[i]->getType();
+
+      if (fsElastic[i].noRows() != order)
+	fsElastic[i] = Matrix(order,order);
+      if (ks->Invert(fsElastic[i]) < 0)
+	return -1;
+
+      Matrix b(workArea, order, NEBD);
+      this->getForceInterpolatMatrix(xi[i], b, code);
+
+      f.addMatrixTripleProduct(1.0, b, fsElastic[i], wt[i]*L);
+    }
+
+    if (!isTorsion)
+      f(5,5) = DefaultLoverGJ;
+
+    Matrix kvE(kvElastic, NEBD, NEBD);
+    if (f.Invert(kvE) < 0)
+      return -1;
+
+    const Vector &v = crdTransf->getBasicTrialDisp();
+    for (int i = 0; i < NEBD; i++)
+      vElastic[i] = v(i);
+
+    elasticCommit = true;
+
+    return 0;
+  }
+
+  int
+  ForceBeamColumn3d::updateElastic(const Vector &v)
+  {
+    double L = crdTransf->getInitialLength();
+
+    double xi[maxNumSections];
+    beamIntegr->getSectionLocations(numSections, L, xi);
+
+    // dSe = kvElastic*(v - vElastic), kvElastic by columns
+    static Vector dSe(NEBD);
+    int i, j;
+    for (i = 0; i < NEBD; i++) {
+      double dSei = 0.0;
+      for (j = 0; j < NEBD; j++)
+	dSei += kvElastic[j*NEBD+i]*(v(j) - vElastic[j]);
+      dSe(i) = dSei;
+    }
+
+    // the section deformations that go with these forces must all be
+    // in the linear range before the element state is changed
+    for (i = 0; i < numSections; i++) {
+
+      int order = sections[i]->getOrder();
+      const ID &code = sections[i]->getType();
+
+      Matrix b(workArea, order, NEBD);
+      this->getForceInterpolatMatrix(xi[i], b, code);
+
+      // vs = vscommit + fs*b*dSe
+      Vector dSs(&workArea[order*NEBD], order);
+      dSs.addMatrixVector(0.0, b, dSe, 1.0);
+      vsSubdivide[i] = vscommit[i];
+      vsSubdivide[i].addMatrixVector(1.0, fsElastic[i], dSs, 1.0);
+
+      if (sections[i]->isElastic(vsSubdivide[i], elasticTol) == false)
+	return -1;
+    }
+
+    Se = Secommit;
+    Se += dSe;
+
+    for (i = 0; i < NEBD; i++)
+      for (j = 0; j < NEBD; j++)
+	kv(i,j) = kvElastic[j*NEBD+i];
+
+    for (i = 0; i < numSections; i++) {
+
+      int order = sections[i]->getOrder();
+      const ID &code = sections[i]->getType();
+
+      Matrix b(workArea, order, NEBD);
+      this->getForceInterpolatMatrix(xi[i], b, code);
+
+      vs[i] = vsSubdivide[i];
+      fs[i] = fsElastic[i];
+      Ssr[i].addMatrixVector(0.0, b, Se, 1.0);
+    }
+
+    elasticTrial = true;
+
+    return 0;
+  }
+
   void ForceBeamColumn3d::getForceInterpolatMatrix(double xi, Matrix &b, const ID &code)
   {
     b.Zero();
@@ -1808,7 +1968,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
        secDefSize   += size;
     }
 
-    Vector dData(1+1+NEBD+NEBD*NEBD+secDefSize + 4); 
+    Vector dData(1+1+NEBD+NEBD*NEBD+secDefSize + 5); 
     loc = 0;
 
     // place double variables into Vector
@@ -1838,6 +1998,8 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     dData(loc++) = betaK;
     dData(loc++) = betaK0;
     dData(loc++) = betaKc;
+
+    dData(loc++) = elasticTol;
     
     if (theChannel.sendVector(dbTag, commitTag, dData) < 0) {
        opserr << "ForceBeamColumn3d::sendSelf() - failed to send Vector data\n";
@@ -2072,7 +2234,7 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
        secDefSize   += size;
     }
 
-    Vector dData(1+1+NEBD+NEBD*NEBD+secDefSize+4);   
+    Vector dData(1+1+NEBD+NEBD*NEBD+secDefSize+5);   
 
     if (theChannel.recvVector(dbTag, commitTag, dData) < 0)  {
       opserr << "ForceBeamColumn3d::recvSelf() - failed to send Vector data\n";
@@ -2115,6 +2277,10 @@ ForceBeamColumn3d::computeSectionForceSensitivity(Vector &dspdh, int isec,
     betaK = dData(loc++);
     betaK0 = dData(loc++);
     betaKc = dData(loc++);
+
+    elasticTol = dData(loc++);
+    elasticCommit = false;
+    elasticTrial = false;
     
     initialFlag = 2;  
     return 0;
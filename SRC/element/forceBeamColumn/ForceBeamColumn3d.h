@@ -81,7 +81,8 @@ class ForceBeamColumn3d: public Element
 		    int numSections, SectionForceDeformation **sec,
 		    BeamIntegration &beamIntegr,
 		    CrdTransf &coordTransf, double rho = 0.0, 
-		    int maxNumIters = 10, double tolerance = 1.0e-12);
+		    int maxNumIters = 10, double tolerance = 1.0e-12,
+		    double elasticTol = -1.0);
   
   ~ForceBeamColumn3d();
   const char *getClassType(void) const {return "ForceBeamColumn3d";};
@@ -141,6 +142,10 @@ class ForceBeamColumn3d: public Element
   void getDistrLoadInterpolatMatrix(double xi, Matrix &bp, const ID &code);
   void compSectionDisplacements(Vector sectionCoords[], Vector sectionDispls[]) const;
   void initializeSectionHistoryVariables (void);
+
+  // elastic bypass
+  int formElasticState(void);
+  int updateElastic(const Vector &v);
   
   // Reactions of basic system due to element loads
   void computeReactions(double *p0);
@@ -194,6 +199,16 @@ class ForceBeamColumn3d: public Element
   Matrix *Ki;
 
   bool isTorsion;
+
+  // elastic bypass: while every section stays in the linear range about
+  // the committed state the local iterations are skipped, the basic
+  // forces follow from the flexibility formed at the last commit
+  double elasticTol;        // fraction of the range held back, < 0 for no bypass
+  bool elasticCommit;       // kvElastic etc. formed at the last commit
+  bool elasticTrial;        // the trial state is in the linear range
+  double kvElastic[36];     // basic stiffness in the linear range
+  double vElastic[6];       // committed basic deformations
+  Matrix *fsElastic;        // section flexibilities in the linear range
   
   static Matrix theMatrix;
   static Vector theVector;
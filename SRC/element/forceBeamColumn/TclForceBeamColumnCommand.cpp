@@ -267,6 +267,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     double tol = 1.0e-12;
     double mass = 0.0;
     int cMass = 0;
+    double elasticTol = -1.0;
     BeamIntegration *beamIntegr = 0;
 
     while (argi < argc) {
@@ -305,6 +306,12 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
       } else if ((strcmp(argv[argi],"-cMass") == 0) || (strcmp(argv[argi],"cMass") == 0)) {
           cMass = 1;
           argi++;
+      } else if (strcmp(argv[argi],"-elasticBypass") == 0) {
+	elasticTol = 0.0;
+	if (argi+1 < argc && Tcl_GetDouble(interp, argv[argi+1], &elasticTol) == TCL_OK)
+	  argi += 2;
+	else
+	  argi++;
       } else if (strcmp(argv[argi],"-integration") == 0) {
 
 	argi++;
@@ -395,11 +402,11 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
       if (strcmp(argv[1],"elasticForceBeamColumn") == 0)
 	theElement = new ElasticForceBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass);
       else if (strcmp(argv[1],"dispBeamColumn") == 0)
-	theElement = new DispBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, cMass);
+	theElement = new DispBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, cMass, elasticTol);
 	  else if (strcmp(argv[1],"dispBeamColumnWithSensitivity") == 0)
 	theElement = new DispBeamColumn3dWithSensitivity(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass);
       else
-	theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, numIter, tol);
+	theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, nIP, sections, *beamIntegr, *theTransf3d, mass, numIter, tol, elasticTol);
     }
 
     delete beamIntegr;
@@ -1258,6 +1265,7 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
   int cMass = 0;
   int numIter = 10;
   double tol = 1.0e-12;
+  double elasticTol = -1.0;
 
   while (argi < argc) {
     if (strcmp(argv[argi],"-iter") == 0) {
@@ -1295,6 +1303,10 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     } else if ((strcmp(argv[argi],"-cMass") == 0 || strcmp(argv[argi],"cMass") == 0)) {
       cMass = 1;
       argi++;
+    } else if (strcmp(argv[argi],"-elasticBypass") == 0) {
+      elasticTol = 0.0;
+      if (argi+1 < argc && Tcl_GetDouble(interp, argv[argi+1], &elasticTol) == TCL_OK)
+	argi++;
     }
     argi += 1;
   }
@@ -1327,9 +1339,9 @@ TclModelBuilder_addForceBeamColumn(ClientData clientData, Tcl_Interp *interp,
     if (strcmp(argv[1],"elasticForceBeamColumn") == 0)
       theElement = new ElasticForceBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass);
     else if (strcmp(argv[1],"dispBeamColumn") == 0)
-      theElement = new DispBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, cMass);
+      theElement = new DispBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, cMass, elasticTol);
     else
-      theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, numIter, tol);
+      theElement = new ForceBeamColumn3d(eleTag, iNode, jNode, numSections, sections, *beamIntegr, *theTransf3d, mass, numIter, tol, elasticTol);
   }
 
   if (beamIntegr != 0)
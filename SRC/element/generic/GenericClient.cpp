@@ -40,6 +40,9 @@
 #include <ElementResponse.h>
 #include <TCP_Socket.h>
 #include <UDP_Socket.h>
+#ifndef _WIN32
+    #include <SharedMemoryChannel.h>
+#endif
 #ifdef SSL
     #include <TCP_SocketSSL.h>
 #endif
@@ -52,11 +55,12 @@
 // responsible for allocating the necessary space needed
 // by each object and storing the tags of the end nodes.
 GenericClient::GenericClient(int tag, ID nodes, ID *dof, int _port,
-    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay)
+    char *machineinetaddr, int _ssl, int _udp, int datasize, int addRay,
+    int _shm)
     : Element(tag, ELE_TAG_GenericClient),
     connectedExternalNodes(nodes), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(_port), machineInetAddr(0), ssl(_ssl),
-    udp(_udp), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
+    udp(_udp), shm(_shm), dataSize(datasize), addRayleigh(addRay), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -111,7 +115,7 @@ GenericClient::GenericClient()
     : Element(0, ELE_TAG_GenericClient),
     connectedExternalNodes(1), basicDOF(1), numExternalNodes(0),
     numDOF(0), numBasicDOF(0), port(0), machineInetAddr(0), ssl(0),
-    udp(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
+    udp(0), shm(0), dataSize(0), addRayleigh(0), theMatrix(1,1),
     theVector(1), theLoad(1), theInitStiff(1,1), theMass(1,1),
     theChannel(0), sData(0), sendData(0), rData(0), recvData(0),
     db(0), vb(0), ab(0), t(0), qDaq(0), rMatrix(0),
@@ -543,7 +547,7 @@ const Vector& GenericClient::getBasicAccel()
 int GenericClient::sendSelf(int commitTag, Channel &sChannel)
 {
     // send element parameters
-    static Vector data(12);
+    static Vector data(13);
     data(0) = this->getTag();
     data(1) = numExternalNodes;
     data(2) = port;
@@ -556,6 +560,7 @@ int GenericClient::sendSelf(int commitTag, Channel &sChannel)
     data(9) = betaK;
     data(10) = betaK0;
     data(11) = betaKc;
+    data(12) = shm;
     sChannel.sendVector(0, commitTag, data);
     
     // send the end nodes and dofs
@@ -583,7 +588,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
         delete [] machineInetAddr;
     
     // receive element parameters
-    static Vector data(12);
+    static Vector data(13);
     rChannel.recvVector(0, commitTag, data);
     this->setTag((int)data(0));
     numExternalNodes = (int)data(1);
@@ -597,6 +602,7 @@ int GenericClient::recvSelf(int commitTag, Channel &rChannel,
     betaK = data(9);
     betaK0 = data(10);
     betaKc = data(11);
+    shm = (int)data(12);
     
     // initialize nodes and receive them
     connectedExternalNodes.resize(numExternalNodes);
@@ -904,6 +910,15 @@ int GenericClient::getResponse(int responseID, Information &eleInfo)
 int GenericClient::setupConnection()
 {
     // setup the connection
+#ifndef _WIN32
+    if (shm)  {
+        // the server process is on this machine, the port names the segment
+        char shmName[32];
+        sprintf(shmName, "/OpenSees.%d", port);
+        theChannel = new SharedMemoryChannel(shmName, 1);
+    }
+    else
+#endif
     if (udp)  {
         if (machineInetAddr == 0)
             theChannel = new UDP_Socket(port, "127.0.0.1");
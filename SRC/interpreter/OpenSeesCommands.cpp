@@ -58,11 +58,13 @@
 #include <FullGenEigenSolver.h>
 #include <FullGenEigenSOE.h>
 #include <ArpackSOE.h>
+#include <SubspaceEigenSolver.h>
 #include <LoadControl.h>
 #include <CTestPFEM.h>
 #include <PFEMIntegrator.h>
 #include <TransientIntegrator.h>
 #include <PFEMSolver.h>
+#include <MeshImporter.h>
 #include <PFEMLinSOE.h>
 #include <Accelerator.h>
 #include <KrylovAccelerator.h>
@@ -216,6 +218,11 @@ OpenSeesCommands::eigen(int typeSolver, double shift,
 	    FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
 	    theEigenSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
 
+	} else if (typeSolver == EigenSOE_TAGS_SubspaceEigenSOE) {
+
+	    SubspaceEigenSolver *theEigenSolver = new SubspaceEigenSolver();
+	    theEigenSOE = new ArpackSOE(*theEigenSolver, shift);
+
 	} else {
 
 	    theEigenSOE = new ArpackSOE(shift);
@@ -1105,13 +1112,41 @@ int OPS_wipeAnalysis()
 int OPS_model()
 {
     // num args
-    if(OPS_GetNumRemainingInputArgs() < 3) {
+    if(OPS_GetNumRemainingInputArgs() < 2) {
 	opserr<<"WARNING insufficient args: model -ndm ndm <-ndf ndf>\n";
 	return -1;
     }
 
     // model type
     const char* modeltype = OPS_GetString();
+
+    // model import fileName - adds a binary mesh to the current model
+    if (strcmp(modeltype,"import") == 0) {
+	const char* fileName = OPS_GetString();
+	Domain* theDomain = cmds->getDomain();
+	if (theDomain == 0 || cmds->getNDM() <= 0) {
+	    opserr<<"WARNING model import - a basic model must be defined first\n";
+	    return -1;
+	}
+	MeshImporter theImporter(*theDomain, cmds->getNDM(), cmds->getNDF());
+	if (theImporter.importMesh(fileName) < 0) {
+	    opserr<<"WARNING model import - failed to import "<<fileName<<"\n";
+	    return -1;
+	}
+	int counts[3] = {theImporter.getNumNodes(), theImporter.getNumElements(),
+			 theImporter.getNumSP_Constraints()};
+	int numdata = 3;
+	if (OPS_SetIntOutput(&numdata, counts) < 0) {
+	    opserr<<"WARNING model import - failed to set output\n";
+	    return -1;
+	}
+	return 0;
+    }
+
+    if(OPS_GetNumRemainingInputArgs() < 2) {
+	opserr<<"WARNING insufficient args: model -ndm ndm <-ndf ndf>\n";
+	return -1;
+    }
     if (strcmp(modeltype,"basic")!=0 && strcmp(modeltype,"Basic")!=0 &&
 	strcmp(modeltype,"BasicBuilder")!=0 && strcmp(modeltype,"basicBuilder")!=0) {
 	opserr<<"WARNING only basic builder is available at this time\n";
@@ -1262,7 +1297,26 @@ int OPS_System()
 
     } else if ((strcmp(type,"SparseSPD") == 0) || (strcmp(type,"SparseSYM") == 0)) {
 	// now must determine the type of solver to create from rest of args
-	theSOE = (LinearSOE*)OPS_SymSparseLinSolver();
+	// the options start with a - and are for the new SparseSPDLinSOE
+	bool options = false;
+	bool outOfCore = false;
+	int numArgs = OPS_GetNumRemainingInputArgs();
+	if (strcmp(type,"SparseSPD") == 0 && numArgs > 0) {
+	    for (int i=0; i<numArgs; i++) {
+		const char *opt = OPS_GetString();
+		if (i == 0)
+		    options = (opt[0] == '-');
+		if (strcmp(opt,"-outOfCore") == 0)
+		    outOfCore = true;
+	    }
+	    OPS_ResetCurrentInputArg(-numArgs);
+	}
+	if (options && outOfCore)
+	    theSOE = (LinearSOE*)OPS_OutOfCoreSparseSPDSolver();
+	else if (options)
+	    theSOE = (LinearSOE*)OPS_SupernodalSparseSPDSolver();
+	else
+	    theSOE = (LinearSOE*)OPS_SymSparseLinSolver();
 
     } else if (strcmp(type, "UmfPack") == 0 || strcmp(type, "Umfpack") == 0) {
 
@@ -1789,6 +1843,10 @@ int OPS_eigenAnalysis()
 		 (strcmp(type,"-fullGenLapackEigen") == 0))
 	    typeSolver = EigenSOE_TAGS_FullGenEigenSOE;
 
+	else if ((strcmp(type,"subspace") == 0) ||
+		 (strcmp(type,"-subspace") == 0))
+	    typeSolver = EigenSOE_TAGS_SubspaceEigenSOE;
+
 	else {
 	    opserr << "eigen - unknown option specified " << type << endln;
 	}
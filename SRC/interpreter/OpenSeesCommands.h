@@ -331,6 +331,8 @@ void* OPS_PFEMSolver();
 void* OPS_PFEMCompressibleSolver();
 void* OPS_PFEMSolver_Umfpack();
 void* OPS_SymSparseLinSolver();
+void* OPS_OutOfCoreSparseSPDSolver();
+void* OPS_SupernodalSparseSPDSolver();
 void* OPS_FullGenLinLapackSolver();
 
 void* OPS_PlainNumberer();
@@ -74,6 +74,7 @@
 #include <FullGenEigenSolver.h>
 #include <FullGenEigenSOE.h>
 #include <ArpackSOE.h>
+#include <SubspaceEigenSolver.h>
 #include <iostream>
 #include <ProfileSPDLinSOE.h>
 
@@ -418,6 +419,10 @@ void PythonAnalysisBuilder::newEigenAnalysis(int typeSolver, double shift)
 	    FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
 	    theEigenSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
 
+	} else if(typeSolver == EigenSOE_TAGS_SubspaceEigenSOE) {
+	    SubspaceEigenSolver *theEigenSolver = new SubspaceEigenSolver();
+	    theEigenSOE = new ArpackSOE(*theEigenSolver, shift);
+
 	} else {
 	    theEigenSOE = new ArpackSOE(shift);    
 	}
@@ -1140,6 +1145,8 @@ PyObject *ops_eigenAnalysis(PyObject *self, PyObject *args)
 	} else if(type=="fullGenLapack"||type=="-fullGenLapack"||
 		  type=="fullGenLapackEigen"||type=="-fullGenLapackEigen") {
 	    typeSolver = EigenSOE_TAGS_FullGenEigenSOE;
+	} else if(type=="subspace"||type=="-subspace") {
+	    typeSolver = EigenSOE_TAGS_SubspaceEigenSOE;
 	} else {
 	    PyErr_SetString(PyExc_RuntimeError,"eigen - unknown option specified");
 	    return NULL;
@@ -0,0 +1,152 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+
+// Description: The implementation of the read-only python buffer object.
+//
+
+#include "PythonBuffer.h"
+
+typedef struct {
+    PyObject_HEAD
+    char* data;
+    int owned;            // 1 doubles, 2 ints from new []
+    char format[2];
+    int ndim;
+    Py_ssize_t itemsize;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} PythonBufferObject;
+
+static PyTypeObject PythonBufferType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+};
+
+static PyBufferProcs PythonBufferProcs;
+
+static void
+PythonBuffer_dealloc(PyObject* self)
+{
+    PythonBufferObject* theBuffer = (PythonBufferObject*)self;
+    if (theBuffer->owned == 1) {
+	delete [] (double*)theBuffer->data;
+    } else if (theBuffer->owned == 2) {
+	delete [] (int*)theBuffer->data;
+    }
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+PythonBuffer_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    PythonBufferObject* theBuffer = (PythonBufferObject*)self;
+
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+	PyErr_SetString(PyExc_BufferError, "OpenSees response buffers are read-only");
+	view->obj = NULL;
+	return -1;
+    }
+
+    Py_ssize_t len = theBuffer->itemsize;
+    for (int i=0; i<theBuffer->ndim; i++) {
+	len *= theBuffer->shape[i];
+    }
+
+    view->buf = theBuffer->data;
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = len;
+    view->readonly = 1;
+    view->itemsize = theBuffer->itemsize;
+    view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? theBuffer->format : NULL;
+    view->ndim = theBuffer->ndim;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? theBuffer->shape : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? theBuffer->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+int
+PythonBuffer_Ready()
+{
+    PythonBufferProcs.bf_getbuffer = PythonBuffer_getbuffer;
+    PythonBufferProcs.bf_releasebuffer = NULL;
+
+    PythonBufferType.tp_name = "opensees.buffer";
+    PythonBufferType.tp_basicsize = sizeof(PythonBufferObject);
+    PythonBufferType.tp_dealloc = PythonBuffer_dealloc;
+    PythonBufferType.tp_as_buffer = &PythonBufferProcs;
+#if PY_MAJOR_VERSION < 3
+    PythonBufferType.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER;
+#else
+    PythonBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+#endif
+    PythonBufferType.tp_doc = "read-only OpenSees response array, use numpy.asarray()";
+
+    return PyType_Ready(&PythonBufferType);
+}
+
+static PyObject*
+PythonBuffer_New(char* data, int owned, char format, Py_ssize_t itemsize,
+		 int nrows, int ncols)
+{
+    PythonBufferObject* theBuffer = PyObject_New(PythonBufferObject, &PythonBufferType);
+    if (theBuffer == NULL) {
+	if (owned == 1) delete [] (double*)data;
+	if (owned == 2) delete [] (int*)data;
+	return NULL;
+    }
+
+    theBuffer->data = data;
+    theBuffer->owned = owned;
+    theBuffer->format[0] = format;
+    theBuffer->format[1] = '\0';
+    theBuffer->itemsize = itemsize;
+    if (ncols > 0) {
+	theBuffer->ndim = 2;
+	theBuffer->shape[0] = nrows;
+	theBuffer->shape[1] = ncols;
+	theBuffer->strides[0] = ncols*itemsize;
+	theBuffer->strides[1] = itemsize;
+    } else {
+	theBuffer->ndim = 1;
+	theBuffer->shape[0] = nrows;
+	theBuffer->shape[1] = 0;
+	theBuffer->strides[0] = itemsize;
+	theBuffer->strides[1] = 0;
+    }
+
+    return (PyObject*)theBuffer;
+}
+
+PyObject*
+PythonBuffer_FromDoubles(double* data, int nrows, int ncols)
+{
+    return PythonBuffer_New((char*)data, 1, 'd', sizeof(double), nrows, ncols);
+}
+
+PyObject*
+PythonBuffer_FromInts(int* data, int n)
+{
+    return PythonBuffer_New((char*)data, 2, 'i', sizeof(int), n, 0);
+}
@@ -0,0 +1,41 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+
+// Description: A read-only python object exposing a contiguous array of
+// doubles or ints through the buffer protocol, so that numpy.asarray()
+// and memoryview() see the data without copying it. The array, the
+// result of a bulk command, is owned by the object.
+//
+
+#ifndef PythonBuffer_h
+#define PythonBuffer_h
+
+#include <Python.h>
+
+// must be called once before any buffer is created
+int PythonBuffer_Ready();
+
+// takes ownership of data, which must have come from new []
+PyObject* PythonBuffer_FromDoubles(double* data, int nrows, int ncols);
+PyObject* PythonBuffer_FromInts(int* data, int n);
+
+#endif
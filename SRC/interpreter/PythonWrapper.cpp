@@ -25,7 +25,12 @@
 
 #include "PythonWrapper.h"
 #include "OpenSeesCommands.h"
+#include "PythonBuffer.h"
 #include <OPS_Globals.h>
+#include <elementAPI.h>
+#include <Node.h>
+#include <NodalStateStore.h>
+#include <Vector.h>
 
 PythonWrapper* wrapper = 0;
 
@@ -129,6 +134,10 @@ PythonWrapper::getResults()
 //////////////////////////////////////////////
 /////// Python wrapper functions  ////////////
 /////////////////////////////////////////////
+static bool isTagArray(PyObject* o);
+static PyObject *bulkNodeResponse(PyObject *args, NodeResponseType type);
+static PyObject *bulkEleResponse(PyObject *args);
+
 static PyObject *Py_ops_UniaxialMaterial(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
@@ -330,6 +339,9 @@ static PyObject *Py_ops_analyze(PyObject *self, PyObject *args)
 
 static PyObject *Py_ops_nodeDisp(PyObject *self, PyObject *args)
 {
+    if (PyTuple_Size(args) > 0 && isTagArray(PyTuple_GetItem(args, 0)))
+	return bulkNodeResponse(args, Disp);
+
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
     if (OPS_nodeDisp() < 0) return NULL;
@@ -546,6 +558,9 @@ static PyObject *Py_ops_getTime(PyObject *self, PyObject *args)
 
 static PyObject *Py_ops_eleResponse(PyObject *self, PyObject *args)
 {
+    if (PyTuple_Size(args) > 0 && isTagArray(PyTuple_GetItem(args, 0)))
+	return bulkEleResponse(args);
+
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
     if (OPS_eleResponse() < 0) return NULL;
@@ -744,6 +759,9 @@ static PyObject *Py_ops_nodeUnbalance(PyObject *self, PyObject *args)
 
 static PyObject *Py_ops_nodeVel(PyObject *self, PyObject *args)
 {
+    if (PyTuple_Size(args) > 0 && isTagArray(PyTuple_GetItem(args, 0)))
+	return bulkNodeResponse(args, Vel);
+
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
     if (OPS_nodeVel() < 0) return NULL;
@@ -762,6 +780,9 @@ static PyObject *Py_ops_setNodeVel(PyObject *self, PyObject *args)
 
 static PyObject *Py_ops_nodeAccel(PyObject *self, PyObject *args)
 {
+    if (PyTuple_Size(args) > 0 && isTagArray(PyTuple_GetItem(args, 0)))
+	return bulkNodeResponse(args, Accel);
+
     wrapper->resetCommandLine(PyTuple_Size(args), 1, args);
 
     if (OPS_nodeAccel() < 0) return NULL;
@@ -1266,12 +1287,259 @@ static PyObject *Py_ops_remesh(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+//////////////////////////////////////////////
+/////// Bulk access to responses  ////////////
+//////////////////////////////////////////////
+
+// true if o holds many tags, rather than being the tag of one component
+static bool isTagArray(PyObject* o)
+{
+    if (PyList_Check(o) || PyTuple_Check(o)) return true;
+    if (!PySequence_Check(o)) return false;
+    if (PySequence_Size(o) < 0) {
+	PyErr_Clear();
+	return false;
+    }
+    return true;
+}
+
+// reads tags from a contiguous buffer of ints, e.g. a numpy array, or
+// from any sequence
+static int getTags(PyObject* o, std::vector<int>& tags)
+{
+    if (PyObject_CheckBuffer(o)) {
+	Py_buffer view;
+	if (PyObject_GetBuffer(o, &view, PyBUF_FORMAT|PyBUF_C_CONTIGUOUS) == 0) {
+	    char type = (view.format != NULL) ? view.format[0] : 'B';
+	    if (type == '=' || type == '<' || type == '@') type = view.format[1];
+	    bool done = true;
+	    Py_ssize_t num = (view.itemsize > 0) ? view.len/view.itemsize : 0;
+	    tags.resize(num);
+	    if ((type == 'i' || type == 'l' || type == 'q') && view.itemsize == sizeof(int)) {
+		int* data = (int*)view.buf;
+		for (Py_ssize_t i=0; i<num; i++) tags[i] = data[i];
+	    } else if ((type == 'l' || type == 'q') && view.itemsize == sizeof(long long)) {
+		long long* data = (long long*)view.buf;
+		for (Py_ssize_t i=0; i<num; i++) tags[i] = (int)data[i];
+	    } else {
+		done = false;
+	    }
+	    PyBuffer_Release(&view);
+	    if (done) return 0;
+	} else {
+	    PyErr_Clear();
+	}
+    }
+
+    PyObject* seq = PySequence_Fast(o, "tags must be a sequence of ints");
+    if (seq == NULL) return -1;
+
+    Py_ssize_t num = PySequence_Fast_GET_SIZE(seq);
+    PyObject** items = PySequence_Fast_ITEMS(seq);
+    tags.resize(num);
+    for (Py_ssize_t i=0; i<num; i++) {
+	Py_ssize_t tag = PyNumber_AsSsize_t(items[i], NULL);
+	if (tag == -1 && PyErr_Occurred()) {
+	    Py_DECREF(seq);
+	    return -1;
+	}
+	tags[i] = (int)tag;
+    }
+    Py_DECREF(seq);
+
+    return 0;
+}
+
+// nodeDisp(tags <, dof>) and the like: the response of all the nodes in
+// one array of shape (numNodes, ndf), or (numNodes) if a dof is given
+static PyObject *bulkNodeResponse(PyObject *args, NodeResponseType type)
+{
+    std::vector<int> tags;
+    if (getTags(PyTuple_GetItem(args, 0), tags) < 0) return NULL;
+
+    int dof = -1;
+    if (PyTuple_Size(args) > 1) {
+	Py_ssize_t value = PyNumber_AsSsize_t(PyTuple_GetItem(args, 1), NULL);
+	if (value == -1 && PyErr_Occurred()) return NULL;
+	dof = (int)value - 1;
+    }
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	PyErr_SetString(PyExc_RuntimeError, "no domain");
+	return NULL;
+    }
+
+    int numNodes = (int)tags.size();
+    int ncols = 0;
+    double* data = 0;
+
+    for (int i=0; i<numNodes; i++) {
+	Node* theNode = theDomain->getNode(tags[i]);
+	const Vector* theResponse = (theNode != 0) ? theNode->getResponse(type) : 0;
+	if (theResponse == 0) {
+	    if (data != 0) delete [] data;
+	    PyErr_Format(PyExc_ValueError, "no response for node %d", tags[i]);
+	    return NULL;
+	}
+
+	int size = theResponse->Size();
+	if (data == 0) {
+	    ncols = (dof >= 0) ? 1 : size;
+	    data = new double[numNodes*ncols];
+	}
+
+	if (dof >= 0) {
+	    if (dof >= size) {
+		delete [] data;
+		PyErr_Format(PyExc_ValueError, "node %d has no dof %d", tags[i], dof+1);
+		return NULL;
+	    }
+	    data[i] = (*theResponse)(dof);
+	} else {
+	    if (size != ncols) {
+		delete [] data;
+		PyErr_Format(PyExc_ValueError, "node %d has %d dof not %d, give a dof", tags[i], size, ncols);
+		return NULL;
+	    }
+	    double* row = &data[i*ncols];
+	    for (int j=0; j<ncols; j++) row[j] = (*theResponse)(j);
+	}
+    }
+
+    if (data == 0) data = new double[1];
+
+    return PythonBuffer_FromDoubles(data, numNodes, (dof >= 0) ? 0 : ncols);
+}
+
+// eleResponse(tags, args..): the response of all the elements in one
+// array of shape (numEle, size)
+static PyObject *bulkEleResponse(PyObject *args)
+{
+    std::vector<int> tags;
+    if (getTags(PyTuple_GetItem(args, 0), tags) < 0) return NULL;
+
+    int argc = (int)PyTuple_Size(args) - 1;
+    std::vector<const char*> argv(argc > 0 ? argc : 1);
+    for (int i=0; i<argc; i++) {
+	PyObject* o = PyTuple_GetItem(args, i+1);
+#if PY_MAJOR_VERSION >= 3
+	if (!PyUnicode_Check(o)) {
+	    PyErr_SetString(PyExc_TypeError, "eleResponse arguments must be strings");
+	    return NULL;
+	}
+	argv[i] = PyUnicode_AsUTF8(o);
+#else
+	if (!PyString_Check(o)) {
+	    PyErr_SetString(PyExc_TypeError, "eleResponse arguments must be strings");
+	    return NULL;
+	}
+	argv[i] = PyString_AS_STRING(o);
+#endif
+    }
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	PyErr_SetString(PyExc_RuntimeError, "no domain");
+	return NULL;
+    }
+
+    int numEle = (int)tags.size();
+    int ncols = 0;
+    double* data = 0;
+
+    for (int i=0; i<numEle; i++) {
+	const Vector* theResponse = theDomain->getElementResponse(tags[i], &argv[0], argc);
+	if (theResponse == 0 || (data != 0 && theResponse->Size() != ncols)) {
+	    if (data != 0) delete [] data;
+	    PyErr_Format(PyExc_ValueError, "no response of the size of the first for element %d", tags[i]);
+	    return NULL;
+	}
+
+	if (data == 0) {
+	    ncols = theResponse->Size();
+	    data = new double[numEle*ncols+1];
+	}
+
+	double* row = &data[i*ncols];
+	for (int j=0; j<ncols; j++) row[j] = (*theResponse)(j);
+    }
+
+    if (data == 0) data = new double[1];
+
+    return PythonBuffer_FromDoubles(data, numEle, ncols);
+}
+
+// nodeResponseView('disp'|'vel'|'accel'): the trial response of all the
+// nodes held by the domain state store, copied in one block into an array
+// which is not affected by later steps or changes to the domain
+static PyObject *Py_ops_nodeResponseView(PyObject *self, PyObject *args)
+{
+    const char* type = "disp";
+    if (!PyArg_ParseTuple(args, "|s", &type)) return NULL;
+
+    Domain* theDomain = OPS_GetDomain();
+    NodalStateStore* theStore = (theDomain != 0) ? theDomain->getNodalStateStore() : 0;
+    if (theStore == 0) {
+	PyErr_SetString(PyExc_RuntimeError, "no nodal state store, use domainStateStore on and analyze first");
+	return NULL;
+    }
+
+    double* data = 0;
+    if (strcmp(type, "disp") == 0) {
+	data = theStore->getDisp();
+    } else if (strcmp(type, "vel") == 0) {
+	data = theStore->getVel();
+    } else if (strcmp(type, "accel") == 0) {
+	data = theStore->getAccel();
+    } else {
+	PyErr_Format(PyExc_ValueError, "unknown response %s, want disp, vel or accel", type);
+	return NULL;
+    }
+
+    int numDOF = theStore->getNumDOF();
+    double* copy = new double[numDOF > 0 ? numDOF : 1];
+    for (int i=0; i<numDOF; i++) copy[i] = data[i];
+
+    return PythonBuffer_FromDoubles(copy, numDOF, 0);
+}
+
+// nodeStoreOffsets(tags): the location of the first dof of each node in
+// the arrays of nodeResponseView(), -1 for a node not in the store
+static PyObject *Py_ops_nodeStoreOffsets(PyObject *self, PyObject *args)
+{
+    if (PyTuple_Size(args) < 1) {
+	PyErr_SetString(PyExc_TypeError, "nodeStoreOffsets(tags)");
+	return NULL;
+    }
+
+    std::vector<int> tags;
+    if (getTags(PyTuple_GetItem(args, 0), tags) < 0) return NULL;
+
+    Domain* theDomain = OPS_GetDomain();
+    if (theDomain == 0) {
+	PyErr_SetString(PyExc_RuntimeError, "no domain");
+	return NULL;
+    }
+
+    int numNodes = (int)tags.size();
+    int* data = new int[numNodes > 0 ? numNodes : 1];
+    for (int i=0; i<numNodes; i++) {
+	Node* theNode = theDomain->getNode(tags[i]);
+	data[i] = (theNode != 0) ? theNode->getStateStoreOffset() : -1;
+    }
+
+    return PythonBuffer_FromInts(data, numNodes);
+}
+
 /////////////////////////////////////////////////
 ////////////// Add Python commands //////////////
 /////////////////////////////////////////////////
 void
 PythonWrapper::addOpenSeesCommands()
 {
+    PythonBuffer_Ready();
+
     addCommand("uniaxialMaterial", &Py_ops_UniaxialMaterial);
     addCommand("testUniaxialMaterial", &Py_ops_testUniaxialMaterial);
     addCommand("setStrain", &Py_ops_setStrain);
@@ -1343,6 +1611,8 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("nodeVel", &Py_ops_nodeVel);
     addCommand("setNodeVel", &Py_ops_setNodeVel);
     addCommand("nodeAccel", &Py_ops_nodeAccel);
+    addCommand("nodeResponseView", &Py_ops_nodeResponseView);
+    addCommand("nodeStoreOffsets", &Py_ops_nodeStoreOffsets);
     addCommand("nodeResponse", &Py_ops_nodeResponse);
     addCommand("nodeCoord", &Py_ops_nodeCoord);
     addCommand("setNodeCoord", &Py_ops_setNodeCoord);
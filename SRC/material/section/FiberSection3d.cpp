@@ -69,7 +69,8 @@ void* OPS_FiberSection3d()
 FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers, UniaxialMaterial *torsion): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  elasticData(0), elasticState(0)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -132,6 +133,9 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers, UniaxialMateria
   for (int i=0; i<16; i++)
     kData[i] = 0.0;
 
+  for (int i=0; i<4; i++)
+    eCommitData[i] = 0.0;
+
   code(0) = SECTION_RESPONSE_P;
   code(1) = SECTION_RESPONSE_MZ;
   code(2) = SECTION_RESPONSE_MY;
@@ -141,7 +145,8 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers, UniaxialMateria
 FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial *torsion): 
     SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
     numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
-    QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+    QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+    elasticData(0), elasticState(0)
 {
     if(sizeFibers != 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -186,6 +191,9 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial *torsion):
     for (int i=0; i<16; i++)
 	kData[i] = 0.0;
 
+    for (int i=0; i<4; i++)
+	eCommitData[i] = 0.0;
+
     code(0) = SECTION_RESPONSE_P;
     code(1) = SECTION_RESPONSE_MZ;
     code(2) = SECTION_RESPONSE_MY;
@@ -196,7 +204,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
 			       SectionIntegration &si, UniaxialMaterial *torsion):
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  elasticData(0), elasticState(0)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -261,6 +270,9 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
   for (int i = 0; i < 16; i++)
     kData[i] = 0.0;
   
+  for (int i=0; i<4; i++)
+    eCommitData[i] = 0.0;
+
   code(0) = SECTION_RESPONSE_P;
   code(1) = SECTION_RESPONSE_MZ;
   code(2) = SECTION_RESPONSE_MY;
@@ -271,7 +283,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
 FiberSection3d::FiberSection3d():
   SectionForceDeformation(0, SEC_TAG_FiberSection3d),
   numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0),
+  elasticData(0), elasticState(0)
 {
   s = new Vector(sData, 4);
   ks = new Matrix(kData, 4, 4);
@@ -284,6 +297,9 @@ FiberSection3d::FiberSection3d():
   for (int i=0; i<16; i++)
     kData[i] = 0.0;
 
+  for (int i=0; i<4; i++)
+    eCommitData[i] = 0.0;
+
   code(0) = SECTION_RESPONSE_P;
   code(1) = SECTION_RESPONSE_MZ;
   code(2) = SECTION_RESPONSE_MY;
@@ -330,6 +346,12 @@ FiberSection3d::addFiber(Fiber &newFiber)
       theMaterials = newArray;
       matData = newMatData;
   }
+
+  // the elastic range is formed again for the new fiber
+  if (elasticData != 0)
+    delete [] elasticData;
+  elasticData = 0;
+  elasticState = 0;
 	    
   // set the new pointers
   double yLoc, zLoc, Area;
@@ -386,6 +408,9 @@ FiberSection3d::~FiberSection3d()
 
   if (theTorsion != 0)
     delete theTorsion;
+
+  if (elasticData != 0)
+    delete [] elasticData;
 }
 
 int
@@ -521,6 +546,135 @@ FiberSection3d::getInitialTangent(void)
   return kInitial;
 }
 
+const Matrix *
+FiberSection3d::getElasticTangent(void)
+{
+  if (elasticState == 0)
+    this->formElasticState();
+
+  if (elasticState < 0)
+    return 0;
+
+  static Matrix kElastic;
+  kElastic.setData(kElasticData, 4, 4);
+
+  return &kElastic;
+}
+
+bool
+FiberSection3d::isElastic(const Vector &deforms, double tol)
+{
+  if (elasticState == 0)
+    this->formElasticState();
+
+  if (elasticState < 0)
+    return false;
+
+  // tol keeps that fraction of the range, on either side of the
+  // committed strain, in reserve
+  double factor = 1.0 - tol;
+  if (factor > 1.0)
+    factor = 1.0;
+  if (factor < 0.0)
+    factor = 0.0;
+
+  double d0 = deforms(0);
+  double d1 = deforms(1);
+  double d2 = deforms(2);
+  double d3 = deforms(3);
+
+  for (int i = 0; i < numFibers; i++) {
+    const double *data = &elasticData[5*i];
+    double strain = d0 + data[0]*d1 + data[1]*d2;
+    double strainC = data[2];
+    if (strain < strainC + factor*(data[3]-strainC) ||
+	strain > strainC + factor*(data[4]-strainC))
+      return false;
+  }
+
+  double strainC = elasticTorsion[0];
+  if (d3 < strainC + factor*(elasticTorsion[1]-strainC) ||
+      d3 > strainC + factor*(elasticTorsion[2]-strainC))
+    return false;
+
+  return true;
+}
+
+int
+FiberSection3d::formElasticState(void)
+{
+  elasticState = -1;
+
+  if (elasticData == 0 && numFibers > 0)
+    elasticData = new double [5*numFibers];
+
+  for (int i = 0; i < 16; i++)
+    kElasticData[i] = 0.0;
+
+  static double yLocs[10000];
+  static double zLocs[10000];
+  static double fiberArea[10000];
+
+  if (sectionIntegr != 0) {
+    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+    sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  }  
+  else {
+    for (int i = 0; i < numFibers; i++) {
+      yLocs[i] = matData[3*i];
+      zLocs[i] = matData[3*i+1];
+      fiberArea[i] = matData[3*i+2];
+    }
+  }
+
+  double strainMin, strainMax, tangent;
+  for (int i = 0; i < numFibers; i++) {
+    double y = yLocs[i] - yBar;
+    double z = zLocs[i] - zBar;
+    double A = fiberArea[i];
+
+    if (theMaterials[i]->getElasticRange(strainMin, strainMax, tangent) < 0)
+      return -1;
+
+    double *data = &elasticData[5*i];
+    data[0] = -y;
+    data[1] = z;
+    data[2] = eCommitData[0] - y*eCommitData[1] + z*eCommitData[2];
+    data[3] = strainMin;
+    data[4] = strainMax;
+
+    double value = tangent * A;
+    double vas1 = -y*value;
+    double vas2 = z*value;
+    double vas1as2 = vas1*z;
+
+    kElasticData[0] += value;
+    kElasticData[1] += vas1;
+    kElasticData[2] += vas2;
+    
+    kElasticData[5] += vas1 * -y;
+    kElasticData[6] += vas1as2;
+    
+    kElasticData[10] += vas2 * z; 
+  }
+
+  kElasticData[4] = kElasticData[1];
+  kElasticData[8] = kElasticData[2];
+  kElasticData[9] = kElasticData[6];
+
+  if (theTorsion->getElasticRange(strainMin, strainMax, tangent) < 0)
+    return -1;
+
+  elasticTorsion[0] = eCommitData[3];
+  elasticTorsion[1] = strainMin;
+  elasticTorsion[2] = strainMax;
+  kElasticData[15] = tangent;
+
+  elasticState = 1;
+
+  return 0;
+}
+
 const Vector&
 FiberSection3d::getSectionDeformation(void)
 {
@@ -578,6 +732,8 @@ FiberSection3d::getCopy(void)
   }
 
   theCopy->e = e;
+  for (int i=0; i<4; i++)
+    theCopy->eCommitData[i] = eCommitData[i];
   theCopy->QzBar = QzBar;
   theCopy->QyBar = QyBar;
   theCopy->Abar = Abar;
@@ -627,6 +783,10 @@ FiberSection3d::commitState(void)
 
   err += theTorsion->commitState();
 
+  for (int i = 0; i < 4; i++)
+    eCommitData[i] = e(i);
+  elasticState = 0;
+
   return err;
 }
 
@@ -767,6 +927,10 @@ FiberSection3d::revertToStart(void)
   kData[15] = theTorsion->getTangent();
   sData[3] = theTorsion->getStress();
 
+  for (int i = 0; i < 4; i++)
+    eCommitData[i] = 0.0;
+  elasticState = 0;
+
   return err;
 }
 
@@ -955,6 +1119,13 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
     
     yBar = QzBar/Abar;
     zBar = QyBar/Abar;
+
+    // the committed deformations are not sent, so the elastic range
+    // is not available until the next commit
+    if (elasticData != 0)
+      delete [] elasticData;
+    elasticData = 0;
+    elasticState = -1;
   }    
 
   return res;
@@ -62,6 +62,9 @@ class FiberSection3d : public SectionForceDeformation
     const Matrix &getSectionTangent(void);
     const Matrix &getInitialTangent(void);
 
+    const Matrix *getElasticTangent(void);
+    bool isElastic(const Vector &deforms, double tol = 0.0);
+
     int   commitState(void);
     int   revertToLastCommit(void);    
     int   revertToStart(void);
@@ -96,6 +99,8 @@ class FiberSection3d : public SectionForceDeformation
   protected:
     
   private:
+    int formElasticState(void);
+
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
@@ -115,6 +120,13 @@ class FiberSection3d : public SectionForceDeformation
     Matrix *ks;        // section stiffness
 
     UniaxialMaterial *theTorsion;
+
+    // linear range about the committed state, formed when first asked for
+    double eCommitData[4];     // committed section deformations
+    double *elasticData;       // -y, z, committed strain, min and max strain of each fiber
+    double elasticTorsion[3];  // the same for the torsion material
+    double kElasticData[16];   // section stiffness in that range
+    int elasticState;          // 0 to be formed, 1 formed, -1 not available
 };
 
 #endif
@@ -158,6 +158,18 @@ SectionForceDeformation::getRho(void)
   return 0.0 ;
 }
 
+const Matrix *
+SectionForceDeformation::getElasticTangent(void)
+{
+  return 0;
+}
+
+bool
+SectionForceDeformation::isElastic(const Vector &deforms, double tol)
+{
+  return false;
+}
+
 Response*
 SectionForceDeformation::setResponse(const char **argv, int argc,
 				     OPS_Stream &output)
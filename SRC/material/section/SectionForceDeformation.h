@@ -74,6 +74,12 @@ class SectionForceDeformation : public Material
   virtual const Matrix &getInitialFlexibility (void);
   
   virtual double getRho(void);
+
+  // the section stiffness valid for all deformations in the linear range
+  // about the last committed state, and whether the deformations are
+  // inside that range; 0 and false if the section cannot tell
+  virtual const Matrix *getElasticTangent(void);
+  virtual bool isElastic(const Vector &deforms, double tol = 0.0);
   
   virtual int commitState (void) = 0;
   virtual int revertToLastCommit (void) = 0;
@@ -398,6 +398,32 @@ double Concrete01::getTangent ()
    return Ttangent;
 }
 
+int Concrete01::getElasticRange (double &strainMin, double &strainMax, double &tangent)
+{
+   // cracked, the stress stays zero until the unloading line is met again
+   if (Cstress == 0.0 && Cstrain >= CendStrain) {
+      strainMin = CendStrain;
+      strainMax = DBL_MAX;
+      tangent = 0.0;
+      return 0;
+   }
+
+   // otherwise the committed point must be on the unloading line, which
+   // holds between the envelope at CminStrain and the end of unloading
+   double lineStress = CunloadSlope*(Cstrain - CendStrain);
+   if (fabs(Cstress - lineStress) > 1.0e-10*fabs(fpc))
+      return -1;
+
+   strainMin = CminStrain;
+   strainMax = (CendStrain < 0.0) ? CendStrain : 0.0;
+   tangent = CunloadSlope;
+
+   if (Cstrain > strainMax)
+      return -1;
+
+   return 0;
+}
+
 int Concrete01::commitState ()
 {
    // History variables
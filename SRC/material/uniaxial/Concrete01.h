@@ -56,6 +56,7 @@ class Concrete01 : public UniaxialMaterial
   double getStress(void);
   double getTangent(void);
   double getInitialTangent(void) {return 2.0*fpc/epsc0;}
+  int getElasticRange(double &strainMin, double &strainMax, double &tangent);
 
   int commitState(void);
   int revertToLastCommit(void);    
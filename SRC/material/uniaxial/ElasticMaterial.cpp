@@ -38,6 +38,7 @@
 #include <Information.h>
 #include <Parameter.h>
 #include <string.h>
+#include <float.h>
 
 #include <OPS_Globals.h>
 
@@ -190,6 +191,31 @@ ElasticMaterial::getInitialTangent(void)
 }
 
 
+int
+ElasticMaterial::getElasticRange(double &strainMin, double &strainMax, double &tangent)
+{
+    // the viscous part depends on the strain rate, not only the strain
+    if (eta != 0.0)
+        return -1;
+
+    strainMin = -DBL_MAX;
+    strainMax = DBL_MAX;
+    tangent = Epos;
+
+    // with different moduli the range stops at zero strain
+    if (Epos != Eneg) {
+        if (committedStrain >= 0.0)
+            strainMin = 0.0;
+        else {
+            strainMax = 0.0;
+            tangent = Eneg;
+        }
+    }
+
+    return 0;
+}
+
+
 int 
 ElasticMaterial::commitState(void)
 {
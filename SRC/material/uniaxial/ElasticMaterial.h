@@ -56,6 +56,7 @@ class ElasticMaterial : public UniaxialMaterial
     double getTangent(void);
     double getDampTangent(void) {return eta;};
     double getInitialTangent(void);
+    int getElasticRange(double &strainMin, double &strainMax, double &tangent);
 
     int commitState(void);
     int revertToLastCommit(void);    
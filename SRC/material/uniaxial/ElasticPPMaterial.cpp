@@ -193,6 +193,18 @@ ElasticPPMaterial::getTangent(void)
   return trialTangent;
 }
 
+int
+ElasticPPMaterial::getElasticRange(double &strainMin, double &strainMax, double &tangent)
+{
+  // commitState() moves ep so the committed point is on or inside
+  // the yield surface, which is then fixed until the next commit
+  strainMin = ezero + ep + fyn/E;
+  strainMax = ezero + ep + fyp/E;
+  tangent = E;
+
+  return 0;
+}
+
 int 
 ElasticPPMaterial::commitState(void)
 {
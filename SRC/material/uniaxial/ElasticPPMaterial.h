@@ -54,6 +54,7 @@ class ElasticPPMaterial : public UniaxialMaterial
     double getTangent(void);
 
     double getInitialTangent(void) {return E;};
+    int getElasticRange(double &strainMin, double &strainMax, double &tangent);
 
     int commitState(void);
     int revertToLastCommit(void);    
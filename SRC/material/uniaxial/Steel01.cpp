@@ -336,6 +336,32 @@ double Steel01::getTangent ()
    return Ttangent;
 }
 
+int Steel01::getElasticRange (double &strainMin, double &strainMax, double &tangent)
+{
+   // the stress follows Cstress + E0*(strain-Cstrain) until it meets one
+   // of the two bounding lines of determineTrialState(), the shifts of
+   // which only change at the next commit
+   double Esh = b*E0;
+   if (Esh >= E0)
+      return -1;
+
+   double fyOneMinusB = fy * (1.0 - b);
+   double c = E0*Cstrain - Cstress;
+
+   strainMax = (CshiftP*fyOneMinusB + c)/(E0 - Esh);
+   strainMin = (-CshiftN*fyOneMinusB + c)/(E0 - Esh);
+   tangent = E0;
+
+   // the shifts never decrease, so Cstress is inside the bounds up to
+   // round off, as when it was committed on one of them
+   if (strainMax < Cstrain)
+      strainMax = Cstrain;
+   if (strainMin > Cstrain)
+      strainMin = Cstrain;
+
+   return 0;
+}
+
 int Steel01::commitState ()
 {
    // History variables
@@ -63,6 +63,7 @@ class Steel01 : public UniaxialMaterial
     double getStress(void);
     double getTangent(void);
     double getInitialTangent(void) {return E0;};
+    int getElasticRange(double &strainMin, double &strainMax, double &tangent);
 
     int commitState(void);
     int revertToLastCommit(void);    
@@ -143,6 +143,12 @@ UniaxialMaterial::getDampTangent(void)
     return 0.0;
 }
 
+int
+UniaxialMaterial::getElasticRange(double &strainMin, double &strainMax, double &tangent)
+{
+    return -1;
+}
+
 // default operation for secant stiffness
 /*
 double
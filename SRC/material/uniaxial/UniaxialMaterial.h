@@ -67,6 +67,11 @@ class UniaxialMaterial : public Material
     virtual double getInitialTangent (void) = 0;
     virtual double getDampTangent (void);
     virtual double getRho(void);
+
+    // range of strain [strainMin, strainMax] about the last committed state
+    // in which the stress is Cstress + tangent*(strain - Cstrain); returns
+    // -1 if the material cannot give one
+    virtual int getElasticRange(double &strainMin, double &strainMax, double &tangent);
     
     virtual int commitState (void) = 0;
     virtual int revertToLastCommit (void) = 0;    
@@ -34,6 +34,7 @@
 #include "Matrix.h"
 #include "Vector.h"
 #include "ID.h"
+#include "MatrixView.h"
 
 #include <stdlib.h>
 #include <iostream>
@@ -151,6 +152,35 @@ Matrix::Matrix(double *theData, int row, int col)
     // does nothing
 }
 
+// Matrix(const MatrixView &):
+//	Constructor to wrap the storage of a view without copying, as
+//	Matrix(double *, int, int) does; a view whose columns are not
+//	contiguous, such as a transpose or a block of a larger matrix, is
+//	copied into storage owned by the Matrix.
+
+Matrix::Matrix(const MatrixView &V)
+:numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
+{
+  // allocate work areas if the first matrix
+  if (matrixWork == 0) {
+    matrixWork = new (nothrow) double[sizeDoubleWork];
+    intWork = new (nothrow) int[sizeIntWork];
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
+      exit(-1);
+    }
+  }
+
+  if (V.isContiguous()) {
+    numRows = V.noRows();
+    numCols = V.noCols();
+    dataSize = numRows*numCols;
+    data = V.getData();
+    fromFree = 1;
+  } else if (this->resize(V.noRows(), V.noCols()) == 0)
+    MatrixView(*this) = V;
+}
+
 Matrix::Matrix(const Matrix &other)
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
@@ -235,6 +265,17 @@ Matrix::setData(double *theData, int row, int col)
   return 0;
 }
 
+int
+Matrix::setData(const MatrixView &V)
+{
+  if (V.isContiguous() == false) {
+    opserr << "WARNING: Matrix::setData() - view is not contiguous\n";
+    return -1;
+  }
+
+  return this->setData(V.getData(), V.noRows(), V.noCols());
+}
+
 void
 Matrix::Zero(void)
 {
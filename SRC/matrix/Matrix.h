@@ -42,6 +42,8 @@
 class Vector;
 class ID;
 class Message;
+class MatrixView;
+template <class E> class MatrixExpr;
 
 #define MATRIX_VERY_LARGE_VALUE 1.0e213
 
@@ -52,11 +54,13 @@ class Matrix
     Matrix();	
     Matrix(int nrows, int ncols);
     Matrix(double *data, int nrows, int ncols);    
+    explicit Matrix(const MatrixView &V);
     Matrix(const Matrix &M);    
     ~Matrix();
 
     // utility methods
     int setData(double *newData, int nRows, int nCols);
+    int setData(const MatrixView &V);
     inline int noRows() const;
     inline int noCols() const;
     void Zero(void);
@@ -116,6 +120,12 @@ class Matrix
     Matrix &operator+=(const Matrix &M);
     Matrix &operator-=(const Matrix &M);
 
+    // assignment of the lazy expressions of MatrixView.h, which must be
+    // included to use them
+    template <class E> Matrix &operator=(const MatrixExpr<E> &expr);
+    template <class E> Matrix &operator+=(const MatrixExpr<E> &expr);
+    template <class E> Matrix &operator-=(const MatrixExpr<E> &expr);
+
     // methods to read/write to/from the matrix
     void Output(OPS_Stream &s) const;
     //    void Input(istream &s);
@@ -135,12 +145,14 @@ class Matrix
     
     
     friend class Vector;    
+    friend class MatrixView;
     friend class Message;
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;
     friend class MPI_Channel;
+    friend class SharedMemoryChannel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
 
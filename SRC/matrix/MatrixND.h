@@ -0,0 +1,238 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MatrixND_h
+#define MatrixND_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class template MatrixND, a
+// matrix whose dimensions are fixed at compile time. It is intended for
+// the small dense matrices (3x3, 6x6, 12x12, 18x18, 24x24) that appear
+// in element and coordinate transformation code. As the loop bounds are
+// known to the compiler, the kernels below are fully unrolled and
+// vectorized and no use is made of the shared Matrix::matrixWork area.
+//
+// The data is stored column-major in the same layout as Matrix, so
+// that a Matrix can be constructed on top of a MatrixND without copying:
+//     static MatrixND<12,12> kgStore;
+//     static Matrix kg(kgStore.values[0], 12, 12);
+// MatrixND has no constructors, so that static and stack objects are
+// plain aggregates; call zero() where an initial value is needed.
+//
+// What: "@(#) MatrixND.h, revA"
+
+#include <Matrix.h>
+#include <VectorND.h>
+#include <math.h>
+
+template <int nr, int nc>
+class MatrixND
+{
+  public:
+    double values[nc][nr];
+
+    inline int noRows() const {return nr;}
+    inline int noCols() const {return nc;}
+
+    inline double &operator()(int row, int col) {return values[col][row];}
+    inline double operator()(int row, int col) const {return values[col][row];}
+
+    inline void zero(void) {
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++)
+	  values[j][i] = 0.0;
+    }
+
+    // copy to and from the general purpose Matrix
+    inline MatrixND &operator=(const Matrix &M) {
+#ifdef _G3DEBUG
+      if (M.noRows() != nr || M.noCols() != nc) {
+	opserr << "MatrixND::operator=() - incompatable Matrix\n";
+	return *this;
+      }
+#endif
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++)
+	  values[j][i] = M(i,j);
+      return *this;
+    }
+
+    inline void copyTo(Matrix &M) const {
+#ifdef _G3DEBUG
+      if (M.noRows() != nr || M.noCols() != nc) {
+	opserr << "MatrixND::copyTo() - incompatable Matrix\n";
+	return;
+      }
+#endif
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++)
+	  M(i,j) = values[j][i];
+    }
+
+    // this = thisFact*this + otherFact*other
+    inline void addMatrix(double thisFact, const MatrixND<nr,nc> &other, double otherFact) {
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++)
+	  values[j][i] = thisFact*values[j][i] + otherFact*other.values[j][i];
+    }
+
+    // this = thisFact*this + otherFact*A*B
+    template <int nk>
+    inline void addMatrixProduct(double thisFact, const MatrixND<nr,nk> &A,
+				 const MatrixND<nk,nc> &B, double otherFact) {
+      for (int j = 0; j < nc; j++) {
+	double work[nr];
+	for (int i = 0; i < nr; i++)
+	  work[i] = 0.0;
+	for (int k = 0; k < nk; k++) {
+	  double bkj = B.values[j][k];
+	  for (int i = 0; i < nr; i++)
+	    work[i] += A.values[k][i]*bkj;
+	}
+	for (int i = 0; i < nr; i++)
+	  values[j][i] = thisFact*values[j][i] + otherFact*work[i];
+      }
+    }
+
+    // this = thisFact*this + otherFact*A'*B
+    template <int nk>
+    inline void addMatrixTransposeProduct(double thisFact, const MatrixND<nk,nr> &A,
+					  const MatrixND<nk,nc> &B, double otherFact) {
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++) {
+	  double sum = 0.0;
+	  for (int k = 0; k < nk; k++)
+	    sum += A.values[i][k]*B.values[j][k];
+	  values[j][i] = thisFact*values[j][i] + otherFact*sum;
+	}
+    }
+
+    // this = thisFact*this + otherFact*T'*B*T, with this square
+    template <int nk>
+    inline void addMatrixTripleProduct(double thisFact, const MatrixND<nk,nr> &T,
+				       const MatrixND<nk,nk> &B, double otherFact) {
+      // BT = B*T, formed column by column as per dgemm_
+      double BT[nr][nk];
+      for (int j = 0; j < nr; j++) {
+	for (int i = 0; i < nk; i++)
+	  BT[j][i] = 0.0;
+	for (int k = 0; k < nk; k++) {
+	  double tkj = T.values[j][k];
+	  if (tkj != 0.0)
+	    for (int i = 0; i < nk; i++)
+	      BT[j][i] += B.values[k][i]*tkj;
+	}
+      }
+
+      // this = thisFact*this + otherFact*T'*BT
+      for (int j = 0; j < nr; j++)
+	for (int i = 0; i < nr; i++) {
+	  double sum = 0.0;
+	  for (int k = 0; k < nk; k++)
+	    sum += T.values[i][k]*BT[j][k];
+	  values[j][i] = thisFact*values[j][i] + otherFact*sum;
+	}
+    }
+
+    // res = inverse(this) using Gauss-Jordan elimination with partial
+    // pivoting; returns -1 if the matrix is singular
+    inline int invert(MatrixND<nr,nc> &res) const {
+      double a[nc][nr];
+      for (int j = 0; j < nc; j++)
+	for (int i = 0; i < nr; i++) {
+	  a[j][i] = values[j][i];
+	  res.values[j][i] = (i == j) ? 1.0 : 0.0;
+	}
+
+      for (int k = 0; k < nr; k++) {
+	// find the pivot row
+	int p = k;
+	double pmax = fabs(a[k][k]);
+	for (int i = k+1; i < nr; i++)
+	  if (fabs(a[k][i]) > pmax) {
+	    pmax = fabs(a[k][i]);
+	    p = i;
+	  }
+	if (pmax == 0.0)
+	  return -1;
+
+	// swap rows k and p
+	if (p != k)
+	  for (int j = 0; j < nc; j++) {
+	    double tmp = a[j][k]; a[j][k] = a[j][p]; a[j][p] = tmp;
+	    tmp = res.values[j][k]; res.values[j][k] = res.values[j][p]; res.values[j][p] = tmp;
+	  }
+
+	// scale the pivot row
+	double oneOverPivot = 1.0/a[k][k];
+	for (int j = 0; j < nc; j++) {
+	  a[j][k] *= oneOverPivot;
+	  res.values[j][k] *= oneOverPivot;
+	}
+
+	// eliminate column k from the other rows
+	for (int i = 0; i < nr; i++) {
+	  if (i == k)
+	    continue;
+	  double factor = a[k][i];
+	  if (factor == 0.0)
+	    continue;
+	  for (int j = 0; j < nc; j++) {
+	    a[j][i] -= factor*a[j][k];
+	    res.values[j][i] -= factor*res.values[j][k];
+	  }
+	}
+      }
+
+      return 0;
+    }
+
+    // y = thisFact*y + otherFact*this*x, provided on the matrix so that
+    // VectorND need not know of MatrixND
+    inline void multiply(VectorND<nr> &y, double thisFact,
+			 const VectorND<nc> &x, double otherFact) const {
+      double work[nr];
+      for (int i = 0; i < nr; i++)
+	work[i] = 0.0;
+      for (int j = 0; j < nc; j++) {
+	double xj = x.values[j];
+	for (int i = 0; i < nr; i++)
+	  work[i] += values[j][i]*xj;
+      }
+      for (int i = 0; i < nr; i++)
+	y.values[i] = thisFact*y.values[i] + otherFact*work[i];
+    }
+
+    // y = thisFact*y + otherFact*this'*x
+    inline void multiplyTranspose(VectorND<nc> &y, double thisFact,
+				  const VectorND<nr> &x, double otherFact) const {
+      for (int j = 0; j < nc; j++) {
+	double sum = 0.0;
+	for (int i = 0; i < nr; i++)
+	  sum += values[j][i]*x.values[i];
+	y.values[j] = thisFact*y.values[j] + otherFact*sum;
+      }
+    }
+};
+
+#endif
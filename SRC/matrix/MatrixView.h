@@ -0,0 +1,479 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+#ifndef MatrixView_h
+#define MatrixView_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definitions for MatrixView
+// and VectorView, non-owning views onto column-major storage, and the
+// lazy expression templates built on them. A view wraps a Matrix, a
+// Vector, a sub-block of either, or a raw array with arbitrary row and
+// column strides; taking the transpose or a block of a view is free.
+//
+// Products, scalings and sums of views are not evaluated when written,
+// but build a small expression object that is evaluated a column at a
+// time when assigned to a Matrix, Vector or view. The stiffness update
+//     MatrixView B(Bmat), D(Dmat);
+//     K += B^D*B*w;
+// thus forms each column of D*B*w in a stack buffer and accumulates
+// B'*(D*B*w) straight into K, with no heap temporaries. The rules are:
+//   - the left operand of * and ^ must be a view (A^B is A'*B as for
+//     Matrix); scale factors go on the right: B^D*B*w, not w*B^D*B.
+//   - ^ binds more loosely than + and *, so parenthesize it in sums:
+//     f = K*d + (B^s*w).
+//   - the destination of an assignment must not be one of its operands.
+// As the operators taking views are distinct from those of Matrix and
+// Vector, which return by value, existing expressions are unchanged;
+// wrapping the left-most operand in a MatrixView selects the lazy form.
+//
+// What: "@(#) MatrixView.h, revA"
+
+#include <Matrix.h>
+#include <Vector.h>
+
+// columns of up to this length are evaluated without heap allocation
+#define MATRIX_EXPR_STACK_SIZE 128
+
+class VectorView;
+
+// work storage for one column of an expression, or any other small
+// per-call work array, kept on the stack when it is short enough
+class MatrixExprWork
+{
+  public:
+    inline MatrixExprWork(int size)
+      :heapWork(0), work(stackWork) {
+      if (size > MATRIX_EXPR_STACK_SIZE)
+	work = heapWork = new double[size];
+    }
+    inline ~MatrixExprWork() {
+      if (heapWork != 0)
+	delete [] heapWork;
+    }
+    inline operator double *() {return work;}
+
+  private:
+    MatrixExprWork(const MatrixExprWork &);
+    MatrixExprWork &operator=(const MatrixExprWork &);
+
+    double stackWork[MATRIX_EXPR_STACK_SIZE];
+    double *heapWork;
+    double *work;
+};
+
+// base of all expressions; E must provide noRows(), noCols() and
+// evalCol(j, col), which writes column j of the expression into col
+template <class E>
+class MatrixExpr
+{
+  public:
+    inline const E &derived(void) const {return static_cast<const E &>(*this);}
+};
+
+class MatrixView : public MatrixExpr<MatrixView>
+{
+  public:
+    inline MatrixView(double *data, int nRows, int nCols)
+      :theData(data), numRows(nRows), numCols(nCols),
+       rowStride(1), colStride(nRows) {}
+    inline MatrixView(double *data, int nRows, int nCols, int rStride, int cStride)
+      :theData(data), numRows(nRows), numCols(nCols),
+       rowStride(rStride), colStride(cStride) {}
+    inline MatrixView(const MatrixView &other)
+      :MatrixExpr<MatrixView>(), theData(other.theData), numRows(other.numRows),
+       numCols(other.numCols), rowStride(other.rowStride), colStride(other.colStride) {}
+
+    // a view on a const Matrix or Vector must only be read from
+    inline MatrixView(const Matrix &M)
+      :theData(M.data), numRows(M.numRows), numCols(M.numCols),
+       rowStride(1), colStride(M.numRows) {}
+    inline MatrixView(const Vector &V)
+      :theData(V.theData), numRows(V.sz), numCols(1),
+       rowStride(1), colStride(V.sz) {}
+
+    inline int noRows(void) const {return numRows;}
+    inline int noCols(void) const {return numCols;}
+    inline int getRowStride(void) const {return rowStride;}
+    inline int getColStride(void) const {return colStride;}
+    inline double *getData(void) const {return theData;}
+
+    // true if the view can be wrapped by a Matrix without copying
+    inline bool isContiguous(void) const {
+      return rowStride == 1 && (colStride == numRows || numCols < 2);
+    }
+
+    inline double &operator()(int row, int col) const {
+#ifdef _G3DEBUG
+      if (row < 0 || row >= numRows || col < 0 || col >= numCols)
+	opserr << "MatrixView::operator() - (" << row << "," << col << ") out of range\n";
+#endif
+      return theData[row*rowStride + col*colStride];
+    }
+
+    inline MatrixView transpose(void) const {
+      return MatrixView(theData, numCols, numRows, colStride, rowStride);
+    }
+    inline MatrixView block(int row, int col, int nRows, int nCols) const {
+      return MatrixView(theData + row*rowStride + col*colStride,
+			nRows, nCols, rowStride, colStride);
+    }
+    inline VectorView column(int col) const;
+
+    inline void evalCol(int j, double *col) const {
+      const double *src = theData + j*colStride;
+      if (rowStride == 1)
+	for (int i = 0; i < numRows; i++)
+	  col[i] = src[i];
+      else
+	for (int i = 0; i < numRows; i++)
+	  col[i] = src[i*rowStride];
+    }
+
+    // this = thisFact*this + otherFact*expr
+    template <class E>
+    void addExpr(double thisFact, const MatrixExpr<E> &expr, double otherFact);
+
+    // assignment writes through to the viewed storage
+    inline MatrixView &operator=(const MatrixView &other) {
+      this->addExpr(0.0, other, 1.0);
+      return *this;
+    }
+    template <class E> inline MatrixView &operator=(const MatrixExpr<E> &expr) {
+      this->addExpr(0.0, expr, 1.0);
+      return *this;
+    }
+    template <class E> inline MatrixView &operator+=(const MatrixExpr<E> &expr) {
+      this->addExpr(1.0, expr, 1.0);
+      return *this;
+    }
+    template <class E> inline MatrixView &operator-=(const MatrixExpr<E> &expr) {
+      this->addExpr(1.0, expr, -1.0);
+      return *this;
+    }
+
+  protected:
+    double *theData;
+    int numRows;
+    int numCols;
+    int rowStride;
+    int colStride;
+};
+
+class VectorView : public MatrixView
+{
+  public:
+    inline VectorView(double *data, int size, int stride = 1)
+      :MatrixView(data, size, 1, stride, size*stride) {}
+    inline VectorView(const Vector &V)
+      :MatrixView(V) {}
+
+    inline int Size(void) const {return numRows;}
+    inline double &operator()(int i) const {
+#ifdef _G3DEBUG
+      if (i < 0 || i >= numRows)
+	opserr << "VectorView::operator() - " << i << " out of range\n";
+#endif
+      return theData[i*rowStride];
+    }
+
+    inline VectorView segment(int start, int size) const {
+      return VectorView(theData + start*rowStride, size, rowStride);
+    }
+
+    using MatrixView::operator=;
+    inline VectorView &operator=(const VectorView &other) {
+      this->addExpr(0.0, other, 1.0);
+      return *this;
+    }
+};
+
+inline VectorView
+MatrixView::column(int col) const
+{
+  return VectorView(theData + col*colStride, numRows, rowStride);
+}
+
+// A*R, with A a view and R any expression: column j of R is evaluated
+// into a stack buffer and then multiplied by A
+template <class R>
+class MatrixProduct : public MatrixExpr<MatrixProduct<R> >
+{
+  public:
+    inline MatrixProduct(const MatrixView &a, const R &r)
+      :left(a), right(r) {
+#ifdef _G3DEBUG
+      if (a.noCols() != r.noRows())
+	opserr << "MatrixProduct - incompatable sizes " << a.noCols() << " " << r.noRows() << endln;
+#endif
+    }
+
+    inline int noRows(void) const {return left.noRows();}
+    inline int noCols(void) const {return right.noCols();}
+
+    inline void evalCol(int j, double *col) const {
+      int nr = left.noRows();
+      int nk = left.noCols();
+      int rs = left.getRowStride();
+      int cs = left.getColStride();
+      const double *a = left.getData();
+
+      MatrixExprWork work(nk);
+      double *x = work;
+      right.evalCol(j, x);
+
+      if (rs == 1) {
+	// columns of A are contiguous: col = sum_k A(:,k)*x(k)
+	for (int i = 0; i < nr; i++)
+	  col[i] = 0.0;
+	for (int k = 0; k < nk; k++) {
+	  double xk = x[k];
+	  if (xk != 0.0) {
+	    const double *ak = a + k*cs;
+	    for (int i = 0; i < nr; i++)
+	      col[i] += ak[i]*xk;
+	  }
+	}
+      } else {
+	// rows of A are contiguous (a transposed view): col(i) = A(i,:).x
+	for (int i = 0; i < nr; i++) {
+	  const double *ai = a + i*rs;
+	  double sum = 0.0;
+	  if (cs == 1)
+	    for (int k = 0; k < nk; k++)
+	      sum += ai[k]*x[k];
+	  else
+	    for (int k = 0; k < nk; k++)
+	      sum += ai[k*cs]*x[k];
+	  col[i] = sum;
+	}
+      }
+    }
+
+  private:
+    MatrixView left;
+    R right;
+};
+
+// fact*E
+template <class E>
+class MatrixScaled : public MatrixExpr<MatrixScaled<E> >
+{
+  public:
+    inline MatrixScaled(const E &e, double f)
+      :expr(e), fact(f) {}
+
+    inline int noRows(void) const {return expr.noRows();}
+    inline int noCols(void) const {return expr.noCols();}
+
+    inline void evalCol(int j, double *col) const {
+      expr.evalCol(j, col);
+      int nr = expr.noRows();
+      for (int i = 0; i < nr; i++)
+	col[i] *= fact;
+    }
+
+  private:
+    E expr;
+    double fact;
+};
+
+// A + fact*B
+template <class A, class B>
+class MatrixSum : public MatrixExpr<MatrixSum<A,B> >
+{
+  public:
+    inline MatrixSum(const A &a, const B &b, double f)
+      :first(a), second(b), fact(f) {
+#ifdef _G3DEBUG
+      if (a.noRows() != b.noRows() || a.noCols() != b.noCols())
+	opserr << "MatrixSum - incompatable sizes\n";
+#endif
+    }
+
+    inline int noRows(void) const {return first.noRows();}
+    inline int noCols(void) const {return first.noCols();}
+
+    inline void evalCol(int j, double *col) const {
+      int nr = first.noRows();
+      first.evalCol(j, col);
+      MatrixExprWork work(nr);
+      double *x = work;
+      second.evalCol(j, x);
+      for (int i = 0; i < nr; i++)
+	col[i] += fact*x[i];
+    }
+
+  private:
+    A first;
+    B second;
+    double fact;
+};
+
+template <class E>
+void
+MatrixView::addExpr(double thisFact, const MatrixExpr<E> &expr, double otherFact)
+{
+  const E &e = expr.derived();
+#ifdef _G3DEBUG
+  if (e.noRows() != numRows || e.noCols() != numCols) {
+    opserr << "MatrixView::addExpr() - incompatable sizes\n";
+    return;
+  }
+#endif
+  MatrixExprWork work(numRows);
+  double *x = work;
+  for (int j = 0; j < numCols; j++) {
+    e.evalCol(j, x);
+    double *dst = theData + j*colStride;
+    if (thisFact == 0.0)
+      for (int i = 0; i < numRows; i++)
+	dst[i*rowStride] = otherFact*x[i];
+    else
+      for (int i = 0; i < numRows; i++)
+	dst[i*rowStride] = thisFact*dst[i*rowStride] + otherFact*x[i];
+  }
+}
+
+// products: the left operand is a view, A^B is A'*B
+inline MatrixProduct<MatrixView>
+operator*(const MatrixView &A, const MatrixView &B)
+{
+  return MatrixProduct<MatrixView>(A, B);
+}
+
+template <class R>
+inline MatrixProduct<R>
+operator*(const MatrixView &A, const MatrixExpr<R> &B)
+{
+  return MatrixProduct<R>(A, B.derived());
+}
+
+inline MatrixProduct<MatrixView>
+operator^(const MatrixView &A, const MatrixView &B)
+{
+  return MatrixProduct<MatrixView>(A.transpose(), B);
+}
+
+template <class R>
+inline MatrixProduct<R>
+operator^(const MatrixView &A, const MatrixExpr<R> &B)
+{
+  return MatrixProduct<R>(A.transpose(), B.derived());
+}
+
+// scaling
+template <class E>
+inline MatrixScaled<E>
+operator*(const MatrixExpr<E> &A, double fact)
+{
+  return MatrixScaled<E>(A.derived(), fact);
+}
+
+template <class E>
+inline MatrixScaled<E>
+operator*(double fact, const MatrixExpr<E> &A)
+{
+  return MatrixScaled<E>(A.derived(), fact);
+}
+
+// sums
+template <class A, class B>
+inline MatrixSum<A,B>
+operator+(const MatrixExpr<A> &a, const MatrixExpr<B> &b)
+{
+  return MatrixSum<A,B>(a.derived(), b.derived(), 1.0);
+}
+
+template <class A, class B>
+inline MatrixSum<A,B>
+operator-(const MatrixExpr<A> &a, const MatrixExpr<B> &b)
+{
+  return MatrixSum<A,B>(a.derived(), b.derived(), -1.0);
+}
+
+// assignment of expressions to Matrix and Vector, declared in their
+// class definitions; the Matrix or Vector is resized if it owns its data
+template <class E>
+inline Matrix &
+Matrix::operator=(const MatrixExpr<E> &expr)
+{
+  const E &e = expr.derived();
+  if (e.noRows() != numRows || e.noCols() != numCols) {
+    if (fromFree != 0 || this->resize(e.noRows(), e.noCols()) < 0) {
+      opserr << "Matrix::operator=() - expression of incompatable size\n";
+      return *this;
+    }
+  }
+  MatrixView(*this).addExpr(0.0, expr, 1.0);
+  return *this;
+}
+
+template <class E>
+inline Matrix &
+Matrix::operator+=(const MatrixExpr<E> &expr)
+{
+  MatrixView(*this).addExpr(1.0, expr, 1.0);
+  return *this;
+}
+
+template <class E>
+inline Matrix &
+Matrix::operator-=(const MatrixExpr<E> &expr)
+{
+  MatrixView(*this).addExpr(1.0, expr, -1.0);
+  return *this;
+}
+
+template <class E>
+inline Vector &
+Vector::operator=(const MatrixExpr<E> &expr)
+{
+  const E &e = expr.derived();
+  if (e.noRows() != sz || e.noCols() != 1) {
+    if (e.noCols() != 1 || fromFree != 0 || this->resize(e.noRows()) < 0) {
+      opserr << "Vector::operator=() - expression of incompatable size\n";
+      return *this;
+    }
+  }
+  MatrixView(*this).addExpr(0.0, expr, 1.0);
+  return *this;
+}
+
+template <class E>
+inline Vector &
+Vector::operator+=(const MatrixExpr<E> &expr)
+{
+  MatrixView(*this).addExpr(1.0, expr, 1.0);
+  return *this;
+}
+
+template <class E>
+inline Vector &
+Vector::operator-=(const MatrixExpr<E> &expr)
+{
+  MatrixView(*this).addExpr(1.0, expr, -1.0);
+  return *this;
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include "Vector.h"
 #include "Matrix.h"
 #include "ID.h"
+#include "MatrixView.h"
 #include <iostream>
 using std::nothrow;
 
@@ -90,6 +91,28 @@ Vector::Vector(double *data, int size)
  
 
 
+// Vector(const MatrixView &):
+//	Constructor to wrap the storage of a single column view without
+//	copying; a view with a stride is copied into storage owned by
+//	the Vector.
+
+Vector::Vector(const MatrixView &V)
+: sz(0),theData(0),fromFree(0)
+{
+  if (V.noCols() != 1) {
+    opserr << "Vector::Vector(const MatrixView &) - view has " << V.noCols() << " columns\n";
+    return;
+  }
+
+  if (V.isContiguous()) {
+    sz = V.noRows();
+    theData = V.getData();
+    fromFree = 1;
+  } else if (this->resize(V.noRows()) == 0)
+    MatrixView(*this) = V;
+}
+
+
 // Vector(const Vector&):
 //	Constructor to init a vector from another.
 
@@ -137,6 +160,18 @@ Vector::setData(double *newData, int size){
 
 
 
+int 
+Vector::setData(const MatrixView &V)
+{
+  if (V.noCols() != 1 || V.isContiguous() == false) {
+    opserr << "Vector::setData() - view is not a contiguous column\n";
+    return -1;
+  }
+
+  return this->setData(V.getData(), V.noRows());
+}
+
+
 int 
 Vector::resize(int newSize){
 
@@ -36,6 +36,8 @@
 #define VECTOR_VERY_LARGE_VALUE 1.0e200
 
 class Matrix; 
+class MatrixView;
+template <class E> class MatrixExpr;
 class Message;
 class SystemOfEqn;
 class ID;
@@ -48,10 +50,12 @@ class Vector
     Vector(int);
     Vector(const Vector &);    
     Vector(double *data, int size);
+    explicit Vector(const MatrixView &V);
     ~Vector();
 
     // utility methods
     int setData(double *newData, int size);
+    int setData(const MatrixView &V);
     int Assemble(const Vector &V, const ID &l, double fact = 1.0);
     double Norm(void) const;
     double pNorm(int p) const;
@@ -85,6 +89,12 @@ class Vector
     
     Vector &operator+=(const Vector &V);
     Vector &operator-=(const Vector &V);
+
+    // assignment of the lazy expressions of MatrixView.h, which must be
+    // included to use them
+    template <class E> Vector &operator=(const MatrixExpr<E> &expr);
+    template <class E> Vector &operator+=(const MatrixExpr<E> &expr);
+    template <class E> Vector &operator-=(const MatrixExpr<E> &expr);
     
     Vector operator+(const Vector &V) const;
     Vector operator-(const Vector &V) const;
@@ -110,11 +120,13 @@ class Vector
     friend class Message;
     friend class SystemOfEqn;
     friend class Matrix;
+    friend class MatrixView;
     friend class UDP_Socket;
     friend class TCP_Socket;
     friend class TCP_SocketSSL;
     friend class TCP_SocketNoDelay;    
     friend class MPI_Channel;
+    friend class SharedMemoryChannel;
     friend class MySqlDatastore;
     friend class BerkeleyDbDatastore;
     
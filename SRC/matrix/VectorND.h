@@ -0,0 +1,88 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef VectorND_h
+#define VectorND_h
+
+// Written: agent
+// Created: 10/26
+//
+// Description: This file contains the class template VectorND, a
+// vector whose size is fixed at compile time. It is the companion of
+// MatrixND; a Vector can be constructed on top of its storage with
+//     static VectorND<12> pgStore;
+//     static Vector pg(pgStore.values, 12);
+
+#include <Vector.h>
+
+template <int n>
+class VectorND
+{
+  public:
+    double values[n];
+
+    inline int Size(void) const {return n;}
+
+    inline double &operator()(int i) {return values[i];}
+    inline double operator()(int i) const {return values[i];}
+
+    inline void zero(void) {
+      for (int i = 0; i < n; i++)
+	values[i] = 0.0;
+    }
+
+    inline VectorND &operator=(const Vector &V) {
+#ifdef _G3DEBUG
+      if (V.Size() != n) {
+	opserr << "VectorND::operator=() - incompatable Vector\n";
+	return *this;
+      }
+#endif
+      for (int i = 0; i < n; i++)
+	values[i] = V(i);
+      return *this;
+    }
+
+    inline void copyTo(Vector &V) const {
+#ifdef _G3DEBUG
+      if (V.Size() != n) {
+	opserr << "VectorND::copyTo() - incompatable Vector\n";
+	return;
+      }
+#endif
+      for (int i = 0; i < n; i++)
+	V(i) = values[i];
+    }
+
+    // this = thisFact*this + otherFact*other
+    inline void addVector(double thisFact, const VectorND<n> &other, double otherFact) {
+      for (int i = 0; i < n; i++)
+	values[i] = thisFact*values[i] + otherFact*other.values[i];
+    }
+
+    inline double dot(const VectorND<n> &other) const {
+      double sum = 0.0;
+      for (int i = 0; i < n; i++)
+	sum += values[i]*other.values[i];
+      return sum;
+    }
+};
+
+#endif
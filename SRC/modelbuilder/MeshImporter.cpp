@@ -0,0 +1,395 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of MeshImporter.
+//
+// What: "@(#) MeshImporter.cpp, revA"
+
+#include <MeshImporter.h>
+#include <Domain.h>
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <OPS_Globals.h>
+#include <elementAPI.h>
+
+#include <UniaxialMaterial.h>
+#include <NDMaterial.h>
+#include <Truss.h>
+#include <FourNodeQuad.h>
+#include <Tri31.h>
+#include <SSPquad.h>
+#include <Brick.h>
+#include <SSPbrick.h>
+
+MeshImporter::MeshImporter(Domain &domain, int nDM, int nDF)
+  :theDomain(&domain), ndm(nDM), ndf(nDF), theFile(0),
+   numNodes(0), numElements(0), numSPs(0)
+{
+
+}
+
+MeshImporter::~MeshImporter()
+{
+  if (theFile != 0)
+    fclose(theFile);
+}
+
+int
+MeshImporter::importMesh(const char *fileName)
+{
+  numNodes = 0;
+  numElements = 0;
+  numSPs = 0;
+
+  theFile = fopen(fileName, "rb");
+  if (theFile == 0) {
+    opserr << "MeshImporter::importMesh() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  int header[4];
+  if (this->readInts(header, 4) < 0) {
+    opserr << "MeshImporter::importMesh() - could not read header of " << fileName << endln;
+    fclose(theFile); theFile = 0;
+    return -1;
+  }
+
+  if (header[0] != MESH_IMPORT_MAGIC) {
+    opserr << "MeshImporter::importMesh() - " << fileName;
+    opserr << " is not a mesh file or was written with a different byte order\n";
+    fclose(theFile); theFile = 0;
+    return -1;
+  }
+
+  if (header[1] != 1) {
+    opserr << "MeshImporter::importMesh() - unknown version " << header[1] << endln;
+    fclose(theFile); theFile = 0;
+    return -1;
+  }
+
+  if (header[2] != ndm || header[3] != ndf) {
+    opserr << "MeshImporter::importMesh() - mesh has ndm " << header[2] << " ndf " << header[3];
+    opserr << ", model has ndm " << ndm << " ndf " << ndf << endln;
+    fclose(theFile); theFile = 0;
+    return -1;
+  }
+
+  int res = this->readNodes();
+  if (res == 0)
+    res = this->readFixities();
+
+  int numBlocks = 0;
+  if (res == 0 && this->readInts(&numBlocks, 1) < 0)
+    res = -1;
+
+  for (int i=0; i<numBlocks && res == 0; i++) {
+    int blockData[5];
+    if (this->readInts(blockData, 5) < 0) {
+      opserr << "MeshImporter::importMesh() - could not read element block " << i+1 << endln;
+      res = -1;
+    } else
+      res = this->readElements(blockData[0], blockData[1], blockData[2],
+			       blockData[3], blockData[4]);
+  }
+
+  fclose(theFile);
+  theFile = 0;
+
+  return res;
+}
+
+int
+MeshImporter::readNodes(void)
+{
+  int num = 0;
+  if (this->readInts(&num, 1) < 0 || num < 0) {
+    opserr << "MeshImporter::readNodes() - could not read number of nodes\n";
+    return -1;
+  }
+
+  if (num == 0)
+    return 0;
+
+  int *tags = new int[num];
+  double *crds = new double[num*ndm];
+
+  if (this->readInts(tags, num) < 0 || this->readDoubles(crds, num*ndm) < 0) {
+    opserr << "MeshImporter::readNodes() - could not read " << num << " nodes\n";
+    delete [] tags;
+    delete [] crds;
+    return -1;
+  }
+
+  theDomain->reserveComponents(num, 0, 0);
+
+  int res = 0;
+  for (int i=0; i<num; i++) {
+    double *crd = &crds[i*ndm];
+    Node *theNode = 0;
+    if (ndm == 1)
+      theNode = new Node(tags[i], ndf, crd[0]);
+    else if (ndm == 2)
+      theNode = new Node(tags[i], ndf, crd[0], crd[1]);
+    else
+      theNode = new Node(tags[i], ndf, crd[0], crd[1], crd[2]);
+
+    if (theDomain->addNode(theNode) == false) {
+      opserr << "MeshImporter::readNodes() - failed to add node " << tags[i] << endln;
+      delete theNode;
+      res = -1;
+      break;
+    }
+    numNodes++;
+  }
+
+  delete [] tags;
+  delete [] crds;
+
+  return res;
+}
+
+int
+MeshImporter::readFixities(void)
+{
+  int num = 0;
+  if (this->readInts(&num, 1) < 0 || num < 0) {
+    opserr << "MeshImporter::readFixities() - could not read number of fixities\n";
+    return -1;
+  }
+
+  if (num == 0)
+    return 0;
+
+  int *tags = new int[num];
+  int *fixities = new int[num*ndf];
+
+  if (this->readInts(tags, num) < 0 || this->readInts(fixities, num*ndf) < 0) {
+    opserr << "MeshImporter::readFixities() - could not read " << num << " fixities\n";
+    delete [] tags;
+    delete [] fixities;
+    return -1;
+  }
+
+  int numFixed = 0;
+  for (int i=0; i<num*ndf; i++)
+    if (fixities[i] != 0)
+      numFixed++;
+
+  // the constraints are added together, so that each one is not checked
+  // against all those already in the domain
+  SP_Constraint **theSPs = new SP_Constraint *[numFixed];
+  int count = 0;
+  for (int i=0; i<num; i++)
+    for (int j=0; j<ndf; j++)
+      if (fixities[i*ndf+j] != 0)
+	theSPs[count++] = new SP_Constraint(tags[i], j, 0.0, true);
+
+  theDomain->reserveComponents(0, 0, numFixed);
+  numSPs = theDomain->addSP_Constraints(theSPs, numFixed);
+
+  // those not added are left in the array
+  for (int i=0; i<numFixed; i++)
+    if (theSPs[i] != 0)
+      delete theSPs[i];
+
+  delete [] theSPs;
+  delete [] tags;
+  delete [] fixities;
+
+  if (numSPs != numFixed) {
+    opserr << "MeshImporter::readFixities() - only " << numSPs << " of ";
+    opserr << numFixed << " fixities could be added\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+MeshImporter::readElements(int eleType, int num, int numNodesPerEle,
+			   int numParams, int option)
+{
+  int numNodesExpected = 0;
+  switch (eleType) {
+  case MESH_IMPORT_TRUSS:
+    numNodesExpected = 2; break;
+  case MESH_IMPORT_TRI31:
+    numNodesExpected = 3; break;
+  case MESH_IMPORT_QUAD:
+  case MESH_IMPORT_SSPQUAD:
+    numNodesExpected = 4; break;
+  case MESH_IMPORT_BRICK:
+  case MESH_IMPORT_SSPBRICK:
+    numNodesExpected = 8; break;
+  default:
+    opserr << "MeshImporter::readElements() - unknown element type " << eleType << endln;
+    return -1;
+  }
+
+  if (numNodesPerEle != numNodesExpected || num < 0 || numParams < 0) {
+    opserr << "MeshImporter::readElements() - invalid block of element type " << eleType;
+    opserr << ", " << num << " elements with " << numNodesPerEle << " nodes\n";
+    return -1;
+  }
+
+  if (num == 0)
+    return 0;
+
+  int *tags = new int[num];
+  int *matTags = new int[num];
+  int *conn = new int[num*numNodesPerEle];
+  double *params = 0;
+  if (numParams > 0)
+    params = new double[num*numParams];
+
+  int res = 0;
+  if (this->readInts(tags, num) < 0 || this->readInts(matTags, num) < 0 ||
+      this->readInts(conn, num*numNodesPerEle) < 0 ||
+      (numParams > 0 && this->readDoubles(params, num*numParams) < 0)) {
+    opserr << "MeshImporter::readElements() - could not read " << num;
+    opserr << " elements of type " << eleType << endln;
+    res = -1;
+  }
+
+  if (res == 0)
+    theDomain->reserveComponents(0, num, 0);
+
+  for (int i=0; i<num && res == 0; i++) {
+    Element *theEle = this->createElement(eleType, tags[i], matTags[i],
+					  &conn[i*numNodesPerEle],
+					  (params != 0) ? &params[i*numParams] : 0,
+					  numParams, option);
+    if (theEle == 0) {
+      res = -1;
+      break;
+    }
+
+    if (theDomain->addElement(theEle) == false) {
+      opserr << "MeshImporter::readElements() - failed to add element " << tags[i] << endln;
+      delete theEle;
+      res = -1;
+      break;
+    }
+    numElements++;
+  }
+
+  delete [] tags;
+  delete [] matTags;
+  delete [] conn;
+  if (params != 0)
+    delete [] params;
+
+  return res;
+}
+
+Element *
+MeshImporter::createElement(int eleType, int tag, int matTag, const int *nodes,
+			    const double *params, int numParams, int option)
+{
+  // values of the optional parameters not given are 0
+  double p[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  for (int i=0; i<numParams && i<5; i++)
+    p[i] = params[i];
+
+  const char *type = (option == 1) ? "PlaneStress" : "PlaneStrain";
+
+  if (eleType == MESH_IMPORT_TRUSS) {
+    UniaxialMaterial *theMaterial = OPS_GetUniaxialMaterial(matTag);
+    if (theMaterial == 0) {
+      opserr << "MeshImporter::createElement() - no uniaxial material " << matTag;
+      opserr << " for element " << tag << endln;
+      return 0;
+    }
+    return new Truss(tag, ndm, nodes[0], nodes[1], *theMaterial, p[0], p[1]);
+  }
+
+  NDMaterial *theMaterial = OPS_GetNDMaterial(matTag);
+  if (theMaterial == 0) {
+    opserr << "MeshImporter::createElement() - no nD material " << matTag;
+    opserr << " for element " << tag << endln;
+    return 0;
+  }
+
+  switch (eleType) {
+  case MESH_IMPORT_QUAD:
+    return new FourNodeQuad(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+			    *theMaterial, type, p[0], p[1], p[2], p[3], p[4]);
+  case MESH_IMPORT_TRI31:
+    return new Tri31(tag, nodes[0], nodes[1], nodes[2],
+		     *theMaterial, type, p[0], p[1], p[2], p[3], p[4]);
+  case MESH_IMPORT_SSPQUAD:
+    return new SSPquad(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+		       *theMaterial, type, p[0], p[1], p[2]);
+  case MESH_IMPORT_BRICK:
+    return new Brick(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+		     nodes[4], nodes[5], nodes[6], nodes[7],
+		     *theMaterial, p[0], p[1], p[2]);
+  case MESH_IMPORT_SSPBRICK:
+    return new SSPbrick(tag, nodes[0], nodes[1], nodes[2], nodes[3],
+			nodes[4], nodes[5], nodes[6], nodes[7],
+			*theMaterial, p[0], p[1], p[2]);
+  default:
+    break;
+  }
+
+  return 0;
+}
+
+int
+MeshImporter::readInts(int *data, int num)
+{
+  if (num <= 0)
+    return 0;
+  if (fread(data, sizeof(int), num, theFile) != (size_t)num)
+    return -1;
+  return 0;
+}
+
+int
+MeshImporter::readDoubles(double *data, int num)
+{
+  if (num <= 0)
+    return 0;
+  if (fread(data, sizeof(double), num, theFile) != (size_t)num)
+    return -1;
+  return 0;
+}
+
+int
+MeshImporter::getNumNodes(void) const
+{
+  return numNodes;
+}
+
+int
+MeshImporter::getNumElements(void) const
+{
+  return numElements;
+}
+
+int
+MeshImporter::getNumSP_Constraints(void) const
+{
+  return numSPs;
+}
@@ -0,0 +1,110 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef MeshImporter_h
+#define MeshImporter_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for MeshImporter.
+// A MeshImporter adds the nodes, fixities and elements held in a binary
+// mesh file to a Domain. No interpreter is involved, so a large mesh is
+// created without parsing millions of commands. The materials the
+// elements refer to must already exist. The file is written in the byte
+// order of the machine reading it, all integers being 32 bit:
+//
+//   int    magic (MESH_IMPORT_MAGIC), version (1), ndm, ndf
+//   int    numNodes
+//   int    nodeTags[numNodes]
+//   double crds[numNodes*ndm]
+//   int    numFix
+//   int    fixNodeTags[numFix]
+//   int    fixities[numFix*ndf]          (0 free, otherwise fixed)
+//   int    numBlocks
+//   for each block of elements of one type:
+//     int    eleType, numEle, numNodesPerEle, numParams, option
+//     int    eleTags[numEle]
+//     int    matTags[numEle]
+//     int    connectivity[numEle*numNodesPerEle]
+//     double params[numEle*numParams]
+//
+// The element types and their parameters, those in [] being optional:
+//   1 Truss        2 nodes  uniaxial material  A [rho]
+//   2 FourNodeQuad 4 nodes  nD material        t [p rho b1 b2]
+//   3 Tri31        3 nodes  nD material        t [p rho b1 b2]
+//   4 SSPquad      4 nodes  nD material        t [b1 b2]
+//   5 Brick        8 nodes  nD material        [b1 b2 b3]
+//   6 SSPbrick     8 nodes  nD material        [b1 b2 b3]
+// For the planar elements option is 0 for PlaneStrain, 1 for PlaneStress.
+//
+// What: "@(#) MeshImporter.h, revA"
+
+#include <stdio.h>
+
+#define MESH_IMPORT_MAGIC 0x4d53504f   // "OPSM"
+
+#define MESH_IMPORT_TRUSS    1
+#define MESH_IMPORT_QUAD     2
+#define MESH_IMPORT_TRI31    3
+#define MESH_IMPORT_SSPQUAD  4
+#define MESH_IMPORT_BRICK    5
+#define MESH_IMPORT_SSPBRICK 6
+
+class Domain;
+class Element;
+
+class MeshImporter
+{
+  public:
+    MeshImporter(Domain &theDomain, int ndm, int ndf);
+    ~MeshImporter();
+
+    int importMesh(const char *fileName);
+
+    int getNumNodes(void) const;
+    int getNumElements(void) const;
+    int getNumSP_Constraints(void) const;
+
+  protected:
+
+  private:
+    int readNodes(void);
+    int readFixities(void);
+    int readElements(int eleType, int numEle, int numNodesPerEle,
+		     int numParams, int option);
+    Element *createElement(int eleType, int tag, int matTag, const int *nodes,
+			   const double *params, int numParams, int option);
+
+    int readInts(int *data, int num);
+    int readDoubles(double *data, int num);
+
+    Domain *theDomain;
+    int ndm;
+    int ndf;
+    FILE *theFile;
+
+    int numNodes;         // components added by the last importMesh()
+    int numElements;
+    int numSPs;
+};
+
+#endif
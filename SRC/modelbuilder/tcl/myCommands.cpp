@@ -35,6 +35,7 @@
 #include "TclModelBuilder.h"
 #include "TclUniaxialMaterialTester.h"
 #include "TclSectionTester.h"
+#include <MeshImporter.h>
 
 #include <tcl.h>
 
@@ -80,6 +81,34 @@ specifyModelBuilder(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Cha
     opserr << "\tBasicBuilder\n";
     return TCL_ERROR;
   }    
+
+  // model import fileName? - adds the contents of a binary mesh file
+  // to the model defined by the current builder
+  if (strcmp(argv[1],"import") == 0) {
+    if (argc < 3) {
+      opserr << "WARNING want - model import fileName?\n";
+      return TCL_ERROR;
+    }
+
+    TclModelBuilder *theTclBuilder = dynamic_cast<TclModelBuilder *>(theBuilder);
+    if (theTclBuilder == 0) {
+      opserr << "WARNING model import - a basic model must be defined first\n";
+      return TCL_ERROR;
+    }
+
+    MeshImporter theImporter(theDomain, theTclBuilder->getNDM(), theTclBuilder->getNDF());
+    if (theImporter.importMesh(argv[2]) < 0) {
+      opserr << "WARNING model import - failed to import " << argv[2] << endln;
+      return TCL_ERROR;
+    }
+
+    char buffer[80];
+    sprintf(buffer, "%d %d %d", theImporter.getNumNodes(), theImporter.getNumElements(),
+	    theImporter.getNumSP_Constraints());
+    Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+    return TCL_OK;
+  }
   
   // invoke the descructor on the old builder
   if (theBuilder != 0) {
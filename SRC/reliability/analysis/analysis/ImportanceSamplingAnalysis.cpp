@@ -213,6 +213,13 @@ ImportanceSamplingAnalysis::analyze(void)
 	ofstream resultsOutputFile( fileName, ios::out );
 
 
+	// the random numbers are generated a batch of samples at a time, sample k
+	// being column k-1-batchStart; counter-based generators give the same
+	// numbers to sample k on a restart
+	const int batchSize = 64;
+	Matrix randomBatch(numRV, batchSize);
+	long int batchStart = -1;
+
 	bool isFirstSimulation = true;
 	while( ( k <= numberOfSimulations && govCov > targetCOV || k <= 2 ) ) {
 
@@ -224,19 +231,20 @@ ImportanceSamplingAnalysis::analyze(void)
 
 		
 		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
-		}
-		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
-		}
-		seed = theRandomNumberGenerator->getSeed();
-		if (result < 0) {
-			opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
-				<< " random numbers for simulation." << endln;
-			return -1;
+		if (isFirstSimulation || k-1 >= batchStart+batchSize) {
+			if (isFirstSimulation)
+				theRandomNumberGenerator->setSeed(seed);
+			batchStart = k-1;
+			result = theRandomNumberGenerator->generate_nSamplesStdNormalNumbers(batchSize, numRV, randomBatch, batchStart);
+			seed = theRandomNumberGenerator->getSeed();
+			if (result < 0) {
+				opserr << "ImportanceSamplingAnalysis::analyze() - could not generate" << endln
+					<< " random numbers for simulation." << endln;
+				return -1;
+			}
 		}
-		randomArray = theRandomNumberGenerator->getGeneratedNumbers();
+		for (int j = 0; j < numRV; j++)
+			randomArray(j) = randomBatch(j, (int)(k-1-batchStart));
 
 		// Compute the point in standard normal space
 		//u = startPointY + chol_covariance * randomArray;
@@ -37,7 +37,16 @@
 #include <GradientEvaluator.h>
 #include <ReliabilityDomain.h>
 #include <LimitStateFunction.h>
+#include <Parameter.h>
 #include <string.h>
+#include <math.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#endif
 
 
 FiniteDifferenceGradient::FiniteDifferenceGradient(FunctionEvaluator *passedGFunEvaluator,
@@ -45,7 +54,7 @@ FiniteDifferenceGradient::FiniteDifferenceGradient(FunctionEvaluator *passedGFun
 						   Domain *passedOpenSeesDomain)
 
 :GradientEvaluator(passedReliabilityDomain, passedGFunEvaluator), 
-theOpenSeesDomain(passedOpenSeesDomain)
+theOpenSeesDomain(passedOpenSeesDomain), numProcesses(1), central(false), noise(0.0)
 {
 	
 	int nparam = theOpenSeesDomain->getNumParameters();
@@ -69,6 +78,32 @@ FiniteDifferenceGradient::getGradient()
 }
 
 
+void
+FiniteDifferenceGradient::setNumProcesses(int num)
+{
+	numProcesses = (num > 1) ? num : 1;
+#ifdef _WIN32
+	if (numProcesses > 1)
+		opserr << "WARNING FiniteDifferenceGradient - no fork() on this platform, the perturbations run in sequence" << endln;
+	numProcesses = 1;
+#endif
+}
+
+
+void
+FiniteDifferenceGradient::setCentralDifferences(bool flag)
+{
+	central = flag;
+}
+
+
+void
+FiniteDifferenceGradient::setAutomaticStep(double relativeNoise)
+{
+	noise = (relativeNoise > 0.0) ? relativeNoise : 0.0;
+}
+
+
 int
 FiniteDifferenceGradient::computeGradient(double g)
 {
@@ -87,6 +122,10 @@ FiniteDifferenceGradient::computeGradient(double g)
 	// get parameters created in the domain
 	int nparam = theOpenSeesDomain->getNumParameters();
 
+	// the parameters that need an analysis, and their steps
+	ID perturbed(0, nparam);
+	int numPerturbed = 0;
+	Vector h(nparam);
     
 	// now loop through to create gradient vector
 	// note this is a for loop because there may be some conflict from a nested iterator already 
@@ -115,41 +154,225 @@ FiniteDifferenceGradient::computeGradient(double g)
 		
 		// if no analytic gradient automatically do finite differences
 		else {
-			// use parameter defined perturbation
-			double h = theParam->getPerturbation();
-            double original = theParam->getValue();
-            theParam->update(original+h);
-
-			// set perturbed values in the variable namespace
-			if (theFunctionEvaluator->setVariables() < 0) {
-				opserr << "ERROR FiniteDifferenceGradient -- error setting variables in namespace" << endln;
-				return -1;
+			// unless the evaluator can differentiate an expression of explicit
+			// parameters itself, without another analysis
+			theFunctionEvaluator->setExpression(lsfExpression);
+			if (theFunctionEvaluator->evaluateGradient(tag, result) == 0) {
+				(*grad_g)(i) = result;
+				continue;
 			}
-			
-			// run analysis
-			if (theFunctionEvaluator->runAnalysis() < 0) {
-				opserr << "ERROR FiniteDifferenceGradient -- error running analysis" << endln;
-				return -1;
+
+			// use parameter defined perturbation, or one scaled to the value
+			double step = theParam->getPerturbation();
+			if (noise > 0.0) {
+				double x = fabs(theParam->getValue());
+				if (x > 0.0)
+					step = pow(noise, central ? 1.0/3.0 : 0.5)*x;
 			}
-			
-            // evaluate LSF and obtain result
-			theFunctionEvaluator->setExpression(lsfExpression);
-			
-			// Add gradient contribution
-			double g_perturbed = theFunctionEvaluator->evaluateExpression();
-			result = (g_perturbed-g)/h;
-            
-            // return values to previous state
-			theParam->update(original);
-
-			//opserr << "g_pert " << g_perturbed << ", g0 = " << g << endln;
+
+			perturbed[numPerturbed] = i;
+			h(numPerturbed) = step;
+			numPerturbed++;
 		}
 		
 		(*grad_g)(i) = result;
 		
 	}
 
+	if (numPerturbed == 0)
+		return 0;
+
+	// one analysis per parameter, or two for central differences
+	int numRuns = central ? 2*numPerturbed : numPerturbed;
+	ID runIndex(numRuns);
+	Vector runStep(numRuns);
+	Vector runValue(numRuns);
+	for (int j = 0; j < numPerturbed; j++) {
+		runIndex(j) = perturbed(j);
+		runStep(j) = h(j);
+		if (central) {
+			runIndex(numPerturbed+j) = perturbed(j);
+			runStep(numPerturbed+j) = -h(j);
+		}
+	}
+
+	int res;
+	if (numProcesses > 1 && numRuns > 1)
+		res = this->runPerturbationsInParallel(runIndex, runStep, runValue);
+	else
+		res = this->runPerturbations(runIndex, runStep, runValue);
+	if (res < 0)
+		return -1;
+
+	theFunctionEvaluator->setExpression(lsfExpression);
+
+	for (int j = 0; j < numPerturbed; j++) {
+		if (central)
+			(*grad_g)(perturbed(j)) = (runValue(j) - runValue(numPerturbed+j))/(2.0*h(j));
+		else
+			(*grad_g)(perturbed(j)) = (runValue(j) - g)/h(j);
+	}
+
 	return 0;
 	
 }
 
+
+int
+FiniteDifferenceGradient::perturbedValue(int paramIndex, double h, double &g)
+{
+	Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(paramIndex);
+	int lsf = theReliabilityDomain->getTagOfActiveLimitStateFunction();
+	LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtr(lsf);
+
+	double original = theParam->getValue();
+	theParam->update(original+h);
+
+	// set perturbed values in the variable namespace
+	if (theFunctionEvaluator->setVariables() < 0) {
+		opserr << "ERROR FiniteDifferenceGradient -- error setting variables in namespace" << endln;
+		theParam->update(original);
+		return -1;
+	}
+			
+	// run analysis
+	if (theFunctionEvaluator->runAnalysis() < 0) {
+		opserr << "ERROR FiniteDifferenceGradient -- error running analysis" << endln;
+		theParam->update(original);
+		return -1;
+	}
+			
+	// evaluate LSF and obtain result
+	theFunctionEvaluator->setExpression(theLimitStateFunction->getExpression());
+	g = theFunctionEvaluator->evaluateExpression();
+
+	// return values to previous state
+	theParam->update(original);
+
+	return 0;
+}
+
+
+int
+FiniteDifferenceGradient::runPerturbations(const ID &paramIndex, const Vector &h, Vector &g)
+{
+	for (int j = 0; j < paramIndex.Size(); j++)
+		if (this->perturbedValue(paramIndex(j), h(j), g(j)) < 0)
+			return -1;
+
+	return 0;
+}
+
+
+int
+FiniteDifferenceGradient::runPerturbationsInParallel(const ID &paramIndex, const Vector &h, Vector &g)
+{
+#ifdef _WIN32
+	return this->runPerturbations(paramIndex, h, g);
+#else
+	int numRuns = paramIndex.Size();
+	int numWorkers = (numProcesses < numRuns) ? numProcesses : numRuns;
+
+	// flush so that output buffered before the fork is not written twice
+	fflush(0);
+
+	// run j is done by worker j%numWorkers, which writes (j, status, g)
+	// records down its pipe; the parent places them by j, so the result
+	// does not depend on which worker finishes first
+	pid_t *workers = new pid_t[numWorkers];
+	int *pipes = new int[numWorkers];
+	int numStarted = 0;
+
+	for (int w = 0; w < numWorkers; w++) {
+		int fd[2];
+		if (pipe(fd) != 0)
+			break;
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			close(fd[0]);
+			close(fd[1]);
+			break;
+		}
+
+		if (pid == 0) {
+			// the files of the parent are pointed at /dev/null rather than
+			// closed: recorders and Tcl channels of the clone still hold
+			// them, and a closed number would be reused by the next file
+			// opened, into which their buffers would then be flushed
+			int devNull = open("/dev/null", O_RDWR);
+			long maxFD = sysconf(_SC_OPEN_MAX);
+			if (maxFD < 0 || maxFD > 65536)
+				maxFD = 65536;
+			if (devNull >= 0) {
+				for (int f = 3; f < maxFD; f++)
+					if (f != fd[1] && f != devNull && fcntl(f, F_GETFD) != -1)
+						dup2(devNull, f);
+				close(devNull);
+			}
+
+			for (int j = w; j < numRuns; j += numWorkers) {
+				double record[3];
+				record[0] = j;
+				record[2] = 0.0;
+				record[1] = this->perturbedValue(paramIndex(j), h(j), record[2]);
+				if (write(fd[1], record, sizeof(record)) != sizeof(record))
+					_exit(1);
+			}
+			_exit(0);
+		}
+
+		close(fd[1]);
+		workers[w] = pid;
+		pipes[w] = fd[0];
+		numStarted++;
+	}
+
+	// anything the workers could not be started for is done here
+	ID done(numRuns);
+	int res = 0;
+	for (int j = 0; j < numRuns; j++)
+		if (j % numWorkers >= numStarted) {
+			if (this->perturbedValue(paramIndex(j), h(j), g(j)) < 0)
+				res = -1;
+			done(j) = 1;
+		}
+
+	for (int w = 0; w < numStarted; w++) {
+		double record[3];
+		size_t numRead = 0;
+		while (true) {
+			ssize_t n = read(pipes[w], (char *)record + numRead, sizeof(record) - numRead);
+			if (n <= 0)
+				break;
+			numRead += n;
+			if (numRead < sizeof(record))
+				continue;
+			numRead = 0;
+
+			int j = (int)record[0];
+			if (j < 0 || j >= numRuns || record[1] < 0.0)
+				res = -1;
+			else {
+				g(j) = record[2];
+				done(j) = 1;
+				theFunctionEvaluator->incrementEvaluations();
+			}
+		}
+		close(pipes[w]);
+		waitpid(workers[w], 0, 0);
+	}
+
+	delete [] workers;
+	delete [] pipes;
+
+	for (int j = 0; j < numRuns; j++)
+		if (done(j) != 1)
+			res = -1;
+
+	if (res < 0)
+		opserr << "ERROR FiniteDifferenceGradient -- a perturbed analysis failed" << endln;
+
+	return res;
+#endif
+}
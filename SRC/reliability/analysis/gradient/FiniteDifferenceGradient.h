@@ -37,6 +37,7 @@
 
 #include <GradientEvaluator.h>
 #include <Vector.h>
+#include <ID.h>
 #include <ReliabilityDomain.h>
 #include <Domain.h>
 #include <FunctionEvaluator.h>
@@ -52,12 +53,28 @@ public:
 	
 	int		computeGradient(double gFunValue);
 	const Vector &getGradient();
+
+	// the perturbed analyses are run by numProcesses copies of the process
+	// made by fork(), so the Tcl interpreter and the model are cloned
+	void    setNumProcesses(int numProcesses);
+	void    setCentralDifferences(bool central);
+	// steps of noise^(1/2)|x|, or noise^(1/3)|x| for central differences,
+	// where noise is the relative accuracy of g; 0 uses the parameter's own
+	void    setAutomaticStep(double noise);
 	
 protected:
 	
 private:
+	int     perturbedValue(int paramIndex, double h, double &g);
+	int     runPerturbations(const ID &paramIndex, const Vector &h, Vector &g);
+	int     runPerturbationsInParallel(const ID &paramIndex, const Vector &h, Vector &g);
+
 	Domain *theOpenSeesDomain;
 	Vector *grad_g;
+
+	int numProcesses;
+	bool central;
+	double noise;
 	
 };
 
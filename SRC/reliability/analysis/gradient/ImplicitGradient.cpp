@@ -126,6 +126,12 @@ ImplicitGradient::computeGradient(double g)
 	  else {
 	    // use parameter defined perturbation after updating implicit parameter
 	    theParam->update(0.0);
+
+	    // unless the evaluator can differentiate the expression itself
+	    theFunctionEvaluator->setExpression(lsfExpression);
+	    if (theFunctionEvaluator->evaluateGradient(tag, partials(i), false) == 0)
+	      continue;
+
 	    double h = theParam->getPerturbation();
 	    double original = theParam->getValue();
 	    theParam->setValue(original+h);
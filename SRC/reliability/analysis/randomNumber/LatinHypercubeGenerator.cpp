@@ -0,0 +1,101 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+
+#include <LatinHypercubeGenerator.h>
+
+
+LatinHypercubeGenerator::LatinHypercubeGenerator(int passedNumSamples, int passedSeed, int passedStream)
+:PhiloxRandGenerator(passedSeed, passedStream), numSamples(passedNumSamples)
+{
+	if (numSamples < 1)
+		numSamples = 1;
+}
+
+
+LatinHypercubeGenerator::~LatinHypercubeGenerator()
+{
+
+}
+
+
+int
+LatinHypercubeGenerator::getNumSamples(void) const
+{
+	return numSamples;
+}
+
+
+unsigned int
+LatinHypercubeGenerator::permute(unsigned int i, unsigned int l, unsigned int p)
+{
+	// a keyed permutation of 0..l-1 (Kensler, 2013): a hash that is a bijection
+	// on the smallest power of two not less than l, walked until it lands below l
+	unsigned int w = l - 1;
+	w |= w >> 1;
+	w |= w >> 2;
+	w |= w >> 4;
+	w |= w >> 8;
+	w |= w >> 16;
+
+	do {
+		i ^= p;             i *= 0xe170893d;
+		i ^= p >> 16;       i ^= (i & w) >> 4;
+		i ^= p >> 8;        i *= 0x0929eb3f;
+		i ^= p >> 23;       i ^= (i & w) >> 1;
+		i *= 1 | p >> 27;   i *= 0x6935fa69;
+		i ^= (i & w) >> 11; i *= 0x74dcb303;
+		i ^= (i & w) >> 2;  i *= 0x9e501cc3;
+		i ^= (i & w) >> 2;  i *= 0xc860a3df;
+		i &= w;
+		i ^= i >> 5;
+	} while (i >= l);
+
+	return (i + p) % l;
+}
+
+
+void
+LatinHypercubeGenerator::generateSample(long int sample, int n, double *u)
+{
+	long int design = sample / numSamples;
+	unsigned int index = (unsigned int)(sample % numSamples);
+	unsigned int block[4];
+
+	// the position of the sample within each stratum
+	PhiloxRandGenerator::generateSample(sample, n, u);
+
+	for (int j=0; j<n; j++) {
+		// a permutation key for each dimension of each design
+		getBlock(j, design, PermutationDomain, block);
+		unsigned int stratum = permute(index, numSamples, block[0]);
+		u[j] = (stratum + u[j])/numSamples;
+	}
+}
@@ -0,0 +1,62 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+// Description: LatinHypercubeGenerator generates Latin hypercube designs of
+// numSamples samples: in each dimension every one of the numSamples strata
+// of (0,1) holds exactly one sample, at a random position within it. The
+// stratum of sample k in dimension j is given by a keyed permutation of k,
+// so no design is stored and samples may be generated in any order. Samples
+// beyond numSamples start a new, independent design.
+//
+
+#ifndef LatinHypercubeGenerator_h
+#define LatinHypercubeGenerator_h
+
+#include <PhiloxRandGenerator.h>
+
+class LatinHypercubeGenerator : public PhiloxRandGenerator
+{
+
+public:
+	LatinHypercubeGenerator(int numSamples, int seed = 0, int stream = 0);
+	~LatinHypercubeGenerator();
+
+	int     getNumSamples(void) const;
+
+protected:
+	void    generateSample(long int sample, int n, double *u);
+
+private:
+	static unsigned int permute(unsigned int i, unsigned int l, unsigned int p);
+
+	int numSamples;
+};
+
+#endif
@@ -0,0 +1,261 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+
+#include <PhiloxRandGenerator.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <time.h>
+
+
+PhiloxRandGenerator::PhiloxRandGenerator(int passedSeed, int passedStream)
+:RandomNumberGenerator(), generatedNumbers(0), seed(0), stream(passedStream),
+ nextSample(0), nextSingle(0)
+{
+	key[0] = 0;
+	key[1] = (unsigned int)passedStream;
+	setSeed(passedSeed);
+}
+
+
+PhiloxRandGenerator::~PhiloxRandGenerator()
+{
+	if (generatedNumbers != 0)
+		delete generatedNumbers;
+}
+
+
+void
+PhiloxRandGenerator::getBlock(unsigned int c0, long int sample, unsigned int domain, unsigned int *out) const
+{
+	unsigned long long k = (unsigned long long)sample;
+	unsigned int ctr[4] = {c0, (unsigned int)k, (unsigned int)(k >> 32), domain};
+	unsigned int k0 = key[0];
+	unsigned int k1 = key[1];
+
+	// ten rounds of Philox4x32
+	for (int r=0; r<10; r++) {
+		unsigned long long p0 = (unsigned long long)0xD2511F53u * ctr[0];
+		unsigned long long p1 = (unsigned long long)0xCD9E8D57u * ctr[2];
+		unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+		unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+		ctr[0] = hi1 ^ ctr[1] ^ k0;
+		ctr[1] = lo1;
+		ctr[2] = hi0 ^ ctr[3] ^ k1;
+		ctr[3] = lo0;
+		k0 += 0x9E3779B9u;
+		k1 += 0xBB67AE85u;
+	}
+
+	out[0] = ctr[0];
+	out[1] = ctr[1];
+	out[2] = ctr[2];
+	out[3] = ctr[3];
+}
+
+
+double
+PhiloxRandGenerator::toUniform(unsigned int hi, unsigned int lo)
+{
+	// 53 random bits, offset by half a step so that 0 and 1 never occur
+	double x = (double)(hi >> 5)*67108864.0 + (double)(lo >> 6);
+	return (x + 0.5)/9007199254740992.0;
+}
+
+
+void
+PhiloxRandGenerator::generateSample(long int sample, int n, double *u)
+{
+	unsigned int block[4];
+	for (int j=0; j<n; j+=2) {
+		getBlock(j/2, sample, SampleDomain, block);
+		u[j] = toUniform(block[0], block[1]);
+		if (j+1 < n)
+			u[j+1] = toUniform(block[2], block[3]);
+	}
+}
+
+
+int
+PhiloxRandGenerator::fill(int n, int seedIn, bool normal)
+{
+	// set RNG seed if necessary
+	if (seedIn != 0)
+		setSeed(seedIn);
+
+	if (generatedNumbers == 0)
+		generatedNumbers = new Vector(n);
+	else if (generatedNumbers->Size() != n) {
+		delete generatedNumbers;
+		generatedNumbers = new Vector(n);
+	}
+
+	if (n > 0) {
+		double *u = &(*generatedNumbers)(0);
+		generateSample(nextSample, n, u);
+		if (normal)
+			transformUniformToStdNormal(u, n);
+	}
+	nextSample++;
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentUniformNumbers(int n, double lower, double upper, int seedIn)
+{
+	fill(n, seedIn, false);
+
+	Vector &randomArray = *generatedNumbers;
+	for (int j=0; j<n; j++)
+		randomArray(j) = (upper-lower)*randomArray(j) + lower;
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentStdNormalNumbers(int n, int seedIn)
+{
+	return fill(n, seedIn, true);
+}
+
+
+int
+PhiloxRandGenerator::generate_nSamplesUniformNumbers(int numSamples, int n, Matrix &samples, long int firstSample)
+{
+	if (samples.noRows() != n || samples.noCols() != numSamples)
+		samples.resize(n, numSamples);
+
+	if (firstSample < 0)
+		firstSample = nextSample;
+
+	// each sample is a column, contiguous in the matrix
+	if (n > 0)
+		for (int i=0; i<numSamples; i++)
+			generateSample(firstSample+i, n, &samples(0,i));
+
+	nextSample = firstSample + numSamples;
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nSamplesStdNormalNumbers(int numSamples, int n, Matrix &samples, long int firstSample)
+{
+	generate_nSamplesUniformNumbers(numSamples, n, samples, firstSample);
+
+	if (n > 0 && numSamples > 0)
+		transformUniformToStdNormal(&samples(0,0), n*numSamples);
+
+	return 0;
+}
+
+
+const Vector&
+PhiloxRandGenerator::getGeneratedNumbers()
+{
+	return (*generatedNumbers);
+}
+
+
+int
+PhiloxRandGenerator::getSeed()
+{
+	return seed;
+}
+
+
+void
+PhiloxRandGenerator::setSeed(int passedSeed)
+{
+	if (passedSeed != 0)
+		seed = passedSeed;
+	else
+		seed = time(NULL);
+
+	key[0] = (unsigned int)seed;
+	nextSample = 0;
+	nextSingle = 0;
+}
+
+
+void
+PhiloxRandGenerator::setStream(int passedStream)
+{
+	stream = passedStream;
+	key[1] = (unsigned int)stream;
+	nextSample = 0;
+	nextSingle = 0;
+}
+
+
+int
+PhiloxRandGenerator::getStream(void) const
+{
+	return stream;
+}
+
+
+void
+PhiloxRandGenerator::setNextSample(long int sample)
+{
+	nextSample = sample;
+}
+
+
+long int
+PhiloxRandGenerator::getNextSample(void) const
+{
+	return nextSample;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleUniformNumber(double lower, double upper)
+{
+	unsigned int block[4];
+	getBlock(0, nextSingle/2, SingleDomain, block);
+	double u = (nextSingle % 2 == 0) ? toUniform(block[0], block[1]) : toUniform(block[2], block[3]);
+	nextSingle++;
+
+	return (upper-lower)*u + lower;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleStdNormalNumber(void)
+{
+	double u = generate_singleUniformNumber(0.0, 1.0);
+	transformUniformToStdNormal(&u, 1);
+	return u;
+}
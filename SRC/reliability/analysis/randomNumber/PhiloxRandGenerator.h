@@ -0,0 +1,90 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+// Description: PhiloxRandGenerator is a counter-based generator, Philox4x32-10
+// of Salmon et al. (2011). Number j of sample k is a function of the seed, the
+// stream and (k,j) only, so that samples may be generated in any order, on any
+// process or thread, and the results are reproducible. Different streams with
+// the same seed are independent. Single numbers are drawn from a sequence of
+// their own. The LatinHypercube and SobolSequence generators are subclasses,
+// which replace generateSample().
+//
+
+#ifndef PhiloxRandGenerator_h
+#define PhiloxRandGenerator_h
+
+#include <RandomNumberGenerator.h>
+
+class PhiloxRandGenerator : public RandomNumberGenerator
+{
+
+public:
+	PhiloxRandGenerator(int seed = 0, int stream = 0);
+	virtual ~PhiloxRandGenerator();
+
+	int		generate_nIndependentStdNormalNumbers(int n, int seed=0);
+	int     generate_nIndependentUniformNumbers(int n, double lower, double upper, int seed=0);
+	const   Vector& getGeneratedNumbers();
+	int     getSeed();
+
+	double  generate_singleStdNormalNumber();
+	double  generate_singleUniformNumber(double lower=0.0, double upper=1.0);
+	void    setSeed(int passedSeed=0);
+
+	int     generate_nSamplesStdNormalNumbers(int numSamples, int n, Matrix &samples, long int firstSample = -1);
+	int     generate_nSamplesUniformNumbers(int numSamples, int n, Matrix &samples, long int firstSample = -1);
+
+	void    setStream(int stream);
+	int     getStream(void) const;
+	void    setNextSample(long int sample);
+	long int getNextSample(void) const;
+
+protected:
+	// the n uniform numbers, in (0,1), of sample number sample
+	virtual void generateSample(long int sample, int n, double *u);
+
+	// one Philox block, four words from a counter of (c0, sample, domain)
+	void    getBlock(unsigned int c0, long int sample, unsigned int domain, unsigned int *out) const;
+	static double toUniform(unsigned int hi, unsigned int lo);
+
+	enum {SampleDomain = 0, SingleDomain = 1, PermutationDomain = 2, ShiftDomain = 3};
+
+private:
+	int     fill(int n, int seed, bool normal);
+
+	Vector *generatedNumbers;
+	int seed;
+	int stream;
+	unsigned int key[2];
+	long int nextSample;
+	long int nextSingle;
+};
+
+#endif
@@ -32,6 +32,7 @@
 //
 
 #include <RandomNumberGenerator.h>
+#include <math.h>
 
 RandomNumberGenerator::RandomNumberGenerator()
 {
@@ -42,3 +43,115 @@ RandomNumberGenerator::~RandomNumberGenerator()
 }
 
 
+int
+RandomNumberGenerator::generate_nSamplesStdNormalNumbers(int numSamples, int n, Matrix &samples, long int firstSample)
+{
+	// generators without a batch implementation produce the samples one at a time,
+	// in sequence, so firstSample cannot be honoured
+	if (samples.noRows() != n || samples.noCols() != numSamples)
+		samples.resize(n, numSamples);
+
+	for (int i=0; i<numSamples; i++) {
+		if (this->generate_nIndependentStdNormalNumbers(n) < 0)
+			return -1;
+		const Vector &theNumbers = this->getGeneratedNumbers();
+		for (int j=0; j<n; j++)
+			samples(j,i) = theNumbers(j);
+	}
+
+	return 0;
+}
+
+
+int
+RandomNumberGenerator::generate_nSamplesUniformNumbers(int numSamples, int n, Matrix &samples, long int firstSample)
+{
+	if (samples.noRows() != n || samples.noCols() != numSamples)
+		samples.resize(n, numSamples);
+
+	for (int i=0; i<numSamples; i++) {
+		if (this->generate_nIndependentUniformNumbers(n, 0.0, 1.0) < 0)
+			return -1;
+		const Vector &theNumbers = this->getGeneratedNumbers();
+		for (int j=0; j<n; j++)
+			samples(j,i) = theNumbers(j);
+	}
+
+	return 0;
+}
+
+
+void
+RandomNumberGenerator::transformUniformToStdNormal(double *p, int n)
+{
+	// Wichura's algorithm AS241 (PPND16), accurate to about 1e-16; the
+	// probabilities are clipped to the open interval (0,1)
+	static const double a[8] = {3.387132872796366608, 133.14166789178437745,
+				    1971.5909503065514427, 13731.693765509461125,
+				    45921.953931549871457, 67265.770927008700853,
+				    33430.575583588128105, 2509.0809287301226727};
+	static const double b[8] = {1.0, 42.313330701600911252,
+				    687.1870074920579083, 5394.1960214247511077,
+				    21213.794301586595867, 39307.89580009271061,
+				    28729.085735721942674, 5226.495278852545925};
+	static const double c[8] = {1.42343711074968357734, 4.6303378461565452959,
+				    5.7694972214606914055, 3.64784832476320460504,
+				    1.27045825245236838258, 0.24178072517745061177,
+				    0.0227238449892691845833, 7.7454501427834140764e-4};
+	static const double d[8] = {1.0, 2.05319162663775882187,
+				    1.6763848301838038494, 0.68976733498510000455,
+				    0.14810397642748007459, 0.0151986665636164571966,
+				    5.475938084995344946e-4, 1.05075007164441684324e-9};
+	static const double e[8] = {6.6579046435011037772, 5.4637849111641143699,
+				    1.7848265399172913358, 0.29656057182850489123,
+				    0.026532189526576123093, 0.0012426609473880784386,
+				    2.71155556874348757815e-5, 2.01033439929228813265e-7};
+	static const double f[8] = {1.0, 0.59983220655588793769,
+				    0.13692988092273580531, 0.0148753612908506148525,
+				    7.868691311456132591e-4, 1.8463183175100546818e-5,
+				    1.4215117583164458887e-7, 2.04426310338993978564e-15};
+
+	for (int i=0; i<n; i++) {
+		double pi = p[i];
+		if (pi < 1.0e-300)
+			pi = 1.0e-300;
+		else if (pi > 1.0 - 1.0e-16)
+			pi = 1.0 - 1.0e-16;
+
+		double q = pi - 0.5;
+		double z;
+
+		if (fabs(q) <= 0.425) {
+			double r = 0.180625 - q*q;
+			double num = a[7], den = b[7];
+			for (int k=6; k>=0; k--) {
+				num = num*r + a[k];
+				den = den*r + b[k];
+			}
+			z = q*num/den;
+		}
+		else {
+			double r = (q < 0.0) ? pi : 1.0-pi;
+			r = sqrt(-log(r));
+			const double *nc, *dc;
+			if (r <= 5.0) {
+				r -= 1.6;
+				nc = c; dc = d;
+			}
+			else {
+				r -= 5.0;
+				nc = e; dc = f;
+			}
+			double num = nc[7], den = dc[7];
+			for (int k=6; k>=0; k--) {
+				num = num*r + nc[k];
+				den = den*r + dc[k];
+			}
+			z = num/den;
+			if (q < 0.0)
+				z = -z;
+		}
+
+		p[i] = z;
+	}
+}
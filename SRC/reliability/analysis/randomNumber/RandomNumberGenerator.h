@@ -35,6 +35,7 @@
 #define RandomNumberGenerator_h
 
 #include <Vector.h>
+#include <Matrix.h>
 
 class RandomNumberGenerator
 {
@@ -53,6 +54,14 @@ public:
 	virtual double  generate_singleUniformNumber(double lower=0.0, double upper=1.0)=0;		
 	virtual void setSeed(int)=0;
 
+	// batch generation, column i of samples holds the n numbers of sample
+	// firstSample+i; a negative firstSample continues from the last sample
+	virtual int generate_nSamplesStdNormalNumbers(int numSamples, int n, Matrix &samples, long int firstSample = -1);
+	virtual int generate_nSamplesUniformNumbers(int numSamples, int n, Matrix &samples, long int firstSample = -1);
+
+	// inverse of the standard normal CDF, applied in place to n probabilities
+	static void transformUniformToStdNormal(double *p, int n);
+
 
 protected:
 
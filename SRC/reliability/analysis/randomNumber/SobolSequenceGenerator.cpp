@@ -0,0 +1,128 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+
+#include <SobolSequenceGenerator.h>
+#include <OPS_Globals.h>
+
+// degree s, coefficients a and initial direction numbers m of the primitive
+// polynomials of dimensions 2 to 21, from new-joe-kuo-6.21201
+static const int sobolDegree[SOBOL_MAX_DIMENSION-1] = 
+  {1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7};
+static const int sobolCoefficients[SOBOL_MAX_DIMENSION-1] = 
+  {0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4};
+static const int sobolInitial[SOBOL_MAX_DIMENSION-1][7] = {
+  {1},
+  {1, 3},
+  {1, 3, 1},
+  {1, 1, 1},
+  {1, 1, 3, 3},
+  {1, 3, 5, 13},
+  {1, 1, 5, 5, 17},
+  {1, 1, 5, 5, 5},
+  {1, 1, 7, 11, 19},
+  {1, 1, 5, 1, 1},
+  {1, 1, 1, 3, 11},
+  {1, 3, 5, 5, 31},
+  {1, 3, 3, 9, 7, 49},
+  {1, 1, 1, 15, 21, 21},
+  {1, 3, 1, 13, 27, 49},
+  {1, 1, 1, 15, 7, 5},
+  {1, 3, 1, 15, 13, 25},
+  {1, 1, 5, 5, 19, 61},
+  {1, 3, 7, 11, 23, 15, 103},
+  {1, 3, 7, 13, 13, 15, 69}
+};
+
+
+SobolSequenceGenerator::SobolSequenceGenerator(int passedSeed, int passedStream)
+:PhiloxRandGenerator(passedSeed, passedStream), paddingReported(false)
+{
+	// the first dimension is the van der Corput sequence in base 2
+	for (int i=0; i<32; i++)
+		directions[0][i] = 1u << (31-i);
+
+	for (int d=1; d<SOBOL_MAX_DIMENSION; d++) {
+		int s = sobolDegree[d-1];
+		int a = sobolCoefficients[d-1];
+		unsigned int *v = directions[d];
+
+		for (int i=0; i<s; i++)
+			v[i] = (unsigned int)sobolInitial[d-1][i] << (31-i);
+
+		for (int i=s; i<32; i++) {
+			v[i] = v[i-s] ^ (v[i-s] >> s);
+			for (int k=1; k<s; k++)
+				if ((a >> (s-1-k)) & 1)
+					v[i] ^= v[i-k];
+		}
+	}
+}
+
+
+SobolSequenceGenerator::~SobolSequenceGenerator()
+{
+
+}
+
+
+void
+SobolSequenceGenerator::generateSample(long int sample, int n, double *u)
+{
+	int numSobol = n;
+	if (n > SOBOL_MAX_DIMENSION) {
+		if (paddingReported == false) {
+			opserr << "WARNING SobolSequenceGenerator - only " << SOBOL_MAX_DIMENSION;
+			opserr << " dimensions are available, the remaining " << n-SOBOL_MAX_DIMENSION;
+			opserr << " are padded with pseudo-random numbers\n";
+			paddingReported = true;
+		}
+		numSobol = SOBOL_MAX_DIMENSION;
+		PhiloxRandGenerator::generateSample(sample, n, u);
+	}
+
+	unsigned int index = (unsigned int)sample;
+	unsigned int block[4];
+
+	for (int j=0; j<numSobol; j++) {
+		// point number sample, in the natural rather than Gray code order
+		unsigned int x = 0;
+		unsigned int bits = index;
+		for (int i=0; bits != 0; i++, bits >>= 1)
+			if (bits & 1)
+				x ^= directions[j][i];
+
+		// digital shift, the same for all samples
+		getBlock(j, 0, ShiftDomain, block);
+		x ^= block[0];
+
+		u[j] = ((double)x + 0.5)/4294967296.0;
+	}
+}
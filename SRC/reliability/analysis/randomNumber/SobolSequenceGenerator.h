@@ -0,0 +1,60 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+
+//
+// Written: agent
+// Created: 10/26
+//
+// Description: SobolSequenceGenerator generates the low-discrepancy sequence of
+// Sobol, with the direction numbers of Joe and Kuo (2008) for up to 21
+// dimensions, randomised by a digital shift drawn from the seed so that
+// independent replicates give an error estimate. Sample k is computed
+// directly from k. Dimensions beyond 21 are padded with Philox numbers.
+//
+
+#ifndef SobolSequenceGenerator_h
+#define SobolSequenceGenerator_h
+
+#include <PhiloxRandGenerator.h>
+
+#define SOBOL_MAX_DIMENSION 21
+
+class SobolSequenceGenerator : public PhiloxRandGenerator
+{
+
+public:
+	SobolSequenceGenerator(int seed = 0, int stream = 0);
+	~SobolSequenceGenerator();
+
+protected:
+	void    generateSample(long int sample, int n, double *u);
+
+private:
+	unsigned int directions[SOBOL_MAX_DIMENSION][32];
+	bool paddingReported;
+};
+
+#endif
@@ -0,0 +1,648 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+//
+// Written: agent
+// Created: 10/26
+//
+
+#include <CompiledExpression.h>
+#include <Domain.h>
+#include <Node.h>
+#include <Parameter.h>
+#include <Vector.h>
+#include <NodeIter.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+enum {
+  OP_CONST, OP_PARAM, OP_NODE_DISP, OP_NODE_VEL, OP_NODE_ACCEL, OP_SENS_NODE_DISP,
+  OP_NEG, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+  OP_SIN, OP_COS, OP_TAN, OP_ASIN, OP_ACOS, OP_ATAN, OP_SINH, OP_COSH, OP_TANH,
+  OP_EXP, OP_LOG, OP_LOG10, OP_SQRT, OP_ABS, OP_CEIL, OP_FLOOR,
+  OP_ATAN2, OP_FMOD, OP_HYPOT, OP_MIN, OP_MAX
+};
+
+// the Tcl math functions that are compiled; numArgs -1 for any number > 0
+struct ExpressionFunction {
+  const char *name;
+  int op;
+  int numArgs;
+  bool keepsInt;   // an integer result for integer arguments
+};
+
+static const ExpressionFunction theFunctions[] = {
+  {"sin", OP_SIN, 1, false}, {"cos", OP_COS, 1, false}, {"tan", OP_TAN, 1, false},
+  {"asin", OP_ASIN, 1, false}, {"acos", OP_ACOS, 1, false}, {"atan", OP_ATAN, 1, false},
+  {"sinh", OP_SINH, 1, false}, {"cosh", OP_COSH, 1, false}, {"tanh", OP_TANH, 1, false},
+  {"exp", OP_EXP, 1, false}, {"log", OP_LOG, 1, false}, {"log10", OP_LOG10, 1, false},
+  {"sqrt", OP_SQRT, 1, false}, {"abs", OP_ABS, 1, true}, {"ceil", OP_CEIL, 1, false},
+  {"floor", OP_FLOOR, 1, false}, {"double", -1, 1, false},
+  {"atan2", OP_ATAN2, 2, false}, {"fmod", OP_FMOD, 2, false}, {"hypot", OP_HYPOT, 2, false},
+  {"pow", OP_POW, 2, false}, {"min", OP_MIN, -1, true}, {"max", OP_MAX, -1, true}
+};
+
+static const int numFunctions = sizeof(theFunctions)/sizeof(ExpressionFunction);
+
+static inline bool
+isFiniteValue(double x)
+{
+  return (x - x == 0.0);
+}
+
+
+CompiledExpression::CompiledExpression(const char *expression, Domain *passedDomain)
+  :theExpression(0), theDomain(passedDomain),
+   program(0), numInstructions(0), sizeProgram(0), depth(0), maxDepth(0),
+   compiled(false), hasResponses(false), pos(0), values(0), derivatives(0)
+{
+  theExpression = new char[strlen(expression)+1];
+  strcpy(theExpression, expression);
+
+  pos = theExpression;
+  bool isInt = false;
+  if (this->parseSum(isInt) == 0) {
+    this->skipSpace();
+    // anything left over, e.g. a comparison or ternary operator, is for Tcl
+    if (*pos == '\0' && numInstructions > 0)
+      compiled = true;
+  }
+  pos = 0;
+
+  if (compiled == true) {
+    values = new double[maxDepth];
+    derivatives = new double[maxDepth];
+  } else {
+    if (program != 0)
+      delete [] program;
+    program = 0;
+    numInstructions = 0;
+  }
+}
+
+
+CompiledExpression::~CompiledExpression()
+{
+  if (theExpression != 0)
+    delete [] theExpression;
+  if (program != 0)
+    delete [] program;
+  if (values != 0)
+    delete [] values;
+  if (derivatives != 0)
+    delete [] derivatives;
+}
+
+
+bool
+CompiledExpression::isCompiled(void) const
+{
+  return compiled;
+}
+
+
+const char *
+CompiledExpression::getExpression(void) const
+{
+  return theExpression;
+}
+
+
+int
+CompiledExpression::evaluate(double &result)
+{
+  if (compiled == false)
+    return -1;
+
+  return this->run(result, 0, 0, false);
+}
+
+
+int
+CompiledExpression::evaluateGradient(int paramTag, double &result, bool explicitOnly)
+{
+  if (compiled == false)
+    return -1;
+
+  if (explicitOnly == true && hasResponses == true)
+    return -1;
+
+  double value;
+  return this->run(value, paramTag, &result, explicitOnly);
+}
+
+
+int
+CompiledExpression::run(double &result, int paramTag, double *dResult, bool explicitOnly)
+{
+  bool diff = (dResult != 0);
+  double *v = values;
+  double *d = derivatives;
+  int top = -1;
+
+  for (int i=0; i<numInstructions; i++) {
+    const Instruction &theInstruction = program[i];
+    int op = theInstruction.op;
+
+    if (op <= OP_SENS_NODE_DISP) {
+      // push a value
+      double value = 0.0;
+      double dValue = 0.0;
+
+      if (op == OP_CONST)
+	value = theInstruction.value;
+
+      else if (op == OP_PARAM) {
+	Parameter *theParam = theDomain->getParameter(theInstruction.tag);
+	if (theParam == 0)
+	  return -1;
+	if (diff == true && explicitOnly == true && theParam->isImplicit())
+	  return -1;
+	value = theParam->getValue();
+	if (theInstruction.tag == paramTag)
+	  dValue = 1.0;
+      }
+
+      else if (op == OP_SENS_NODE_DISP) {
+	Node *theNode = theDomain->getNode(theInstruction.tag);
+	Parameter *theParam = theDomain->getParameter(theInstruction.paramTag);
+	if (theNode == 0 || theParam == 0)
+	  return -1;
+	value = theNode->getDispSensitivity(theInstruction.dof, theParam->getGradIndex());
+      }
+
+      else {
+	NodeResponseType type = Disp;
+	if (op == OP_NODE_VEL)
+	  type = Vel;
+	else if (op == OP_NODE_ACCEL)
+	  type = Accel;
+	const Vector *theResponse = theDomain->getNodeResponse(theInstruction.tag, type);
+	if (theResponse == 0)
+	  return -1;
+	int dof = theInstruction.dof - 1;
+	if (dof < 0 || dof >= theResponse->Size())
+	  return -1;
+	value = (*theResponse)(dof);
+      }
+
+      top++;
+      v[top] = value;
+      d[top] = dValue;
+      continue;
+    }
+
+    double a = v[top];
+    double da = d[top];
+
+    switch (op) {
+      // unary operators and functions
+    case OP_NEG:
+      v[top] = -a; d[top] = -da; break;
+    case OP_SIN:
+      v[top] = sin(a); d[top] = cos(a)*da; break;
+    case OP_COS:
+      v[top] = cos(a); d[top] = -sin(a)*da; break;
+    case OP_TAN:
+      v[top] = tan(a); d[top] = da/(cos(a)*cos(a)); break;
+    case OP_ASIN:
+      if (a < -1.0 || a > 1.0) return -1;
+      v[top] = asin(a); if (diff) d[top] = da/sqrt(1.0-a*a); break;
+    case OP_ACOS:
+      if (a < -1.0 || a > 1.0) return -1;
+      v[top] = acos(a); if (diff) d[top] = -da/sqrt(1.0-a*a); break;
+    case OP_ATAN:
+      v[top] = atan(a); d[top] = da/(1.0+a*a); break;
+    case OP_SINH:
+      v[top] = sinh(a); d[top] = cosh(a)*da; break;
+    case OP_COSH:
+      v[top] = cosh(a); d[top] = sinh(a)*da; break;
+    case OP_TANH:
+      v[top] = tanh(a); d[top] = (1.0-v[top]*v[top])*da; break;
+    case OP_EXP:
+      v[top] = exp(a); d[top] = v[top]*da; break;
+    case OP_LOG:
+      if (a <= 0.0) return -1;
+      v[top] = log(a); d[top] = da/a; break;
+    case OP_LOG10:
+      if (a <= 0.0) return -1;
+      v[top] = log10(a); d[top] = da/(a*log(10.0)); break;
+    case OP_SQRT:
+      if (a < 0.0) return -1;
+      v[top] = sqrt(a); if (diff) d[top] = (a > 0.0) ? 0.5*da/v[top] : 0.0; break;
+    case OP_ABS:
+      v[top] = fabs(a); d[top] = (a < 0.0) ? -da : da; break;
+    case OP_CEIL:
+      v[top] = ceil(a); d[top] = 0.0; break;
+    case OP_FLOOR:
+      v[top] = floor(a); d[top] = 0.0; break;
+
+    default: {
+      // binary operators and functions, a the left operand
+      double b = a;
+      double db = da;
+      top--;
+      a = v[top];
+      da = d[top];
+
+      switch (op) {
+      case OP_ADD:
+	v[top] = a + b; d[top] = da + db; break;
+      case OP_SUB:
+	v[top] = a - b; d[top] = da - db; break;
+      case OP_MUL:
+	v[top] = a*b; d[top] = da*b + a*db; break;
+      case OP_DIV:
+	if (b == 0.0) return -1;
+	v[top] = a/b; d[top] = (da - a/b*db)/b; break;
+      case OP_POW:
+	if (a < 0.0 && b != floor(b)) return -1;
+	if (a == 0.0 && b < 0.0) return -1;
+	v[top] = pow(a, b);
+	if (diff) {
+	  d[top] = (da != 0.0) ? b*pow(a, b-1.0)*da : 0.0;
+	  if (db != 0.0) {
+	    if (a <= 0.0) return -1;
+	    d[top] += v[top]*log(a)*db;
+	  }
+	}
+	break;
+      case OP_ATAN2:
+	v[top] = atan2(a, b); d[top] = (b*da - a*db)/(a*a + b*b); break;
+      case OP_FMOD:
+	if (b == 0.0) return -1;
+	v[top] = fmod(a, b); d[top] = da - (a-v[top])/b*db; break;
+      case OP_HYPOT:
+	v[top] = hypot(a, b); if (diff) d[top] = (v[top] > 0.0) ? (a*da + b*db)/v[top] : 0.0; break;
+      case OP_MIN:
+	if (b < a) {v[top] = b; d[top] = db;} break;
+      case OP_MAX:
+	if (b > a) {v[top] = b; d[top] = db;} break;
+      default:
+	return -1;
+      }
+    }
+    }
+
+    // Tcl reports overflow and domain errors, the caller will use Tcl
+    if (!isFiniteValue(v[top]))
+      return -1;
+  }
+
+  result = v[0];
+  if (diff == true) {
+    if (!isFiniteValue(d[0]))
+      return -1;
+    *dResult = d[0];
+  }
+
+  return 0;
+}
+
+
+int
+CompiledExpression::emit(int op, double value, int tag, int dof, int paramTag)
+{
+  if (numInstructions == sizeProgram) {
+    int newSize = (sizeProgram == 0) ? 16 : 2*sizeProgram;
+    Instruction *newProgram = new Instruction[newSize];
+    for (int i=0; i<numInstructions; i++)
+      newProgram[i] = program[i];
+    if (program != 0)
+      delete [] program;
+    program = newProgram;
+    sizeProgram = newSize;
+  }
+
+  Instruction &theInstruction = program[numInstructions++];
+  theInstruction.op = op;
+  theInstruction.value = value;
+  theInstruction.tag = tag;
+  theInstruction.dof = dof;
+  theInstruction.paramTag = paramTag;
+
+  // keep track of the stack depth needed
+  if (op <= OP_SENS_NODE_DISP) {
+    depth++;
+    if (depth > maxDepth)
+      maxDepth = depth;
+  } else if (op >= OP_ADD && op <= OP_POW)
+    depth--;
+  else if (op >= OP_ATAN2)
+    depth--;
+
+  return 0;
+}
+
+
+void
+CompiledExpression::skipSpace(void)
+{
+  while (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')
+    pos++;
+}
+
+
+int
+CompiledExpression::parseSum(bool &isInt)
+{
+  if (this->parseProduct(isInt) < 0)
+    return -1;
+
+  while (true) {
+    this->skipSpace();
+    char c = *pos;
+    if (c != '+' && c != '-')
+      return 0;
+    pos++;
+
+    bool rightInt = false;
+    if (this->parseProduct(rightInt) < 0)
+      return -1;
+    this->emit((c == '+') ? OP_ADD : OP_SUB);
+    isInt = isInt && rightInt;
+  }
+}
+
+
+int
+CompiledExpression::parseProduct(bool &isInt)
+{
+  if (this->parsePower(isInt) < 0)
+    return -1;
+
+  while (true) {
+    this->skipSpace();
+    char c = *pos;
+    if (c == '%')
+      return -1;
+    if ((c != '*' && c != '/') || (c == '*' && pos[1] == '*'))
+      return 0;
+    pos++;
+
+    bool rightInt = false;
+    if (this->parsePower(rightInt) < 0)
+      return -1;
+
+    // Tcl divides integers as integers
+    if (c == '/' && isInt && rightInt)
+      return -1;
+
+    this->emit((c == '*') ? OP_MUL : OP_DIV);
+    isInt = isInt && rightInt;
+  }
+}
+
+
+int
+CompiledExpression::parsePower(bool &isInt)
+{
+  // unary operators bind more tightly than **, which is right associative
+  if (this->parseUnary(isInt) < 0)
+    return -1;
+
+  this->skipSpace();
+  if (pos[0] != '*' || pos[1] != '*')
+    return 0;
+  pos += 2;
+
+  bool rightInt = false;
+  if (this->parsePower(rightInt) < 0)
+    return -1;
+
+  // Tcl raises integers to integer powers as integers
+  if (isInt && rightInt)
+    return -1;
+
+  this->emit(OP_POW);
+  isInt = false;
+
+  return 0;
+}
+
+
+int
+CompiledExpression::parseUnary(bool &isInt)
+{
+  this->skipSpace();
+  if (*pos == '-') {
+    pos++;
+    if (this->parseUnary(isInt) < 0)
+      return -1;
+    this->emit(OP_NEG);
+    return 0;
+  }
+  if (*pos == '+') {
+    pos++;
+    return this->parseUnary(isInt);
+  }
+
+  return this->parsePrimary(isInt);
+}
+
+
+int
+CompiledExpression::parsePrimary(bool &isInt)
+{
+  this->skipSpace();
+  char c = *pos;
+  isInt = false;
+
+  // a parenthesised expression
+  if (c == '(') {
+    pos++;
+    if (this->parseSum(isInt) < 0)
+      return -1;
+    this->skipSpace();
+    if (*pos != ')')
+      return -1;
+    pos++;
+    return 0;
+  }
+
+  // a number, Tcl reads octal and hexadecimal integers
+  if (isdigit(c) || (c == '.' && isdigit(pos[1]))) {
+    const char *start = pos;
+    char *end = 0;
+    double value = strtod(start, &end);
+    if (end == start)
+      return -1;
+    isInt = true;
+    for (const char *p = start; p < end; p++) {
+      if (*p == 'x' || *p == 'X')
+	return -1;
+      if (*p == '.' || *p == 'e' || *p == 'E')
+	isInt = false;
+    }
+    if (isInt && start[0] == '0' && end-start > 1)
+      return -1;
+    if (isalpha(*end) || *end == '_')
+      return -1;
+    pos = end;
+    this->emit(OP_CONST, value);
+    return 0;
+  }
+
+  // a parameter value $par(tag)
+  if (c == '$') {
+    pos++;
+    if (strncmp(pos, "par(", 4) != 0)
+      return -1;
+    pos += 4;
+    int tag;
+    if (this->parseInteger(tag) < 0 || *pos != ')')
+      return -1;
+    pos++;
+    this->emit(OP_PARAM, 0.0, tag);
+    return 0;
+  }
+
+  // a nodal response command
+  if (c == '[') {
+    pos++;
+    if (this->parseCommand() < 0)
+      return -1;
+    this->skipSpace();
+    if (*pos != ']')
+      return -1;
+    pos++;
+    return 0;
+  }
+
+  // a math function
+  if (isalpha(c)) {
+    const char *start = pos;
+    while (isalnum(*pos) || *pos == '_')
+      pos++;
+    int length = pos - start;
+
+    const ExpressionFunction *theFunction = 0;
+    for (int i=0; i<numFunctions; i++)
+      if ((int)strlen(theFunctions[i].name) == length &&
+	  strncmp(theFunctions[i].name, start, length) == 0)
+	theFunction = &theFunctions[i];
+    if (theFunction == 0)
+      return -1;
+
+    this->skipSpace();
+    if (*pos != '(')
+      return -1;
+    pos++;
+
+    int numArgs = 0;
+    bool allInt = true;
+    while (true) {
+      bool argInt = false;
+      if (this->parseSum(argInt) < 0)
+	return -1;
+      numArgs++;
+      allInt = allInt && argInt;
+
+      // min and max of more than two arguments are done in pairs
+      if (theFunction->numArgs < 0 && numArgs > 1)
+	this->emit(theFunction->op);
+
+      this->skipSpace();
+      if (*pos == ',') {
+	pos++;
+	continue;
+      }
+      if (*pos != ')')
+	return -1;
+      pos++;
+      break;
+    }
+
+    if (theFunction->numArgs > 0 && numArgs != theFunction->numArgs)
+      return -1;
+
+    if (theFunction->numArgs > 0 && theFunction->op >= 0)
+      this->emit(theFunction->op);
+
+    isInt = theFunction->keepsInt && allInt;
+    return 0;
+  }
+
+  return -1;
+}
+
+
+int
+CompiledExpression::parseCommand(void)
+{
+  this->skipSpace();
+  const char *start = pos;
+  while (isalpha(*pos))
+    pos++;
+  int length = pos - start;
+
+  int op = -1;
+  int numArgs = 2;
+  if (length == 8 && strncmp(start, "nodeDisp", 8) == 0)
+    op = OP_NODE_DISP;
+  else if (length == 7 && strncmp(start, "nodeVel", 7) == 0)
+    op = OP_NODE_VEL;
+  else if (length == 9 && strncmp(start, "nodeAccel", 9) == 0)
+    op = OP_NODE_ACCEL;
+  else if (length == 12 && strncmp(start, "sensNodeDisp", 12) == 0) {
+    op = OP_SENS_NODE_DISP;
+    numArgs = 3;
+  }
+  if (op < 0)
+    return -1;
+
+  int args[3];
+  for (int i=0; i<numArgs; i++) {
+    if (*pos != ' ' && *pos != '\t')
+      return -1;
+    this->skipSpace();
+    if (this->parseInteger(args[i]) < 0)
+      return -1;
+  }
+
+  this->emit(op, 0.0, args[0], args[1], (numArgs == 3) ? args[2] : 0);
+  hasResponses = true;
+
+  return 0;
+}
+
+
+int
+CompiledExpression::parseInteger(int &value)
+{
+  if (!isdigit(*pos))
+    return -1;
+
+  value = 0;
+  while (isdigit(*pos)) {
+    value = 10*value + (*pos - '0');
+    pos++;
+  }
+
+  return 0;
+}
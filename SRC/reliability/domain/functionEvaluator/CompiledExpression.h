@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+                                                                        
+//
+// Written: agent
+// Created: 10/26
+//
+// Description: CompiledExpression parses a limit-state function expression
+// once into a program for a small stack machine, so that it is evaluated
+// without the Tcl parser or interpreter variables. It handles numbers, the
+// operators + - * / **, parentheses, the Tcl math functions, $par(tag) and
+// the commands nodeDisp, nodeVel, nodeAccel and sensNodeDisp with constant
+// arguments. Parameters and nodes are looked up in the Domain when the
+// expression is evaluated. Anything else, or anything whose Tcl value would
+// differ (e.g. integer division), leaves the expression uncompiled and the
+// caller should use Tcl. The derivative with respect to a parameter is
+// evaluated alongside the value by forward differentiation.
+//
+
+#ifndef CompiledExpression_h
+#define CompiledExpression_h
+
+class Domain;
+
+class CompiledExpression
+{
+ public:
+	CompiledExpression(const char *expression, Domain *theDomain);
+	~CompiledExpression();
+
+	bool isCompiled(void) const;
+	const char *getExpression(void) const;
+
+	// both return < 0 if the value could not be found or is not finite
+	int evaluate(double &result);
+	// derivative with respect to parameter paramTag, the other parameters
+	// fixed; if explicitOnly it also fails if the expression refers to nodal
+	// responses or implicit parameters, so the result is the total derivative
+	int evaluateGradient(int paramTag, double &result, bool explicitOnly = true);
+
+ protected:
+
+ private:
+	struct Instruction {
+	  int op;
+	  double value;
+	  int tag;
+	  int dof;
+	  int paramTag;
+	};
+
+	int run(double &result, int paramTag, double *dResult, bool explicitOnly);
+
+	// recursive descent parser, each returns < 0 if the expression cannot
+	// be compiled and sets isInt for a result Tcl would hold as an integer
+	int parseSum(bool &isInt);
+	int parseProduct(bool &isInt);
+	int parsePower(bool &isInt);
+	int parseUnary(bool &isInt);
+	int parsePrimary(bool &isInt);
+	int parseCommand(void);
+	int parseInteger(int &value);
+	void skipSpace(void);
+
+	int emit(int op, double value = 0.0, int tag = 0, int dof = 0, int paramTag = 0);
+
+	char *theExpression;
+	Domain *theDomain;
+
+	Instruction *program;
+	int numInstructions;
+	int sizeProgram;
+	int depth;
+	int maxDepth;
+
+	bool compiled;
+	bool hasResponses;
+
+	const char *pos;    // position of the parser
+
+	double *values;
+	double *derivatives;
+};
+
+#endif
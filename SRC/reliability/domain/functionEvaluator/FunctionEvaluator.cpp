@@ -107,6 +107,13 @@ FunctionEvaluator::getResponseVariable(const char *label, int lsfTag)
 }
 
 
+int
+FunctionEvaluator::evaluateGradient(int paramTag, double &result, bool explicitOnly)
+{
+  return -1;
+}
+
+
 /*
 int 
 FunctionEvaluator::setTclRandomVariables(const Vector &x)
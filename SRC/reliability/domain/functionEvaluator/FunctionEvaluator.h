@@ -59,6 +59,10 @@ public:
 	virtual int addToExpression(const char *expression) = 0;
 	virtual double evaluateExpression(void) = 0;
 	virtual int runAnalysis(void) = 0;
+
+	// derivative of the expression with respect to parameter paramTag, if
+	// the evaluator can find it without an analysis; returns < 0 if not
+	virtual int evaluateGradient(int paramTag, double &result, bool explicitOnly = true);
 	
 	// MHS hack for reliability recorders ... set value in namespace
 	virtual int setResponseVariable(const char *label, int lsfTag,
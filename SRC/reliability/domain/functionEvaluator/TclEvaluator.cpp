@@ -33,6 +33,7 @@
 //
 
 #include <TclEvaluator.h>
+#include <CompiledExpression.h>
 #include <Vector.h>
 #include <FunctionEvaluator.h>
 #include <ReliabilityDomain.h>
@@ -53,6 +54,7 @@ TclEvaluator::TclEvaluator(Tcl_Interp *passedTclInterp,
   
 {
     theExpression = 0;
+    theCompiledExpression = 0;
     int exprLen = strlen(passed_fileName);
     fileName = new char[exprLen+1];
     strcpy(fileName,passed_fileName);
@@ -66,6 +68,7 @@ TclEvaluator::TclEvaluator(Tcl_Interp *passedTclInterp,
    theOpenSeesDomain(passedOpenSeesDomain)
 {
     theExpression = 0;
+    theCompiledExpression = 0;
     fileName = 0;
 }
 
@@ -76,6 +79,10 @@ TclEvaluator::~TclEvaluator()
     delete [] theExpression;
   if (fileName != 0)
     delete [] fileName;
+
+  std::map<std::string, CompiledExpression *>::iterator it;
+  for (it = theCompiledExpressions.begin(); it != theCompiledExpressions.end(); it++)
+    delete it->second;
 }
 
 
@@ -120,6 +127,14 @@ TclEvaluator::setExpression(const char *passedExpression)
     theExpression = new char[exprLen+1];
     strcpy(theExpression,passedExpression);
 
+    // compile the expression the first time it is seen
+    std::map<std::string, CompiledExpression *>::iterator it = theCompiledExpressions.find(theExpression);
+    if (it == theCompiledExpressions.end()) {
+        theCompiledExpression = new CompiledExpression(theExpression, theOpenSeesDomain);
+        theCompiledExpressions[theExpression] = theCompiledExpression;
+    } else
+        theCompiledExpression = it->second;
+
     return 0;
 }
 
@@ -139,6 +154,12 @@ TclEvaluator::evaluateExpression()
         opserr << "to evaluate" << endln;
         return -1;
     }
+
+    // Tcl is left to evaluate what is not compiled, and to report any error
+    if (theCompiledExpression != 0 && theCompiledExpression->evaluate(current_val) == 0) {
+        this->incrementEvaluations();
+        return current_val;
+    }
     
     if (Tcl_ExprDouble( theTclInterp, theExpression, &current_val) != TCL_OK) {
         opserr << "TclEvaluator::evaluateExpression -- expression \"" << theExpression;
@@ -151,6 +172,16 @@ TclEvaluator::evaluateExpression()
 }
 
 
+int
+TclEvaluator::evaluateGradient(int paramTag, double &result, bool explicitOnly)
+{
+    if (theCompiledExpression == 0)
+        return -1;
+
+    return theCompiledExpression->evaluateGradient(paramTag, result, explicitOnly);
+}
+
+
 int
 TclEvaluator::runAnalysis()
 {	
@@ -39,6 +39,10 @@
 #include <Domain.h>
 #include <ReliabilityDomain.h>
 #include <tcl.h>
+#include <map>
+#include <string>
+
+class CompiledExpression;
 
 
 class TclEvaluator : public FunctionEvaluator
@@ -59,6 +63,7 @@ class TclEvaluator : public FunctionEvaluator
 	
 	double evaluateExpression(void);
 	int runAnalysis(void);
+	int evaluateGradient(int paramTag, double &result, bool explicitOnly = true);
 
 	int setResponseVariable(const char *label, int lsfTag,
 				int rvTag, double value);
@@ -78,6 +83,11 @@ class TclEvaluator : public FunctionEvaluator
 	char *theExpression;
 	
 	double current_val;
+
+	// the expressions compiled so far, by their text; those the compiler
+	// does not handle are evaluated by Tcl
+	std::map<std::string, CompiledExpression *> theCompiledExpressions;
+	CompiledExpression *theCompiledExpression;
 };
 
 #endif
@@ -100,6 +100,9 @@ using std::setiosflags;
 #include <SearchWithStepSizeAndStepDirection.h>
 #include <RandomNumberGenerator.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
+#include <LatinHypercubeGenerator.h>
+#include <SobolSequenceGenerator.h>
 #include <FindCurvatures.h>
 #include <FirstPrincipalCurvature.h>
 #include <CurvaturesBySearchAlgorithm.h>
@@ -2173,10 +2176,63 @@ TclReliabilityModelBuilder_addRandomNumberGenerator(ClientData clientData, Tcl_I
 	}
 
 
+  if (argc < 2) {
+	opserr << "ERROR: want - randomNumberGenerator type <args>\n";
+	return TCL_ERROR;
+  }
+
   // GET INPUT PARAMETER (string) AND CREATE THE OBJECT
   if (strcmp(argv[1],"CStdLib") == 0) {
 	  theRandomNumberGenerator = new CStdLibRandGenerator();
   }
+  else if (strcmp(argv[1],"Philox") == 0 || strcmp(argv[1],"LatinHypercube") == 0 ||
+	   strcmp(argv[1],"LHS") == 0 || strcmp(argv[1],"Sobol") == 0) {
+
+	  // randomNumberGenerator Philox <-seed seed> <-stream stream>
+	  // randomNumberGenerator LatinHypercube numSamples <-seed seed> <-stream stream>
+	  // randomNumberGenerator Sobol <-seed seed> <-stream stream>
+	  int seed = 0;
+	  int stream = 0;
+	  int numSamples = 0;
+	  int argi = 2;
+
+	  bool isLHS = (strcmp(argv[1],"LatinHypercube") == 0 || strcmp(argv[1],"LHS") == 0);
+	  if (isLHS) {
+		  if (argc < 3 || Tcl_GetInt(interp, argv[2], &numSamples) != TCL_OK || numSamples < 1) {
+			  opserr << "ERROR: invalid numSamples, want - randomNumberGenerator LatinHypercube numSamples <-seed seed> <-stream stream>\n";
+			  return TCL_ERROR;
+		  }
+		  argi = 3;
+	  }
+
+	  while (argi < argc) {
+		  if (strcmp(argv[argi],"-seed") == 0 && argi+1 < argc) {
+			  if (Tcl_GetInt(interp, argv[argi+1], &seed) != TCL_OK) {
+				  opserr << "ERROR: invalid seed for randomNumberGenerator " << argv[1] << endln;
+				  return TCL_ERROR;
+			  }
+			  argi += 2;
+		  }
+		  else if (strcmp(argv[argi],"-stream") == 0 && argi+1 < argc) {
+			  if (Tcl_GetInt(interp, argv[argi+1], &stream) != TCL_OK) {
+				  opserr << "ERROR: invalid stream for randomNumberGenerator " << argv[1] << endln;
+				  return TCL_ERROR;
+			  }
+			  argi += 2;
+		  }
+		  else {
+			  opserr << "ERROR: unknown option " << argv[argi] << " for randomNumberGenerator " << argv[1] << endln;
+			  return TCL_ERROR;
+		  }
+	  }
+
+	  if (isLHS)
+		  theRandomNumberGenerator = new LatinHypercubeGenerator(numSamples, seed, stream);
+	  else if (strcmp(argv[1],"Sobol") == 0)
+		  theRandomNumberGenerator = new SobolSequenceGenerator(seed, stream);
+	  else
+		  theRandomNumberGenerator = new PhiloxRandGenerator(seed, stream);
+  }
   else {
 	opserr << "ERROR: unrecognized type of RandomNumberGenerator \n";
 	return TCL_ERROR;
@@ -3077,46 +3133,60 @@ TclReliabilityModelBuilder_addGradientEvaluator(ClientData clientData, Tcl_Inter
 			return TCL_ERROR;
 		}
 
-		// Possibly read perturbation factor
-		if (argc>2) {
-			int numExtras;
-			if (argc==3 || argc==4) {
-				numExtras = 1;
-			}
-			else if (argc==5) {
-				numExtras = 2;
-			}
-			else {
-				opserr << "ERROR: Wrong number of arguments to FiniteDifferenceGradient. " << endln;
-				return TCL_ERROR;
-			}
+		// gradientEvaluator FiniteDifference <-pert factor> <-check> <-central>
+		//                   <-auto relNoise> <-numProcesses n>
+		int numProcesses = 1;
+		bool central = false;
+		double noise = 0.0;
 
-			int counter = 2;
+		int counter = 2;
+		while (counter < argc) {
 
-			for (int i=1; i<=numExtras; i++) {
+			if (strcmp(argv[counter],"-pert") == 0 && counter+1 < argc) {
+				counter ++;
 
-				if (strcmp(argv[counter],"-pert") == 0) {
-					counter ++;
-
-					if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
-						opserr << "ERROR: invalid input: perturbationFactor \n";
-						return TCL_ERROR;
-					}
-					counter++;
+				if (Tcl_GetDouble(interp, argv[counter], &perturbationFactor) != TCL_OK) {
+					opserr << "ERROR: invalid input: perturbationFactor \n";
+					return TCL_ERROR;
 				}
-				else if (strcmp(argv[counter],"-check") == 0) {
-					counter++;
-					doGradientCheck = true;
+				counter++;
+			}
+			else if (strcmp(argv[counter],"-check") == 0) {
+				counter++;
+				doGradientCheck = true;
+			}
+			else if (strcmp(argv[counter],"-central") == 0) {
+				counter++;
+				central = true;
+			}
+			else if (strcmp(argv[counter],"-auto") == 0 && counter+1 < argc) {
+				counter++;
+				if (Tcl_GetDouble(interp, argv[counter], &noise) != TCL_OK || noise <= 0.0) {
+					opserr << "ERROR: invalid input: relative noise of -auto \n";
+					return TCL_ERROR;
 				}
-				else {
-					opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				counter++;
+			}
+			else if (strcmp(argv[counter],"-numProcesses") == 0 && counter+1 < argc) {
+				counter++;
+				if (Tcl_GetInt(interp, argv[counter], &numProcesses) != TCL_OK || numProcesses < 1) {
+					opserr << "ERROR: invalid input: numProcesses \n";
 					return TCL_ERROR;
 				}
+				counter++;
+			}
+			else {
+				opserr << "ERROR: Error in input to FiniteDifferenceGradient. " << endln;
+				return TCL_ERROR;
 			}
 		}
 
-		theGradientEvaluator = new FiniteDifferenceGradient(theFunctionEvaluator, theReliabilityDomain, 
-								    theStructuralDomain);
+		FiniteDifferenceGradient *theFDGradient = new FiniteDifferenceGradient(theFunctionEvaluator, theReliabilityDomain, 
+										      theStructuralDomain);
+		theFDGradient->setNumProcesses(numProcesses);
+		theFDGradient->setCentralDifferences(central);
+		theFDGradient->setAutomaticStep(noise);
+		theGradientEvaluator = theFDGradient;
 	}
 
 	else if (strcmp(argv[1],"OpenSees") == 0 || strcmp(argv[1],"Implicit") == 0) {
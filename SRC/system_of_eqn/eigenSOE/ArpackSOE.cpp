@@ -29,6 +29,7 @@
 
 #include <ArpackSOE.h>
 #include <ArpackSolver.h>
+#include <SubspaceEigenSolver.h>
 #include <Matrix.h>
 #include <Graph.h>
 #include <Vertex.h>
@@ -39,13 +40,20 @@
 #include <FEM_ObjectBroker.h>
 #include <AnalysisModel.h>
 #include <LinearSOE.h>
+#include <Domain.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
 
 
 
 ArpackSOE::ArpackSOE(double s)
 :EigenSOE(EigenSOE_TAGS_ArpackSOE),
  M(0), Msize(0), mDiagonal(false), shift(s), theModel(0), theSOE(0),
- processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0)
+ processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0),
+ keepA(false), reuseA(false), factoredA(false), factoredSOE(0),
+ domainStamp(-1), stateStamp(-1), massStamp(-1)
 {
   ArpackSolver *theSolvr = new ArpackSolver();
   this->setSolver(*theSolvr);
@@ -53,6 +61,18 @@ ArpackSOE::ArpackSOE(double s)
 }
 
 
+ArpackSOE::ArpackSOE(SubspaceEigenSolver &theSolvr, double s)
+:EigenSOE(EigenSOE_TAGS_SubspaceEigenSOE),
+ M(0), Msize(0), mDiagonal(false), shift(s), theModel(0), theSOE(0),
+ processID(-1), numChannels(0), theChannels(0), localCol(0), sizeLocal(0),
+ keepA(true), reuseA(false), factoredA(false), factoredSOE(0),
+ domainStamp(-1), stateStamp(-1), massStamp(-1)
+{
+  this->setSolver(theSolvr);
+  theSolvr.setEigenSOE(*this);
+}
+
+
 int
 ArpackSOE::getNumEqn(void) const
 {
@@ -145,6 +165,8 @@ ArpackSOE::setSize(Graph &theGraph)
   }
   */
 
+  factoredA = false;
+
   if (size != Msize && size > 0) {
 
     if (M != 0) 
@@ -188,7 +210,7 @@ ArpackSOE::addA(const Matrix &m, const ID &id, double fact)
   }
 
   // check for a quick return 
-  if (fact == 0.0)  return 0;
+  if (fact == 0.0 || reuseA == true)  return 0;
 
   return theSOE->addA(m, id, fact);
 }
@@ -201,9 +223,86 @@ ArpackSOE::zeroA(void)
     opserr << "ArpackSOE::zeroA() - no SOE set\n";
     return;
   }
+
+  reuseA = false;
+
+  Domain *theDomain = 0;
+  if (keepA == true && processID == -1 && theModel != 0)
+    theDomain = theModel->getDomainPtr();
+
+  if (theDomain != 0) {
+    int newDomainStamp = theDomain->hasDomainChanged();
+    int newStateStamp = theDomain->getStateChangeStamp();
+    int newMassStamp = theDomain->getMassChangeStamp();
+
+    // A = K - shift*M was factored by the last solve and nothing it
+    // depends on has changed, so the factored A is used again
+    if (factoredA == true && factoredSOE == theSOE &&
+	newDomainStamp == domainStamp && newStateStamp == stateStamp &&
+	newMassStamp == massStamp) {
+      reuseA = true;
+      return;
+    }
+
+    domainStamp = newDomainStamp;
+    stateStamp = newStateStamp;
+    massStamp = newMassStamp;
+  }
+
+  factoredA = false;
   return theSOE->zeroA();
 }
 
+
+int
+ArpackSOE::formA(void)
+{
+  // forms A = K - shift*M in the LinearSOE again, for when the factored
+  // A that was to be used again has been overwritten
+  if (theSOE == 0 || theModel == 0) {
+    opserr << "ArpackSOE::formA() - no SOE or AnalysisModel set\n";
+    return -1;
+  }
+
+  reuseA = false;
+  factoredA = false;
+  theSOE->zeroA();
+
+  int result = 0;
+  FE_Element *elePtr;
+  FE_EleIter &theEles = theModel->getFEs();
+  while ((elePtr = theEles()) != 0) {
+    elePtr->zeroTangent();
+    elePtr->addKtToTang(1.0);
+    if (theSOE->addA(elePtr->getTangent(0), elePtr->getID()) < 0)
+      result = -1;
+  }
+
+  if (shift != 0.0) {
+    FE_EleIter &theEles2 = theModel->getFEs();
+    while ((elePtr = theEles2()) != 0) {
+      elePtr->zeroTangent();
+      elePtr->addMtoTang(1.0);
+      if (theSOE->addA(elePtr->getTangent(0), elePtr->getID(), -shift) < 0)
+	result = -1;
+    }
+
+    DOF_Group *dofPtr;
+    DOF_GrpIter &theDofs = theModel->getDOFs();
+    while ((dofPtr = theDofs()) != 0) {
+      dofPtr->zeroTangent();
+      dofPtr->addMtoTang(1.0);
+      if (theSOE->addA(dofPtr->getTangent(0), dofPtr->getID(), -shift) < 0)
+	result = -1;
+    }
+  }
+
+  if (result < 0)
+    opserr << "ArpackSOE::formA() - failed in addA\n";
+
+  return result;
+}
+
 int 
 ArpackSOE::addM(const Matrix &m, const ID &id, double fact)
 {
@@ -382,6 +481,7 @@ int
 ArpackSOE::setLinearSOE(LinearSOE &theLinearSOE)
 {
   theSOE = &theLinearSOE;
+  factoredA = false;
   return 0;
 }
 
@@ -36,12 +36,14 @@
 
 class AnalysisModel;
 class ArpackSolver;
+class SubspaceEigenSolver;
 class LinearSOE;
 
 class ArpackSOE : public EigenSOE
 {
   public:
     ArpackSOE(double shift = 0.0);
+    ArpackSOE(SubspaceEigenSolver &theSolver, double shift = 0.0);
 
     ~ArpackSOE();
 
@@ -63,12 +65,15 @@ class ArpackSOE : public EigenSOE
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
 
     friend class ArpackSolver;
+    friend class SubspaceEigenSolver;
 
 	int checkSameInt(int);
 
   protected:
     
   private:
+    int formA(void);
+
     double *M;
     int Msize;
     bool mDiagonal;
@@ -81,6 +86,16 @@ class ArpackSOE : public EigenSOE
     Channel **theChannels;
     ID **localCol;
     ID *sizeLocal;
+
+    // if the solver keeps the factored A between calls, A is not formed
+    // again until the domain, its state or the masses have changed
+    bool keepA;
+    bool reuseA;
+    bool factoredA;
+    LinearSOE *factoredSOE;
+    int domainStamp;
+    int stateStamp;
+    int massStamp;
 };
 
 
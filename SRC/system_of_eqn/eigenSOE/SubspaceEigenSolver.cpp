@@ -0,0 +1,640 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of SubspaceEigenSolver.
+//
+// What: "@(#) SubspaceEigenSolver.cpp, revA"
+
+#include <SubspaceEigenSolver.h>
+#include <ArpackSOE.h>
+#include <LinearSOE.h>
+#include <AnalysisModel.h>
+#include <DOF_GrpIter.h>
+#include <DOF_Group.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <Channel.h>
+#include <math.h>
+#include <string.h>
+
+SubspaceEigenSolver::SubspaceEigenSolver(double tolerance, int maxIterations)
+:EigenSolver(EigenSOLVER_TAGS_SubspaceEigenSolver),
+ theSOE(0), theArpackSOE(0), tol(tolerance), maxIter(maxIterations),
+ size(0), numMode(0), numVectors(0), numConverged(0),
+ X(0), MX(0), Y(0), MY(0), Ka(0), Ma(0), Q(0), mu(0), work(0), other(0)
+{
+
+}
+
+
+SubspaceEigenSolver::~SubspaceEigenSolver()
+{
+  if (X != 0) delete [] X;
+  if (MX != 0) delete [] MX;
+  if (Y != 0) delete [] Y;
+  if (MY != 0) delete [] MY;
+  if (Ka != 0) delete [] Ka;
+  if (Ma != 0) delete [] Ma;
+  if (Q != 0) delete [] Q;
+  if (mu != 0) delete [] mu;
+  if (work != 0) delete [] work;
+  if (other != 0) delete [] other;
+}
+
+
+static double
+dot(int n, const double *a, const double *b)
+{
+  double sum = 0.0;
+  for (int i=0; i<n; i++)
+    sum += a[i]*b[i];
+  return sum;
+}
+
+
+// numbers in [-0.5, 0.5) for the starting vectors, the same on every run
+static double
+startValue(unsigned int &seed)
+{
+  seed = seed*1664525u + 1013904223u;
+  return (seed >> 8)*(1.0/16777216.0) - 0.5;
+}
+
+
+// eigenvalues d and eigenvectors V of the symmetric n x n matrix A, all
+// stored by column, by cyclic Jacobi rotations; A is overwritten
+static void
+jacobi(int n, double *A, double *V, double *d)
+{
+  for (int i=0; i<n*n; i++)
+    V[i] = 0.0;
+  for (int i=0; i<n; i++)
+    V[i*n+i] = 1.0;
+
+  for (int sweep=0; sweep<100; sweep++) {
+    double off = 0.0;
+    double diag = 0.0;
+    for (int j=0; j<n; j++) {
+      diag += A[j*n+j]*A[j*n+j];
+      for (int i=0; i<j; i++)
+	off += A[j*n+i]*A[j*n+i];
+    }
+    if (off == 0.0 || off <= 1.0e-30*diag)
+      break;
+
+    for (int p=0; p<n-1; p++) {
+      for (int q=p+1; q<n; q++) {
+	double apq = A[q*n+p];
+	if (apq == 0.0)
+	  continue;
+
+	// rotation in the p-q plane that zeroes A(p,q)
+	double theta = (A[q*n+q] - A[p*n+p])/(2.0*apq);
+	double t;
+	if (fabs(theta) > 1.0e150)
+	  t = 0.5/theta;
+	else {
+	  t = 1.0/(fabs(theta) + sqrt(theta*theta + 1.0));
+	  if (theta < 0.0)
+	    t = -t;
+	}
+	double c = 1.0/sqrt(t*t + 1.0);
+	double s = t*c;
+
+	for (int r=0; r<n; r++) {
+	  double arp = A[p*n+r];
+	  double arq = A[q*n+r];
+	  A[p*n+r] = c*arp - s*arq;
+	  A[q*n+r] = s*arp + c*arq;
+	}
+	for (int r=0; r<n; r++) {
+	  double apr = A[r*n+p];
+	  double aqr = A[r*n+q];
+	  A[r*n+p] = c*apr - s*aqr;
+	  A[r*n+q] = s*apr + c*aqr;
+	}
+	A[q*n+p] = 0.0;
+	A[p*n+q] = 0.0;
+
+	for (int r=0; r<n; r++) {
+	  double vrp = V[p*n+r];
+	  double vrq = V[q*n+r];
+	  V[p*n+r] = c*vrp - s*vrq;
+	  V[q*n+r] = s*vrp + c*vrq;
+	}
+      }
+    }
+  }
+
+  for (int i=0; i<n; i++)
+    d[i] = A[i*n+i];
+}
+
+
+int
+SubspaceEigenSolver::solve(int numModes, bool generalized, bool findSmallest)
+{
+  if (generalized == false) {
+    opserr << "SubspaceEigenSolver::solve() - at moment only solves generalized problem\n";
+    return -1;
+  }
+
+  if (findSmallest == false) {
+    opserr << "SubspaceEigenSolver::solve() - only finds the smallest eigenvalues\n";
+    return -1;
+  }
+
+  theSOE = theArpackSOE->theSOE;
+  if (theSOE == 0) {
+    opserr << "SubspaceEigenSolver::solve() - no LinearSOE set\n";
+    return -1;
+  }
+
+  int n = size;
+  if (numModes <= 0 || numModes > n) {
+    opserr << "SubspaceEigenSolver::solve() - " << numModes << " modes requested of a system of size " << n << endln;
+    return -1;
+  }
+
+  // the size of the subspace, as in ArpackSolver::getNCV()
+  int q = (2*numModes > numModes+8) ? numModes+8 : 2*numModes;
+  if (q > n)
+    q = n;
+
+  // the vectors of the last solve are kept as the start of this one
+  bool warmStart = (numConverged >= numModes);
+  if (this->setNumVectors(q) < 0)
+    return -1;
+
+  // if the factored A of the last solve is to be used again, check it is
+  // still what the LinearSOE holds, and form it again if it is not
+  if (theArpackSOE->reuseA == true) {
+    if (this->checkFactoredA() != 0) {
+      if (theArpackSOE->formA() < 0)
+	return -1;
+      warmStart = false;
+    }
+  }
+  theArpackSOE->factoredA = false;
+
+  unsigned int seed = 12345;
+  for (int j=numConverged; j<q; j++) {
+    double *x = &X[j*n];
+    for (int i=0; i<n; i++)
+      x[i] = startValue(seed);
+  }
+  for (int j=0; j<q; j++)
+    this->myMv(n, &X[j*n], &MX[j*n]);
+
+  bool converged = false;
+  int numKept = 0;
+  int iter = 0;
+
+  for (iter=0; iter<maxIter && converged == false; iter++) {
+
+    // Y = A^-1 M X; as A*Y = M*X the projection of A is Y'MX
+    for (int j=0; j<q; j++) {
+      double *y = &Y[j*n];
+      double *my = &MY[j*n];
+      if (this->solveA(&MX[j*n], y) < 0) {
+	numConverged = 0;
+	return -2;
+      }
+      this->myMv(n, y, my);
+      for (int i=0; i<=j; i++) {
+	Ka[j*q+i] = Ka[i*q+j] = dot(n, &Y[i*n], &MX[j*n]);
+	Ma[j*q+i] = Ma[i*q+j] = dot(n, &Y[i*n], my);
+      }
+    }
+
+    // the Ritz pairs of the last iteration have converged if mu*A^-1*M*x = x
+    if (iter > 0 || warmStart == true) {
+      converged = true;
+      for (int i=0; i<numModes && converged == true; i++) {
+	double *x = &X[i*n];
+	double *y = &Y[i*n];
+	double num = 0.0;
+	double den = 0.0;
+	for (int k=0; k<n; k++) {
+	  double r = mu[i]*y[k] - x[k];
+	  num += r*r;
+	  den += x[k]*x[k];
+	}
+	if (num > tol*tol*den)
+	  converged = false;
+      }
+      if (theArpackSOE->checkSameInt(converged == true ? 1 : 0) != 1) {
+	opserr << "SubspaceEigenSolver::solve() - processes do not agree on convergence\n";
+	numConverged = 0;
+	return -1;
+      }
+    }
+
+    // the Ritz pairs in the subspace Y
+    if (this->solveReduced(q, numKept) < 0 || numKept < numModes) {
+      opserr << "SubspaceEigenSolver::solve() - only " << numKept;
+      opserr << " independent vectors with mass found for " << numModes << " modes\n";
+      numConverged = 0;
+      return -3;
+    }
+
+    // X = Y*Q and M*X = M*Y*Q; vectors dropped as dependent are started again
+    for (int j=0; j<q; j++) {
+      double *x = &X[j*n];
+      double *mx = &MX[j*n];
+      if (j < numKept) {
+	for (int k=0; k<n; k++) {
+	  x[k] = 0.0;
+	  mx[k] = 0.0;
+	}
+	for (int i=0; i<q; i++) {
+	  double qij = Q[j*q+i];
+	  if (qij != 0.0) {
+	    double *y = &Y[i*n];
+	    double *my = &MY[i*n];
+	    for (int k=0; k<n; k++) {
+	      x[k] += qij*y[k];
+	      mx[k] += qij*my[k];
+	    }
+	  }
+	}
+      } else {
+	for (int k=0; k<n; k++)
+	  x[k] = startValue(seed);
+	this->myMv(n, x, mx);
+      }
+    }
+  }
+
+  if (converged == false) {
+    opserr << "SubspaceEigenSolver::solve() - maximum number of iterations " << maxIter;
+    opserr << " reached before convergence\n";
+  }
+
+  numMode = numModes;
+  numConverged = q;
+
+  // the LinearSOE now holds the factored A
+  theArpackSOE->factoredA = true;
+  theArpackSOE->factoredSOE = theSOE;
+
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::solveReduced(int q, int &numKept)
+{
+  double *B = work;
+  double *C = &work[q*q];
+  double *W = &work[2*q*q];
+  double *d = &work[3*q*q];
+  double *D = &work[3*q*q+q];
+
+  // scale Ma to a unit diagonal, so that vectors of very different
+  // eigenvalues are not taken as dependent, and find Ma = U S U'
+  for (int i=0; i<q; i++)
+    D[i] = (Ma[i*q+i] > 0.0) ? 1.0/sqrt(Ma[i*q+i]) : 0.0;
+  for (int j=0; j<q; j++)
+    for (int i=0; i<q; i++)
+      C[j*q+i] = D[i]*Ma[j*q+i]*D[j];
+  jacobi(q, C, B, d);
+
+  // B = U S^-1/2 of the independent directions only
+  int k = 0;
+  for (int i=0; i<q; i++) {
+    if (d[i] > 1.0e-12) {
+      double factor = 1.0/sqrt(d[i]);
+      for (int r=0; r<q; r++)
+	B[k*q+r] = B[i*q+r]*factor;
+      k++;
+    }
+  }
+
+  numKept = k;
+  if (k == 0)
+    return -1;
+
+  // the standard problem B'(D Ka D)B, k x k
+  for (int j=0; j<k; j++)
+    for (int i=0; i<q; i++) {
+      double sum = 0.0;
+      for (int r=0; r<q; r++)
+	sum += Ka[r*q+i]*D[r]*B[j*q+r];
+      W[j*q+i] = D[i]*sum;
+    }
+  for (int j=0; j<k; j++)
+    for (int i=0; i<=j; i++) {
+      double sum = 0.0;
+      for (int r=0; r<q; r++)
+	sum += B[i*q+r]*W[j*q+r] + B[j*q+r]*W[i*q+r];
+      C[j*k+i] = C[i*k+j] = 0.5*sum;
+    }
+  jacobi(k, C, W, d);
+
+  // order by distance from the shift and set Q = D B W
+  int *order = new int[k];
+  for (int i=0; i<k; i++)
+    order[i] = i;
+  for (int i=1; i<k; i++) {
+    int current = order[i];
+    int j = i;
+    while (j > 0 && fabs(d[order[j-1]]) > fabs(d[current])) {
+      order[j] = order[j-1];
+      j--;
+    }
+    order[j] = current;
+  }
+
+  for (int m=0; m<k; m++) {
+    int col = order[m];
+    mu[m] = d[col];
+    for (int i=0; i<q; i++) {
+      double sum = 0.0;
+      for (int r=0; r<k; r++)
+	sum += B[r*q+i]*W[col*k+r];
+      Q[m*q+i] = D[i]*sum;
+    }
+  }
+
+  delete [] order;
+
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::checkFactoredA(void)
+{
+  // the first vector of the last solve satisfies A^-1 M x = x/mu if the
+  // LinearSOE still holds the A it was found with
+  if (numConverged == 0 || numMode == 0 || mu[0] == 0.0)
+    return -1;
+
+  int n = size;
+  this->myMv(n, X, MY);
+  if (this->solveA(MY, Y) < 0)
+    return -1;
+
+  double num = 0.0;
+  double den = 0.0;
+  for (int k=0; k<n; k++) {
+    double r = mu[0]*Y[k] - X[k];
+    num += r*r;
+    den += X[k]*X[k];
+  }
+
+  double checkTol = 100.0*tol;
+  if (num > checkTol*checkTol*den)
+    return -1;
+
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::solveA(double *b, double *x)
+{
+  theVector.setData(b, size);
+
+  int processID = theArpackSOE->processID;
+  if (processID > 0)
+    theSOE->zeroB();
+  else
+    theSOE->setB(theVector);
+
+  if (theSOE->solve() < 0) {
+    opserr << "SubspaceEigenSolver::solve() - the LinearSOE failed in solve()\n";
+    return -1;
+  }
+
+  const Vector &theX = theSOE->getX();
+  for (int i=0; i<size; i++)
+    x[i] = theX(i);
+
+  return 0;
+}
+
+
+void
+SubspaceEigenSolver::myMv(int n, double *v, double *result)
+{
+  Vector x(v, n);
+  Vector y(result,n);
+
+  bool mDiagonal = theArpackSOE->mDiagonal;
+
+  if (mDiagonal == true) {
+
+    int Msize = theArpackSOE->Msize;
+    double *M = theArpackSOE->M;
+
+    if (n <= Msize) {
+      for (int i=0; i<n; i++)
+	result[i] = M[i]*v[i];
+    } else {
+      opserr << "SubspaceEigenSolver::myMv() n > Msize!\n";
+      return;
+    }
+
+  } else {
+
+    y.Zero();
+
+    AnalysisModel *theAnalysisModel = theArpackSOE->theModel;
+
+    // loop over the FE_Elements
+    FE_Element *elePtr;
+    FE_EleIter &theEles = theAnalysisModel->getFEs();
+    while((elePtr = theEles()) != 0) {
+      const Vector &b = elePtr->getM_Force(x, 1.0);
+      y.Assemble(b, elePtr->getID(), 1.0);
+    }
+
+    // loop over the DOF_Groups
+    DOF_Group *dofPtr;
+    DOF_GrpIter &theDofs = theAnalysisModel->getDOFs();
+    while ((dofPtr = theDofs()) != 0) {
+      const Vector &a = dofPtr->getM_Force(x,1.0);
+      y.Assemble(a, dofPtr->getID(), 1.0);
+    }
+  }
+
+  // if parallel we have to merge the results
+  int processID = theArpackSOE->processID;
+  if (processID != -1) {
+    Channel **theChannels = theArpackSOE->theChannels;
+    int numChannels = theArpackSOE->numChannels;
+    if (processID != 0) {
+      theChannels[0]->sendVector(0, 0, y);
+      theChannels[0]->recvVector(0, 0, y);
+    } else {
+      Vector otherY(other, n);
+      // recv contribution from remote & add
+      for (int i=0; i<numChannels; i++) {
+	theChannels[i]->recvVector(0,0,otherY);
+	y += otherY;
+      }
+      // send result back
+      for (int i=0; i<numChannels; i++) {
+	theChannels[i]->sendVector(0,0,y);
+      }
+    }
+  }
+}
+
+
+int
+SubspaceEigenSolver::setNumVectors(int q)
+{
+  if (q == numVectors && X != 0)
+    return 0;
+
+  int n = size;
+  int numOld = (numConverged < q) ? numConverged : q;
+
+  // keep the vectors and eigenvalues of the last solve
+  double *newX = new double[n*q];
+  double *newMu = new double[q];
+  for (int j=0; j<numOld; j++) {
+    for (int i=0; i<n; i++)
+      newX[j*n+i] = X[j*n+i];
+    newMu[j] = mu[j];
+  }
+
+  if (X != 0) delete [] X;
+  if (MX != 0) delete [] MX;
+  if (Y != 0) delete [] Y;
+  if (MY != 0) delete [] MY;
+  if (Ka != 0) delete [] Ka;
+  if (Ma != 0) delete [] Ma;
+  if (Q != 0) delete [] Q;
+  if (mu != 0) delete [] mu;
+  if (work != 0) delete [] work;
+
+  X = newX;
+  mu = newMu;
+  MX = new double[n*q];
+  Y = new double[n*q];
+  MY = new double[n*q];
+  Ka = new double[q*q];
+  Ma = new double[q*q];
+  Q = new double[q*q];
+  work = new double[3*q*q + 2*q];
+
+  if (MX == 0 || Y == 0 || MY == 0 || Ka == 0 || Ma == 0 || Q == 0 || work == 0) {
+    opserr << "SubspaceEigenSolver::setNumVectors() - out of memory for " << q << " vectors\n";
+    numVectors = 0;
+    numConverged = 0;
+    return -1;
+  }
+
+  numVectors = q;
+  numConverged = numOld;
+
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::setEigenSOE(ArpackSOE &theArpSOE)
+{
+  theArpackSOE = &theArpSOE;
+  return 0;
+}
+
+
+const Vector &
+SubspaceEigenSolver::getEigenvector(int mode)
+{
+  static Vector errVector(0);
+
+  if (mode <= 0 || mode > numMode) {
+    opserr << "SubspaceEigenSolver::getEigenvector() - mode is out of range(1 - nev)\n";
+    return errVector;
+  }
+
+  theVector.setData(&X[(mode-1)*size], size);
+
+  return theVector;
+}
+
+
+double
+SubspaceEigenSolver::getEigenvalue(int mode)
+{
+  if (mode <= 0 || mode > numMode) {
+    opserr << "SubspaceEigenSolver::getEigenvalue() - mode is out of range(1 - nev)\n";
+    return -1;
+  }
+
+  return mu[mode-1] + theArpackSOE->getShift();
+}
+
+
+int
+SubspaceEigenSolver::setSize()
+{
+  int newSize = theArpackSOE->Msize;
+
+  if (newSize != size) {
+    if (X != 0) delete [] X;
+    if (MX != 0) delete [] MX;
+    if (Y != 0) delete [] Y;
+    if (MY != 0) delete [] MY;
+    if (Ka != 0) delete [] Ka;
+    if (Ma != 0) delete [] Ma;
+    if (Q != 0) delete [] Q;
+    if (mu != 0) delete [] mu;
+    if (work != 0) delete [] work;
+    if (other != 0) delete [] other;
+    X = MX = Y = MY = Ka = Ma = Q = mu = work = other = 0;
+
+    size = newSize;
+    numVectors = 0;
+    numConverged = 0;
+    numMode = 0;
+
+    if (size > 0)
+      other = new double[size];
+  }
+
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::sendSelf(int commitTag, Channel &theChannel)
+{
+  return 0;
+}
+
+
+int
+SubspaceEigenSolver::recvSelf(int commitTag, Channel &theChannel,
+			      FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
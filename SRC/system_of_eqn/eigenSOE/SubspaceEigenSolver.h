@@ -0,0 +1,90 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SubspaceEigenSolver. SubspaceEigenSolver is an EigenSolver that works on
+// the ArpackSOE. It finds the modes by block subspace iteration on
+// (K - shift*M)^-1 M, with a Rayleigh-Ritz step on each iteration. All the
+// vectors of the block are solved for with the one factorization held by
+// the LinearSOE. The subspace of the last call is the starting subspace of
+// the next, so repeated calls on a slowly changing model converge in a few
+// iterations. If the model has not changed since the last call, the
+// factored matrix is not formed or factored again.
+//
+// What: "@(#) SubspaceEigenSolver.h, revA"
+
+#ifndef SubspaceEigenSolver_h
+#define SubspaceEigenSolver_h
+
+#include <EigenSolver.h>
+#include <ArpackSOE.h>
+
+class LinearSOE;
+
+class SubspaceEigenSolver : public EigenSolver
+{
+  public:
+    SubspaceEigenSolver(double tol = 1.0e-8, int maxIter = 200);
+    ~SubspaceEigenSolver();
+
+    int solve(int numMode, bool generalized, bool findSmallest = true);
+    int setSize(void);
+    int setEigenSOE(ArpackSOE &theSOE);
+
+    const Vector &getEigenvector(int mode);
+    double getEigenvalue(int mode);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int setNumVectors(int q);
+    int solveA(double *b, double *x);
+    int checkFactoredA(void);
+    int solveReduced(int q, int &numKept);
+    void myMv(int n, double *v, double *result);
+
+    LinearSOE *theSOE;
+    ArpackSOE *theArpackSOE;
+    double tol;
+    int maxIter;
+    int size;
+    int numMode;
+    int numVectors;        // number of vectors in the subspace
+    int numConverged;      // vectors in X from the last solve, 0 if none
+
+    double *X, *MX;        // the subspace and M times it, size x numVectors
+    double *Y, *MY;        // (K - shift*M)^-1 M X and M times it
+    double *Ka, *Ma, *Q;   // the projected problem, numVectors x numVectors
+    double *mu;            // its eigenvalues, shifted
+    double *work;          // numVectors x numVectors
+    double *other;         // size, for merging parallel products
+    Vector theVector;
+};
+
+#endif
@@ -0,0 +1,501 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// OutOfCoreSparseSPDSolver.
+//
+// What: "@(#) OutOfCoreSparseSPDSolver.cpp, revA"
+
+#include <OutOfCoreSparseSPDSolver.h>
+#include <SparseSPDLinSOE.h>
+#include <OPS_Globals.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <elementAPI.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+using std::nothrow;
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+// the least memory given to the panels of the factor, in bytes
+#define OUT_OF_CORE_MIN_WINDOW 67108864
+
+void* OPS_OutOfCoreSparseSPDSolver()
+{
+    // system SparseSPD -outOfCore <-memory MB> <-scratch dir> <-LDLT>
+    double maxMemory = 0.0;
+    const char *scratchDir = 0;
+    bool ldlt = false;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-outOfCore") == 0) {
+	    // the default for this solver
+	} else if (strcmp(opt, "-memory") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    int numdata = 1;
+	    if (OPS_GetDoubleInput(&numdata, &maxMemory) < 0 || maxMemory < 0.0) {
+		opserr << "WARNING SparseSPD -outOfCore failed to read memory\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-scratch") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    scratchDir = OPS_GetString();
+	} else if (strcmp(opt, "-LDLT") == 0 || strcmp(opt, "-ldlt") == 0) {
+	    ldlt = true;
+	} else {
+	    opserr << "WARNING SparseSPD -outOfCore unknown option " << opt << endln;
+	    return 0;
+	}
+    }
+
+    OutOfCoreSparseSPDSolver *theSolver =
+	new OutOfCoreSparseSPDSolver(maxMemory, scratchDir, ldlt);
+    return new SparseSPDLinSOE(*theSolver);
+}
+
+
+OutOfCoreSparseSPDSolver::OutOfCoreSparseSPDSolver(double maxMemory,
+						   const char *dir,
+						   bool LDLT)
+:SparseSPDLinSolver(SOLVER_TAGS_OutOfCoreSparseSPDSolver),
+ ldlt(LDLT), memoryBudget(0), windowSize(0), scratchDir(0),
+ front(0), stack(0), cbStart(0), map(0), work(0), x(0),
+ theFactor(0), factorSize(0), fd(-1), mapSize(0)
+{
+    if (maxMemory > 0.0)
+	memoryBudget = (long long)(maxMemory*1048576.0);
+    else {
+#ifndef _WIN32
+	memoryBudget = (long long)sysconf(_SC_PHYS_PAGES)*sysconf(_SC_PAGESIZE)/2;
+#endif
+	if (memoryBudget <= 0)
+	    memoryBudget = (long long)4096*1048576;
+    }
+
+    if (dir == 0)
+	dir = getenv("TMPDIR");
+    if (dir == 0)
+	dir = "/tmp";
+    scratchDir = new char[strlen(dir)+1];
+    strcpy(scratchDir, dir);
+}
+
+
+OutOfCoreSparseSPDSolver::~OutOfCoreSparseSPDSolver()
+{
+    this->closeFactorStore();
+
+    if (front != 0) delete [] front;
+    if (stack != 0) delete [] stack;
+    if (cbStart != 0) delete [] cbStart;
+    if (map != 0) delete [] map;
+    if (work != 0) delete [] work;
+    if (x != 0) delete [] x;
+    if (scratchDir != 0) delete [] scratchDir;
+}
+
+
+int
+OutOfCoreSparseSPDSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    this->closeFactorStore();
+    if (front != 0) delete [] front;
+    if (stack != 0) delete [] stack;
+    if (cbStart != 0) delete [] cbStart;
+    if (map != 0) delete [] map;
+    if (work != 0) delete [] work;
+    if (x != 0) delete [] x;
+    front = 0; stack = 0; cbStart = 0; map = 0; work = 0; x = 0;
+
+    int n = theSOE->size;
+    if (theSupernodes.analyze(n, theSOE->colStartA, theSOE->rowA) < 0) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - ";
+	opserr << " symbolic factorization failed\n";
+	return -1;
+    }
+
+    int maxFront = theSupernodes.getMaxFront();
+    long long frontSize = (long long)maxFront*maxFront;
+    long long stackSize = theSupernodes.getStackSize();
+
+    front = new (nothrow) double[frontSize+1];
+    stack = new (nothrow) double[stackSize+1];
+    cbStart = new (nothrow) long long[theSupernodes.getNumSupernodes()+1];
+    map = new (nothrow) int[n+1];
+    work = new (nothrow) double[maxFront+1];
+    x = new (nothrow) double[n+1];
+    if (front == 0 || stack == 0 || cbStart == 0 || map == 0 || work == 0 || x == 0) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - ";
+	opserr << " ran out of memory for a front of " << maxFront;
+	opserr << " rows and a stack of " << (double)stackSize << " entries\n";
+	return -1;
+    }
+
+    // what is left of the budget after the work arrays is for the panels
+    long long workBytes = (frontSize + stackSize)*(long long)sizeof(double);
+    long long windowBytes = memoryBudget - workBytes;
+    if (windowBytes < OUT_OF_CORE_MIN_WINDOW) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - the front and";
+	opserr << " contribution blocks need " << (double)workBytes/1048576.0;
+	opserr << " MB of a budget of " << (double)memoryBudget/1048576.0 << " MB\n";
+	windowBytes = OUT_OF_CORE_MIN_WINDOW;
+    }
+    windowSize = windowBytes/(long long)sizeof(double);
+
+    factorSize = theSupernodes.getFactorSize();
+    return this->openFactorStore();
+}
+
+
+int
+OutOfCoreSparseSPDSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+
+    // check for quick return
+    if (n == 0)
+	return 0;
+
+    if (theSOE->factored == false) {
+	if (this->factor() < 0)
+	    return -1;
+	theSOE->factored = true;
+    }
+
+    double *B = theSOE->B;
+    double *X = theSOE->X;
+    int numSuper = theSupernodes.getNumSupernodes();
+    long long half = windowSize/2;
+
+    for (int k=0; k<n; k++)
+	x[k] = B[theSupernodes.getEquation(k)];
+
+    // forward through the panels, prefetching ahead and releasing behind
+    long long released = 0;
+    long long fetched = 0;
+    for (int s=0; s<numSuper; s++) {
+	long long start = theSupernodes.getPanelStart(s);
+	long long end = theSupernodes.getPanelStart(s+1);
+	if (end + half/2 > fetched && fetched < factorSize) {
+	    long long to = (end + half < factorSize) ? end + half : factorSize;
+	    this->prefetchFactor(fetched, to);
+	    fetched = to;
+	}
+	theSupernodes.forwardSolve(s, &theFactor[start], x, work, ldlt);
+	if (start - released > half) {
+	    this->releaseFactor(released, start, false);
+	    released = start;
+	}
+    }
+
+    // and back in reverse
+    released = factorSize;
+    fetched = factorSize;
+    for (int s=numSuper-1; s>=0; s--) {
+	long long start = theSupernodes.getPanelStart(s);
+	long long end = theSupernodes.getPanelStart(s+1);
+	if (start - half/2 < fetched && fetched > 0) {
+	    long long to = (start - half > 0) ? start - half : 0;
+	    this->prefetchFactor(to, fetched);
+	    fetched = to;
+	}
+	theSupernodes.backwardSolve(s, &theFactor[start], x, work, ldlt);
+	if (released - end > half) {
+	    this->releaseFactor(end, released, false);
+	    released = end;
+	}
+    }
+
+    for (int k=0; k<n; k++)
+	X[theSupernodes.getEquation(k)] = x[k];
+
+    return 0;
+}
+
+
+int
+OutOfCoreSparseSPDSolver::factor(void)
+{
+    this->clearFactorStore();
+
+    double *A = theSOE->A;
+    int numSuper = theSupernodes.getNumSupernodes();
+    long long top = 0;
+    long long released = 0;
+
+    // the supernodes are in postorder, so the contribution blocks of the
+    // children of s are the last ones on the stack, that of the first
+    // child at the bottom, and the one of s replaces them
+    for (int s=0; s<numSuper; s++) {
+	theSupernodes.assembleFront(s, A, front, map);
+
+	int numChildren = theSupernodes.getNumChildren(s);
+	for (int i=0; i<numChildren; i++) {
+	    int child = theSupernodes.getChild(s, i);
+	    theSupernodes.extendAdd(s, child, &stack[cbStart[child]], front, map);
+	}
+	if (numChildren > 0)
+	    top = cbStart[theSupernodes.getChild(s, 0)];
+
+	int res = theSupernodes.factorFront(s, front, ldlt);
+	if (res != 0) {
+	    opserr << "WARNING OutOfCoreSparseSPDSolver::solve() - ";
+	    if (ldlt == false)
+		opserr << "matrix not positive definite, ";
+	    else
+		opserr << "zero pivot, ";
+	    opserr << "factorization failed at equation ";
+	    opserr << theSupernodes.getEquation(res-1) << endln;
+	    return -2;
+	}
+
+	long long start = theSupernodes.getPanelStart(s);
+	long long end = theSupernodes.getPanelStart(s+1);
+	memcpy(&theFactor[start], front, (end-start)*sizeof(double));
+	this->startWriteBack(start, end);
+
+	// once the budget is used the oldest half of the panels in memory
+	// is written out and released
+	if (end - released > windowSize) {
+	    long long to = end - windowSize/2;
+	    this->releaseFactor(released, to, true);
+	    released = to;
+	}
+
+	cbStart[s] = top;
+	theSupernodes.getContribution(s, front, &stack[top]);
+	top += theSupernodes.getContributionSize(s);
+    }
+
+    return 0;
+}
+
+
+int
+OutOfCoreSparseSPDSolver::openFactorStore(void)
+{
+    long long numBytes = (factorSize+1)*(long long)sizeof(double);
+
+#ifndef _WIN32
+    if (factorSize > windowSize) {
+	int length = strlen(scratchDir);
+	char *fileName = new char[length+32];
+	strcpy(fileName, scratchDir);
+	strcpy(&fileName[length], "/OpenSeesFactorXXXXXX");
+
+	// the file is unlinked straight away, so that it goes when closed
+	fd = mkstemp(fileName);
+	if (fd >= 0)
+	    unlink(fileName);
+	delete [] fileName;
+
+	if (fd < 0 || ftruncate(fd, numBytes) != 0) {
+	    opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - could not";
+	    opserr << " create a scratch file of " << (double)numBytes/1048576.0;
+	    opserr << " MB in " << scratchDir << endln;
+	    this->closeFactorStore();
+	    return -1;
+	}
+
+	void *theAddress = mmap(0, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (theAddress == MAP_FAILED) {
+	    opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - could not";
+	    opserr << " map the scratch file\n";
+	    this->closeFactorStore();
+	    return -1;
+	}
+	mapSize = numBytes;
+	theFactor = (double *)theAddress;
+	madvise(theAddress, mapSize, MADV_SEQUENTIAL);
+	return 0;
+    }
+#else
+    if (factorSize > windowSize) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - the factor of ";
+	opserr << (double)numBytes/1048576.0 << " MB is kept in memory,";
+	opserr << " scratch files are not supported on Windows\n";
+    }
+#endif
+
+    theFactor = new (nothrow) double[factorSize+1];
+    if (theFactor == 0) {
+	opserr << "WARNING OutOfCoreSparseSPDSolver::setSize() - ";
+	opserr << " ran out of memory for a factor of " << (double)factorSize;
+	opserr << " entries\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+
+void
+OutOfCoreSparseSPDSolver::closeFactorStore(void)
+{
+#ifndef _WIN32
+    if (fd >= 0) {
+	if (theFactor != 0)
+	    munmap(theFactor, mapSize);
+	close(fd);
+	theFactor = 0;
+    }
+#endif
+    if (theFactor != 0)
+	delete [] theFactor;
+
+    theFactor = 0;
+    fd = -1;
+    mapSize = 0;
+}
+
+
+void
+OutOfCoreSparseSPDSolver::clearFactorStore(void)
+{
+#ifndef _WIN32
+    // the old factor is not read back when the panels are overwritten:
+    // cutting the file drops its pages, and extending it again leaves a
+    // hole that reads as zeros until written
+    if (fd >= 0) {
+	if (ftruncate(fd, 0) != 0 || ftruncate(fd, mapSize) != 0) {
+	    opserr << "WARNING OutOfCoreSparseSPDSolver::solve() - ";
+	    opserr << " could not clear the scratch file\n";
+	}
+    }
+#endif
+}
+
+
+void
+OutOfCoreSparseSPDSolver::startWriteBack(long long first, long long last)
+{
+#ifndef _WIN32
+    if (fd < 0)
+	return;
+
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    long long begin = first*(long long)sizeof(double);
+    long long end = last*(long long)sizeof(double);
+    begin -= begin % pageSize;
+    if (end <= begin)
+	return;
+
+#ifdef __linux__
+    sync_file_range(fd, begin, end-begin, SYNC_FILE_RANGE_WRITE);
+#else
+    msync((char *)theFactor + begin, end-begin, MS_ASYNC);
+#endif
+#endif
+}
+
+
+void
+OutOfCoreSparseSPDSolver::releaseFactor(long long first, long long last,
+					bool written)
+{
+#ifndef _WIN32
+    if (fd < 0)
+	return;
+
+    // only whole pages are released, those shared with the panels kept
+    // stay in memory
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    long long begin = first*(long long)sizeof(double);
+    long long end = last*(long long)sizeof(double);
+    begin += (pageSize - begin % pageSize) % pageSize;
+    end -= end % pageSize;
+    if (end <= begin)
+	return;
+
+    char *address = (char *)theFactor + begin;
+    if (written == true) {
+#ifdef __linux__
+	sync_file_range(fd, begin, end-begin, SYNC_FILE_RANGE_WAIT_BEFORE |
+			SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+#else
+	msync(address, end-begin, MS_SYNC);
+#endif
+    }
+
+    madvise(address, end-begin, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd, begin, end-begin, POSIX_FADV_DONTNEED);
+#endif
+#endif
+}
+
+
+void
+OutOfCoreSparseSPDSolver::prefetchFactor(long long first, long long last)
+{
+#ifndef _WIN32
+    if (fd < 0)
+	return;
+
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    long long begin = first*(long long)sizeof(double);
+    long long end = last*(long long)sizeof(double);
+    begin -= begin % pageSize;
+    if (end <= begin)
+	return;
+
+    madvise((char *)theFactor + begin, end-begin, MADV_WILLNEED);
+#endif
+}
+
+
+int
+OutOfCoreSparseSPDSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+OutOfCoreSparseSPDSolver::recvSelf(int cTag,
+				   Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
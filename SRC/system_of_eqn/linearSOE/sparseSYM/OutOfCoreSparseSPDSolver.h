@@ -0,0 +1,97 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+#ifndef OutOfCoreSparseSPDSolver_h
+#define OutOfCoreSparseSPDSolver_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// OutOfCoreSparseSPDSolver. OutOfCoreSparseSPDSolver is a subclass of
+// SparseSPDLinSolver. It does a multifrontal Cholesky, or LDL' without
+// pivoting, factorization of the matrix of a SparseSPDLinSOE. When the
+// factor does not fit in the memory budget its panels are written to a
+// memory mapped scratch file as they are formed: the writes of each
+// panel are started straight away and the pages of the panels already
+// written are released once the budget is used, and in the solves the
+// panels ahead are prefetched and those behind released. The fronts and
+// the stack of contribution blocks are always kept in memory. The
+// symbolic factorization and the scratch file are kept until the graph
+// changes, so each Newton iteration only refactors the matrix.
+//
+// What: "@(#) OutOfCoreSparseSPDSolver.h, revA"
+
+#include <SparseSPDLinSolver.h>
+#include <SparseSPDSupernodes.h>
+
+class OutOfCoreSparseSPDSolver : public SparseSPDLinSolver
+{
+  public:
+    // maxMemory in MB, 0 for half of the physical memory; scratchDir
+    // 0 for $TMPDIR or /tmp
+    OutOfCoreSparseSPDSolver(double maxMemory = 0.0,
+			     const char *scratchDir = 0,
+			     bool ldlt = false);
+    ~OutOfCoreSparseSPDSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int factor(void);
+    int openFactorStore(void);
+    void closeFactorStore(void);
+    void clearFactorStore(void);
+
+    // the operations on the pages of the scratch file holding the
+    // entries [first, last) of the factor
+    void startWriteBack(long long first, long long last);
+    void releaseFactor(long long first, long long last, bool written);
+    void prefetchFactor(long long first, long long last);
+
+    SparseSPDSupernodes theSupernodes;
+    bool ldlt;
+    long long memoryBudget;  // bytes
+    long long windowSize;    // entries of the factor kept in memory
+    char *scratchDir;
+
+    double *front;
+    double *stack;
+    long long *cbStart;      // place of each contribution block in stack
+    int *map;
+    double *work;
+    double *x;
+
+    double *theFactor;       // the panels, in memory or mapped
+    long long factorSize;    // entries of the factor
+    int fd;                  // the scratch file, -1 if in memory
+    long long mapSize;       // bytes mapped
+};
+
+#endif
@@ -0,0 +1,421 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation for SparseSPDLinSOE.
+//
+// What: "@(#) SparseSPDLinSOE.cpp, revA"
+
+#include <SparseSPDLinSOE.h>
+#include <SparseSPDLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+
+#include <stdlib.h>
+#include <math.h>
+#include <new>
+#include <algorithm>
+using std::nothrow;
+
+SparseSPDLinSOE::SparseSPDLinSOE(SparseSPDLinSolver &the_Solver)
+:LinearSOE(the_Solver, LinSOE_TAGS_SparseSPDLinSOE),
+ size(0), nnz(0), A(0), B(0), X(0), rowA(0), colStartA(0),
+ vectX(0), vectB(0),
+ Asize(0), Bsize(0),
+ factored(false)
+{
+    the_Solver.setLinearSOE(*this);
+}
+
+
+SparseSPDLinSOE::~SparseSPDLinSOE()
+{
+    if (A != 0) delete [] A;
+    if (B != 0) delete [] B;
+    if (X != 0) delete [] X;
+    if (colStartA != 0) delete [] colStartA;
+    if (rowA != 0) delete [] rowA;
+    if (vectX != 0) delete vectX;
+    if (vectB != 0) delete vectB;
+}
+
+
+int
+SparseSPDLinSOE::getNumEqn(void) const
+{
+    return size;
+}
+
+
+int
+SparseSPDLinSOE::setSize(Graph &theGraph)
+{
+    int result = 0;
+    int oldSize = size;
+    size = theGraph.getNumVertex();
+
+    // count the entries in the lower triangle, the adjacency of each
+    // vertex holds the rows above and below the diagonal
+    Vertex *theVertex;
+    int newNNZ = 0;
+    VertexIter &theVertices = theGraph.getVertices();
+    while ((theVertex = theVertices()) != 0) {
+	int col = theVertex->getTag();
+	const ID &theAdjacency = theVertex->getAdjacency();
+	newNNZ++;
+	for (int i=0; i<theAdjacency.Size(); i++)
+	    if (theAdjacency(i) > col)
+		newNNZ++;
+    }
+    nnz = newNNZ;
+
+    if (newNNZ > Asize) {
+	if (A != 0)
+	    delete [] A;
+	if (rowA != 0)
+	    delete [] rowA;
+
+	A = new (nothrow) double[newNNZ];
+	rowA = new (nothrow) int[newNNZ];
+
+	if (A == 0 || rowA == 0) {
+	    opserr << "WARNING SparseSPDLinSOE::setSize :";
+	    opserr << " ran out of memory for A and rowA with nnz = ";
+	    opserr << newNNZ << " \n";
+	    size = 0; Asize = 0; nnz = 0;
+	    return -1;
+	}
+
+	Asize = newNNZ;
+    }
+
+    for (int i=0; i<Asize; i++)
+	A[i] = 0;
+
+    factored = false;
+
+    if (size > Bsize) {
+	if (B != 0) delete [] B;
+	if (X != 0) delete [] X;
+	if (colStartA != 0) delete [] colStartA;
+
+	B = new (nothrow) double[size];
+	X = new (nothrow) double[size];
+	colStartA = new (nothrow) int[size+1];
+
+	if (B == 0 || X == 0 || colStartA == 0) {
+	    opserr << "WARNING SparseSPDLinSOE::setSize :";
+	    opserr << " ran out of memory for vectors (size) (";
+	    opserr << size << ") \n";
+	    size = 0; Bsize = 0;
+	    return -1;
+	}
+	else
+	    Bsize = size;
+    }
+
+    for (int j=0; j<size; j++) {
+	B[j] = 0;
+	X[j] = 0;
+    }
+
+    if (size != oldSize) {
+	if (vectX != 0)
+	    delete vectX;
+
+	if (vectB != 0)
+	    delete vectB;
+
+	vectX = new Vector(X,size);
+	vectB = new Vector(B,size);
+    }
+
+    // fill in colStartA and rowA, diagonal first and then the rows
+    // below it in increasing order
+    if (size != 0) {
+	colStartA[0] = 0;
+	int lastLoc = 0;
+	for (int a=0; a<size; a++) {
+	    theVertex = theGraph.getVertexPtr(a);
+	    if (theVertex == 0) {
+		opserr << "WARNING:SparseSPDLinSOE::setSize :";
+		opserr << " vertex " << a << " not in graph! - size set to 0\n";
+		size = 0;
+		return -1;
+	    }
+
+	    rowA[lastLoc++] = a;
+	    int startLoc = lastLoc;
+	    const ID &theAdjacency = theVertex->getAdjacency();
+	    for (int i=0; i<theAdjacency.Size(); i++)
+		if (theAdjacency(i) > a)
+		    rowA[lastLoc++] = theAdjacency(i);
+
+	    std::sort(&rowA[startLoc], &rowA[lastLoc]);
+	    colStartA[a+1] = lastLoc;
+	}
+    }
+
+    // invoke setSize() on the Solver, which does the symbolic factorization
+    LinearSOESolver *the_Solver = this->getSolver();
+    int solverOK = the_Solver->setSize();
+    if (solverOK < 0) {
+	opserr << "WARNING:SparseSPDLinSOE::setSize :";
+	opserr << " solver failed setSize()\n";
+	return solverOK;
+    }
+
+    return result;
+}
+
+
+int
+SparseSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)
+	return 0;
+
+    int idSize = id.Size();
+
+    // check that m and id are of similar size
+    if (idSize != m.noRows() && idSize != m.noCols()) {
+	opserr << "SparseSPDLinSOE::addA() ";
+	opserr << " - Matrix and ID not of similar sizes\n";
+	return -1;
+    }
+
+    // only the entries in the lower triangle are added, the rows of a
+    // column are in order so the place of each is found by bisection
+    for (int i=0; i<idSize; i++) {
+	int col = id(i);
+	if (col < size && col >= 0) {
+	    int startColLoc = colStartA[col];
+	    int endColLoc = colStartA[col+1];
+	    for (int j=0; j<idSize; j++) {
+		int row = id(j);
+		if (row < size && row >= col) {
+		    int loc = startColLoc;
+		    if (row != col) {
+			int lo = startColLoc+1;
+			int hi = endColLoc-1;
+			loc = -1;
+			while (lo <= hi) {
+			    int mid = (lo+hi)/2;
+			    if (rowA[mid] < row)
+				lo = mid+1;
+			    else if (rowA[mid] > row)
+				hi = mid-1;
+			    else {
+				loc = mid;
+				break;
+			    }
+			}
+		    }
+		    if (loc >= 0) {
+			if (fact == 1.0)
+			    A[loc] += m(j,i);
+			else
+			    A[loc] += fact * m(j,i);
+		    }
+		}
+	    }
+	}
+    }
+
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    int idSize = id.Size();
+    // check that m and id are of similar size
+    if (idSize != v.Size() ) {
+	opserr << "SparseSPDLinSOE::addB() ";
+	opserr << " - Vector and ID not of similar sizes\n";
+	return -1;
+    }
+
+    if (fact == 1.0) {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i);
+	}
+    } else if (fact == -1.0) {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] -= v(i);
+	}
+    } else {
+	for (int i=0; i<idSize; i++) {
+	    int pos = id(i);
+	    if (pos <size && pos >= 0)
+		B[pos] += v(i) * fact;
+	}
+    }
+
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::setB(const Vector &v, double fact)
+{
+    // check for a quick return
+    if (fact == 0.0)  return 0;
+
+    if (v.Size() != size) {
+	opserr << "WARNING SparseSPDLinSOE::setB() -";
+	opserr << " incomptable sizes " << size << " and " << v.Size() << endln;
+	return -1;
+    }
+
+    if (fact == 1.0) {
+	for (int i=0; i<size; i++)
+	    B[i] = v(i);
+    } else if (fact == -1.0) {
+	for (int i=0; i<size; i++)
+	    B[i] = -v(i);
+    } else {
+	for (int i=0; i<size; i++)
+	    B[i] = v(i) * fact;
+    }
+    return 0;
+}
+
+
+void
+SparseSPDLinSOE::zeroA(void)
+{
+    double *Aptr = A;
+    for (int i=0; i<Asize; i++)
+	*Aptr++ = 0;
+
+    factored = false;
+}
+
+
+void
+SparseSPDLinSOE::zeroB(void)
+{
+    double *Bptr = B;
+    for (int i=0; i<size; i++)
+	*Bptr++ = 0;
+}
+
+
+void
+SparseSPDLinSOE::setX(int loc, double value)
+{
+    if (loc < size && loc >=0)
+	X[loc] = value;
+}
+
+
+void
+SparseSPDLinSOE::setX(const Vector &x)
+{
+    if (x.Size() == size && vectX != 0)
+	*vectX = x;
+}
+
+
+const Vector &
+SparseSPDLinSOE::getX(void)
+{
+    if (vectX == 0) {
+	opserr << "FATAL SparseSPDLinSOE::getX - vectX == 0";
+	exit(-1);
+    }
+    return *vectX;
+}
+
+
+const Vector &
+SparseSPDLinSOE::getB(void)
+{
+    if (vectB == 0) {
+	opserr << "FATAL SparseSPDLinSOE::getB - vectB == 0";
+	exit(-1);
+    }
+    return *vectB;
+}
+
+
+double
+SparseSPDLinSOE::normRHS(void)
+{
+    double norm =0.0;
+    for (int i=0; i<size; i++) {
+	double Yi = B[i];
+	norm += Yi*Yi;
+    }
+    return sqrt(norm);
+}
+
+
+int
+SparseSPDLinSOE::setSparseSPDSolver(SparseSPDLinSolver &newSolver)
+{
+    newSolver.setLinearSOE(*this);
+
+    if (size != 0) {
+	int solverOK = newSolver.setSize();
+	if (solverOK < 0) {
+	    opserr << "WARNING:SparseSPDLinSOE::setSolver :";
+	    opserr << "the new solver could not setSize() - staying with old\n";
+	    return -1;
+	}
+    }
+
+    factored = false;
+
+    return this->LinearSOE::setSolver(newSolver);
+}
+
+
+int
+SparseSPDLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+    return 0;
+}
+
+
+int
+SparseSPDLinSOE::recvSelf(int cTag, Channel &theChannel,
+			  FEM_ObjectBroker &theBroker)
+{
+    return 0;
+}
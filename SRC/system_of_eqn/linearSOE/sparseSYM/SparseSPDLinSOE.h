@@ -0,0 +1,85 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+#ifndef SparseSPDLinSOE_h
+#define SparseSPDLinSOE_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for SparseSPDLinSOE.
+// SparseSPDLinSOE is a subclass of LinearSOE. It stores the lower triangle
+// of a symmetric matrix A in compressed columns, the diagonal entry first
+// in each column and the rows in increasing order. It is solved by the
+// supernodal solvers, which do their own ordering of the equations.
+//
+// What: "@(#) SparseSPDLinSOE.h, revA"
+
+#include <LinearSOE.h>
+#include <Vector.h>
+
+class SparseSPDLinSolver;
+
+class SparseSPDLinSOE : public LinearSOE
+{
+  public:
+    SparseSPDLinSOE(SparseSPDLinSolver &theSolver);
+    ~SparseSPDLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setSparseSPDSolver(SparseSPDLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class OutOfCoreSparseSPDSolver;
+    friend class SupernodalSparseSPDSolver;
+
+  protected:
+
+  private:
+    int size;              // order of A
+    int nnz;               // number of entries in the lower triangle of A
+    double *A, *B, *X;
+    int *rowA, *colStartA; // row of each entry of A, start of each column
+    Vector *vectX;
+    Vector *vectB;
+    int Asize, Bsize;
+    bool factored;
+};
+
+#endif
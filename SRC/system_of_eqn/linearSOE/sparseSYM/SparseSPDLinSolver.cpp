@@ -0,0 +1,50 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of SparseSPDLinSolver.
+//
+// What: "@(#) SparseSPDLinSolver.cpp, revA"
+
+#include <SparseSPDLinSolver.h>
+#include <SparseSPDLinSOE.h>
+
+SparseSPDLinSolver::SparseSPDLinSolver(int theClassTag)
+:LinearSOESolver(theClassTag),
+ theSOE(0)
+{
+
+}
+
+SparseSPDLinSolver::~SparseSPDLinSolver()
+{
+
+}
+
+int
+SparseSPDLinSolver::setLinearSOE(SparseSPDLinSOE &theSparseSPDSOE)
+{
+    theSOE = &theSparseSPDSOE;
+    return 0;
+}
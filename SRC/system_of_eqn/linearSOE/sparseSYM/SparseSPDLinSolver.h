@@ -0,0 +1,54 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+#ifndef SparseSPDLinSolver_h
+#define SparseSPDLinSolver_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for SparseSPDLinSolver.
+// SparseSPDLinSolver is an abstract base class and thus no objects of it's
+// type can be instantiated. Instances of SparseSPDLinSolver are used to
+// solve a system of equations of type SparseSPDLinSOE.
+//
+// What: "@(#) SparseSPDLinSolver.h, revA"
+
+#include <LinearSOESolver.h>
+class SparseSPDLinSOE;
+
+class SparseSPDLinSolver : public LinearSOESolver
+{
+  public:
+    SparseSPDLinSolver(int classTag);
+    virtual ~SparseSPDLinSolver();
+
+    virtual int setLinearSOE(SparseSPDLinSOE &theSOE);
+
+  protected:
+    SparseSPDLinSOE *theSOE;
+
+  private:
+
+};
+
+#endif
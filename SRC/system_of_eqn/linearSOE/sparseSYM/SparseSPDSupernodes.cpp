@@ -0,0 +1,1001 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of SparseSPDSupernodes.
+//
+// What: "@(#) SparseSPDSupernodes.cpp, revA"
+
+#include <SparseSPDSupernodes.h>
+#include <OPS_Globals.h>
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <ThreadPool.h>
+
+#ifdef _WIN32
+extern "C" int MYGENMMD(int *neq, int *xadj, int *adjncy, int *invp,
+			int *perm, int *delta, int *dhead, int *qsize,
+			int *llist, int *marker, int *maxint, int *nofsub,
+			int *kdx);
+extern "C" int DPOTRF(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+extern "C" int DTRSM(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		     int *M, int *N, double *ALPHA, double *A, int *LDA,
+		     double *B, int *LDB);
+extern "C" int DGEMM(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		     double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		     double *BETA, double *C, int *LDC);
+extern "C" int DGEMV(char *TRANS, int *M, int *N, double *ALPHA, double *A,
+		     int *LDA, double *X, int *INCX, double *BETA, double *Y,
+		     int *INCY);
+extern "C" int DTRSV(char *UPLO, char *TRANS, char *DIAG, int *N, double *A,
+		     int *LDA, double *X, int *INCX);
+#define mygenmmd_ MYGENMMD
+#define dpotrf_ DPOTRF
+#define dtrsm_ DTRSM
+#define dgemm_ DGEMM
+#define dgemv_ DGEMV
+#define dtrsv_ DTRSV
+#else
+extern "C" int mygenmmd_(int *neq, int *xadj, int *adjncy, int *invp,
+			 int *perm, int *delta, int *dhead, int *qsize,
+			 int *llist, int *marker, int *maxint, int *nofsub,
+			 int *kdx);
+extern "C" int dpotrf_(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+extern "C" int dtrsm_(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		      int *M, int *N, double *ALPHA, double *A, int *LDA,
+		      double *B, int *LDB);
+extern "C" int dgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
+extern "C" int dgemv_(char *TRANS, int *M, int *N, double *ALPHA, double *A,
+		      int *LDA, double *X, int *INCX, double *BETA, double *Y,
+		      int *INCY);
+extern "C" int dtrsv_(char *UPLO, char *TRANS, char *DIAG, int *N, double *A,
+		      int *LDA, double *X, int *INCX);
+#endif
+
+// columns of the Schur complement updated by each call to dgemm_
+#define SCHUR_BLOCK_SIZE 128
+
+// the least rows below the diagonal block for the update of a front to
+// be split over threads
+#define SCHUR_MIN_THREAD_SIZE 256
+
+// minimum degree order of the graph (xadj, adjncy), numbered from 0
+// and destroyed; order[k] is the vertex at place k
+static int
+minimumDegree(int n, int *xadj, int *adjncy, int *order)
+{
+    // genmmd numbers from 1
+    int numAdj = xadj[n];
+    for (int i=0; i<=n; i++)
+	xadj[i]++;
+    for (int p=0; p<numAdj; p++)
+	adjncy[p]++;
+
+    int *winvp = new int[n+1];
+    int *wperm = new int[n+1];
+    int *dhead = new int[n+1];
+    int *qsize = new int[n+1];
+    int *llist = new int[n+1];
+    int *marker = new int[n+1];
+    int delta = 1;
+    int maxint = 99999999;
+    int nofsub = 0;
+    int kdx = 0;
+
+    mygenmmd_(&n, xadj, adjncy, winvp, wperm, &delta, dhead, qsize,
+	      llist, marker, &maxint, &nofsub, &kdx);
+
+    // check it is a permutation before using it
+    int res = 0;
+    for (int i=0; i<n; i++)
+	marker[i] = 0;
+    for (int k=0; k<n; k++) {
+	int i = wperm[k]-1;
+	if (i < 0 || i >= n || marker[i] != 0) {
+	    res = -1;
+	    break;
+	}
+	marker[i] = 1;
+	order[k] = i;
+    }
+
+    delete [] winvp;
+    delete [] wperm;
+    delete [] dhead;
+    delete [] qsize;
+    delete [] llist;
+    delete [] marker;
+
+    return res;
+}
+
+// the level structure (xls, ls) rooted at root of the vertices with
+// part[v] == id, those reached get visit[v] = stamp; returns the number
+// of levels
+static int
+levelStructure(int root, const int *xadj, const int *adjncy,
+	       const int *part, int id, int *visit, int stamp,
+	       int *xls, int *ls)
+{
+    int numLevels = 0;
+    int size = 1;
+    int levelEnd = 0;
+    ls[0] = root;
+    visit[root] = stamp;
+
+    while (size > levelEnd) {
+	int levelBegin = levelEnd;
+	levelEnd = size;
+	xls[numLevels++] = levelBegin;
+	for (int i=levelBegin; i<levelEnd; i++) {
+	    int v = ls[i];
+	    for (int p=xadj[v]; p<xadj[v+1]; p++) {
+		int w = adjncy[p];
+		if (part[w] == id && visit[w] != stamp) {
+		    visit[w] = stamp;
+		    ls[size++] = w;
+		}
+	    }
+	}
+    }
+    xls[numLevels] = size;
+
+    return numLevels;
+}
+
+// elimination tree of the matrix with the rows (rowListStart, rowList)
+// below the diagonal, by path compression
+static void
+eliminationTree(int n, const int *rowListStart, const int *rowList,
+		int *parent, int *ancestor)
+{
+    for (int k=0; k<n; k++) {
+	parent[k] = -1;
+	ancestor[k] = -1;
+	for (int p=rowListStart[k]; p<rowListStart[k+1]; p++) {
+	    int j = rowList[p];
+	    while (j != -1 && j < k) {
+		int next = ancestor[j];
+		ancestor[j] = k;
+		if (next == -1)
+		    parent[j] = k;
+		j = next;
+	    }
+	}
+    }
+}
+
+// postorder of a forest, the children of a node visited in order
+static void
+postorderTree(int n, const int *parent, int *post, int *work)
+{
+    int *head = work;
+    int *next = &work[n];
+    int *stack = &work[2*n];
+
+    for (int j=0; j<n; j++)
+	head[j] = -1;
+    for (int j=n-1; j>=0; j--)
+	if (parent[j] != -1) {
+	    next[j] = head[parent[j]];
+	    head[parent[j]] = j;
+	}
+
+    int k = 0;
+    for (int root=0; root<n; root++) {
+	if (parent[root] != -1)
+	    continue;
+	int top = 0;
+	stack[0] = root;
+	while (top >= 0) {
+	    int j = stack[top];
+	    int child = head[j];
+	    if (child == -1) {
+		post[k++] = j;
+		top--;
+	    } else {
+		head[j] = next[child];
+		stack[++top] = child;
+	    }
+	}
+    }
+}
+
+
+SparseSPDSupernodes::SparseSPDSupernodes()
+:numEqn(0), perm(0), invp(0),
+ permColStart(0), permRow(0), permSrc(0),
+ numSuper(0), superStart(0), superParent(0), childStart(0), childList(0),
+ rowStart(0), rowIndex(0), panelStart(0),
+ maxFront(0), stackSize(0)
+{
+
+}
+
+
+SparseSPDSupernodes::~SparseSPDSupernodes()
+{
+    this->clear();
+}
+
+
+void
+SparseSPDSupernodes::clear(void)
+{
+    if (perm != 0) delete [] perm;
+    if (invp != 0) delete [] invp;
+    if (permColStart != 0) delete [] permColStart;
+    if (permRow != 0) delete [] permRow;
+    if (permSrc != 0) delete [] permSrc;
+    if (superStart != 0) delete [] superStart;
+    if (superParent != 0) delete [] superParent;
+    if (childStart != 0) delete [] childStart;
+    if (childList != 0) delete [] childList;
+    if (rowStart != 0) delete [] rowStart;
+    if (rowIndex != 0) delete [] rowIndex;
+    if (panelStart != 0) delete [] panelStart;
+
+    perm = 0; invp = 0;
+    permColStart = 0; permRow = 0; permSrc = 0;
+    superStart = 0; superParent = 0; childStart = 0; childList = 0;
+    rowStart = 0; rowIndex = 0; panelStart = 0;
+    numEqn = 0;
+    numSuper = 0;
+    maxFront = 0;
+    stackSize = 0;
+}
+
+
+int
+SparseSPDSupernodes::analyze(int n, const int *colStartA, const int *rowA,
+			     int ordering)
+{
+    this->clear();
+
+    numEqn = n;
+    perm = new int[n+1];
+    invp = new int[n+1];
+
+    // the adjacency of the equations, both triangles without the diagonal
+    int *xadj = new int[n+1];
+    int *fill = new int[n+1];
+    for (int i=0; i<=n; i++)
+	xadj[i] = 0;
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++)
+	    if (rowA[p] != c) {
+		xadj[rowA[p]+1]++;
+		xadj[c+1]++;
+	    }
+    for (int i=0; i<n; i++) {
+	xadj[i+1] += xadj[i];
+	fill[i] = xadj[i];
+    }
+
+    int *adjncy = new int[xadj[n]+1];
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++) {
+	    int r = rowA[p];
+	    if (r != c) {
+		adjncy[fill[r]++] = c;
+		adjncy[fill[c]++] = r;
+	    }
+	}
+
+    int res = 0;
+    if (ordering == SPARSE_SPD_ORDER_ND)
+	res = this->orderND(xadj, adjncy);
+    else
+	res = this->orderMMD(xadj, adjncy);
+    delete [] adjncy;
+    delete [] xadj;
+    delete [] fill;
+    if (res < 0) {
+	this->clear();
+	return res;
+    }
+
+    // the elimination tree in that order, then postordered, which does
+    // not change the fill but makes the columns of a supernode and the
+    // supernodes of a subtree consecutive
+    int nnzA = colStartA[n];
+    int *rowListStart = new int[n+1];
+    int *rowList = new int[nnzA+1];
+    int *parent = new int[n+1];
+    int *work = new int[3*n+1];
+    int *post = new int[n+1];
+
+    this->formRowLists(colStartA, rowA, rowListStart, rowList);
+    eliminationTree(n, rowListStart, rowList, parent, work);
+    postorderTree(n, parent, post, work);
+
+    for (int k=0; k<n; k++)
+	work[k] = perm[post[k]];
+    for (int k=0; k<n; k++) {
+	perm[k] = work[k];
+	invp[perm[k]] = k;
+    }
+
+    this->formRowLists(colStartA, rowA, rowListStart, rowList);
+    eliminationTree(n, rowListStart, rowList, parent, work);
+
+    // the number of entries in each column of the factor, from the row
+    // subtrees: the entries in row k are at the nodes on the paths up
+    // the tree from the entries of A in row k
+    int *count = post;
+    int *mark = work;
+    for (int j=0; j<n; j++) {
+	count[j] = 1;
+	mark[j] = -1;
+    }
+    for (int k=0; k<n; k++) {
+	mark[k] = k;
+	for (int p=rowListStart[k]; p<rowListStart[k+1]; p++) {
+	    int j = rowList[p];
+	    while (j != -1 && mark[j] != k) {
+		count[j]++;
+		mark[j] = k;
+		j = parent[j];
+	    }
+	}
+    }
+
+    delete [] rowListStart;
+    delete [] rowList;
+
+    // the lower triangle of A in the order of the factor
+    permColStart = new int[n+1];
+    permRow = new int[nnzA+1];
+    permSrc = new int[nnzA+1];
+    for (int i=0; i<=n; i++)
+	permColStart[i] = 0;
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[c];
+	    permColStart[(a < b ? a : b)+1]++;
+	}
+    for (int i=0; i<n; i++)
+	permColStart[i+1] += permColStart[i];
+
+    int *next = &work[n];
+    for (int i=0; i<n; i++)
+	next[i] = permColStart[i];
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[c];
+	    int col = (a < b) ? a : b;
+	    int loc = next[col]++;
+	    permRow[loc] = (a < b) ? b : a;
+	    permSrc[loc] = p;
+	}
+
+    // the supernodes, column j-1 joins column j if j is its parent and
+    // its rows below the diagonal are those of j
+    superStart = new int[n+1];
+    numSuper = 0;
+    if (n > 0) {
+	superStart[0] = 0;
+	for (int j=1; j<n; j++)
+	    if (parent[j-1] != j || count[j-1] != count[j]+1)
+		superStart[++numSuper] = j;
+	superStart[++numSuper] = n;
+    }
+
+    int *colToSuper = &work[2*n];
+    for (int s=0; s<numSuper; s++)
+	for (int j=superStart[s]; j<superStart[s+1]; j++)
+	    colToSuper[j] = s;
+
+    superParent = new int[numSuper+1];
+    childStart = new int[numSuper+2];
+    childList = new int[numSuper+1];
+    for (int s=0; s<=numSuper; s++)
+	childStart[s] = 0;
+    for (int s=0; s<numSuper; s++) {
+	int p = parent[superStart[s+1]-1];
+	superParent[s] = (p == -1) ? -1 : colToSuper[p];
+	if (p != -1)
+	    childStart[superParent[s]+1]++;
+    }
+    for (int s=0; s<numSuper; s++) {
+	childStart[s+1] += childStart[s];
+	next[s] = childStart[s];
+    }
+    for (int s=0; s<numSuper; s++)
+	if (superParent[s] != -1)
+	    childList[next[superParent[s]]++] = s;
+
+    // the rows of each supernode: its columns, the rows of A in its
+    // columns and the rows of the contribution blocks of its children
+    rowStart = new int[numSuper+1];
+    rowStart[0] = 0;
+    maxFront = 0;
+    for (int s=0; s<numSuper; s++) {
+	int m = count[superStart[s]];
+	rowStart[s+1] = rowStart[s] + m;
+	if (m > maxFront)
+	    maxFront = m;
+    }
+
+    rowIndex = new int[rowStart[numSuper]+1];
+    for (int j=0; j<n; j++)
+	mark[j] = -1;
+
+    res = 0;
+    for (int s=0; s<numSuper && res == 0; s++) {
+	int first = superStart[s];
+	int last = superStart[s+1]-1;
+	int loc = rowStart[s];
+	int end = rowStart[s+1];
+	for (int j=first; j<=last; j++) {
+	    rowIndex[loc++] = j;
+	    mark[j] = s;
+	}
+	int begin = loc;
+
+	for (int j=first; j<=last && res == 0; j++)
+	    for (int p=permColStart[j]; p<permColStart[j+1]; p++) {
+		int row = permRow[p];
+		if (mark[row] != s) {
+		    if (loc == end) {
+			res = -1;
+			break;
+		    }
+		    mark[row] = s;
+		    rowIndex[loc++] = row;
+		}
+	    }
+
+	for (int i=childStart[s]; i<childStart[s+1] && res == 0; i++) {
+	    int c = childList[i];
+	    for (int p=rowStart[c]+superStart[c+1]-superStart[c]; p<rowStart[c+1]; p++) {
+		int row = rowIndex[p];
+		if (mark[row] != s) {
+		    if (loc == end) {
+			res = -1;
+			break;
+		    }
+		    mark[row] = s;
+		    rowIndex[loc++] = row;
+		}
+	    }
+	}
+
+	if (loc != end)
+	    res = -1;
+	else
+	    std::sort(&rowIndex[begin], &rowIndex[end]);
+    }
+
+    delete [] parent;
+    delete [] work;
+    delete [] post;
+
+    if (res < 0) {
+	opserr << "WARNING SparseSPDSupernodes::analyze() - the rows of the";
+	opserr << " supernodes do not match the column counts\n";
+	this->clear();
+	return -1;
+    }
+
+    // the panels of the supernodes, one after the other in order, and
+    // the largest total of contribution blocks waiting for their parent
+    // when the supernodes are factored in order
+    panelStart = new long long[numSuper+1];
+    long long *cbStart = new long long[numSuper+1];
+    panelStart[0] = 0;
+    long long top = 0;
+    for (int s=0; s<numSuper; s++) {
+	long long m = this->getNumRows(s);
+	long long k = this->getNumCols(s);
+	panelStart[s+1] = panelStart[s] + m*k;
+
+	if (childStart[s+1] > childStart[s])
+	    top = cbStart[childList[childStart[s]]];
+	cbStart[s] = top;
+	top += this->getContributionSize(s);
+	if (top > stackSize)
+	    stackSize = top;
+    }
+    delete [] cbStart;
+
+    return 0;
+}
+
+
+int
+SparseSPDSupernodes::orderMMD(int *xadj, int *adjncy)
+{
+    int n = numEqn;
+    if (n == 0)
+	return 0;
+
+    if (minimumDegree(n, xadj, adjncy, perm) < 0) {
+	opserr << "WARNING SparseSPDSupernodes::orderMMD() - ";
+	opserr << "minimum degree ordering failed\n";
+	return -1;
+    }
+
+    for (int k=0; k<n; k++)
+	invp[perm[k]] = k;
+
+    return 0;
+}
+
+
+int
+SparseSPDSupernodes::orderND(const int *xadj, const int *adjncy)
+{
+    int n = numEqn;
+    if (n == 0)
+	return 0;
+
+    // the parts still to be ordered are ranges of list on a stack; each
+    // is split into its components, or by a separator from the middle of
+    // a level structure, which takes the last places left. Small parts
+    // are ordered by minimum degree.
+    int *list = new int[n+1];
+    int *part = new int[n+1];
+    int *visit = new int[n+1];
+    int *level = new int[n+1];
+    int *ls = new int[n+1];
+    int *xls = new int[n+2];
+    int *rangeBegin = new int[n+1];
+    int *rangeEnd = new int[n+1];
+    int *local = new int[n+1];
+    int *leafXadj = new int[n+1];
+    int *leafAdj = new int[xadj[n]+1];
+    int *order = new int[n+1];
+
+    for (int i=0; i<n; i++) {
+	list[i] = i;
+	part[i] = 0;
+	visit[i] = 0;
+    }
+
+    int numRanges = 1;
+    rangeBegin[0] = 0;
+    rangeEnd[0] = n;
+    int next = n;
+    int id = 0;
+    int stamp = 0;
+    int res = 0;
+
+    while (numRanges > 0 && res == 0) {
+	numRanges--;
+	int begin = rangeBegin[numRanges];
+	int end = rangeEnd[numRanges];
+	int size = end-begin;
+
+	id++;
+	for (int i=begin; i<end; i++)
+	    part[list[i]] = id;
+
+	// the component of the first equation, and if it is not the whole
+	// part the rest is put back as a part of its own
+	int numLevels = levelStructure(list[begin], xadj, adjncy, part, id,
+				       visit, ++stamp, xls, ls);
+	int compSize = xls[numLevels];
+	if (compSize < size) {
+	    int loc = begin;
+	    for (int i=begin; i<end; i++)
+		if (visit[list[i]] != stamp)
+		    local[loc++ - begin] = list[i];
+	    for (int i=0; i<compSize; i++)
+		list[begin + size - compSize + i] = ls[i];
+	    for (int i=begin; i<loc; i++)
+		list[i] = local[i-begin];
+	    rangeBegin[numRanges] = begin;
+	    rangeEnd[numRanges++] = loc;
+	    rangeBegin[numRanges] = loc;
+	    rangeEnd[numRanges++] = end;
+	    continue;
+	}
+
+	// a few sweeps for a root at the end of a long level structure
+	for (int sweep=0; sweep<4 && size > SPARSE_SPD_ND_LEAF_SIZE; sweep++) {
+	    int root = -1;
+	    int minDegree = n+1;
+	    for (int i=xls[numLevels-1]; i<xls[numLevels]; i++) {
+		int v = ls[i];
+		int degree = 0;
+		for (int p=xadj[v]; p<xadj[v+1]; p++)
+		    if (part[adjncy[p]] == id)
+			degree++;
+		if (degree < minDegree) {
+		    minDegree = degree;
+		    root = v;
+		}
+	    }
+	    int oldRoot = ls[0];
+	    int newLevels = levelStructure(root, xadj, adjncy, part, id,
+					   visit, ++stamp, xls, ls);
+	    if (newLevels <= numLevels) {
+		if (newLevels < numLevels)
+		    numLevels = levelStructure(oldRoot, xadj, adjncy, part, id,
+					       visit, ++stamp, xls, ls);
+		break;
+	    }
+	    numLevels = newLevels;
+	}
+
+	if (size <= SPARSE_SPD_ND_LEAF_SIZE || numLevels < 3) {
+	    for (int i=0; i<size; i++)
+		local[list[begin+i]] = i;
+	    int numAdj = 0;
+	    for (int i=0; i<size; i++) {
+		int v = list[begin+i];
+		leafXadj[i] = numAdj;
+		for (int p=xadj[v]; p<xadj[v+1]; p++)
+		    if (part[adjncy[p]] == id)
+			leafAdj[numAdj++] = local[adjncy[p]];
+	    }
+	    leafXadj[size] = numAdj;
+
+	    if (minimumDegree(size, leafXadj, leafAdj, order) < 0) {
+		res = -1;
+		break;
+	    }
+	    next -= size;
+	    for (int k=0; k<size; k++)
+		perm[next+k] = list[begin+order[k]];
+	    for (int i=begin; i<end; i++)
+		part[list[i]] = -1;
+	    continue;
+	}
+
+	// the middle level holds half the equations, the separator is made
+	// of those in it next to the level after it
+	int middle = 1;
+	while (middle < numLevels-2 && xls[middle+1] < size/2)
+	    middle++;
+	for (int l=0; l<numLevels; l++)
+	    for (int i=xls[l]; i<xls[l+1]; i++)
+		level[ls[i]] = l;
+
+	int loc1 = begin;
+	int loc2 = end;
+	int numSep = 0;
+	for (int i=0; i<size; i++) {
+	    int v = ls[i];
+	    bool inSep = false;
+	    if (level[v] == middle)
+		for (int p=xadj[v]; p<xadj[v+1]; p++) {
+		    int w = adjncy[p];
+		    if (part[w] == id && level[w] == middle+1) {
+			inSep = true;
+			break;
+		    }
+		}
+	    if (inSep == true)
+		order[numSep++] = v;
+	    else if (level[v] <= middle)
+		list[loc1++] = v;
+	    else
+		list[--loc2] = v;
+	}
+
+	next -= numSep;
+	for (int k=0; k<numSep; k++) {
+	    perm[next+k] = order[k];
+	    part[order[k]] = -1;
+	}
+
+	rangeBegin[numRanges] = begin;
+	rangeEnd[numRanges++] = loc1;
+	rangeBegin[numRanges] = loc2;
+	rangeEnd[numRanges++] = end;
+    }
+
+    delete [] list;
+    delete [] part;
+    delete [] visit;
+    delete [] level;
+    delete [] ls;
+    delete [] xls;
+    delete [] rangeBegin;
+    delete [] rangeEnd;
+    delete [] local;
+    delete [] leafXadj;
+    delete [] leafAdj;
+    delete [] order;
+
+    if (res < 0 || next != 0) {
+	opserr << "WARNING SparseSPDSupernodes::orderND() - ";
+	opserr << "nested dissection ordering failed\n";
+	return -1;
+    }
+
+    for (int k=0; k<n; k++)
+	invp[perm[k]] = k;
+
+    return 0;
+}
+
+
+void
+SparseSPDSupernodes::formRowLists(const int *colStartA, const int *rowA,
+				  int *rowListStart, int *rowList) const
+{
+    // for each place k the places j < k of the entries of A in row k
+    int n = numEqn;
+    for (int i=0; i<=n; i++)
+	rowListStart[i] = 0;
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[c];
+	    if (a != b)
+		rowListStart[(a > b ? a : b)+1]++;
+	}
+    for (int i=0; i<n; i++)
+	rowListStart[i+1] += rowListStart[i];
+
+    int *next = new int[n+1];
+    for (int i=0; i<n; i++)
+	next[i] = rowListStart[i];
+    for (int c=0; c<n; c++)
+	for (int p=colStartA[c]; p<colStartA[c+1]; p++) {
+	    int a = invp[rowA[p]];
+	    int b = invp[c];
+	    if (a > b)
+		rowList[next[a]++] = b;
+	    else if (b > a)
+		rowList[next[b]++] = a;
+	}
+    delete [] next;
+}
+
+
+long long
+SparseSPDSupernodes::getContributionSize(int s) const
+{
+    // the contribution block is kept as the columns of its lower triangle
+    long long nc = this->getNumRows(s) - this->getNumCols(s);
+    return nc*(nc+1)/2;
+}
+
+
+void
+SparseSPDSupernodes::assembleFront(int s, const double *A, double *F,
+				   int *map) const
+{
+    int m = this->getNumRows(s);
+    const int *rows = &rowIndex[rowStart[s]];
+
+    for (int j=0; j<m; j++) {
+	map[rows[j]] = j;
+	memset(&F[(long long)j*m+j], 0, (m-j)*sizeof(double));
+    }
+
+    int first = superStart[s];
+    for (int j=first; j<superStart[s+1]; j++) {
+	double *Fj = &F[(long long)(j-first)*m];
+	for (int p=permColStart[j]; p<permColStart[j+1]; p++)
+	    Fj[map[permRow[p]]] += A[permSrc[p]];
+    }
+}
+
+
+void
+SparseSPDSupernodes::extendAdd(int s, int child, const double *C, double *F,
+			       const int *map) const
+{
+    long long m = this->getNumRows(s);
+    int kc = this->getNumCols(child);
+    int nc = this->getNumRows(child) - kc;
+    const int *rows = &rowIndex[rowStart[child]+kc];
+
+    // the rows of the child are in order, as are their places in F
+    for (int j=0; j<nc; j++) {
+	double *Fj = &F[map[rows[j]]*m];
+	for (int i=j; i<nc; i++)
+	    Fj[map[rows[i]]] += *C++;
+    }
+}
+
+
+int
+SparseSPDSupernodes::factorFront(int s, double *F, bool ldlt,
+				 int numThreads) const
+{
+    int m = this->getNumRows(s);
+    int k = this->getNumCols(s);
+    int m2 = m-k;
+    double *F21 = &F[k];
+    double *F22 = &F[(long long)k*m+k];
+
+    if (m2 < SCHUR_MIN_THREAD_SIZE)
+	numThreads = 1;
+
+    char L = 'L';
+    char N = 'N';
+    char T = 'T';
+    char R = 'R';
+    char diag = (ldlt == true) ? 'U' : 'N';
+    double one = 1.0;
+    double minusOne = -1.0;
+
+    if (ldlt == false) {
+	int info = 0;
+	dpotrf_(&L, &k, F, &m, &info);
+	if (info != 0)
+	    return superStart[s] + (info > 0 ? info : 1);
+
+    } else {
+	// F11 = L11 D L11', without pivoting
+	for (int j=0; j<k; j++) {
+	    double *Fj = &F[(long long)j*m];
+	    double d = Fj[j];
+	    if (d == 0.0 || d != d)
+		return superStart[s] + j + 1;
+	    for (int c=j+1; c<k; c++) {
+		double *Fc = &F[(long long)c*m];
+		double t = Fj[c]/d;
+		for (int i=c; i<k; i++)
+		    Fc[i] -= Fj[i]*t;
+	    }
+	    for (int i=j+1; i<k; i++)
+		Fj[i] /= d;
+	}
+    }
+
+    if (m2 == 0)
+	return 0;
+
+    // F21 L11'^-1, by blocks of rows; for LDL' this is L21 D, kept in W
+    // for the update, and then scaled to L21
+    double *W = F21;
+    int ldW = m;
+    if (ldlt == true) {
+	W = new double[(long long)m2*k];
+	ldW = m2;
+    }
+
+    parallelFor(m2, numThreads, [&](int begin, int end) {
+	int numRows = end-begin;
+	dtrsm_(&R, &L, &T, &diag, &numRows, &k, &one, F, &m, &F21[begin], &m);
+	if (ldlt == true)
+	    for (int j=0; j<k; j++) {
+		double *Wj = &W[(long long)j*m2];
+		double *Lj = &F21[(long long)j*m];
+		double d = F[(long long)j*m+j];
+		for (int i=begin; i<end; i++) {
+		    Wj[i] = Lj[i];
+		    Lj[i] /= d;
+		}
+	    }
+    });
+
+    // F22 = F22 - L21 W', the lower triangle by blocks of columns; over
+    // threads the columns are split in parts with the same area of the
+    // triangle, two for each thread
+    int numParts = (numThreads > 1) ? 2*numThreads : 1;
+    std::vector<int> partStart(numParts+1, m2);
+    partStart[0] = 0;
+    double area = 0.5*(double)m2*(m2+1)/numParts;
+    double sum = 0.0;
+    int part = 1;
+    for (int j=0; j<m2 && part<numParts; j++) {
+	sum += m2-j;
+	if (sum >= part*area)
+	    partStart[part++] = j+1;
+    }
+
+    parallelFor(numParts, numThreads, [&](int begin, int end) {
+	for (int jb=partStart[begin]; jb<partStart[end]; jb+=SCHUR_BLOCK_SIZE) {
+	    int nb = partStart[end]-jb;
+	    if (nb > SCHUR_BLOCK_SIZE)
+		nb = SCHUR_BLOCK_SIZE;
+	    int mb = m2-jb;
+	    dgemm_(&N, &T, &mb, &nb, &k, &minusOne, &F21[jb], &m, &W[jb], &ldW,
+		   &one, &F22[(long long)jb*m+jb], &m);
+	}
+    });
+
+    if (W != F21)
+	delete [] W;
+
+    return 0;
+}
+
+
+void
+SparseSPDSupernodes::getContribution(int s, const double *F, double *C) const
+{
+    long long m = this->getNumRows(s);
+    int k = this->getNumCols(s);
+    for (int j=k; j<m; j++) {
+	const double *Fj = &F[j*m];
+	for (int i=j; i<m; i++)
+	    *C++ = Fj[i];
+    }
+}
+
+
+void
+SparseSPDSupernodes::forwardSolve(int s, const double *L, double *x,
+				  double *work, bool ldlt) const
+{
+    int m = this->getNumRows(s);
+    int k = this->getNumCols(s);
+    int m2 = m-k;
+    double *xs = &x[superStart[s]];
+    double *Lp = (double *)L;
+
+    char Lo = 'L';
+    char N = 'N';
+    char diag = (ldlt == true) ? 'U' : 'N';
+    int inc = 1;
+    double one = 1.0;
+    double zero = 0.0;
+
+    dtrsv_(&Lo, &N, &diag, &k, Lp, &m, xs, &inc);
+
+    if (m2 > 0) {
+	dgemv_(&N, &m2, &k, &one, &Lp[k], &m, xs, &inc, &zero, work, &inc);
+	const int *rows = &rowIndex[rowStart[s]+k];
+	for (int i=0; i<m2; i++)
+	    x[rows[i]] -= work[i];
+    }
+
+    if (ldlt == true)
+	for (int j=0; j<k; j++)
+	    xs[j] /= L[(long long)j*m+j];
+}
+
+
+void
+SparseSPDSupernodes::backwardSolve(int s, const double *L, double *x,
+				   double *work, bool ldlt) const
+{
+    int m = this->getNumRows(s);
+    int k = this->getNumCols(s);
+    int m2 = m-k;
+    double *xs = &x[superStart[s]];
+    double *Lp = (double *)L;
+
+    char Lo = 'L';
+    char T = 'T';
+    char diag = (ldlt == true) ? 'U' : 'N';
+    int inc = 1;
+    double one = 1.0;
+    double minusOne = -1.0;
+
+    if (m2 > 0) {
+	const int *rows = &rowIndex[rowStart[s]+k];
+	for (int i=0; i<m2; i++)
+	    work[i] = x[rows[i]];
+	dgemv_(&T, &m2, &k, &minusOne, &Lp[k], &m, work, &inc, &one, xs, &inc);
+    }
+
+    dtrsv_(&Lo, &T, &diag, &k, Lp, &m, xs, &inc);
+}
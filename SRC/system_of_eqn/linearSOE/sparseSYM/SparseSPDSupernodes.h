@@ -0,0 +1,125 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+#ifndef SparseSPDSupernodes_h
+#define SparseSPDSupernodes_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SparseSPDSupernodes. A SparseSPDSupernodes object holds the symbolic
+// factorization of the matrix of a SparseSPDLinSOE: a fill reducing
+// order of the equations, postordered on its elimination tree, and the
+// partition of the columns of the factor into supernodes, consecutive
+// columns with the same rows below the diagonal block. It also provides
+// the operations of a multifrontal factorization on the dense front of
+// a supernode, and the forward and backward solves with its panel, the
+// m by k columns of the factor of a supernode with m rows and k columns.
+// The solvers only differ in how they order these operations and where
+// they keep the panels. The ordering is multiple minimum degree, or
+// nested dissection by level structures with the parts of fewer than
+// SPARSE_SPD_ND_LEAF_SIZE equations ordered by minimum degree.
+//
+// What: "@(#) SparseSPDSupernodes.h, revA"
+
+// the orderings, numbered as those of SymSparseLinSOE
+#define SPARSE_SPD_ORDER_MMD 1
+#define SPARSE_SPD_ORDER_ND  2
+
+#define SPARSE_SPD_ND_LEAF_SIZE 256
+
+class SparseSPDSupernodes
+{
+  public:
+    SparseSPDSupernodes();
+    ~SparseSPDSupernodes();
+
+    // the symbolic factorization of the matrix with the lower triangle
+    // (colStartA, rowA) as stored by the SparseSPDLinSOE
+    int analyze(int n, const int *colStartA, const int *rowA,
+		int ordering = SPARSE_SPD_ORDER_MMD);
+    void clear(void);
+
+    int getNumSupernodes(void) const {return numSuper;};
+    int getNumCols(int s) const {return superStart[s+1]-superStart[s];};
+    int getNumRows(int s) const {return rowStart[s+1]-rowStart[s];};
+    int getParent(int s) const {return superParent[s];};
+    int getNumChildren(int s) const {return childStart[s+1]-childStart[s];};
+    int getChild(int s, int i) const {return childList[childStart[s]+i];};
+    int getMaxFront(void) const {return maxFront;};
+    long long getPanelStart(int s) const {return panelStart[s];};
+    long long getFactorSize(void) const {return panelStart[numSuper];};
+    long long getStackSize(void) const {return stackSize;};
+    long long getContributionSize(int s) const;
+
+    // the operations on the front F, m by m, of supernode s; map is a
+    // work array of size n set by assembleFront() and used by extendAdd();
+    // factorFront() splits the update of a large front over numThreads
+    void assembleFront(int s, const double *A, double *F, int *map) const;
+    void extendAdd(int s, int child, const double *C, double *F,
+		   const int *map) const;
+    int factorFront(int s, double *F, bool ldlt, int numThreads = 1) const;
+    void getContribution(int s, const double *F, double *C) const;
+
+    // the forward and backward solves with the panel L of supernode s,
+    // x in the order of the factor; work holds at least m doubles
+    void forwardSolve(int s, const double *L, double *x, double *work,
+		      bool ldlt) const;
+    void backwardSolve(int s, const double *L, double *x, double *work,
+		       bool ldlt) const;
+
+    // place of equation i in the factor, and equation at place k
+    int getPlace(int i) const {return invp[i];};
+    int getEquation(int k) const {return perm[k];};
+
+  private:
+    int orderMMD(int *xadj, int *adjncy);
+    int orderND(const int *xadj, const int *adjncy);
+    void formRowLists(const int *colStartA, const int *rowA,
+		      int *rowListStart, int *rowList) const;
+
+    int numEqn;
+    int *perm;            // perm[k] is the equation at place k
+    int *invp;            // invp[i] is the place of equation i
+
+    // the lower triangle of A in the order of the factor: column k holds
+    // the entries of A with row and column at places k and >= k
+    int *permColStart;
+    int *permRow;
+    int *permSrc;         // location of each entry in the A of the SOE
+
+    int numSuper;
+    int *superStart;      // first column of each supernode, numSuper+1
+    int *superParent;     // parent of each supernode, -1 for a root
+    int *childStart;      // start of the children of each supernode
+    int *childList;       // children of each supernode, in order
+    int *rowStart;        // start of the rows of each supernode, numSuper+1
+    int *rowIndex;        // rows of each supernode, its columns first
+    long long *panelStart; // start of the panel of each supernode
+
+    int maxFront;         // most rows of a supernode
+    long long stackSize;  // most contribution blocks held at once when
+                          // the supernodes are visited in order
+};
+
+#endif
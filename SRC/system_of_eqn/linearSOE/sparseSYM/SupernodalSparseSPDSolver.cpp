@@ -0,0 +1,410 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of
+// SupernodalSparseSPDSolver.
+//
+// What: "@(#) SupernodalSparseSPDSolver.cpp, revA"
+
+#include <SupernodalSparseSPDSolver.h>
+#include <SparseSPDLinSOE.h>
+#include <OPS_Globals.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <elementAPI.h>
+#include <ThreadPool.h>
+
+#include <string.h>
+#include <new>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+using std::nothrow;
+
+void* OPS_SupernodalSparseSPDSolver()
+{
+    // system SparseSPD <-threads N> <-ordering MMD|ND> <-LDLT>
+    int numThreads = 1;
+    int ordering = SPARSE_SPD_ORDER_ND;
+    bool ldlt = false;
+
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-threads") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    int numdata = 1;
+	    if (OPS_GetIntInput(&numdata, &numThreads) < 0 || numThreads < 1) {
+		opserr << "WARNING SparseSPD failed to read number of threads\n";
+		return 0;
+	    }
+	} else if (strcmp(opt, "-ordering") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+	    const char *type = OPS_GetString();
+	    if (strcmp(type, "MMD") == 0 || strcmp(type, "1") == 0)
+		ordering = SPARSE_SPD_ORDER_MMD;
+	    else if (strcmp(type, "ND") == 0 || strcmp(type, "2") == 0)
+		ordering = SPARSE_SPD_ORDER_ND;
+	    else {
+		opserr << "WARNING SparseSPD unknown ordering " << type << endln;
+		return 0;
+	    }
+	} else if (strcmp(opt, "-LDLT") == 0 || strcmp(opt, "-ldlt") == 0) {
+	    ldlt = true;
+	} else {
+	    opserr << "WARNING SparseSPD unknown option " << opt << endln;
+	    return 0;
+	}
+    }
+
+    SupernodalSparseSPDSolver *theSolver =
+	new SupernodalSparseSPDSolver(numThreads, ordering, ldlt);
+    return new SparseSPDLinSOE(*theSolver);
+}
+
+
+SupernodalSparseSPDSolver::SupernodalSparseSPDSolver(int nThreads,
+						     int order,
+						     bool LDLT)
+:SparseSPDLinSolver(SOLVER_TAGS_SupernodalSparseSPDSolver),
+ numThreads(nThreads), ordering(order), ldlt(LDLT),
+ theFactor(0), contribution(0), top(0), pending(0), map(0),
+ front(0), frontSize(0), x(0), work(0)
+{
+    if (numThreads < 1)
+	numThreads = 1;
+}
+
+
+SupernodalSparseSPDSolver::~SupernodalSparseSPDSolver()
+{
+    this->clearContributions();
+
+    if (front != 0) {
+	for (int t=0; t<numThreads; t++)
+	    if (front[t] != 0)
+		delete [] front[t];
+	delete [] front;
+    }
+
+    if (theFactor != 0) delete [] theFactor;
+    if (contribution != 0) delete [] contribution;
+    if (top != 0) delete [] top;
+    if (pending != 0) delete [] pending;
+    if (map != 0) delete [] map;
+    if (frontSize != 0) delete [] frontSize;
+    if (x != 0) delete [] x;
+    if (work != 0) delete [] work;
+}
+
+
+int
+SupernodalSparseSPDSolver::setSize(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSparseSPDSolver::setSize() - ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    this->clearContributions();
+    if (front != 0) {
+	for (int t=0; t<numThreads; t++)
+	    if (front[t] != 0)
+		delete [] front[t];
+	delete [] front;
+    }
+    if (theFactor != 0) delete [] theFactor;
+    if (contribution != 0) delete [] contribution;
+    if (top != 0) delete [] top;
+    if (pending != 0) delete [] pending;
+    if (map != 0) delete [] map;
+    if (frontSize != 0) delete [] frontSize;
+    if (x != 0) delete [] x;
+    if (work != 0) delete [] work;
+    theFactor = 0; contribution = 0; top = 0; pending = 0; map = 0;
+    front = 0; frontSize = 0; x = 0; work = 0;
+
+    int n = theSOE->size;
+    if (theSupernodes.analyze(n, theSOE->colStartA, theSOE->rowA, ordering) < 0) {
+	opserr << "WARNING SupernodalSparseSPDSolver::setSize() - ";
+	opserr << " symbolic factorization failed\n";
+	return -1;
+    }
+
+    int numSuper = theSupernodes.getNumSupernodes();
+    long long factorSize = theSupernodes.getFactorSize();
+
+    theFactor = new (nothrow) double[factorSize+1];
+    contribution = new double *[numSuper+1];
+    top = new bool[numSuper+1];
+    pending = new int[numSuper+1];
+    map = new int[(long long)numThreads*(n+1)];
+    front = new double *[numThreads];
+    frontSize = new long long[numThreads];
+    x = new double[n+1];
+    work = new double[theSupernodes.getMaxFront()+1];
+
+    if (theFactor == 0) {
+	opserr << "WARNING SupernodalSparseSPDSolver::setSize() - ";
+	opserr << " ran out of memory for a factor of " << (double)factorSize;
+	opserr << " entries\n";
+	return -1;
+    }
+
+    for (int s=0; s<numSuper; s++)
+	contribution[s] = 0;
+    for (int t=0; t<numThreads; t++) {
+	front[t] = 0;
+	frontSize[t] = 0;
+    }
+
+    // the work in the subtree of each supernode, the children coming
+    // before their parent; those with more than a share of the whole
+    // are left for the threads to do together
+    double *subtreeWork = new double[numSuper+1];
+    double totalWork = 0.0;
+    for (int s=0; s<numSuper; s++)
+	subtreeWork[s] = 0.0;
+    for (int s=0; s<numSuper; s++) {
+	double m = theSupernodes.getNumRows(s);
+	double k = theSupernodes.getNumCols(s);
+	subtreeWork[s] += k*m*m;
+	int parent = theSupernodes.getParent(s);
+	if (parent != -1)
+	    subtreeWork[parent] += subtreeWork[s];
+	else
+	    totalWork += subtreeWork[s];
+    }
+    for (int s=0; s<numSuper; s++)
+	top[s] = (numThreads > 1 && subtreeWork[s] > totalWork/(2*numThreads));
+    delete [] subtreeWork;
+
+    return 0;
+}
+
+
+int
+SupernodalSparseSPDSolver::solve(void)
+{
+    if (theSOE == 0) {
+	opserr << "WARNING SupernodalSparseSPDSolver::solve(void)- ";
+	opserr << " No LinearSOE object has been set\n";
+	return -1;
+    }
+
+    int n = theSOE->size;
+
+    // check for quick return
+    if (n == 0)
+	return 0;
+
+    if (theSOE->factored == false) {
+	if (this->factor() < 0)
+	    return -1;
+	theSOE->factored = true;
+    }
+
+    double *B = theSOE->B;
+    double *X = theSOE->X;
+    int numSuper = theSupernodes.getNumSupernodes();
+
+    for (int k=0; k<n; k++)
+	x[k] = B[theSupernodes.getEquation(k)];
+
+    for (int s=0; s<numSuper; s++)
+	theSupernodes.forwardSolve(s, &theFactor[theSupernodes.getPanelStart(s)],
+				   x, work, ldlt);
+    for (int s=numSuper-1; s>=0; s--)
+	theSupernodes.backwardSolve(s, &theFactor[theSupernodes.getPanelStart(s)],
+				    x, work, ldlt);
+
+    for (int k=0; k<n; k++)
+	X[theSupernodes.getEquation(k)] = x[k];
+
+    return 0;
+}
+
+
+int
+SupernodalSparseSPDSolver::factor(void)
+{
+    int numSuper = theSupernodes.getNumSupernodes();
+
+    // the supernodes below the top are tasks, ready once their children
+    // are done; the most recently readied is taken first, so that a
+    // subtree is finished before another is started
+    std::vector<int> ready;
+    int numTasks = 0;
+    for (int s=0; s<numSuper; s++) {
+	pending[s] = theSupernodes.getNumChildren(s);
+	if (top[s] == false) {
+	    numTasks++;
+	    if (pending[s] == 0)
+		ready.push_back(s);
+	}
+    }
+
+    std::mutex theMutex;
+    std::condition_variable readyCondition;
+    int numDone = 0;
+    int failed = 0;
+
+    auto worker = [&](int thread) {
+	std::unique_lock<std::mutex> lock(theMutex);
+	while (true) {
+	    while (ready.empty() && numDone < numTasks && failed == 0)
+		readyCondition.wait(lock);
+	    if (failed != 0 || numDone == numTasks)
+		break;
+
+	    int s = ready.back();
+	    ready.pop_back();
+	    lock.unlock();
+	    int res = this->factorSupernode(s, thread, 1);
+	    lock.lock();
+
+	    if (res != 0) {
+		if (failed == 0)
+		    failed = res;
+		readyCondition.notify_all();
+		break;
+	    }
+
+	    numDone++;
+	    int parent = theSupernodes.getParent(s);
+	    if (parent != -1 && top[parent] == false && --pending[parent] == 0) {
+		ready.push_back(parent);
+		readyCondition.notify_one();
+	    }
+	    if (numDone == numTasks)
+		readyCondition.notify_all();
+	}
+    };
+
+    // a worker started after the last subtree is done simply returns
+    ThreadPool::getThreadPool().run(numThreads, numThreads, worker);
+
+    // the top of the tree, in order, each front on all the threads
+    for (int s=0; s<numSuper && failed == 0; s++)
+	if (top[s] == true)
+	    failed = this->factorSupernode(s, 0, numThreads);
+
+    if (failed != 0) {
+	this->clearContributions();
+	opserr << "WARNING SupernodalSparseSPDSolver::solve() - ";
+	if (failed < 0)
+	    opserr << "ran out of memory for a front\n";
+	else {
+	    if (ldlt == false)
+		opserr << "matrix not positive definite, ";
+	    else
+		opserr << "zero pivot, ";
+	    opserr << "factorization failed at equation ";
+	    opserr << theSupernodes.getEquation(failed-1) << endln;
+	}
+	return -2;
+    }
+
+    return 0;
+}
+
+
+int
+SupernodalSparseSPDSolver::factorSupernode(int s, int thread,
+					   int numFrontThreads)
+{
+    long long m = theSupernodes.getNumRows(s);
+    long long k = theSupernodes.getNumCols(s);
+
+    if (frontSize[thread] < m*m) {
+	if (front[thread] != 0)
+	    delete [] front[thread];
+	front[thread] = new (nothrow) double[m*m];
+	frontSize[thread] = (front[thread] != 0) ? m*m : 0;
+	if (front[thread] == 0)
+	    return -1;
+    }
+
+    double *F = front[thread];
+    int *threadMap = &map[(long long)thread*(theSOE->size+1)];
+
+    theSupernodes.assembleFront(s, theSOE->A, F, threadMap);
+
+    int numChildren = theSupernodes.getNumChildren(s);
+    for (int i=0; i<numChildren; i++) {
+	int child = theSupernodes.getChild(s, i);
+	if (contribution[child] != 0) {
+	    theSupernodes.extendAdd(s, child, contribution[child], F, threadMap);
+	    delete [] contribution[child];
+	    contribution[child] = 0;
+	}
+    }
+
+    int res = theSupernodes.factorFront(s, F, ldlt, numFrontThreads);
+    if (res != 0)
+	return res;
+
+    memcpy(&theFactor[theSupernodes.getPanelStart(s)], F, m*k*sizeof(double));
+
+    long long size = theSupernodes.getContributionSize(s);
+    if (size > 0) {
+	contribution[s] = new (nothrow) double[size];
+	if (contribution[s] == 0)
+	    return -1;
+	theSupernodes.getContribution(s, F, contribution[s]);
+    }
+
+    return 0;
+}
+
+
+void
+SupernodalSparseSPDSolver::clearContributions(void)
+{
+    if (contribution == 0)
+	return;
+
+    int numSuper = theSupernodes.getNumSupernodes();
+    for (int s=0; s<numSuper; s++)
+	if (contribution[s] != 0) {
+	    delete [] contribution[s];
+	    contribution[s] = 0;
+	}
+}
+
+
+int
+SupernodalSparseSPDSolver::sendSelf(int cTag, Channel &theChannel)
+{
+    // nothing to do
+    return 0;
+}
+
+
+int
+SupernodalSparseSPDSolver::recvSelf(int cTag,
+				    Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+    // nothing to do
+    return 0;
+}
@@ -0,0 +1,83 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+
+#ifndef SupernodalSparseSPDSolver_h
+#define SupernodalSparseSPDSolver_h
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for
+// SupernodalSparseSPDSolver. SupernodalSparseSPDSolver is a subclass of
+// SparseSPDLinSolver. It does a multifrontal supernodal Cholesky, or LDL'
+// without pivoting, factorization of the matrix of a SparseSPDLinSOE in
+// memory. The supernodes are tasks on the elimination tree: a supernode
+// is factored by the first free thread once all its children are done.
+// The few supernodes at the top of the tree, which hold most of the work
+// but leave no tasks to run beside them, are then factored one after the
+// other with the update of each front split over all the threads.
+//
+// What: "@(#) SupernodalSparseSPDSolver.h, revA"
+
+#include <SparseSPDLinSolver.h>
+#include <SparseSPDSupernodes.h>
+
+class SupernodalSparseSPDSolver : public SparseSPDLinSolver
+{
+  public:
+    SupernodalSparseSPDSolver(int numThreads = 1,
+			      int ordering = SPARSE_SPD_ORDER_ND,
+			      bool ldlt = false);
+    ~SupernodalSparseSPDSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    int factor(void);
+    int factorSupernode(int s, int thread, int numFrontThreads);
+    void clearContributions(void);
+
+    SparseSPDSupernodes theSupernodes;
+    int numThreads;
+    int ordering;
+    bool ldlt;
+
+    double *theFactor;      // the panels of the supernodes, in order
+    double **contribution;  // contribution block of each supernode,
+                            // kept until its parent is factored
+    bool *top;              // supernodes factored after the tasks
+    int *pending;           // children of each supernode not yet done
+    int *map;               // work arrays, one for each thread
+    double **front;
+    long long *frontSize;
+    double *x;
+    double *work;
+};
+
+#endif
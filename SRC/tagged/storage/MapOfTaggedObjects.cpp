@@ -77,6 +77,13 @@ MapOfTaggedObjects::addComponent(TaggedObject *newComponent)
     MAP_TAGGED_ITERATOR theEle;
     int tag = newComponent->getTag();
 
+    // components are mostly added in increasing order of tag, when the
+    // tag is larger than any in the map it goes at the end without a search
+    if (theMap.empty() || tag > theMap.rbegin()->first) {
+      theMap.insert(theMap.end(), MAP_TAGGED_TYPE(tag,newComponent));
+      return true;
+    }
+
     // check if the ele already in map, if not we add
     theEle = theMap.find(tag);
     if (theEle == theMap.end()) {
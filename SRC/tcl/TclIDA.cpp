@@ -0,0 +1,539 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the function invoked when the user
+// invokes the ida command in the interpreter. The command runs an
+// incremental dynamic analysis of the model currently in the domain:
+// a number of ground motion records, each at a number of intensity
+// scales. The model is built, and gravity run, once. For each run a
+// worker process is forked off the interpreter, so that it starts from
+// the current (post-gravity) state without the model being re-sourced;
+// it adds a UniformExcitation pattern for the record and scale, evaluates
+// the user's analysis script, which returns the engineering demand
+// parameter (EDP) of interest, and writes the EDP back to the parent.
+//
+//   ida -record file dt <-record file dt ...> -run script
+//       <-dof dir> <-pattern tag> <-factor f> <-jobs n> <-collapse edpLimit>
+//       <-scales {s1 s2 ..}>
+//       <-hunt first step <stepIncr>> <-fill n> <-maxRuns n> <-tol dS> <-maxScale s>
+//
+// With -scales every record is run at every scale (a stripe analysis);
+// runs at scales above one at which a record has collapsed are skipped.
+// With -hunt the scales of each record are found by hunt and fill: the
+// scale is increased by a growing step until collapse, the collapse
+// scale is then bracketed by bisection (-fill runs, or until the bracket
+// is smaller than -tol), and any runs left of -maxRuns fill the largest
+// gaps between the scales run. A run is a collapse if the script fails,
+// as it does when the analysis does not converge, or if the EDP is
+// greater than the -collapse limit.
+//
+// In the script the variables idaRecord (index from 0), idaFile and
+// idaScale are set. Recorders existing in the domain when ida is invoked
+// are closed first, as the runs would otherwise all write to them.
+//
+// The result is a list with an entry {record scale edp collapsed} for
+// each run, sorted by record and scale; edp is -1 for a failed run.
+//
+// What: "@(#) TclIDA.cpp, revA"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <tcl.h>
+#include <OPS_Globals.h>
+#include <Domain.h>
+#include <PathSeries.h>
+#include <GroundMotion.h>
+#include <UniformExcitation.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+// a single run of a record at a scale
+struct IDA_Run {
+  int record;
+  double scale;
+  double edp;
+  int collapsed;
+};
+
+// the hunt and fill state of a record
+struct IDA_Record {
+  const char *fileName;
+  double dt;
+  int numRuns;          // runs done or under way
+  int busy;             // a run of this record is under way
+  int done;             // no more runs to be made
+  double lastScale;     // last scale of the hunt
+  double step;          // next step of the hunt
+  double noCollapse;    // highest scale without collapse
+  double collapse;      // lowest scale with collapse, < 0 if none yet
+  int numFill;          // bisection runs made
+};
+
+static int
+compareRuns(const void *a, const void *b)
+{
+  const IDA_Run *ra = (const IDA_Run *)a;
+  const IDA_Run *rb = (const IDA_Run *)b;
+  if (ra->record != rb->record)
+    return ra->record - rb->record;
+  if (ra->scale < rb->scale)
+    return -1;
+  if (ra->scale > rb->scale)
+    return 1;
+  return 0;
+}
+
+// largest gap between the scales run without collapse for the record,
+// starting from zero; returns the mid point of the gap
+static double
+largestGap(IDA_Run *theRuns, int numRuns, int record, double upper)
+{
+  double *scales = new double[numRuns+2];
+  int n = 0;
+  scales[n++] = 0.0;
+  for (int i=0; i<numRuns; i++)
+    if (theRuns[i].record == record && theRuns[i].collapsed == 0)
+      scales[n++] = theRuns[i].scale;
+  scales[n++] = upper;
+
+  // insertion sort, the lists are short
+  for (int i=1; i<n; i++) {
+    double s = scales[i];
+    int j = i-1;
+    while (j >= 0 && scales[j] > s) {
+      scales[j+1] = scales[j];
+      j--;
+    }
+    scales[j+1] = s;
+  }
+
+  double gap = 0.0;
+  double mid = 0.0;
+  for (int i=1; i<n; i++)
+    if (scales[i]-scales[i-1] > gap) {
+      gap = scales[i]-scales[i-1];
+      mid = 0.5*(scales[i]+scales[i-1]);
+    }
+
+  delete [] scales;
+  return mid;
+}
+
+#ifndef _WIN32
+
+// invoked in the worker process; never returns
+static void
+runWorker(Tcl_Interp *interp, Domain &theDomain, IDA_Record &theRecord, IDA_Run &theRun,
+	  const char *script, int dof, int patternTag, double factor, double collapseLimit,
+	  int fd)
+{
+  char buffer[128];
+
+  sprintf(buffer, "%d", theRun.record);
+  Tcl_SetVar(interp, "idaRecord", buffer, TCL_GLOBAL_ONLY);
+  sprintf(buffer, "%.16g", theRun.scale);
+  Tcl_SetVar(interp, "idaScale", buffer, TCL_GLOBAL_ONLY);
+  Tcl_SetVar(interp, "idaFile", theRecord.fileName, TCL_GLOBAL_ONLY);
+
+  double edp = -1.0;
+  int collapsed = 1;
+
+  PathSeries *theSeries = new PathSeries(patternTag, theRecord.fileName, theRecord.dt,
+					 factor*theRun.scale);
+  GroundMotion *theMotion = new GroundMotion(0, 0, theSeries);
+  UniformExcitation *thePattern = new UniformExcitation(*theMotion, dof, patternTag);
+
+  if (theDomain.addLoadPattern(thePattern) == false)
+    opserr << "WARNING ida - could not add pattern for record " << theRecord.fileName << endln;
+
+  else if (Tcl_Eval(interp, script) != TCL_OK)
+    opserr << "WARNING ida - record " << theRecord.fileName << " at scale "
+	   << theRun.scale << " failed: " << Tcl_GetStringResult(interp) << endln;
+
+  else if (Tcl_GetDouble(interp, Tcl_GetStringResult(interp), &edp) != TCL_OK) {
+    opserr << "WARNING ida - script did not return an edp for record " << theRecord.fileName << endln;
+    edp = -1.0;
+
+  } else
+    collapsed = (collapseLimit > 0.0 && edp > collapseLimit) ? 1 : 0;
+
+  // close the recorders of the run, flushing their output
+  theDomain.removeRecorders();
+
+  sprintf(buffer, "%.16g %d\n", edp, collapsed);
+  if (write(fd, buffer, strlen(buffer)) < 0)
+    opserr << "WARNING ida - failed to return result to parent\n";
+  close(fd);
+
+  // skip the exit handlers, they belong to the parent
+  _exit(0);
+}
+
+#endif
+
+int
+TclCommand_ida(ClientData clientData, Tcl_Interp *interp, int argc,
+	       TCL_Char **argv, Domain &theDomain)
+{
+#ifdef _WIN32
+  opserr << "WARNING ida - needs fork(), which is not available on this platform\n";
+  return TCL_ERROR;
+#else
+
+  int numRecords = 0;
+  IDA_Record *theRecords = new IDA_Record[argc/3+1];
+  const char *script = 0;
+  int dof = 1;
+  int patternTag = 10000;
+  double factor = 1.0;
+  int numJobs = 1;
+  double collapseLimit = 0.0;
+  double *scales = 0;
+  int numScales = 0;
+  bool hunt = false;
+  double huntFirst = 0.1, huntStep = 0.1, huntStepIncr = 0.05;
+  int numFill = 3;
+  int maxRuns = 12;
+  double tol = 0.0;
+  double maxScale = 1.0e10;
+
+  int loc = 1;
+  while (loc < argc) {
+    if (strcmp(argv[loc],"-record") == 0 && loc+2 < argc) {
+      theRecords[numRecords].fileName = argv[loc+1];
+      if (Tcl_GetDouble(interp, argv[loc+2], &theRecords[numRecords].dt) != TCL_OK) {
+	opserr << "WARNING ida - invalid dt " << argv[loc+2] << endln;
+	delete [] theRecords;
+	return TCL_ERROR;
+      }
+      numRecords++;
+      loc += 3;
+    } else if (strcmp(argv[loc],"-run") == 0 && loc+1 < argc) {
+      script = argv[loc+1];
+      loc += 2;
+    } else if (strcmp(argv[loc],"-dof") == 0 && loc+1 < argc &&
+	       Tcl_GetInt(interp, argv[loc+1], &dof) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-pattern") == 0 && loc+1 < argc &&
+	       Tcl_GetInt(interp, argv[loc+1], &patternTag) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-factor") == 0 && loc+1 < argc &&
+	       Tcl_GetDouble(interp, argv[loc+1], &factor) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-jobs") == 0 && loc+1 < argc &&
+	       Tcl_GetInt(interp, argv[loc+1], &numJobs) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-collapse") == 0 && loc+1 < argc &&
+	       Tcl_GetDouble(interp, argv[loc+1], &collapseLimit) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-scales") == 0 && loc+1 < argc) {
+      int numArgs;
+      TCL_Char **theArgs;
+      if (Tcl_SplitList(interp, argv[loc+1], &numArgs, &theArgs) != TCL_OK) {
+	opserr << "WARNING ida - invalid list of scales\n";
+	delete [] theRecords;
+	return TCL_ERROR;
+      }
+      if (scales != 0)
+	delete [] scales;
+      scales = new double[numArgs];
+      numScales = 0;
+      for (int i=0; i<numArgs; i++)
+	if (Tcl_GetDouble(interp, theArgs[i], &scales[numScales]) == TCL_OK)
+	  numScales++;
+      Tcl_Free((char *)theArgs);
+      loc += 2;
+    } else if (strcmp(argv[loc],"-hunt") == 0 && loc+2 < argc) {
+      if (Tcl_GetDouble(interp, argv[loc+1], &huntFirst) != TCL_OK ||
+	  Tcl_GetDouble(interp, argv[loc+2], &huntStep) != TCL_OK) {
+	opserr << "WARNING ida - want -hunt first step <stepIncr>\n";
+	delete [] theRecords;
+	return TCL_ERROR;
+      }
+      hunt = true;
+      loc += 3;
+      if (loc < argc && Tcl_GetDouble(interp, argv[loc], &huntStepIncr) == TCL_OK)
+	loc++;
+    } else if (strcmp(argv[loc],"-fill") == 0 && loc+1 < argc &&
+	       Tcl_GetInt(interp, argv[loc+1], &numFill) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-maxRuns") == 0 && loc+1 < argc &&
+	       Tcl_GetInt(interp, argv[loc+1], &maxRuns) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-tol") == 0 && loc+1 < argc &&
+	       Tcl_GetDouble(interp, argv[loc+1], &tol) == TCL_OK) {
+      loc += 2;
+    } else if (strcmp(argv[loc],"-maxScale") == 0 && loc+1 < argc &&
+	       Tcl_GetDouble(interp, argv[loc+1], &maxScale) == TCL_OK) {
+      loc += 2;
+    } else {
+      opserr << "WARNING ida - unknown or incomplete option " << argv[loc] << endln;
+      opserr << "want: ida -record file dt <-record file dt ...> -run script <-dof dir> <-pattern tag>\n";
+      opserr << "      <-factor f> <-jobs n> <-collapse edpLimit> <-scales {s1 s2 ..}>\n";
+      opserr << "      <-hunt first step <stepIncr>> <-fill n> <-maxRuns n> <-tol dS> <-maxScale s>\n";
+      if (scales != 0)
+	delete [] scales;
+      delete [] theRecords;
+      return TCL_ERROR;
+    }
+  }
+
+  if (numRecords == 0 || script == 0 || (hunt == false && numScales == 0)) {
+    opserr << "WARNING ida - need at least one -record, a -run script and either -scales or -hunt\n";
+    if (scales != 0)
+      delete [] scales;
+    delete [] theRecords;
+    return TCL_ERROR;
+  }
+
+  if (numJobs < 1)
+    numJobs = 1;
+  dof--; // subtract 1 for c indexing
+
+  // the list of runs; all known up front for a stripe analysis
+  int maxNumRuns = hunt ? numRecords*maxRuns : numRecords*numScales;
+  IDA_Run *theRuns = new IDA_Run[maxNumRuns];
+  int numRuns = 0;
+
+  for (int i=0; i<numRecords; i++) {
+    IDA_Record &theRecord = theRecords[i];
+    theRecord.numRuns = 0;
+    theRecord.busy = 0;
+    theRecord.done = 0;
+    theRecord.lastScale = 0.0;
+    theRecord.step = huntStep;
+    theRecord.noCollapse = 0.0;
+    theRecord.collapse = -1.0;
+    theRecord.numFill = 0;
+  }
+
+  if (hunt == false) {
+    // all records at the lowest scale first, so collapses are found
+    // before the higher scales are dispatched
+    for (int j=0; j<numScales; j++)
+      for (int i=0; i<numRecords; i++) {
+	theRuns[numRuns].record = i;
+	theRuns[numRuns].scale = scales[j];
+	theRuns[numRuns].edp = -1.0;
+	theRuns[numRuns].collapsed = -1; // not yet run
+	numRuns++;
+      }
+  }
+
+  // the recorders of the parent would be shared by all the workers
+  theDomain.removeRecorders();
+
+  int *jobPids = new int[numJobs];
+  int *jobFds = new int[numJobs];
+  int *jobRuns = new int[numJobs];
+  for (int j=0; j<numJobs; j++)
+    jobPids[j] = -1;
+
+  int numActive = 0;
+  int nextStripeRun = 0;
+  bool forkFailed = false;
+
+  while (true) {
+
+    // dispatch runs while there are free workers
+    while (numActive < numJobs && forkFailed == false) {
+
+      int runIndex = -1;
+
+      if (hunt == false) {
+	while (nextStripeRun < numRuns && runIndex < 0) {
+	  IDA_Run &theRun = theRuns[nextStripeRun];
+	  IDA_Record &theRecord = theRecords[theRun.record];
+	  if (theRecord.collapse >= 0.0 && theRun.scale >= theRecord.collapse) {
+	    // no need to run, it collapsed at a lower scale
+	    theRun.collapsed = 1;
+	    theRun.edp = -1.0;
+	  } else
+	    runIndex = nextStripeRun;
+	  nextStripeRun++;
+	}
+
+      } else {
+	for (int i=0; i<numRecords && runIndex < 0; i++) {
+	  IDA_Record &theRecord = theRecords[i];
+	  if (theRecord.busy == 1 || theRecord.done == 1)
+	    continue;
+	  if (theRecord.numRuns >= maxRuns) {
+	    theRecord.done = 1;
+	    continue;
+	  }
+
+	  double scale;
+	  if (theRecord.numRuns == 0)
+	    scale = huntFirst;
+	  else if (theRecord.collapse < 0.0) {
+	    // hunt up
+	    scale = theRecord.lastScale + theRecord.step;
+	    theRecord.step += huntStepIncr;
+	    if (scale > maxScale) {
+	      theRecord.done = 1;
+	      continue;
+	    }
+	  } else if (theRecord.numFill < numFill &&
+		     theRecord.collapse - theRecord.noCollapse > tol) {
+	    // bracket the collapse scale
+	    scale = 0.5*(theRecord.collapse + theRecord.noCollapse);
+	    theRecord.numFill++;
+	  } else {
+	    // fill in below the collapse scale
+	    scale = largestGap(theRuns, numRuns, i, theRecord.noCollapse);
+	    if (scale <= 0.0) {
+	      theRecord.done = 1;
+	      continue;
+	    }
+	  }
+
+	  theRecord.lastScale = scale;
+	  theRuns[numRuns].record = i;
+	  theRuns[numRuns].scale = scale;
+	  theRuns[numRuns].edp = -1.0;
+	  theRuns[numRuns].collapsed = -1;
+	  runIndex = numRuns++;
+	}
+      }
+
+      if (runIndex < 0)
+	break;
+
+      IDA_Run &theRun = theRuns[runIndex];
+      IDA_Record &theRecord = theRecords[theRun.record];
+
+      int fds[2];
+      if (pipe(fds) != 0) {
+	opserr << "WARNING ida - could not create pipe for worker\n";
+	forkFailed = true;
+	break;
+      }
+
+      // flush so the worker does not write our buffered output again
+      fflush(stdout);
+      fflush(stderr);
+
+      pid_t pid = fork();
+      if (pid < 0) {
+	opserr << "WARNING ida - could not fork worker\n";
+	close(fds[0]);
+	close(fds[1]);
+	forkFailed = true;
+	break;
+      }
+
+      if (pid == 0) {
+	close(fds[0]);
+	runWorker(interp, theDomain, theRecord, theRun, script, dof, patternTag,
+		  factor, collapseLimit, fds[1]);
+      }
+
+      close(fds[1]);
+      int job = 0;
+      while (jobPids[job] != -1)
+	job++;
+      jobPids[job] = pid;
+      jobFds[job] = fds[0];
+      jobRuns[job] = runIndex;
+      theRecord.busy = 1;
+      theRecord.numRuns++;
+      numActive++;
+    }
+
+    if (numActive == 0)
+      break;
+
+    // wait for a worker to finish and collect its result
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0)
+      break;
+
+    int job = 0;
+    while (job < numJobs && jobPids[job] != pid)
+      job++;
+    if (job == numJobs)
+      continue; // not one of ours
+
+    char buffer[128];
+    int numRead = 0;
+    int res;
+    while (numRead < 127 && (res = read(jobFds[job], &buffer[numRead], 127-numRead)) > 0)
+      numRead += res;
+    buffer[numRead] = '\0';
+    close(jobFds[job]);
+    jobPids[job] = -1;
+    numActive--;
+
+    IDA_Run &theRun = theRuns[jobRuns[job]];
+    IDA_Record &theRecord = theRecords[theRun.record];
+    theRecord.busy = 0;
+
+    if (sscanf(buffer, "%lf %d", &theRun.edp, &theRun.collapsed) != 2) {
+      // the worker died before reporting, count it as a failed run
+      theRun.edp = -1.0;
+      theRun.collapsed = 1;
+    }
+
+    if (theRun.collapsed == 1) {
+      if (theRecord.collapse < 0.0 || theRun.scale < theRecord.collapse)
+	theRecord.collapse = theRun.scale;
+    } else if (theRun.scale > theRecord.noCollapse)
+      theRecord.noCollapse = theRun.scale;
+  }
+
+  // return the results sorted by record and scale
+  qsort(theRuns, numRuns, sizeof(IDA_Run), compareRuns);
+
+  Tcl_ResetResult(interp);
+  char buffer[128];
+  for (int i=0; i<numRuns; i++) {
+    if (theRuns[i].collapsed < 0)
+      continue;
+    sprintf(buffer, "{%d %.10g %.10g %d} ", theRuns[i].record, theRuns[i].scale,
+	    theRuns[i].edp, theRuns[i].collapsed);
+    Tcl_AppendResult(interp, buffer, NULL);
+  }
+
+  delete [] jobPids;
+  delete [] jobFds;
+  delete [] jobRuns;
+  delete [] theRuns;
+  delete [] theRecords;
+  if (scales != 0)
+    delete [] scales;
+
+  if (forkFailed == true)
+    return TCL_ERROR;
+
+  return TCL_OK;
+#endif
+}
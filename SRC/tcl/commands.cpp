@@ -36,6 +36,8 @@
 
 #ifdef _PARALLEL_PROCESSING
 #include <mpi.h>
+// before f2c.h, whose min and max macros break the <thread> it includes
+#include <ThreadedSubdomain.h>
 #elif _PARALLEL_INTERPRETERS
 #include <mpi.h>
 #endif
@@ -70,12 +72,16 @@ OPS_Stream *opserrPtr = &sserr;
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <vector>
 
 #include <packages.h>
 
 #include <FEM_ObjectBrokerAllClasses.h>
 
 #include <Timer.h>
+#include <TimeSeries.h>
+#include <ResponseSpectrum.h>
 #include <ModelBuilder.h>
 #include "commands.h"
 
@@ -215,6 +221,7 @@ extern void *OPS_WilsonTheta(void);
 #include <StaticAnalysis.h>
 #include <DirectIntegrationAnalysis.h>
 #include <VariableTimeStepDirectIntegrationAnalysis.h>
+#include <SolutionController.h>
 #include <PFEMAnalysis.h>
 
 // system of eqn and solvers
@@ -299,11 +306,15 @@ extern void *OPS_WilsonTheta(void);
 #include <SparseGenRowLinSOE.h>
 #include <SymSparseLinSOE.h>
 #include <SymSparseLinSolver.h>
+#include <SparseSPDLinSOE.h>
+#include <OutOfCoreSparseSPDSolver.h>
+#include <SupernodalSparseSPDSolver.h>
 #include <UmfpackGenLinSOE.h>
 #include <UmfpackGenLinSolver.h>
 #include <EigenSOE.h>
 #include <EigenSolver.h>
 #include <ArpackSOE.h>
+#include <SubspaceEigenSolver.h>
 #include <ArpackSolver.h>
 #include <SymArpackSOE.h>
 #include <SymArpackSolver.h>
@@ -386,6 +397,7 @@ ModelBuilder *theBuilder =0;
 #include <ShadowSubdomain.h>
 #include <Metis.h>
 #include <ShedHeaviest.h>
+#include <RepartitionWhenUnbalanced.h>
 #include <DomainPartitioner.h>
 #include <GraphPartitioner.h>
 #include <FEM_ObjectBrokerAllClasses.h>
@@ -419,10 +431,14 @@ int OPS_NUM_SUBDOMAINS      =0;
 bool OPS_PARTITIONED        =false;
 bool OPS_USING_MAIN_DOMAIN  = false;
 int OPS_MAIN_DOMAIN_PARTITION_ID =0;
+int OPS_NUM_THREADED_SUBDOMAINS =0;
 
 DomainPartitioner *OPS_DOMAIN_PARTITIONER =0;
 GraphPartitioner  *OPS_GRAPH_PARTITIONER =0;
 LoadBalancer      *OPS_BALANCER = 0;
+int OPS_BALANCE_INTERVAL = 0;
+double OPS_BALANCE_FACTOR = 1.1;
+bool OPS_BALANCE_PRINT = false;
 FEM_ObjectBroker  *OPS_OBJECT_BROKER;
 MachineBroker     *OPS_MACHINE;
 Channel          **OPS_theChannels = 0;
@@ -508,6 +524,7 @@ EigenSOE *theEigenSOE =0;
 StaticAnalysis *theStaticAnalysis = 0;
 DirectIntegrationAnalysis *theTransientAnalysis = 0;
 VariableTimeStepDirectIntegrationAnalysis *theVariableTimeStepTransientAnalysis = 0;
+SolutionController *theSolutionController = 0;
 int numEigen = 0;
 
 #define _PFEM
@@ -609,6 +626,18 @@ opsBarrier(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 int 
 domainChange(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+domainArena(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+domainStateStore(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+specifySolutionController(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+runIDA(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 record(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -873,6 +902,8 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);
     Tcl_CreateCommand(interp, "eigen", &eigenAnalysis, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);       
+    Tcl_CreateCommand(interp, "responseSpectrum", &responseSpectrum, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);       
     Tcl_CreateCommand(interp, "video", &videoPlayer, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);       
     Tcl_CreateCommand(interp, "remove", &removeObject, 
@@ -965,6 +996,14 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 
     Tcl_CreateCommand(interp, "domainChange",  &domainChange,(ClientData)NULL, NULL);
 
+    Tcl_CreateCommand(interp, "domainArena",  &domainArena,(ClientData)NULL, NULL);
+
+    Tcl_CreateCommand(interp, "domainStateStore",  &domainStateStore,(ClientData)NULL, NULL);
+
+    Tcl_CreateCommand(interp, "solutionController",  &specifySolutionController,(ClientData)NULL, NULL);
+
+    Tcl_CreateCommand(interp, "ida",  &runIDA,(ClientData)NULL, NULL);
+
     Tcl_CreateCommand(interp, "record",  &record,(ClientData)NULL, NULL);
 
     Tcl_CreateCommand(interp, "metaData",  &neesMetaData,(ClientData)NULL, NULL);
@@ -1078,6 +1117,7 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
     theStaticAnalysis =0;
     theTransientAnalysis =0;    
     theVariableTimeStepTransientAnalysis =0;    
+    theSolutionController = 0;
     theTest = 0;
 
     // create an error handler
@@ -1378,6 +1418,9 @@ wipeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   theStaticAnalysis =0;
   theTransientAnalysis =0;    
   theVariableTimeStepTransientAnalysis =0;    
+  if (theSolutionController != 0)
+    delete theSolutionController;
+  theSolutionController = 0;
 
   theTest = 0;
   theDatabase = 0;
@@ -1433,6 +1476,9 @@ wipeAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
   theStaticAnalysis =0;
   theTransientAnalysis =0;    
   theVariableTimeStepTransientAnalysis =0;   
+  if (theSolutionController != 0)
+    delete theSolutionController;
+  theSolutionController = 0;
   //  theSensitivityAlgorithm=0; 
 #ifdef _PFEM
   thePFEMAnalysis = 0;
@@ -1659,20 +1705,52 @@ partitionModel(int eleTag)
   OPS_theChannels = new Channel *[OPS_NUM_SUBDOMAINS];
   
   // create some subdomains
-  for (int i=1; i<=OPS_NUM_SUBDOMAINS; i++) {
-    if (i != OPS_MAIN_DOMAIN_PARTITION_ID) {
-      ShadowSubdomain *theSubdomain = new ShadowSubdomain(i, *OPS_MACHINE, *OPS_OBJECT_BROKER);
+  if (OPS_NUM_THREADED_SUBDOMAINS > 0) {
+
+    // subdomains in this process, each condensed on its own thread with
+    // its own copy of the analysis; all the elements go to the subdomains
+    if (theHandler == 0 || theNumberer == 0 ||
+	(theStaticIntegrator == 0 && theTransientIntegrator == 0)) {
+      opserr << "WARNING partition -threads - the analysis has not been defined\n";
+      return -1;
+    }
+
+    OPS_NUM_SUBDOMAINS = OPS_NUM_THREADED_SUBDOMAINS;
+    OPS_USING_MAIN_DOMAIN = false;
+    OPS_MAIN_DOMAIN_PARTITION_ID = 0;
+
+    for (int i=1; i<=OPS_NUM_SUBDOMAINS; i++) {
+      ThreadedSubdomain *theSubdomain = new ThreadedSubdomain(i, theDomain);
       theDomain.addSubdomain(theSubdomain);
-      OPS_theChannels[i-1] = theSubdomain->getChannelPtr();
+      OPS_theChannels[i-1] = 0;
+    }
+
+  } else {
+
+    for (int i=1; i<=OPS_NUM_SUBDOMAINS; i++) {
+      if (i != OPS_MAIN_DOMAIN_PARTITION_ID) {
+	ShadowSubdomain *theSubdomain = new ShadowSubdomain(i, *OPS_MACHINE, *OPS_OBJECT_BROKER);
+	theDomain.addSubdomain(theSubdomain);
+	OPS_theChannels[i-1] = theSubdomain->getChannelPtr();
+      }
     }
   }
 
-  // create a partitioner & partition the domain
+  // create a partitioner & partition the domain, with a load balancer
+  // which repartitions on the measured element costs if asked for
+  if (OPS_DOMAIN_PARTITIONER != 0 && OPS_BALANCE_INTERVAL > 0 && OPS_BALANCER == 0) {
+    delete OPS_DOMAIN_PARTITIONER;
+    OPS_DOMAIN_PARTITIONER = 0;
+  }
+
   if (OPS_DOMAIN_PARTITIONER == 0) {
-    //      OPS_BALANCER = new ShedHeaviest();
-    OPS_GRAPH_PARTITIONER  = new Metis;
-    //OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
-    OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+    if (OPS_GRAPH_PARTITIONER == 0)
+      OPS_GRAPH_PARTITIONER  = new Metis;
+    if (OPS_BALANCE_INTERVAL > 0) {
+      OPS_BALANCER = new RepartitionWhenUnbalanced(OPS_BALANCE_FACTOR);
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+    } else
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
     theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
   }
  // opserr << "commands.cpp - partition numPartitions: " << OPS_NUM_SUBDOMAINS << endln;
@@ -1682,6 +1760,8 @@ partitionModel(int eleTag)
   if (result < 0) 
     return result;
 
+  theDomain.setLoadBalancing(OPS_BALANCE_INTERVAL, OPS_BALANCE_PRINT);
+
   OPS_PARTITIONED = true;
   
   DomainDecompositionAnalysis *theSubAnalysis;
@@ -1690,6 +1770,16 @@ partitionModel(int eleTag)
   
   // create the appropriate domain decomposition analysis
   while ((theSub = theSubdomains()) != 0) {
+    if (OPS_NUM_THREADED_SUBDOMAINS > 0) {
+      IncrementalIntegrator *theIntegrator = theStaticIntegrator;
+      if (theStaticAnalysis == 0)
+	theIntegrator = theTransientIntegrator;
+
+      if (((ThreadedSubdomain *)theSub)->buildDomainDecompAnalysis(*theHandler, *theNumberer, *theIntegrator, *OPS_OBJECT_BROKER) < 0)
+	result = -1;
+      continue;
+    }
+
     if (theStaticAnalysis != 0) {      
       theSubAnalysis = new StaticDomainDecompositionAnalysis(*theSub,
 							     *theHandler,
@@ -1726,12 +1816,47 @@ int
 opsPartition(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
 #ifdef _PARALLEL_PROCESSING
-  int eleTag;
-  if (argc == 2) {
+  int eleTag = 0;
+  int loc = 1;
+  if (argc > 1 && argv[1][0] != '-') {
     if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
       ;
     }
+    loc++;
   }
+
+  // partition <eleTag?> <-threads numSubdomains?> <-balance numCommits? factorGreater?> <-print>
+  while (loc < argc) {
+    if (strcmp(argv[loc],"-threads") == 0 && loc+1 < argc) {
+      if (Tcl_GetInt(interp, argv[loc+1], &OPS_NUM_THREADED_SUBDOMAINS) != TCL_OK ||
+	  OPS_NUM_THREADED_SUBDOMAINS < 2) {
+	opserr << "WARNING partition -threads numSubdomains? - invalid value, must be > 1\n";
+	OPS_NUM_THREADED_SUBDOMAINS = 0;
+	return TCL_ERROR;
+      }
+      OPS_NUM_SUBDOMAINS = OPS_NUM_THREADED_SUBDOMAINS;
+      loc += 2;
+    } else if (strcmp(argv[loc],"-balance") == 0 && loc+2 < argc) {
+      if (Tcl_GetInt(interp, argv[loc+1], &OPS_BALANCE_INTERVAL) != TCL_OK ||
+	  Tcl_GetDouble(interp, argv[loc+2], &OPS_BALANCE_FACTOR) != TCL_OK) {
+	opserr << "WARNING partition -balance numCommits? factorGreater? - invalid value\n";
+	return TCL_ERROR;
+      }
+      loc += 3;
+    } else if (strcmp(argv[loc],"-print") == 0) {
+      OPS_BALANCE_PRINT = true;
+      loc++;
+    } else {
+      opserr << "WARNING partition <eleTag?> <-threads numSubdomains?> <-balance numCommits? factorGreater?> <-print> - unknown option " << argv[loc] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  // threaded subdomains are given copies of the analysis, so if it is not
+  // yet defined the model is partitioned by the first analyze
+  if (OPS_NUM_THREADED_SUBDOMAINS > 0 && theHandler == 0)
+    return TCL_OK;
+
   partitionModel(eleTag);
 
 #endif
@@ -1803,6 +1928,8 @@ analyzeModel(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
 	return TCL_ERROR;
       }
 
+    } else if (theSolutionController != 0) {
+      result = theSolutionController->analyze(*theTransientAnalysis, numIncr, dT);
     } else {
       result = theTransientAnalysis->analyze(numIncr, dT);
     }
@@ -3087,6 +3214,62 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   }
 
   
+  else if (strcmp(argv[1],"SparseSPD") == 0 && argc > 2 && argv[2][0] == '-') {
+    // system SparseSPD <-threads N> <-ordering MMD|ND> <-LDLT>
+    // system SparseSPD -outOfCore <-memory MB> <-scratch dir> <-LDLT>
+    double maxMemory = 0.0;
+    const char *scratchDir = 0;
+    bool ldlt = false;
+    bool outOfCore = false;
+    int numThreads = 1;
+    int ordering = SPARSE_SPD_ORDER_ND;
+    int count = 2;
+    while (count < argc) {
+      if (strcmp(argv[count],"-outOfCore") == 0) {
+	outOfCore = true;
+      } else if (strcmp(argv[count],"-memory") == 0 && count+1 < argc) {
+	if (Tcl_GetDouble(interp, argv[count+1], &maxMemory) != TCL_OK || maxMemory < 0.0) {
+	  opserr << "WARNING system SparseSPD -memory MB - invalid memory " << argv[count+1] << endln;
+	  return TCL_ERROR;
+	}
+	count++;
+      } else if (strcmp(argv[count],"-scratch") == 0 && count+1 < argc) {
+	scratchDir = argv[count+1];
+	count++;
+      } else if (strcmp(argv[count],"-threads") == 0 && count+1 < argc) {
+	if (Tcl_GetInt(interp, argv[count+1], &numThreads) != TCL_OK || numThreads < 1) {
+	  opserr << "WARNING system SparseSPD -threads N - invalid number of threads " << argv[count+1] << endln;
+	  return TCL_ERROR;
+	}
+	count++;
+      } else if (strcmp(argv[count],"-ordering") == 0 && count+1 < argc) {
+	if ((strcmp(argv[count+1],"MMD") == 0) || (strcmp(argv[count+1],"1") == 0))
+	  ordering = SPARSE_SPD_ORDER_MMD;
+	else if ((strcmp(argv[count+1],"ND") == 0) || (strcmp(argv[count+1],"2") == 0))
+	  ordering = SPARSE_SPD_ORDER_ND;
+	else {
+	  opserr << "WARNING system SparseSPD -ordering - unknown ordering " << argv[count+1] << endln;
+	  return TCL_ERROR;
+	}
+	count++;
+      } else if ((strcmp(argv[count],"-LDLT") == 0) || (strcmp(argv[count],"-ldlt") == 0)) {
+	ldlt = true;
+      } else {
+	opserr << "WARNING system SparseSPD - unknown option " << argv[count] << endln;
+	return TCL_ERROR;
+      }
+      count++;
+    }
+
+    if (outOfCore == true) {
+      OutOfCoreSparseSPDSolver *theSolver = new OutOfCoreSparseSPDSolver(maxMemory, scratchDir, ldlt);
+      theSOE = new SparseSPDLinSOE(*theSolver);
+    } else {
+      SupernodalSparseSPDSolver *theSolver = new SupernodalSparseSPDSolver(numThreads, ordering, ldlt);
+      theSOE = new SparseSPDLinSOE(*theSolver);
+    }
+  }
+
   else if ((strcmp(argv[1],"SparseSPD") == 0) || (strcmp(argv[1],"SparseSYM") == 0)) {
     // now must determine the type of solver to create from rest of args
 
@@ -3488,17 +3671,12 @@ specifyConstraintHandler(ClientData clientData, Tcl_Interp *interp, int argc,
 
 
 //
-// command invoked to allow the SolnAlgorithm object to be built
+// creates the SolnAlgorithm object given by argv[1], returns 0 on error
 //
-int
-specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, 
-		 TCL_Char **argv)
+EquiSolnAlgo *
+TclCreateAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, 
+		   TCL_Char **argv)
 {
-  // make sure at least one other argument to contain numberer
-  if (argc < 2) {
-      opserr << "WARNING need to specify an Algorithm type \n";
-      return TCL_ERROR;
-  }    
   EquiSolnAlgo *theNewAlgo = 0;
 
   // check argv[1] for type of Algorithm and create the object
@@ -3521,22 +3699,25 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
   else if (strcmp(argv[1],"Newton") == 0) {
     int formTangent = CURRENT_TANGENT;
-    if (argc > 2) {
-      if (strcmp(argv[2],"-secant") == 0) {
+    bool fused = false;
+    for (int i = 2; i < argc; i++) {
+      if (strcmp(argv[i],"-secant") == 0) {
 	formTangent = CURRENT_SECANT;
-      } else if (strcmp(argv[2],"-initial") == 0) {
+      } else if (strcmp(argv[i],"-initial") == 0) {
 	formTangent = INITIAL_TANGENT;
-      } else if ((strcmp(argv[2],"-initialThenCurrent") == 0) || 
-		 (strcmp(argv[2],"-initialCurrent") == 0))  {
+      } else if ((strcmp(argv[i],"-initialThenCurrent") == 0) || 
+		 (strcmp(argv[i],"-initialCurrent") == 0))  {
 	formTangent = INITIAL_THEN_CURRENT_TANGENT;
+      } else if (strcmp(argv[i],"-fused") == 0) {
+	fused = true;
       }
     }
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
-    theNewAlgo = new NewtonRaphson(*theTest, formTangent); 
+    theNewAlgo = new NewtonRaphson(*theTest, formTangent, fused); 
   }
 
   else if (strcmp(argv[1],"KrylovNewton") == 0) {
@@ -3570,7 +3751,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     Accelerator *theAccel;
@@ -3605,7 +3786,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     Accelerator *theAccel;
@@ -3645,7 +3826,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     Accelerator *theAccel = 0;
@@ -3685,7 +3866,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     Accelerator *theAccel;
@@ -3725,7 +3906,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     Accelerator *theAccel;
@@ -3740,7 +3921,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
     for (int i = 2; i < argc; i++) {
       if (strcmp(argv[i],"-secant") == 0) {
@@ -3773,7 +3954,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
 
     if (count == -1)
@@ -3793,7 +3974,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
     }
     if (theTest == 0) {
       opserr << "ERROR: No ConvergenceTest yet specified\n";
-      return TCL_ERROR;	  
+      return 0;	  
     }
       
     theNewAlgo = new ModifiedNewton(*theTest, formTangent); 
@@ -3802,7 +3983,7 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
   else if (strcmp(argv[1],"NewtonLineSearch") == 0) {
       if (theTest == 0) {
 	  opserr << "ERROR: No ConvergenceTest yet specified\n";
-	  return TCL_ERROR;	  
+	  return 0;	  
       }
 
       int    count = 2;
@@ -3819,27 +4000,27 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 	if (strcmp(argv[count], "-tol") == 0) {
 	  count++;
 	  if (Tcl_GetDouble(interp, argv[count], &tol) != TCL_OK)	
-	    return TCL_ERROR;	      	  
+	    return 0;	      	  
 	  count++;
 	} else if (strcmp(argv[count], "-maxIter") == 0) {
 	  count++;
 	  if (Tcl_GetInt(interp, argv[count], &maxIter) != TCL_OK)	
-	    return TCL_ERROR;	      	  
+	    return 0;	      	  
 	  count++;	  
 	} else if (strcmp(argv[count], "-pFlag") == 0) {
 	  count++;
 	  if (Tcl_GetInt(interp, argv[count], &pFlag) != TCL_OK)	
-	    return TCL_ERROR;	      	  
+	    return 0;	      	  
 	  count++;
 	} else if (strcmp(argv[count], "-minEta") == 0) {
 	  count++;
 	  if (Tcl_GetDouble(interp, argv[count], &minEta) != TCL_OK)	
-	    return TCL_ERROR;	      	  
+	    return 0;	      	  
 	  count++;
 	} else if (strcmp(argv[count], "-maxEta") == 0) {
 	  count++;
 	  if (Tcl_GetDouble(interp, argv[count], &maxEta) != TCL_OK)	
-	    return TCL_ERROR;	      	  
+	    return 0;	      	  
 	  count++;
 	} else if (strcmp(argv[count], "-type") == 0) {
 	  count++;
@@ -3874,9 +4055,28 @@ specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc,
 
   else {
     opserr << "WARNING No EquiSolnAlgo type " << argv[1] << " exists\n";
-      return TCL_ERROR;
+      return 0;
   }    
 
+  return theNewAlgo;
+}
+
+
+//
+// command invoked to allow the SolnAlgorithm object to be built
+//
+int
+specifyAlgorithm(ClientData clientData, Tcl_Interp *interp, int argc, 
+		 TCL_Char **argv)
+{
+  // make sure at least one other argument to contain numberer
+  if (argc < 2) {
+      opserr << "WARNING need to specify an Algorithm type \n";
+      return TCL_ERROR;
+  }    
+  EquiSolnAlgo *theNewAlgo = TclCreateAlgorithm(clientData, interp, argc, argv);
+  if (theNewAlgo == 0)
+    return TCL_ERROR;
 
   if (theNewAlgo != 0) {
     theAlgorithm = theNewAlgo;
@@ -5233,6 +5433,10 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
          (strcmp(argv[loc],"fullGenLapackEigen") == 0) || 
          (strcmp(argv[loc],"-fullGenLapackEigen") == 0))
       typeSolver = EigenSOE_TAGS_FullGenEigenSOE;
+
+    else if ((strcmp(argv[loc],"subspace") == 0) || 
+         (strcmp(argv[loc],"-subspace") == 0))
+      typeSolver = EigenSOE_TAGS_SubspaceEigenSOE;
     
     else {
       opserr << "eigen - unknown option specified " << argv[loc] << endln;
@@ -5316,6 +5520,11 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
 	FullGenEigenSolver *theEigenSolver = new FullGenEigenSolver();
 	theEigenSOE = new FullGenEigenSOE(*theEigenSolver, *theAnalysisModel);
 
+      } else if (typeSolver == EigenSOE_TAGS_SubspaceEigenSOE) {
+
+	SubspaceEigenSolver *theEigenSolver = new SubspaceEigenSolver();
+	theEigenSOE = new ArpackSOE(*theEigenSolver, shift);
+
       } else {
 
 	theEigenSOE = new ArpackSOE(shift);    
@@ -5388,6 +5597,179 @@ eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_OK;
 }
 
+// responseSpectrum -timeSeries tag1 <tag2 ...> -periods T1 <T2 ...>
+//    <-logPeriods Tmin Tmax numPeriods> <-damping z1 <z2 ...>> <-dt dt>
+//    <-bilinear R alpha> <-threads numThreads>
+//
+// returns for each record, damping ratio and period, the periods varying
+// fastest: Sd PSv PSa, followed by the inelastic Sd and the ductility if
+// -bilinear is given
+int 
+responseSpectrum(ClientData clientData, Tcl_Interp *interp, int argc, 
+		 TCL_Char **argv)
+{
+  if (argc < 5) {
+    opserr << "WARNING want - responseSpectrum -timeSeries tag1 <tag2 ...> -periods T1 <T2 ...> ";
+    opserr << "<-damping z1 ...> <-dt dt> <-bilinear R alpha> <-threads n>\n";
+    return TCL_ERROR;
+  }
+
+  ID seriesTags(0, 8);
+  std::vector<double> periods;
+  std::vector<double> dampings;
+  int numSeries = 0;
+  double dT = 0.0;
+  double R = 0.0;
+  double alpha = 0.0;
+  int numThreads = 1;
+
+  int loc = 1;
+  while (loc < argc) {
+    if (strcmp(argv[loc],"-timeSeries") == 0) {
+      loc++;
+      int tag;
+      while (loc < argc && Tcl_GetInt(interp, argv[loc], &tag) == TCL_OK) {
+	seriesTags[numSeries++] = tag;
+	loc++;
+      }
+    } else if (strcmp(argv[loc],"-periods") == 0) {
+      loc++;
+      double T;
+      while (loc < argc && Tcl_GetDouble(interp, argv[loc], &T) == TCL_OK) {
+	periods.push_back(T);
+	loc++;
+      }
+    } else if (strcmp(argv[loc],"-logPeriods") == 0) {
+      double Tmin, Tmax;
+      int num;
+      if (loc+3 >= argc ||
+	  Tcl_GetDouble(interp, argv[loc+1], &Tmin) != TCL_OK ||
+	  Tcl_GetDouble(interp, argv[loc+2], &Tmax) != TCL_OK ||
+	  Tcl_GetInt(interp, argv[loc+3], &num) != TCL_OK ||
+	  Tmin <= 0.0 || Tmax < Tmin || num < 1) {
+	opserr << "WARNING responseSpectrum - want -logPeriods Tmin Tmax numPeriods\n";
+	return TCL_ERROR;
+      }
+      for (int i=0; i<num; i++)
+	periods.push_back((num == 1) ? Tmin : Tmin*pow(Tmax/Tmin, double(i)/(num-1)));
+      loc += 4;
+    } else if (strcmp(argv[loc],"-damping") == 0) {
+      loc++;
+      double zeta;
+      while (loc < argc && Tcl_GetDouble(interp, argv[loc], &zeta) == TCL_OK) {
+	dampings.push_back(zeta);
+	loc++;
+      }
+    } else if (strcmp(argv[loc],"-dt") == 0) {
+      if (loc+1 >= argc || Tcl_GetDouble(interp, argv[loc+1], &dT) != TCL_OK || dT <= 0.0) {
+	opserr << "WARNING responseSpectrum - invalid -dt\n";
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else if (strcmp(argv[loc],"-bilinear") == 0) {
+      if (loc+2 >= argc ||
+	  Tcl_GetDouble(interp, argv[loc+1], &R) != TCL_OK ||
+	  Tcl_GetDouble(interp, argv[loc+2], &alpha) != TCL_OK || R <= 0.0) {
+	opserr << "WARNING responseSpectrum - want -bilinear R alpha\n";
+	return TCL_ERROR;
+      }
+      loc += 3;
+    } else if (strcmp(argv[loc],"-threads") == 0) {
+      if (loc+1 >= argc || Tcl_GetInt(interp, argv[loc+1], &numThreads) != TCL_OK) {
+	opserr << "WARNING responseSpectrum - invalid -threads\n";
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else {
+      opserr << "WARNING responseSpectrum - unknown option " << argv[loc] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  if (numSeries == 0 || periods.empty()) {
+    opserr << "WARNING responseSpectrum - need at least one time series and one period\n";
+    return TCL_ERROR;
+  }
+
+  if (dampings.empty())
+    dampings.push_back(0.05);
+
+  int numPeriods = periods.size();
+  int numDampings = dampings.size();
+
+  // the records are sampled here, the series are not safe to use from
+  // more than one thread
+  double **accel = new double *[numSeries];
+  int *numSteps = new int[numSeries];
+  double *dts = new double[numSeries];
+  for (int i=0; i<numSeries; i++)
+    accel[i] = 0;
+
+  int res = 0;
+  for (int i=0; i<numSeries && res == 0; i++) {
+    TimeSeries *theSeries = OPS_getTimeSeries(seriesTags(i));
+    if (theSeries == 0) {
+      opserr << "WARNING responseSpectrum - no time series with tag " << seriesTags(i) << endln;
+      res = -1;
+      break;
+    }
+
+    double duration = theSeries->getDuration();
+    double h = (dT > 0.0) ? dT : theSeries->getTimeIncr(0.0);
+    if (h <= 0.0 || h > 0.1*duration) {
+      opserr << "WARNING responseSpectrum - time series " << seriesTags(i);
+      opserr << " does not give a time step, use -dt\n";
+      res = -1;
+      break;
+    }
+
+    int num = (int)floor(duration/h + 0.5) + 1;
+    accel[i] = new double[num];
+    for (int j=0; j<num; j++)
+      accel[i][j] = theSeries->getFactor(j*h);
+    numSteps[i] = num;
+    dts[i] = h;
+  }
+
+  ResponseSpectrum theSpectrum(numPeriods, &periods[0], numDampings, &dampings[0]);
+  if (res == 0)
+    res = theSpectrum.setBilinear(R, alpha);
+  if (res == 0)
+    res = theSpectrum.compute(numSeries, accel, numSteps, dts, numThreads);
+
+  for (int i=0; i<numSeries; i++)
+    if (accel[i] != 0)
+      delete [] accel[i];
+  delete [] accel;
+  delete [] numSteps;
+  delete [] dts;
+
+  if (res != 0)
+    return TCL_ERROR;
+
+  const double *Sd = theSpectrum.getSd();
+  const double *PSv = theSpectrum.getPSv();
+  const double *PSa = theSpectrum.getPSa();
+  const double *SdIn = theSpectrum.getSdInelastic();
+  const double *mu = theSpectrum.getDuctility();
+
+  // the parsing of the lists above may have left an error in the result
+  Tcl_ResetResult(interp);
+
+  char buffer [80];
+  int numResults = numSeries*numDampings*numPeriods;
+  for (int i=0; i<numResults; i++) {
+    sprintf(buffer,"%.12e %.12e %.12e ", Sd[i], PSv[i], PSa[i]);
+    Tcl_AppendResult(interp, buffer, NULL);
+    if (SdIn != 0) {
+      sprintf(buffer,"%.12e %.12e ", SdIn[i], mu[i]);
+      Tcl_AppendResult(interp, buffer, NULL);
+    }
+  }
+
+  return TCL_OK;
+}
+
 
 int 
 videoPlayer(ClientData clientData, Tcl_Interp *interp, int argc, 
@@ -8596,7 +8978,12 @@ OpenSeesExit(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **arg
     //    delete theMachineBroker;
     //    theMachineBroker = 0;
   }
-  MPI_Finalize();
+
+  // MPI is not started when the processes share memory (OpenSeesSP -shm)
+  int mpiStarted = 0;
+  MPI_Initialized(&mpiStarted);
+  if (mpiStarted != 0)
+    MPI_Finalize();
 #endif
 
 #ifdef _PARALLEL_INTERPRETERS
@@ -8759,6 +9146,171 @@ int domainChange(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char *
   return TCL_OK;
 }
 
+// domainArena on|off
+//   - nodes created after this command keep their response arrays in a
+//     memory arena owned by the Domain; must be issued before the nodes
+int domainArena(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING want - domainArena on|off\n";
+    return TCL_ERROR;
+  }
+
+  bool useArena;
+  if (strcmp(argv[1],"on") == 0 || strcmp(argv[1],"1") == 0)
+    useArena = true;
+  else if (strcmp(argv[1],"off") == 0 || strcmp(argv[1],"0") == 0)
+    useArena = false;
+  else {
+    opserr << "WARNING domainArena - unknown option " << argv[1] << " want on|off\n";
+    return TCL_ERROR;
+  }
+
+  if (theDomain.setNodalArena(useArena) < 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+// domainStateStore on|off
+//   - keeps the response of all the nodes in one structure of arrays, so
+//     that committing the domain and setting the trial response from the
+//     analysis are sweeps over whole arrays
+int domainStateStore(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING want - domainStateStore on|off\n";
+    return TCL_ERROR;
+  }
+
+  bool useStore;
+  if (strcmp(argv[1],"on") == 0 || strcmp(argv[1],"1") == 0)
+    useStore = true;
+  else if (strcmp(argv[1],"off") == 0 || strcmp(argv[1],"0") == 0)
+    useStore = false;
+  else {
+    opserr << "WARNING domainStateStore - unknown option " << argv[1] << " want on|off\n";
+    return TCL_ERROR;
+  }
+
+  if (theDomain.setNodalStateStore(useStore) < 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+// solutionController -algorithms {algo args..} .. <-numSub n> <-maxCuts n> <-minDt dt>
+// solutionController print|reset|off
+//   - a transient step that fails is tried again with each of the
+//     algorithms in turn, then split into numSub sub-steps; the
+//     algorithms are created once here, with the current test
+int specifySolutionController(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING want - solutionController -algorithms {algo args..} .. <-numSub n> <-maxCuts n> <-minDt dt>\n";
+    opserr << "           or - solutionController print|reset|off\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1],"print") == 0) {
+    if (theSolutionController != 0)
+      theSolutionController->Print(opserr);
+    return TCL_OK;
+  } else if (strcmp(argv[1],"reset") == 0) {
+    if (theSolutionController != 0)
+      theSolutionController->resetStatistics();
+    return TCL_OK;
+  } else if (strcmp(argv[1],"off") == 0) {
+    if (theSolutionController != 0)
+      delete theSolutionController;
+    theSolutionController = 0;
+    return TCL_OK;
+  }
+
+  int numSub = 2;
+  int maxCuts = 4;
+  double minDt = 0.0;
+  int algoStart = 0;
+  int algoEnd = 0;
+
+  int loc = 1;
+  while (loc < argc) {
+    if (strcmp(argv[loc],"-algorithms") == 0) {
+      algoStart = ++loc;
+      while (loc < argc && argv[loc][0] != '-')
+	loc++;
+      algoEnd = loc;
+    } else if (strcmp(argv[loc],"-numSub") == 0 && loc+1 < argc) {
+      if (Tcl_GetInt(interp, argv[loc+1], &numSub) != TCL_OK) {
+	opserr << "WARNING solutionController - invalid numSub " << argv[loc+1] << endln;
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else if (strcmp(argv[loc],"-maxCuts") == 0 && loc+1 < argc) {
+      if (Tcl_GetInt(interp, argv[loc+1], &maxCuts) != TCL_OK) {
+	opserr << "WARNING solutionController - invalid maxCuts " << argv[loc+1] << endln;
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else if (strcmp(argv[loc],"-minDt") == 0 && loc+1 < argc) {
+      if (Tcl_GetDouble(interp, argv[loc+1], &minDt) != TCL_OK) {
+	opserr << "WARNING solutionController - invalid minDt " << argv[loc+1] << endln;
+	return TCL_ERROR;
+      }
+      loc += 2;
+    } else {
+      opserr << "WARNING solutionController - unknown option " << argv[loc] << endln;
+      return TCL_ERROR;
+    }
+  }
+
+  SolutionController *theNewController = new SolutionController(numSub, maxCuts, minDt);
+
+  for (int i=algoStart; i<algoEnd; i++) {
+    int num = 0;
+    TCL_Char **argvPtr = 0;
+    if (Tcl_SplitList(interp, argv[i], &num, &argvPtr) != TCL_OK || num < 1) {
+      opserr << "WARNING solutionController - failed to read the algorithm " << argv[i] << endln;
+      delete theNewController;
+      return TCL_ERROR;
+    }
+
+    // as the arguments of the algorithm command
+    TCL_Char **algoArgv = new TCL_Char *[num+1];
+    algoArgv[0] = "algorithm";
+    for (int j=0; j<num; j++)
+      algoArgv[j+1] = argvPtr[j];
+
+    EquiSolnAlgo *theAlgo = TclCreateAlgorithm(clientData, interp, num+1, algoArgv);
+    delete [] algoArgv;
+
+    if (theAlgo == 0) {
+      opserr << "WARNING solutionController - failed to create the algorithm " << argv[i] << endln;
+      Tcl_Free((char *)argvPtr);
+      delete theNewController;
+      return TCL_ERROR;
+    }
+
+    theNewController->addAlgorithm(theAlgo, argv[i]);
+    Tcl_Free((char *)argvPtr);
+  }
+
+  if (theSolutionController != 0)
+    delete theSolutionController;
+  theSolutionController = theNewController;
+
+  return TCL_OK;
+}
+
+extern int
+TclCommand_ida(ClientData clientData, Tcl_Interp *interp, int argc,
+	       TCL_Char **argv, Domain &theDomain);
+
+int runIDA(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  return TclCommand_ida(clientData, interp, argc, argv, theDomain);
+}
+
 
 int record(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -117,6 +117,9 @@ groundExcitation(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char *
 int 
 eigenAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+responseSpectrum(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int 
 videoPlayer(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -147,10 +147,12 @@ extern int		Tclxttest_Init _ANSI_ARGS_((Tcl_Interp *interp));
 
 extern void g3TclMain(int argc, char **argv, Tcl_AppInitProc *appInitProc, int rank, int np);
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <PartitionedDomain.h>
 #include <MPI_MachineBroker.h>
+#include <SharedMemoryMachineBroker.h>
 #include <ShadowSubdomain.h>
 #include <ActorSubdomain.h>
 #include <FEM_ObjectBrokerAllClasses.h>
@@ -184,9 +186,31 @@ extern int OPS_np;
 int
 main(int argc, char **argv)
 {
-  theMachineBroker = new MPI_MachineBroker(0, argc, argv);
   FEM_ObjectBrokerAllClasses theBroker;
-  theMachineBroker->setObjectBroker(&theBroker);
+
+  //
+  // OpenSeesSP -shm np runs np processes on this machine, forked here and
+  // joined by shared memory channels, instead of the MPI processes
+  //
+  int numShmProcesses = 0;
+  if (argc > 2 && strcmp(argv[1], "-shm") == 0) {
+    numShmProcesses = atoi(argv[2]);
+    if (numShmProcesses < 1) {
+      fprintf(stderr, "OpenSeesSP -shm np - invalid number of processes %s\n", argv[2]);
+      return -1;
+    }
+    argv[2] = argv[0];
+    argv += 2;
+    argc -= 2;
+  }
+
+  if (numShmProcesses > 0)
+    // only process 0 returns, the others run actors until shutdown()
+    theMachineBroker = new SharedMemoryMachineBroker(&theBroker, numShmProcesses);
+  else {
+    theMachineBroker = new MPI_MachineBroker(0, argc, argv);
+    theMachineBroker->setObjectBroker(&theBroker);
+  }
 
   OPS_rank = theMachineBroker->getPID();
   OPS_np = theMachineBroker->getNP();
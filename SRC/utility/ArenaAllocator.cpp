@@ -0,0 +1,135 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ArenaAllocator.
+//
+// What: "@(#) ArenaAllocator.cpp, revA"
+
+#include <ArenaAllocator.h>
+#include <OPS_Globals.h>
+#include <stdlib.h>
+#include <string.h>
+
+// all allocations are rounded up to this, which is enough for doubles
+// and pointers on every platform we build on
+#define ARENA_ALIGNMENT 16
+
+static inline size_t
+arenaRoundUp(size_t numBytes)
+{
+  return (numBytes + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+}
+
+ArenaAllocator::ArenaAllocator(size_t size)
+  :theBlocks(0), blockSize(size), numBytesAllocated(0), numBytesReserved(0)
+{
+  if (blockSize < 1024)
+    blockSize = 1024;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+  this->release();
+}
+
+ArenaAllocator::Block *
+ArenaAllocator::newBlock(size_t minSize)
+{
+  size_t size = (minSize > blockSize) ? minSize : blockSize;
+  size_t header = arenaRoundUp(sizeof(Block));
+
+  Block *theBlock = (Block *)malloc(header + size);
+  if (theBlock == 0) {
+    opserr << "ArenaAllocator::newBlock() - out of memory allocating block of size " << (int)size << endln;
+    return 0;
+  }
+
+  theBlock->next = theBlocks;
+  theBlock->size = size;
+  theBlock->used = 0;
+  theBlocks = theBlock;
+  numBytesReserved += size;
+
+  return theBlock;
+}
+
+void *
+ArenaAllocator::allocate(size_t numBytes)
+{
+  numBytes = arenaRoundUp(numBytes);
+
+  Block *theBlock = theBlocks;
+  if (theBlock == 0 || theBlock->size - theBlock->used < numBytes) {
+    theBlock = this->newBlock(numBytes);
+    if (theBlock == 0)
+      return 0;
+  }
+
+  char *data = (char *)theBlock + arenaRoundUp(sizeof(Block)) + theBlock->used;
+  theBlock->used += numBytes;
+  numBytesAllocated += numBytes;
+
+  return data;
+}
+
+double *
+ArenaAllocator::allocateDoubles(int numDoubles)
+{
+  if (numDoubles <= 0)
+    return 0;
+
+  double *data = (double *)this->allocate(numDoubles*sizeof(double));
+  if (data != 0)
+    for (int i=0; i<numDoubles; i++)
+      data[i] = 0.0;
+
+  return data;
+}
+
+void
+ArenaAllocator::release(void)
+{
+  Block *theBlock = theBlocks;
+  while (theBlock != 0) {
+    Block *next = theBlock->next;
+    free(theBlock);
+    theBlock = next;
+  }
+
+  theBlocks = 0;
+  numBytesAllocated = 0;
+  numBytesReserved = 0;
+}
+
+size_t
+ArenaAllocator::getNumBytesAllocated(void) const
+{
+  return numBytesAllocated;
+}
+
+size_t
+ArenaAllocator::getNumBytesReserved(void) const
+{
+  return numBytesReserved;
+}
@@ -0,0 +1,75 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for ArenaAllocator.
+// An ArenaAllocator hands out memory from a list of large blocks by
+// bumping a pointer. Individual allocations are never freed; all the
+// memory is returned at once by release(). It is used by the Domain to
+// hold the nodal response arrays, and the Vector objects that wrap
+// them, so that a large model does not make millions of small heap
+// allocations and so that the state of consecutive nodes is adjacent.
+//
+// What: "@(#) ArenaAllocator.h, revA"
+
+#ifndef ArenaAllocator_h
+#define ArenaAllocator_h
+
+#include <stddef.h>
+
+class ArenaAllocator
+{
+  public:
+    ArenaAllocator(size_t blockSize = 1048576);
+    ~ArenaAllocator();
+
+    // returns zeroed memory for numDoubles doubles
+    double *allocateDoubles(int numDoubles);
+
+    // returns memory for numBytes bytes, aligned for any object
+    void *allocate(size_t numBytes);
+
+    // frees every block; all pointers handed out become invalid
+    void release(void);
+
+    size_t getNumBytesAllocated(void) const;
+    size_t getNumBytesReserved(void) const;
+
+  protected:
+
+  private:
+    struct Block {
+      Block *next;
+      size_t size;
+      size_t used;
+    };
+
+    Block *newBlock(size_t minSize);
+
+    Block *theBlocks;         // linked list, current block first
+    size_t blockSize;         // default size of a new block in bytes
+    size_t numBytesAllocated; // sum of all requests since last release
+    size_t numBytesReserved;  // sum of all block sizes
+};
+
+#endif
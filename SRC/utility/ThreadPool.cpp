@@ -0,0 +1,150 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the implementation of ThreadPool.
+//
+// What: "@(#) ThreadPool.cpp, revA"
+
+#include <ThreadPool.h>
+#include <algorithm>
+
+ThreadPool &
+ThreadPool::getThreadPool(void)
+{
+  static ThreadPool thePool;
+  return thePool;
+}
+
+ThreadPool::ThreadPool()
+  :stopping(false)
+{
+
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+
+  for (int i=0; i<(int)theWorkers.size(); i++)
+    theWorkers[i].join();
+}
+
+int
+ThreadPool::getNumWorkers(void)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  return (int)theWorkers.size();
+}
+
+// addWorkers():
+// private method to start workers until there are numWorkers of them;
+// invoked with theMutex held
+
+void
+ThreadPool::addWorkers(int numWorkers)
+{
+  while ((int)theWorkers.size() < numWorkers)
+    theWorkers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+void
+ThreadPool::run(int numTasks, int numThreads, const std::function<void(int)> &task)
+{
+  if (numTasks <= 0)
+    return;
+
+  if (numThreads < 2 || numTasks < 2) {
+    for (int t=0; t<numTasks; t++)
+      task(t);
+    return;
+  }
+
+  Batch theBatch;
+  theBatch.task = &task;
+  theBatch.numTasks = numTasks;
+  theBatch.numStarted = 0;
+  theBatch.numDone = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    this->addWorkers(numThreads-1);
+    theBatch.numStarted = 1;   // task 0 is ours
+    theBatches.push_back(&theBatch);
+  }
+  workAvailable.notify_all();
+
+  // work on our own tasks until all have been started
+  int t = 0;
+  std::unique_lock<std::mutex> lock(theMutex, std::defer_lock);
+  while (t >= 0) {
+    task(t);
+
+    lock.lock();
+    theBatch.numDone++;
+    if (theBatch.numStarted < numTasks) {
+      t = theBatch.numStarted++;
+      if (theBatch.numStarted == numTasks)
+	theBatches.erase(std::find(theBatches.begin(), theBatches.end(), &theBatch));
+    } else
+      t = -1;
+    lock.unlock();
+  }
+
+  // wait for the tasks the workers started
+  lock.lock();
+  while (theBatch.numDone < numTasks)
+    theBatch.allDone.wait(lock);
+}
+
+// work():
+// private method run by each worker, taking tasks from the oldest batch
+
+void
+ThreadPool::work(void)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (true) {
+    while (stopping == false && theBatches.empty() == true)
+      workAvailable.wait(lock);
+    if (stopping == true)
+      return;
+
+    Batch *theBatch = theBatches.front();
+    int t = theBatch->numStarted++;
+    if (theBatch->numStarted == theBatch->numTasks)
+      theBatches.pop_front();
+
+    lock.unlock();
+    (*theBatch->task)(t);
+    lock.lock();
+
+    theBatch->numDone++;
+    if (theBatch->numDone == theBatch->numTasks)
+      theBatch->allDone.notify_all();
+  }
+}
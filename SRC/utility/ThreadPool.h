@@ -0,0 +1,107 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Written: agent
+// Created: 10/26
+// Revision: A
+//
+// Description: This file contains the class definition for ThreadPool,
+// a set of worker threads shared by the whole program, and the function
+// template parallelFor() built on it. The workers are started the first
+// time they are needed and then wait for work, so that a parallel loop
+// does not pay for creating and joining threads every time it is run.
+//
+// The thread calling run() works on its own tasks as well, and only
+// waits for tasks already taken by workers; a task may therefore itself
+// call run() or parallelFor() without deadlock.
+//
+// What: "@(#) ThreadPool.h, revA"
+
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class ThreadPool
+{
+  public:
+    // the pool shared by all the parallel loops of the program
+    static ThreadPool &getThreadPool(void);
+
+    // runs task(t) for t in [0, numTasks) on the calling thread and up
+    // to numThreads-1 workers, returning when all have completed
+    void run(int numTasks, int numThreads, const std::function<void(int)> &task);
+
+    int getNumWorkers(void);
+
+  protected:
+
+  private:
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    struct Batch {
+      const std::function<void(int)> *task;
+      int numTasks;
+      int numStarted;
+      int numDone;
+      std::condition_variable allDone;
+    };
+
+    void addWorkers(int numWorkers);
+    void work(void);
+
+    std::mutex theMutex;
+    std::condition_variable workAvailable;
+    std::deque<Batch *> theBatches;      // batches with tasks not yet started
+    std::vector<std::thread> theWorkers;
+    bool stopping;
+};
+
+// calls func(begin, end) for numThreads ranges covering [0, num), in
+// parallel on the shared pool; small loops are run on the calling thread
+template <class Func>
+inline void
+parallelFor(int num, int numThreads, Func func)
+{
+  if (numThreads < 2 || num < 2*numThreads) {
+    func(0, num);
+    return;
+  }
+
+  int chunk = (num+numThreads-1)/numThreads;
+  int numChunks = (num+chunk-1)/chunk;
+  ThreadPool::getThreadPool().run(numChunks, numThreads, [&](int t) {
+    int begin = t*chunk;
+    int end = begin+chunk;
+    if (end > num)
+      end = num;
+    func(begin, end);
+  });
+}
+
+#endif